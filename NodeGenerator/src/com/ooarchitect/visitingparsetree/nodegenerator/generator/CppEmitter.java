@@ -37,6 +37,10 @@ public class CppEmitter {
                 "VisitingParseTree::TraversalStatus";
     private static final String BASE_VISITOR_CLASS =
             "VisitingParseTree::Visitor";
+    private static final String NODE_ARENA_CLASS =
+            "VisitingParseTree::NodeArena";
+    private static final String DISPATCH_TAG_CLASS =
+            "VisitingParseTree::DispatchTag";
 
     private final Appendable declarationTarget;
     private final Appendable implementationTarget;
@@ -136,24 +140,90 @@ public class CppEmitter {
         return target;
     }
 
+    /**
+     * Returns the dispatch tag type for nodes in the generated hierarchy
+     * @return the tag type
+     */
+    private String dispatchTagType() {
+        return DISPATCH_TAG_CLASS + '<' + classHierarchyRoot + '>';
+    }
+
+    /**
+     * Emits a node's dispatch tag and its {@code accept()} method, which
+     * hands the visitor to the tag. The tag links to the superclass's
+     * tag so that visitation falls back to the nearest superclass
+     * whose visitor the visitor implements.
+     *
+     * @param nodeClassName node class name
+     * @param superclassName the node's immediate superclass
+     * @return the implementation target, for chaining
+     * @throws IOException when appending generated text fails
+     */
     Appendable acceptMethodImplementation(
             String nodeClassName,
             String superclassName) throws IOException {
         String withinClass = nodeClassName + "::";
+        String visitorClassName = toVisitorClassName(nodeClassName);
         return implementationTarget
+                .append(dispatchTagType()).append(' ').append(withinClass).append("DISPATCH_TAG =\n")
+                .append("    ").append(dispatchTagType()).append("::make<\n")
+                .append("        ").append(nodeClassName).append(",\n")
+                .append("        ").append(visitorClassName).append(",\n")
+                .append("        &").append(visitorClassName).append("::").append(toProcessMethod(nodeClassName)).append(">(\n")
+                .append("            &").append(superclassName).append("::DISPATCH_TAG);\n")
+                .append('\n')
                 .append(TRAVERSAL_STATUS + ' ').append(withinClass).append("accept(" + BASE_VISITOR_CLASS + " *visitor) {\n")
-                .append("  auto concrete_visitor = dynamic_cast<").append(toVisitorClassName(nodeClassName)).append(" *>(visitor);\n")
-                .append("  return concrete_visitor\n")
-                .append("      ? concrete_visitor->").append(toProcessMethod(nodeClassName)).append("(this)\n")
-                .append("      : ").append(superclassName).append("::accept(visitor);\n")
+                .append("  return DISPATCH_TAG.dispatch(visitor, this);\n")
                 .append("}\n")
                 .append('\n')
         ;
     }
 
+    /**
+     * Maps an attribute type keyword to the C++ value type that
+     * stores it.
+     *
+     * @param attributeType type keyword from the configuration
+     * @return the C++ value type, or {@code null} for string
+     *         attributes, which use the attribute class itself
+     */
+    private static String cppValueType(String attributeType) {
+        return switch (attributeType) {
+            case "bool" -> "bool";
+            case "double" -> "double";
+            case "int64" -> "std::int64_t";
+            case "interned" -> "VisitingParseTree::InternedString";
+            default -> null;
+        };
+    }
+
+    private boolean hasTypedAttributes() {
+        for (String name : context.attributes()) {
+            if (cppValueType(context.attributeType(name)) != null) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Returns the declared type of the specified attribute: the
+     * attribute class for strings, or the nested {@code Typed}
+     * template instance for typed values.
+     */
+    private String attributeMemberType(String name) {
+        String valueType = cppValueType(context.attributeType(name));
+        return valueType == null
+                ? context.attributeClass()
+                : "Typed<" + valueType + ">";
+    }
+
     /**
      * Declare attributes if the configuration specifies any. Does
-     * nothing if the user does not request attributes.
+     * nothing if the user does not request attributes. Typed
+     * attributes are declared as instances of a nested
+     * {@code Typed<V>} template so that, like string attributes,
+     * only the attribute class can create them.
      *
      * @throws IOException on error
      */
@@ -165,17 +235,30 @@ public class CppEmitter {
                     .append('\n')
                     .append("class ")
                         .append(attributeClass)
-                    .append(" : ")
+                    .append(" : public ")
                     .append("VisitingParseTree::Attribute")
                         .append(" {\n")
                     .append("  ")
                         .append(attributeClass)
-                        .append("(const char *name);\n")
-                    .append("public:\n");
+                        .append("(const char *name);\n");
+            if (hasTypedAttributes()) {
+                declarationTarget
+                        .append('\n')
+                        .append("  template <typename V>\n")
+                        .append("  class Typed : public VisitingParseTree::TypedAttribute<V> {\n")
+                        .append("    friend class ")
+                            .append(attributeClass)
+                            .append(";\n")
+                        .append("    Typed(const char *name) :\n")
+                        .append("        VisitingParseTree::TypedAttribute<V>(name) {}\n")
+                        .append("  };\n")
+                        .append('\n');
+            }
+            declarationTarget.append("public:\n");
             for (String name : context.attributes()) {
                 declarationTarget
                         .append("  static ")
-                            .append(attributeClass)
+                            .append(attributeMemberType(name))
                             .append(' ')
                             .append(name)
                             .append(";\n");
@@ -197,9 +280,12 @@ public class CppEmitter {
                     .append("(const char *name) :\n")
                     .append("    VisitingParseTree::Attribute(name) {}\n");
             for (String name: context.attributes()) {
+                String memberType = attributeMemberType(name);
                 implementationTarget
                         .append('\n')
-                        .append(attributeClass)
+                        .append(memberType.equals(attributeClass)
+                                ? attributeClass
+                                : attributeClass + "::" + memberType)
                             .append(' ')
                             .append(attributeClass)
                             .append("::")
@@ -225,6 +311,7 @@ public class CppEmitter {
                 .append("#ifndef ").append(guard).append('\n')
                 .append("#define ").append(guard).append('\n')
                 .append('\n')
+                .append("#include <cstdint>\n")
                 .append("#include <memory>\n")
                 .append('\n')
                 .append("#include <")
@@ -234,6 +321,7 @@ public class CppEmitter {
                 .append("#include <Attribute.h>\n")
                 .append("#include <Supplier.h>\n")
                 .append("#include <TraversalStatus.h>\n")
+                .append("#include <TypedAttribute.h>\n")
                 .append('\n');
         openNamespaces(declarationTarget);
     }
@@ -306,6 +394,8 @@ public class CppEmitter {
      */
     private void nodeDeclarationClose() throws IOException {
         declarationTarget
+                .append("  static ").append(dispatchTagType()).append(" DISPATCH_TAG;\n")
+                .append('\n')
                 .append("  virtual " + TRAVERSAL_STATUS + " accept(" + BASE_VISITOR_CLASS + " *visitor) override;\n")
                 .append("};\n")
                 .append('\n');
@@ -428,6 +518,9 @@ public class CppEmitter {
                 .append("    virtual std::shared_ptr<")
                     .append(classHierarchyRoot)
                     .append("> make_shared(void) override;\n")
+                .append("    virtual std::shared_ptr<")
+                    .append(classHierarchyRoot)
+                    .append("> allocate_shared(" + NODE_ARENA_CLASS + "& arena) override;\n")
                 .append("  };\n")
         ;
     }
@@ -464,6 +557,19 @@ public class CppEmitter {
                 .append("    std::make_shared<")
                     .append(nodeClassName)
                     .append(">(forbid_public_access::here));\n")
+                .append("}\n")
+                .append('\n')
+                .append("std::shared_ptr<")
+                    .append(classHierarchyRoot)
+                    .append("> ")
+                    .append(withinSupplier)
+                    .append("allocate_shared(" + NODE_ARENA_CLASS + "& arena) {\n")
+                .append("  return std::static_pointer_cast<")
+                    .append(classHierarchyRoot)
+                    .append(">(\n")
+                .append("    arena.make_shared<")
+                    .append(nodeClassName)
+                    .append(">(forbid_public_access::here));\n")
                 .append("}\n");
     }
 
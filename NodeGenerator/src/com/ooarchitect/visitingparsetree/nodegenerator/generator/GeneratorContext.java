@@ -24,6 +24,7 @@ package com.ooarchitect.visitingparsetree.nodegenerator.generator;
 
 import com.google.common.collect.ImmutableSetMultimap;
 import java.util.ArrayList;
+import java.util.HashMap;
 
 /**
  * Accumulates node-related information during configuration file
@@ -33,6 +34,8 @@ import java.util.ArrayList;
  */
 public class GeneratorContext {
 
+    public static final String STRING_ATTRIBUTE_TYPE = "string";
+
     public record NodeClassAndSuperclass(String supertype, String node)
             implements Comparable<NodeClassAndSuperclass> {
 
@@ -52,6 +55,7 @@ public class GeneratorContext {
     private final String declarationFilename;
     private final String implementationFilename;
     private final ArrayList<String> attributes;
+    private final HashMap<String, String> attributeTypes;
     private final ArrayList<String> namespaces;
     private final ImmutableSetMultimap.Builder<String, NodeClassAndSuperclass> nodeDeclarationsBuilder;
 
@@ -69,13 +73,19 @@ public class GeneratorContext {
         declarationFilename = outputFileStem + ".h";
         implementationFilename = outputFileStem + ".cpp";
         attributes = new ArrayList<>();
+        attributeTypes = new HashMap<>();
         namespaces = new ArrayList<>();
         nodeDeclarationsBuilder = ImmutableSetMultimap.builder();
         nodeClass = "";
     }
 
     void addAttribute(String attributeName) {
+        addAttribute(attributeName, STRING_ATTRIBUTE_TYPE);
+    }
+
+    void addAttribute(String attributeName, String attributeType) {
         attributes.add(attributeName);
+        attributeTypes.put(attributeName, attributeType);
     }
 
     void addNamespace(String namespace) {
@@ -94,6 +104,16 @@ public class GeneratorContext {
         return new ArrayList<>(attributes);
     }
 
+    /**
+     * Returns the declared type of the specified attribute
+     * @param attributeName attribute name
+     * @return the type keyword from the configuration: bool, double,
+     *         int64, interned, or string, the default
+     */
+    public String attributeType(String attributeName) {
+        return attributeTypes.getOrDefault(attributeName, STRING_ATTRIBUTE_TYPE);
+    }
+
     public String classHierarchyRoot() {
         return classHierarchyRoot;
     }
@@ -102,12 +122,18 @@ public class GeneratorContext {
         return declarationFilename;
     }
 
+    /**
+     * Qualifies a class name with the configured namespaces
+     * @param className class name, or an empty string for the
+     *                  namespace prefix alone
+     * @return the qualified name, e.g. {@code curly::larry::Foo}
+     */
     public String fullyQualifiedPrefixFrom(String className) {
         StringBuilder builder = new StringBuilder();
         for (String namespaceName : namespaces) {
             builder.append(namespaceName).append("::");
         }
-        return builder.toString();
+        return builder.append(className).toString();
     }
 
     public boolean hasInputFile() {
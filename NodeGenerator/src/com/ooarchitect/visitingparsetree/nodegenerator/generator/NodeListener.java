@@ -23,10 +23,36 @@ package com.ooarchitect.visitingparsetree.nodegenerator.generator;
 
 import com.ooarchitect.visitingparsetree.nodegenerator.grammar.NodeGenerationBaseListener;
 import com.ooarchitect.visitingparsetree.nodegenerator.grammar.NodeGenerationParser;
+import java.util.Set;
+import org.antlr.v4.runtime.ParserRuleContext;
 
 
 public class NodeListener extends NodeGenerationBaseListener {
 
+    /**
+     * C++ keywords and alternative tokens, which cannot name the
+     * generated namespaces, classes, and attributes. Keywords
+     * containing digits are omitted, since names cannot contain
+     * digits.
+     */
+    private static final Set<String> CPP_KEYWORDS = Set.of(
+            "alignas", "alignof", "and", "and_eq", "asm", "auto",
+            "bitand", "bitor", "bool", "break", "case", "catch", "char",
+            "class", "co_await", "co_return", "co_yield", "compl",
+            "concept", "const", "const_cast", "consteval", "constexpr",
+            "constinit", "continue", "decltype", "default", "delete",
+            "do", "double", "dynamic_cast", "else", "enum", "explicit",
+            "export", "extern", "false", "float", "for", "friend", "goto",
+            "if", "inline", "int", "long", "mutable", "namespace", "new",
+            "noexcept", "not", "not_eq", "nullptr", "operator", "or",
+            "or_eq", "private", "protected", "public", "register",
+            "reinterpret_cast", "requires", "return", "short", "signed",
+            "sizeof", "static", "static_assert", "static_cast", "struct",
+            "switch", "template", "this", "thread_local", "throw", "true",
+            "try", "typedef", "typeid", "typename", "union", "unsigned",
+            "using", "virtual", "void", "volatile", "wchar_t", "while",
+            "xor", "xor_eq");
+
     private final GeneratorContext context;
     private final String defaultBaseNodeClassClass;
 
@@ -42,6 +68,23 @@ public class NodeListener extends NodeGenerationBaseListener {
         nodeClass = "";
     }
 
+    /**
+     * Returns the name that a parse tree node holds, which becomes a
+     * C++ identifier in the generated code.
+     *
+     * @param ctx parse tree node containing a name
+     * @return the name
+     * @throws GeneratorException if the name is a C++ keyword
+     */
+    private static String cppName(ParserRuleContext ctx) {
+        String name = ctx.getText();
+        if (CPP_KEYWORDS.contains(name)) {
+            throw new GeneratorException(
+                    "The C++ keyword " + name + " cannot be used as a name.");
+        }
+        return name;
+    }
+
     @Override
     public void enterNode(NodeGenerationParser.NodeContext ctx) {
         nodeBaseClass = defaultBaseNodeClassClass;
@@ -51,25 +94,30 @@ public class NodeListener extends NodeGenerationBaseListener {
     @Override
     public void exitAttribute(
             NodeGenerationParser.AttributeContext ctx) {
-        context.addAttribute(ctx.getText());
+        String attributeName = cppName(ctx.attribute_name());
+        if (ctx.attribute_type() == null) {
+            context.addAttribute(attributeName);
+        } else {
+            context.addAttribute(attributeName, ctx.attribute_type().getText());
+        }
     }
 
     @Override
     public void exitAttribute_class(
             NodeGenerationParser.Attribute_classContext ctx) {
-        context.setAttributeClass(ctx.getText());
+        context.setAttributeClass(cppName(ctx));
     }
 
     @Override
     public void exitBare_node(
             NodeGenerationParser.Bare_nodeContext ctx) {
-        nodeClass = ctx.getText();
+        nodeClass = cppName(ctx);
     }
 
     @Override
     public void exitNamespace_name(
             NodeGenerationParser.Namespace_nameContext ctx) {
-        String namespaceName = ctx.getText();
+        String namespaceName = cppName(ctx);
         context.addNamespace(namespaceName);
     }
 
@@ -82,18 +130,18 @@ public class NodeListener extends NodeGenerationBaseListener {
     @Override
     public void exitNode_class(
             NodeGenerationParser.Node_classContext ctx) {
-        context.setNodeClass(ctx.getText());
+        context.setNodeClass(cppName(ctx));
     }
 
     @Override
     public void exitNode_subtype(
             NodeGenerationParser.Node_subtypeContext ctx) {
-        nodeClass = ctx.getText();
+        nodeClass = cppName(ctx);
     }
 
     @Override
     public void exitNode_supertype(
             NodeGenerationParser.Node_supertypeContext ctx) {
-        nodeBaseClass = ctx.getText();
+        nodeBaseClass = cppName(ctx);
     }
 }
@@ -33,25 +33,35 @@ configuration_body:
 namespace_declaration: NAMESPACES_KEYWORD EQUALS namespace_block SEMI;
 namespace_block:  OPEN_BRACE namespace_list CLOSE_BRACE;
 namespace_list: namespace_name (COMMA namespace_name)*;
-namespace_name: ID;
+namespace_name: name;
 
 node_declaration: NODES_KEYWORD EQUALS node_class_and_block SEMI;
 node_class_and_block: node_class node_block;
-node_class: ID;
+node_class: name;
 node_block: OPEN_BRACE node_list CLOSE_BRACE;
 node_list: node (COMMA node)*;
 node: bare_node | qualified_node;
-bare_node: ID;
+bare_node: name;
 qualified_node : node_subtype SUBTYPE_OF node_supertype;
-node_supertype: ID;
-node_subtype: ID;
+node_supertype: name;
+node_subtype: name;
 
 attribute_declaration: ATTRIBUTES_KEYWORD EQUALS attribute_class_and_block SEMI;
 attribute_class_and_block: attribute_class attribute_block;
-attribute_class: ID;
+attribute_class: name;
 attribute_block: OPEN_BRACE attribute_list CLOSE_BRACE;
 attribute_list: attribute (COMMA attribute)*;
-attribute: ID;
+attribute: attribute_name (COLON attribute_type)?;
+attribute_name: name;
+attribute_type: BOOL_KEYWORD | DOUBLE_KEYWORD | INT64_KEYWORD | INTERNED_KEYWORD | STRING_KEYWORD;
+
+/*
+ * The attribute type keywords are reserved only where a type is
+ * expected, so they remain valid names elsewhere. Names become C++
+ * identifiers, so the generator rejects C++ keywords such as bool and
+ * double (see NodeListener).
+ */
+name: ID | BOOL_KEYWORD | DOUBLE_KEYWORD | INT64_KEYWORD | INTERNED_KEYWORD | STRING_KEYWORD;
 
 
 /* Keywords */
@@ -59,9 +69,17 @@ ATTRIBUTES_KEYWORD: 'attributes';
 NAMESPACES_KEYWORD: 'namespaces';
 NODES_KEYWORD: 'nodes';
 
+/* Attribute types */
+BOOL_KEYWORD: 'bool';
+DOUBLE_KEYWORD: 'double';
+INT64_KEYWORD: 'int64';
+INTERNED_KEYWORD: 'interned';
+STRING_KEYWORD: 'string';
+
 /* Operators */
 SUBTYPE_OF: '->';
 CLOSE_BRACE: '}';
+COLON: ':';
 COMMA: ',';
 EQUALS: '=';
 OPEN_BRACE: '{';
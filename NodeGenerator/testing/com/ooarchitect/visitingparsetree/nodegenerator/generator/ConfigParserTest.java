@@ -21,6 +21,8 @@ package com.ooarchitect.visitingparsetree.nodegenerator.generator;
 
 import com.google.common.collect.ImmutableSetMultimap;
 
+import java.util.List;
+
 import org.junit.Test;
 import org.junit.runner.RunWith;
 import org.junit.runners.JUnit4;
@@ -28,6 +30,7 @@ import org.junit.runners.JUnit4;
 import com.ooarchitect.visitingparsetree.nodegenerator.generator.GeneratorContext.NodeClassAndSuperclass;
 
 import static com.google.common.truth.Truth.assertThat;
+import static org.junit.Assert.assertThrows;
 
 @RunWith(JUnit4.class)
 public class ConfigParserTest {
@@ -70,4 +73,62 @@ public class ConfigParserTest {
                 "goofy",
                 "slapstick");
     }
+
+    @Test
+    public void testTypedAttributes() {
+        GeneratorContext context = ConfigParser.fromString(
+                """
+                        namespaces = { curly };
+                        nodes = TestNodes { Foo };
+                        attributes = TestAttributes { silly, count : int64, weight : double, seen : bool, kind : interned, name : string };
+                """,
+                DEFAULT_BASE_CLASS,
+                OUTPUT_FILE_STEM).parse();
+        assertThat(context.attributes()).containsExactly(
+                "silly", "count", "weight", "seen", "kind", "name").inOrder();
+        assertThat(context.attributeType("silly")).isEqualTo("string");
+        assertThat(context.attributeType("count")).isEqualTo("int64");
+        assertThat(context.attributeType("weight")).isEqualTo("double");
+        assertThat(context.attributeType("seen")).isEqualTo("bool");
+        assertThat(context.attributeType("kind")).isEqualTo("interned");
+        assertThat(context.attributeType("name")).isEqualTo("string");
+    }
+
+    @Test
+    public void testTypeKeywordsAsNames() {
+        GeneratorContext context = ConfigParser.fromString(
+                """
+                        namespaces = { interned };
+                        nodes = TestNodes { string, int64 -> string };
+                        attributes = TestAttributes { int64 : bool, string, interned : double };
+                """,
+                DEFAULT_BASE_CLASS,
+                OUTPUT_FILE_STEM).parse();
+        assertThat(context.namespaces()).containsExactly("interned");
+        assertThat(context.nodeDeclarations().get("string")).containsExactly(
+                new NodeClassAndSuperclass("string", "int64"));
+        assertThat(context.attributes()).containsExactly(
+                "int64", "string", "interned").inOrder();
+        assertThat(context.attributeType("int64")).isEqualTo("bool");
+        assertThat(context.attributeType("string")).isEqualTo("string");
+        assertThat(context.attributeType("interned")).isEqualTo("double");
+    }
+
+    @Test
+    public void testCppKeywordsRejected() {
+        for (String config : List.of(
+                "namespaces = { namespace }; nodes = TestNodes { Foo };",
+                "nodes = class { Foo };",
+                "nodes = TestNodes { double };",
+                "nodes = TestNodes { Foo, bool -> Foo };",
+                "nodes = TestNodes { Foo -> int };",
+                "nodes = TestNodes { Foo }; attributes = struct { silly };",
+                "nodes = TestNodes { Foo }; attributes = TestAttributes { bool : int64 };")) {
+            ConfigParser parser = ConfigParser.fromString(
+                    config,
+                    DEFAULT_BASE_CLASS,
+                    OUTPUT_FILE_STEM);
+            assertThrows(GeneratorException.class, parser::parse);
+        }
+    }
 }
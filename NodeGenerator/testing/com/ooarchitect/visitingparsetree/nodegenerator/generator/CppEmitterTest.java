@@ -71,6 +71,7 @@ public class CppEmitterTest {
             #ifndef TESTNODES_H_
             #define TESTNODES_H_
             
+            #include <cstdint>
             #include <memory>
             
             #include <BaseAttrNode.h>
@@ -78,6 +79,7 @@ public class CppEmitterTest {
             #include <Attribute.h>
             #include <Supplier.h>
             #include <TraversalStatus.h>
+            #include <TypedAttribute.h>
             
             namespace curly {
             namespace larry {
@@ -103,11 +105,15 @@ public class CppEmitterTest {
             """;
 
     private static final String EXPECTED_ABSTRACT_NODE_IMPLEMENTATION = """
+            VisitingParseTree::DispatchTag<VisitingParseTree::BaseAttrNode> Foo::DISPATCH_TAG =
+                VisitingParseTree::DispatchTag<VisitingParseTree::BaseAttrNode>::make<
+                    Foo,
+                    FooVisitor,
+                    &FooVisitor::processFoo>(
+                        &VisitingParseTree::BaseAttrNode::DISPATCH_TAG);
+            
             VisitingParseTree::TraversalStatus Foo::accept(VisitingParseTree::Visitor *visitor) {
-              auto concrete_visitor = dynamic_cast<FooVisitor *>(visitor);
-              return concrete_visitor
-                  ? concrete_visitor->processFoo(this)
-                  : VisitingParseTree::BaseAttrNode::accept(visitor);
+              return DISPATCH_TAG.dispatch(visitor, this);
             }
             
             """;
@@ -116,11 +122,15 @@ public class CppEmitterTest {
        """
        Foo::Foo(forbid_public_access) {}
        
+       VisitingParseTree::DispatchTag<VisitingParseTree::BaseAttrNode> Foo::DISPATCH_TAG =
+           VisitingParseTree::DispatchTag<VisitingParseTree::BaseAttrNode>::make<
+               Foo,
+               FooVisitor,
+               &FooVisitor::processFoo>(
+                   &VisitingParseTree::BaseAttrNode::DISPATCH_TAG);
+       
        VisitingParseTree::TraversalStatus Foo::accept(VisitingParseTree::Visitor *visitor) {
-         auto concrete_visitor = dynamic_cast<FooVisitor *>(visitor);
-         return concrete_visitor
-             ? concrete_visitor->processFoo(this)
-             : VisitingParseTree::BaseAttrNode::accept(visitor);
+         return DISPATCH_TAG.dispatch(visitor, this);
        }
 
        Foo::FooSupplier Foo::SUPPLIER;
@@ -137,6 +147,7 @@ public class CppEmitterTest {
                 FooSupplier(void);
               public:
                 virtual std::shared_ptr<VisitingParseTree::BaseAttrNode> make_shared(void) override;
+                virtual std::shared_ptr<VisitingParseTree::BaseAttrNode> allocate_shared(VisitingParseTree::NodeArena& arena) override;
               };
             """;
 
@@ -147,6 +158,8 @@ public class CppEmitterTest {
             
             public:
             
+              static VisitingParseTree::DispatchTag<VisitingParseTree::BaseAttrNode> DISPATCH_TAG;
+            
               virtual VisitingParseTree::TraversalStatus accept(VisitingParseTree::Visitor *visitor) override;
             };
             
@@ -166,6 +179,8 @@ public class CppEmitterTest {
             
               virtual VisitingParseTree::BaseAttrNodeSupplier& supplier(void) override;
             
+              static VisitingParseTree::DispatchTag<VisitingParseTree::BaseAttrNode> DISPATCH_TAG;
+            
               virtual VisitingParseTree::TraversalStatus accept(VisitingParseTree::Visitor *visitor) override;
             };
             
@@ -179,6 +194,11 @@ public class CppEmitterTest {
               return std::static_pointer_cast<VisitingParseTree::BaseAttrNode>(
                 std::make_shared<Foo>(forbid_public_access::here));
             }
+            
+            std::shared_ptr<VisitingParseTree::BaseAttrNode> Foo::FooSupplier::allocate_shared(VisitingParseTree::NodeArena& arena) {
+              return std::static_pointer_cast<VisitingParseTree::BaseAttrNode>(
+                arena.make_shared<Foo>(forbid_public_access::here));
+            }
             """;
 
     private static final String EXPECTED_VISITOR_DECLARATION = """
@@ -188,6 +208,49 @@ public class CppEmitterTest {
             };
             """;
 
+    private static final String TYPED_CONFIG =
+            """
+                    namespaces = { curly, larry, moe };
+                    nodes = TestNodes { Foo };
+                    attributes = TestAttributes { silly, count : int64, weight : double, seen : bool, kind : interned };
+            """;
+
+    private static final String EXPECTED_TYPED_ATTRIBUTE_DECLARATION = """
+            
+            class TestAttributes : public VisitingParseTree::Attribute {
+              TestAttributes(const char *name);
+            
+              template <typename V>
+              class Typed : public VisitingParseTree::TypedAttribute<V> {
+                friend class TestAttributes;
+                Typed(const char *name) :
+                    VisitingParseTree::TypedAttribute<V>(name) {}
+              };
+            
+            public:
+              static TestAttributes silly;
+              static Typed<std::int64_t> count;
+              static Typed<double> weight;
+              static Typed<bool> seen;
+              static Typed<VisitingParseTree::InternedString> kind;
+            };
+            """;
+
+    private static final String EXPECTED_TYPED_ATTRIBUTE_IMPLEMENTATION = """
+            TestAttributes::TestAttributes(const char *name) :
+                VisitingParseTree::Attribute(name) {}
+            
+            TestAttributes TestAttributes::silly("curly::larry::moe::TestAttributes::silly");
+            
+            TestAttributes::Typed<std::int64_t> TestAttributes::count("curly::larry::moe::TestAttributes::count");
+            
+            TestAttributes::Typed<double> TestAttributes::weight("curly::larry::moe::TestAttributes::weight");
+            
+            TestAttributes::Typed<bool> TestAttributes::seen("curly::larry::moe::TestAttributes::seen");
+            
+            TestAttributes::Typed<VisitingParseTree::InternedString> TestAttributes::kind("curly::larry::moe::TestAttributes::kind");
+            """;
+
     private CppEmitter emitter;
     private GeneratorContext context;
     private StringBuilder declarationTarget;
@@ -297,4 +360,77 @@ public class CppEmitterTest {
         assertThat(declarationTarget.toString()).isEmpty();
         assertThat(implementationTarget.toString()).isEqualTo(EXPECTED_CONCRETE_NODE_IMPLEMENTATION);
     }
-}
\ No newline at end of file
+
+    @Test
+    public void testConcreteSuppliersAllocateFromArena() throws IOException {
+        emitter.emit();
+        String declaration = declarationTarget.toString();
+        String implementation = implementationTarget.toString();
+        for (String node : new String[] {"Bar", "Fubb"}) {
+            assertThat(implementation).contains(
+                    "std::shared_ptr<VisitingParseTree::BaseAttrNode> "
+                    + node + "::" + node + "Supplier::allocate_shared("
+                    + "VisitingParseTree::NodeArena& arena) {\n"
+                    + "  return std::static_pointer_cast<VisitingParseTree::BaseAttrNode>(\n"
+                    + "    arena.make_shared<" + node + ">(forbid_public_access::here));\n");
+        }
+        assertThat(declaration).doesNotContain("FooSupplier");
+        assertThat(implementation).doesNotContain("make_shared<Foo>");
+    }
+
+    @Test
+    public void testDispatchTagsChainToSuperclasses() throws IOException {
+        emitter.emit();
+        String implementation = implementationTarget.toString();
+        assertThat(implementation).contains("""
+                        &FooVisitor::processFoo>(
+                            &VisitingParseTree::BaseAttrNode::DISPATCH_TAG);
+                """);
+        assertThat(implementation).contains("""
+                        &BarVisitor::processBar>(
+                            &VisitingParseTree::BaseAttrNode::DISPATCH_TAG);
+                """);
+        assertThat(implementation).contains("""
+                        &FubbVisitor::processFubb>(
+                            &Foo::DISPATCH_TAG);
+                """);
+        assertThat(implementation).doesNotContain("dynamic_cast");
+    }
+
+    @Test
+    public void testTypedAttributes() throws IOException {
+        GeneratorContext typedContext = ConfigParser.fromString(
+                TYPED_CONFIG,
+                DEFAULT_BASE_CLASS, OUTPUT_FILE_STEM).parse();
+        CppEmitter typedEmitter = new CppEmitter(
+                declarationTarget,
+                implementationTarget,
+                typedContext,
+                () -> EPOCH_START,
+                () -> TEST_USER);
+        typedEmitter.attributeDeclaration();
+        typedEmitter.attributeImplementation();
+        assertThat(declarationTarget.toString())
+                .isEqualTo(EXPECTED_TYPED_ATTRIBUTE_DECLARATION);
+        assertThat(implementationTarget.toString())
+                .isEqualTo(EXPECTED_TYPED_ATTRIBUTE_IMPLEMENTATION);
+    }
+
+    @Test
+    public void testInternedAttributeHeader() throws IOException {
+        GeneratorContext typedContext = ConfigParser.fromString(
+                TYPED_CONFIG,
+                DEFAULT_BASE_CLASS, OUTPUT_FILE_STEM).parse();
+        new CppEmitter(
+                declarationTarget,
+                implementationTarget,
+                typedContext,
+                () -> EPOCH_START,
+                () -> TEST_USER).emit();
+        String declaration = declarationTarget.toString();
+        // TypedAttribute.h declares InternedString.
+        assertThat(declaration).contains("#include <TypedAttribute.h>\n");
+        assertThat(declaration).contains(
+                "  static Typed<VisitingParseTree::InternedString> kind;\n");
+    }
+}
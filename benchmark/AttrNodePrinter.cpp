@@ -0,0 +1,79 @@
+/*
+ * AttrNodePrinter.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Times printing a large tree, in full and truncated.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include "AttrNodePrinter.h"
+#include "BaseAttrNode.h"
+#include "IntegerNode.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+#include "TreeBuilder.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace AttrNodePrinterBenchmark {
+
+/*
+ * A root with sum_count sums of leaves_per_sum leaves each.
+ */
+static shared_ptr<BaseAttrNode> sums(int sum_count, int leaves_per_sum) {
+  TreeBuilder<BaseAttrNode> builder;
+  builder.open(RootNode::SUPPLIER, sum_count);
+  for (int i = 0; i < sum_count; ++i) {
+    builder.open(PlusNode::SUPPLIER, leaves_per_sum);
+    for (int j = 0; j < leaves_per_sum; ++j) {
+      builder.open(IntegerNode::SUPPLIER)
+          .attr(TestAttribute::COUNT, int64_t(j))
+          .close();
+    }
+    builder.close();
+  }
+  return builder.close().finish();
+}
+
+} /* namespace AttrNodePrinterBenchmark */
+
+using namespace AttrNodePrinterBenchmark;
+
+/*
+ * Benchmark: prints a tree of about a million nodes in full and
+ * truncated.
+ */
+TEST(AttrNodePrinter, Benchmark) {
+  auto root = sums(1 << 16, 15);
+  AttrNodePrinter printer;
+
+  auto full_start = chrono::steady_clock::now();
+  ostringstream full;
+  printer.print(root, full);
+  chrono::duration<double, milli> full_time =
+      chrono::steady_clock::now() - full_start;
+
+  printer.set_max_children(8);
+  auto truncated_start = chrono::steady_clock::now();
+  ostringstream truncated;
+  printer.print(root, truncated);
+  chrono::duration<double, milli> truncated_time =
+      chrono::steady_clock::now() - truncated_start;
+
+  ASSERT_LT(truncated.str().size(), full.str().size());
+  cout << "Printing " << (1 << 16) * 16 + 1 << " nodes ("
+      << full.str().size() / (1024 * 1024) << " MiB): "
+      << full_time.count() << " ms; at most 8 children per node: "
+      << truncated_time.count() << " ms." << endl;
+}
@@ -0,0 +1,99 @@
+/*
+ * Attributes.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Measures the memory that attributed nodes occupy and the time that
+ * attribute lookups take.
+ */
+
+#include <malloc.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "AttributedTestNode.h"
+#include "AttributeMap.h"
+#include "TestAttribute.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace AttributesBenchmark {
+
+constexpr size_t NODE_COUNT = 100000;
+
+const Attribute *ATTRIBUTES[] = {
+    &TestAttribute::BIRTH_DATE,
+    &TestAttribute::NAME,
+    &TestAttribute::SERIAL_NO,
+    &TestAttribute::URL,
+    &TestAttribute::VALUE,
+};
+
+/*
+ * Creates nodes that carry the specified number of short attributes.
+ */
+static vector<shared_ptr<BaseAttrNode>> nodes(size_t attribute_count) {
+  vector<shared_ptr<BaseAttrNode>> result;
+  result.reserve(NODE_COUNT);
+  for (size_t i = 0; i < NODE_COUNT; ++i) {
+    result.push_back(AttributedTestNode::SUPPLIER.make_shared());
+    for (size_t a = 0; a < attribute_count; ++a) {
+      result.back()->set(*ATTRIBUTES[a], "v" + to_string(a));
+    }
+  }
+  return result;
+}
+
+} /* namespace AttributesBenchmark */
+
+using namespace AttributesBenchmark;
+
+/*
+ * Benchmark: heap bytes per node, including the shared_ptr control
+ * block, for nodes with zero to five attributes. A node without
+ * attributes allocates no entry block.
+ */
+TEST(Attributes, Memory) {
+  for (size_t attribute_count : {0, 1, 2, 3, 4, 5}) {
+    size_t before = mallinfo2().uordblks;
+    auto created = nodes(attribute_count);
+    size_t after = mallinfo2().uordblks;
+    size_t vector_bytes = created.capacity() * sizeof(created[0]);
+    cout << "Nodes with " << attribute_count << " attributes: "
+        << (after - before - vector_bytes) / NODE_COUNT
+        << " bytes per node." << endl;
+  }
+  cout << "sizeof(AttributeMap) is " << sizeof(AttributeMap)
+      << " bytes, sizeof(AttributeMap::Entry) is "
+      << sizeof(AttributeMap::Entry) << " bytes." << endl;
+}
+
+/*
+ * Benchmark: get() and has() on nodes with three attributes.
+ */
+TEST(Attributes, Lookup) {
+  constexpr int PASSES = 10;
+  auto created = nodes(3);
+  size_t found = 0;
+  auto start = chrono::steady_clock::now();
+  for (int pass = 0; pass < PASSES; ++pass) {
+    for (auto& node : created) {
+      found += node->get(TestAttribute::SERIAL_NO).size();
+      found += node->has(TestAttribute::VALUE);
+    }
+  }
+  chrono::duration<double, nano> elapsed =
+      chrono::steady_clock::now() - start;
+  ASSERT_EQ(2 * PASSES * NODE_COUNT, found);
+  cout << "get() and has() on three-attribute nodes: "
+      << elapsed.count() / (2 * PASSES * NODE_COUNT) << " ns each."
+      << endl;
+}
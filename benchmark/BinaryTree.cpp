@@ -0,0 +1,122 @@
+/*
+ * BinaryTree.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Measures the throughput of the binary tree writer and reader.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "BinaryTreeReader.h"
+#include "BinaryTreeWriter.h"
+#include "DivNode.h"
+#include "FileSink.h"
+#include "IntegerNode.h"
+#include "InternPool.h"
+#include "MinusNode.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+#include "TimesNode.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace BinaryTreeBenchmark {
+
+/*
+ * Registers every test node type and attribute with a reader.
+ */
+static BinaryTreeReader& register_all(BinaryTreeReader& reader) {
+  return reader
+      .add(RootNode::SUPPLIER)
+      .add(PlusNode::SUPPLIER)
+      .add(MinusNode::SUPPLIER)
+      .add(TimesNode::SUPPLIER)
+      .add(DivNode::SUPPLIER)
+      .add(IntegerNode::SUPPLIER)
+      .add(TestAttribute::BYPASS_CHILDREN_ON_ENTRY)
+      .add(TestAttribute::NAME)
+      .add(TestAttribute::SERIAL_NO)
+      .add(TestAttribute::VALUE)
+      .add(TestAttribute::COUNT)
+      .add(TestAttribute::WEIGHT)
+      .add(TestAttribute::VISITED)
+      .add(TestAttribute::TYPE_NAME);
+}
+
+/*
+ * Builds a wide tree of sums with about the specified number of
+ * nodes, each leaf having a string value and typed attributes.
+ */
+static shared_ptr<BaseAttrNode> large_tree(int node_count) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  auto sum = root->append_child(PlusNode::SUPPLIER);
+  auto integer_type = InternPool::global().intern("integer");
+  for (int i = 1; i < node_count; ++i) {
+    if (0 == i % 16) {
+      sum = root->append_child(PlusNode::SUPPLIER);
+      continue;
+    }
+    auto leaf = sum->append_child(IntegerNode::SUPPLIER);
+    leaf->put(TestAttribute::VALUE, to_string(i));
+    leaf->put(TestAttribute::COUNT, int64_t(i) - node_count / 2);
+    leaf->put(TestAttribute::TYPE_NAME, integer_type);
+  }
+  return root;
+}
+
+} /* namespace BinaryTreeBenchmark */
+
+using namespace BinaryTreeBenchmark;
+
+/*
+ * Benchmark: writes and reads a tree with about a million nodes.
+ */
+TEST(BinaryTree, Benchmark) {
+  constexpr int NODE_COUNT = 1000000;
+  auto tree = large_tree(NODE_COUNT);
+  stringstream stream;
+
+  auto write_start = chrono::steady_clock::now();
+  BinaryTreeWriter(stream).write(tree);
+  chrono::duration<double> write_time =
+      chrono::steady_clock::now() - write_start;
+  double megabytes = stream.str().size() / 1e6;
+
+  auto path = filesystem::temp_directory_path() / "BinaryTree.Benchmark.vpt";
+  auto file_start = chrono::steady_clock::now();
+  {
+    FileSink sink(path.string());
+    BinaryTreeWriter(sink).write(tree);
+  }
+  chrono::duration<double> file_time =
+      chrono::steady_clock::now() - file_start;
+  ASSERT_EQ(stream.str().size(), filesystem::file_size(path));
+  filesystem::remove(path);
+
+  BinaryTreeReader reader(stream);
+  register_all(reader);
+  auto read_start = chrono::steady_clock::now();
+  auto copy = reader.read();
+  chrono::duration<double> read_time =
+      chrono::steady_clock::now() - read_start;
+  ASSERT_TRUE(tree->structurally_equals(*copy));
+
+  cout << "Serialized " << NODE_COUNT << " nodes into " << megabytes
+      << " MB: writing " << megabytes / write_time.count()
+      << " MB/s to a string stream, " << megabytes / file_time.count()
+      << " MB/s to a file, reading " << megabytes / read_time.count()
+      << " MB/s." << endl;
+}
@@ -0,0 +1,165 @@
+/*
+ * DeepClone.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Compares deep_clone() with cloning a tree one node at a time.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "FrozenTree.h"
+#include "IntegerNode.h"
+#include "NodeArena.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+#include "VacuousVoidFunction.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace DeepCloneBenchmark {
+
+/*
+ * Builds a complete binary expression tree whose leaves carry values.
+ */
+static shared_ptr<BaseAttrNode> expression(int depth) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  vector<shared_ptr<BaseAttrNode>> level = {root};
+  for (int d = 0; d < depth; ++d) {
+    vector<shared_ptr<BaseAttrNode>> next_level;
+    for (auto& node : level) {
+      for (int i = 0; i < 2; ++i) {
+        auto& supplier = d + 1 < depth
+            ? static_cast<Supplier<BaseAttrNode>&>(PlusNode::SUPPLIER)
+            : static_cast<Supplier<BaseAttrNode>&>(IntegerNode::SUPPLIER);
+        auto child = node->append_child(supplier);
+        child->put(TestAttribute::SERIAL_NO, to_string(next_level.size()));
+        child->put(TestAttribute::COUNT, d);
+        next_level.push_back(child);
+      }
+    }
+    level = std::move(next_level);
+  }
+  return root;
+}
+
+/*
+ * Asserts that two trees have the same shape, node types, and
+ * attributes.
+ */
+static void assert_same(
+    const shared_ptr<BaseAttrNode>& expected,
+    const shared_ptr<BaseAttrNode>& actual) {
+  auto expected_frozen = FrozenTree::freeze(expected);
+  auto actual_frozen = FrozenTree::freeze(actual);
+  ASSERT_EQ(expected_frozen.size(), actual_frozen.size());
+  for (size_t i = 0; i < expected_frozen.size(); ++i) {
+    ASSERT_NE(expected_frozen.node(i), actual_frozen.node(i));
+    ASSERT_EQ(expected_frozen.supplier(i), actual_frozen.supplier(i));
+    ASSERT_EQ(expected_frozen.parent(i), actual_frozen.parent(i));
+    ASSERT_EQ(expected_frozen.subtree_end(i), actual_frozen.subtree_end(i));
+    auto expected_attributes = expected_frozen.attributes(i);
+    auto actual_attributes = actual_frozen.attributes(i);
+    ASSERT_EQ(expected_attributes.size(), actual_attributes.size());
+    for (size_t j = 0; j < expected_attributes.size(); ++j) {
+      ASSERT_EQ(expected_attributes[j].attribute, actual_attributes[j].attribute);
+      ASSERT_EQ(expected_attributes[j].value, actual_attributes[j].value);
+    }
+  }
+}
+
+/*
+ * Clones a subtree the way callers did before deep_clone(): one
+ * clone() and append_child() per node.
+ */
+class HandCloner : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  vector<shared_ptr<BaseAttrNode>> path;
+  shared_ptr<BaseAttrNode> root;
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    auto copy = node->clone();
+    if (path.empty()) {
+      root = copy;
+    } else {
+      path.back()->append_child(copy);
+    }
+    path.push_back(copy);
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+class Popper : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  vector<shared_ptr<BaseAttrNode>>& path;
+
+  Popper(vector<shared_ptr<BaseAttrNode>>& path) :
+      path(path) {
+  }
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    path.pop_back();
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+} /* namespace DeepCloneBenchmark */
+
+using namespace DeepCloneBenchmark;
+
+/*
+ * Benchmark: compares deep_clone(), with and without an arena, to a
+ * hand-written clone that copies one node at a time. Each copy is
+ * released before the next one is made, after a warm-up copy, so
+ * that every copy draws from the same recycled heap.
+ */
+TEST(DeepClone, Benchmark) {
+  auto source = expression(18);
+  source->deep_clone();
+
+  HandCloner hand_cloner;
+  Popper popper(hand_cloner.path);
+  BorrowingTraversal<BaseAttrNode> traversal(
+      hand_cloner,
+      popper,
+      VacuousVoidFunction::INSTANCE,
+      VacuousVoidFunction::INSTANCE);
+  auto hand_start = chrono::steady_clock::now();
+  traversal(source);
+  chrono::duration<double, milli> hand_time =
+      chrono::steady_clock::now() - hand_start;
+  assert_same(source, hand_cloner.root);
+  hand_cloner.root.reset();
+
+  auto deep_start = chrono::steady_clock::now();
+  auto copy = source->deep_clone();
+  chrono::duration<double, milli> deep_time =
+      chrono::steady_clock::now() - deep_start;
+  assert_same(source, copy);
+  copy.reset();
+
+  auto arena = NodeArena::make_shared(1 << 20);
+  auto arena_start = chrono::steady_clock::now();
+  copy = source->deep_clone(*arena);
+  chrono::duration<double, milli> arena_time =
+      chrono::steady_clock::now() - arena_start;
+  assert_same(source, copy);
+
+  cout << "Cloning " << FrozenTree::freeze(source).size()
+      << " nodes: node by node " << hand_time.count()
+      << " ms, deep_clone() " << deep_time.count()
+      << " ms, deep_clone() into an arena " << arena_time.count()
+      << " ms." << endl;
+}
@@ -0,0 +1,123 @@
+/*
+ * Detach.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Times detaching every child of a very wide node, and the removal
+ * that detach() performed before nodes recorded their slot in their
+ * parent.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "AttributedTestNode.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace DetachBenchmark {
+
+constexpr size_t WIDTH = 100000;
+
+/*
+ * Orders in which to detach the children: oldest first, youngest
+ * first, and pairwise swapped (1, 0, 3, 2, ...), which opens a
+ * vacancy between children before every other detach.
+ */
+enum class Order { OLDEST_FIRST, YOUNGEST_FIRST, INTERLEAVED };
+
+static const char *order_name(Order order) {
+  switch (order) {
+  case Order::OLDEST_FIRST:
+    return "oldest first";
+  case Order::YOUNGEST_FIRST:
+    return "youngest first";
+  default:
+    return "interleaved";
+  }
+}
+
+/*
+ * Returns the index of the i-th child to detach.
+ */
+static size_t child_to_detach(Order order, size_t i) {
+  switch (order) {
+  case Order::OLDEST_FIRST:
+    return i;
+  case Order::YOUNGEST_FIRST:
+    return WIDTH - 1 - i;
+  default:
+    return i ^ 1;
+  }
+}
+
+/*
+ * Removes a child the way detach() used to: scan the parent's child
+ * vector for the child, then erase it, shifting its younger siblings.
+ */
+static void scan_and_erase(
+    vector<shared_ptr<BaseAttrNode>>& siblings,
+    const BaseAttrNode *child) {
+  for (auto it = siblings.begin(); it != siblings.end(); ++it) {
+    if (child == (*it).get()) {
+      siblings.erase(it);
+      return;
+    }
+  }
+  FAIL() << "Child not found in parent.";
+}
+
+/*
+ * Detaches all of a wide node's children in the specified order and
+ * returns the time it took in milliseconds. The baseline applies
+ * scan_and_erase() to a copy of the child vector instead.
+ */
+static double detach_all(Order order, bool baseline) {
+  auto root = AttributedTestNode::SUPPLIER.make_shared();
+  vector<shared_ptr<BaseAttrNode>> children;
+  for (size_t i = 0; i < WIDTH; ++i) {
+    children.push_back(root->append_child(AttributedTestNode::SUPPLIER));
+  }
+  vector<shared_ptr<BaseAttrNode>> siblings(children);
+
+  auto start = chrono::steady_clock::now();
+  for (size_t i = 0; i < WIDTH; ++i) {
+    auto& child = children[child_to_detach(order, i)];
+    if (baseline) {
+      scan_and_erase(siblings, child.get());
+    } else {
+      child->detach();
+    }
+  }
+  chrono::duration<double, milli> elapsed =
+      chrono::steady_clock::now() - start;
+
+  EXPECT_TRUE(baseline ? siblings.empty() : root->is_leaf());
+  return elapsed.count();
+}
+
+} /* namespace DetachBenchmark */
+
+using namespace DetachBenchmark;
+
+/*
+ * Benchmark: detaches all children of a 100,000-child node, oldest
+ * first, youngest first, and interleaved, with detach() and with the
+ * scan and erase that it replaced.
+ */
+TEST(Detach, Benchmark) {
+  for (Order order :
+      {Order::OLDEST_FIRST, Order::YOUNGEST_FIRST, Order::INTERLEAVED}) {
+    double baseline_time = detach_all(order, true);
+    double detach_time = detach_all(order, false);
+    cout << "Detaching " << WIDTH << " children " << order_name(order)
+        << ": scan and erase " << baseline_time << " ms, detach() "
+        << detach_time << " ms." << endl;
+  }
+}
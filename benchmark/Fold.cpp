@@ -0,0 +1,103 @@
+/*
+ * Fold.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Compares a sequential fold with parallel folds on pools of
+ * increasing size.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "Fold.h"
+#include "FoldFunction.h"
+#include "ParallelFold.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "WorkStealingPool.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace FoldBenchmark {
+
+/*
+ * Computes subtree sizes.
+ */
+class Size : public FoldFunction<BaseAttrNode, size_t> {
+public:
+  virtual size_t operator()(
+      BaseAttrNode *node,
+      span<const size_t> children) override {
+    size_t size = 1;
+    for (size_t child : children) {
+      size += child;
+    }
+    return size;
+  }
+};
+
+/*
+ * Builds a tree of the specified size, attaching every node to a
+ * randomly chosen earlier one.
+ */
+static shared_ptr<BaseAttrNode> random_tree(size_t size, unsigned seed) {
+  mt19937 random(seed);
+  auto root = RootNode::SUPPLIER.make_shared();
+  vector<shared_ptr<BaseAttrNode>> nodes = {root};
+  while (nodes.size() < size) {
+    uniform_int_distribution<size_t> pick(0, nodes.size() - 1);
+    nodes.push_back(nodes[pick(random)]->append_child(PlusNode::SUPPLIER));
+  }
+  return root;
+}
+
+} /* namespace FoldBenchmark */
+
+using namespace FoldBenchmark;
+
+/*
+ * Benchmark: computes subtree sizes in a large tree, sequentially and
+ * then in parallel on pools of one, two, four, and so on up to every
+ * hardware thread.
+ */
+TEST(Fold, Benchmark) {
+  auto root = random_tree(1000000, 7);
+  Size size;
+  Fold<BaseAttrNode, size_t> sequential(size);
+  auto sequential_start = chrono::steady_clock::now();
+  auto expected = sequential(root);
+  chrono::duration<double, milli> sequential_time =
+      chrono::steady_clock::now() - sequential_start;
+  cout << "Folding " << expected.size() << " nodes: sequential "
+      << sequential_time.count() << " ms." << endl;
+
+  size_t hardware_threads = max(1u, thread::hardware_concurrency());
+  for (size_t threads = 1; ; threads = min(2 * threads, hardware_threads)) {
+    WorkStealingPool pool(threads);
+    ParallelFold<BaseAttrNode, size_t> parallel(size, pool);
+    auto parallel_start = chrono::steady_clock::now();
+    auto actual = parallel(root);
+    chrono::duration<double, milli> parallel_time =
+        chrono::steady_clock::now() - parallel_start;
+
+    ASSERT_EQ(expected, actual);
+    cout << "Parallel on " << pool.thread_count() << " threads: "
+        << parallel_time.count() << " ms, speedup "
+        << sequential_time.count() / parallel_time.count() << "." << endl;
+    if (threads == hardware_threads) {
+      break;
+    }
+  }
+}
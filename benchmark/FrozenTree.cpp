@@ -0,0 +1,151 @@
+/*
+ * FrozenTree.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Compares read-only pass speed over a flattened snapshot with speed
+ * over the tree it was frozen from.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "FrozenNodeAction.h"
+#include "FrozenTree.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+#include "VacuousVoidFunction.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace FrozenTreeBenchmark {
+
+class BorrowedSum : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  int64_t sum = 0;
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    sum += node->get(TestAttribute::COUNT);
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+class FrozenSum : public FrozenNodeAction {
+public:
+  int64_t sum = 0;
+
+  virtual TraversalStatus operator()(
+      const FrozenTree& tree, size_t index) override {
+    sum += tree.get(index, TestAttribute::COUNT);
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+class Nothing : public FrozenNodeAction {
+public:
+  virtual TraversalStatus operator()(
+      const FrozenTree& tree, size_t index) override {
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+class BorrowedNothing : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+} /* namespace FrozenTreeBenchmark */
+
+using namespace FrozenTreeBenchmark;
+
+/*
+ * Benchmark: sums an attribute over a large, bushy tree with a
+ * borrowing traversal, a frozen traversal, and a linear scan of the
+ * snapshot.
+ */
+TEST(FrozenTree, Benchmark) {
+  constexpr int64_t FANOUT = 8;
+  constexpr int64_t NODE_COUNT = 1 + FANOUT + FANOUT * FANOUT
+      + FANOUT * FANOUT * FANOUT + FANOUT * FANOUT * FANOUT * FANOUT
+      + FANOUT * FANOUT * FANOUT * FANOUT * FANOUT
+      + FANOUT * FANOUT * FANOUT * FANOUT * FANOUT * FANOUT;
+  constexpr int PASSES = 10;
+
+  // Build breadth first, so that siblings, not parents and children,
+  // are adjacent in memory, as in trees that grow in stages.
+  auto root = RootNode::SUPPLIER.make_shared();
+  root->set(TestAttribute::COUNT, 1);
+  vector<shared_ptr<BaseAttrNode>> level = {root};
+  for (int depth = 0; depth < 6; ++depth) {
+    vector<shared_ptr<BaseAttrNode>> next_level;
+    for (auto& node : level) {
+      for (int64_t i = 0; i < FANOUT; ++i) {
+        next_level.push_back(node->append_child(PlusNode::SUPPLIER));
+        next_level.back()->set(TestAttribute::COUNT, 1);
+      }
+    }
+    level = std::move(next_level);
+  }
+  level.clear();
+
+  auto freeze_start = chrono::steady_clock::now();
+  auto snapshot = FrozenTree::freeze(root);
+  chrono::duration<double, milli> freeze_time =
+      chrono::steady_clock::now() - freeze_start;
+  ASSERT_EQ(NODE_COUNT, snapshot.size());
+
+  BorrowedSum borrowed_sum;
+  BorrowedNothing borrowed_nothing;
+  BorrowingTraversal<BaseAttrNode> traversal(
+      borrowed_sum,
+      borrowed_nothing,
+      VacuousVoidFunction::INSTANCE,
+      VacuousVoidFunction::INSTANCE);
+  auto tree_start = chrono::steady_clock::now();
+  for (int pass = 0; pass < PASSES; ++pass) {
+    traversal(root);
+  }
+  chrono::duration<double, milli> tree_time =
+      chrono::steady_clock::now() - tree_start;
+
+  FrozenSum frozen_sum;
+  Nothing nothing;
+  auto frozen_start = chrono::steady_clock::now();
+  for (int pass = 0; pass < PASSES; ++pass) {
+    snapshot.traverse(frozen_sum, nothing);
+  }
+  chrono::duration<double, milli> frozen_time =
+      chrono::steady_clock::now() - frozen_start;
+
+  int64_t scan_sum = 0;
+  auto scan_start = chrono::steady_clock::now();
+  for (int pass = 0; pass < PASSES; ++pass) {
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+      scan_sum += snapshot.get(i, TestAttribute::COUNT);
+    }
+  }
+  chrono::duration<double, milli> scan_time =
+      chrono::steady_clock::now() - scan_start;
+
+  ASSERT_EQ(NODE_COUNT * PASSES, borrowed_sum.sum);
+  ASSERT_EQ(NODE_COUNT * PASSES, frozen_sum.sum);
+  ASSERT_EQ(NODE_COUNT * PASSES, scan_sum);
+  cout << "Summing an attribute over " << NODE_COUNT << " nodes "
+      << PASSES << " times: tree traversal " << tree_time.count()
+      << " ms, frozen traversal " << frozen_time.count()
+      << " ms, frozen scan " << scan_time.count()
+      << " ms. Freezing took " << freeze_time.count() << " ms." << endl;
+}
@@ -0,0 +1,159 @@
+/*
+ * IncrementalTraversal.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Compares an incremental run after a small edit with a full
+ * traversal.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "IncrementalTraversal.h"
+#include "IntegerNode.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+#include "VacuousVoidFunction.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace IncrementalTraversalBenchmark {
+
+/*
+ * Counts entered nodes, and cancels on entering a node with the
+ * CANCEL_ON_ENTRY attribute.
+ */
+class Counter : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  long count = 0;
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    ++count;
+    return node->has(TestAttribute::CANCEL_ON_ENTRY)
+        ? TraversalStatus::CANCEL
+        : TraversalStatus::CONTINUE;
+  }
+};
+
+/*
+ * Stores each node's value, the sum of the leaf values in its
+ * subtree, in its COUNT attribute.
+ */
+class Evaluator : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    int64_t value = 0;
+    if (node->is_leaf()) {
+      value = stoll(node->get(TestAttribute::VALUE));
+    } else {
+      for (size_t i = 0; i < node->child_count(); ++i) {
+        value += node->child(i)->get(TestAttribute::COUNT);
+      }
+    }
+    node->put(TestAttribute::COUNT, value);
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+/*
+ * Reuses the value of every unchanged node that has one.
+ */
+class Reuser : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    return node->has(TestAttribute::COUNT)
+        ? TraversalStatus::BYPASS_CHILDREN
+        : TraversalStatus::CONTINUE;
+  }
+};
+
+/*
+ * Builds a complete binary tree of sums with the specified number of
+ * levels, whose leaves all have the value 1.
+ */
+static shared_ptr<BaseAttrNode> balanced(int depth) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  vector<shared_ptr<BaseAttrNode>> level = {root};
+  for (int d = 1; d < depth; ++d) {
+    vector<shared_ptr<BaseAttrNode>> next_level;
+    for (auto& parent : level) {
+      for (int i = 0; i < 2; ++i) {
+        if (d + 1 < depth) {
+          next_level.push_back(parent->append_child(PlusNode::SUPPLIER));
+        } else {
+          parent->append_child(IntegerNode::SUPPLIER)
+              ->put(TestAttribute::VALUE, "1");
+        }
+      }
+    }
+    level = std::move(next_level);
+  }
+  return root;
+}
+
+/*
+ * Returns the leftmost leaf under a node.
+ */
+static shared_ptr<BaseAttrNode> leftmost_leaf(shared_ptr<BaseAttrNode> node) {
+  while (!node->is_leaf()) {
+    node = node->child(0);
+  }
+  return node;
+}
+
+} /* namespace IncrementalTraversalBenchmark */
+
+using namespace IncrementalTraversalBenchmark;
+
+/*
+ * Benchmark: reevaluates a tree with about a million nodes after
+ * changing one leaf, incrementally and from scratch.
+ */
+TEST(IncrementalTraversal, Benchmark) {
+  auto root = balanced(20);
+  Counter counter;
+  Evaluator evaluator;
+  Reuser reuser;
+  IncrementalTraversal<BaseAttrNode> incremental(counter, evaluator, reuser);
+  incremental(root);
+
+  leftmost_leaf(root)->set(TestAttribute::VALUE, "2");
+  counter.count = 0;
+  auto incremental_start = chrono::steady_clock::now();
+  incremental(root);
+  chrono::duration<double, milli> incremental_time =
+      chrono::steady_clock::now() - incremental_start;
+  ASSERT_EQ(20, counter.count);
+  ASSERT_EQ((1 << 19) + 1, root->get(TestAttribute::COUNT));
+
+  counter.count = 0;
+  BorrowingTraversal<BaseAttrNode> full(
+      counter,
+      evaluator,
+      VacuousVoidFunction::INSTANCE,
+      VacuousVoidFunction::INSTANCE);
+  auto full_start = chrono::steady_clock::now();
+  full(root);
+  chrono::duration<double, milli> full_time =
+      chrono::steady_clock::now() - full_start;
+  ASSERT_EQ((1 << 20) - 1, counter.count);
+  ASSERT_EQ((1 << 19) + 1, root->get(TestAttribute::COUNT));
+
+  cout << "Reevaluating " << counter.count
+      << " nodes after a one leaf edit: incremental "
+      << incremental_time.count() << " ms, full "
+      << full_time.count() << " ms." << endl;
+}
@@ -0,0 +1,153 @@
+/*
+ * MappedTree.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Compares opening and traversing a mapped tree with deserializing
+ * the same tree.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "BinaryTreeReader.h"
+#include "BinaryTreeWriter.h"
+#include "IntegerNode.h"
+#include "MappedNodeAction.h"
+#include "MappedTree.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace MappedTreeBenchmark {
+
+/*
+ * Writes a tree to a temporary file that is removed on destruction.
+ */
+class TreeFile {
+  filesystem::path path_;
+
+public:
+  TreeFile(const shared_ptr<BaseAttrNode>& root, const string& name) :
+      path_(filesystem::temp_directory_path() / name) {
+    ofstream out(path_, ios::binary);
+    MappedTree::write(root, out);
+  }
+
+  ~TreeFile() {
+    filesystem::remove(path_);
+  }
+
+  string path(void) const {
+    return path_.string();
+  }
+};
+
+class Continue : public MappedNodeAction {
+public:
+  virtual TraversalStatus operator()(
+      const MappedTree& tree, size_t node) override {
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+/*
+ * Sums the COUNT attribute.
+ */
+class CountSum : public MappedNodeAction {
+  MappedTree::Key count_;
+
+public:
+  int64_t sum = 0;
+
+  CountSum(const MappedTree& tree) :
+      count_(tree.key(TestAttribute::COUNT)) {
+  }
+
+  virtual TraversalStatus operator()(
+      const MappedTree& tree, size_t node) override {
+    sum += tree.get<int64_t>(node, count_);
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+/*
+ * Builds a wide tree of sums with about the specified number of
+ * nodes.
+ */
+static shared_ptr<BaseAttrNode> large_tree(int node_count) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  auto sum = root->append_child(PlusNode::SUPPLIER);
+  for (int i = 1; i < node_count; ++i) {
+    if (0 == i % 16) {
+      sum = root->append_child(PlusNode::SUPPLIER);
+      continue;
+    }
+    auto leaf = sum->append_child(IntegerNode::SUPPLIER);
+    leaf->put(TestAttribute::VALUE, to_string(i % 1000));
+    leaf->put(TestAttribute::COUNT, int64_t(i));
+  }
+  return root;
+}
+
+} /* namespace MappedTreeBenchmark */
+
+using namespace MappedTreeBenchmark;
+
+/*
+ * Benchmark: time to first node and time to sum an attribute over a
+ * tree with about a million nodes, mapped and deserialized.
+ */
+TEST(MappedTree, Benchmark) {
+  constexpr int NODE_COUNT = 1000000;
+  auto tree = large_tree(NODE_COUNT);
+  TreeFile file(tree, "MappedTree.Benchmark.vpt");
+  stringstream serialized;
+  BinaryTreeWriter(serialized).write(tree);
+
+  auto open_start = chrono::steady_clock::now();
+  auto mapped = MappedTree::open(file.path());
+  chrono::duration<double, milli> open_time =
+      chrono::steady_clock::now() - open_start;
+  CountSum mapped_sum(mapped);
+  Continue on_exit;
+  mapped.traverse(mapped_sum, on_exit);
+  chrono::duration<double, milli> mapped_time =
+      chrono::steady_clock::now() - open_start;
+
+  auto read_start = chrono::steady_clock::now();
+  BinaryTreeReader reader(serialized);
+  reader.add(RootNode::SUPPLIER)
+      .add(PlusNode::SUPPLIER)
+      .add(IntegerNode::SUPPLIER)
+      .add(TestAttribute::VALUE)
+      .add(TestAttribute::COUNT);
+  auto copy = reader.read();
+  chrono::duration<double, milli> read_time =
+      chrono::steady_clock::now() - read_start;
+
+  int64_t expected = 0;
+  for (int i = 1; i < NODE_COUNT; ++i) {
+    expected += 0 == i % 16 ? 0 : i;
+  }
+  ASSERT_EQ(expected, mapped_sum.sum);
+  ASSERT_TRUE(tree->structurally_equals(*copy));
+
+  cout << "Mapped tree of " << mapped.size() << " nodes: open "
+      << open_time.count() << " ms, open and traverse "
+      << mapped_time.count() << " ms; deserializing "
+      << read_time.count() << " ms." << endl;
+}
@@ -0,0 +1,125 @@
+/*
+ * ParallelTraversal.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Compares sequential traversal with parallel traversal on pools of
+ * increasing size.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "ParallelTraversal.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "VacuousVoidFunction.h"
+#include "WorkStealingPool.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace ParallelTraversalBenchmark {
+
+/*
+ * Builds a tree in which every interior node has the specified
+ * number of children.
+ */
+static shared_ptr<BaseAttrNode> bushy(int fanout, int depth) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  vector<shared_ptr<BaseAttrNode>> level = {root};
+  for (int d = 0; d < depth; ++d) {
+    vector<shared_ptr<BaseAttrNode>> next_level;
+    for (auto& node : level) {
+      for (int i = 0; i < fanout; ++i) {
+        next_level.push_back(node->append_child(PlusNode::SUPPLIER));
+      }
+    }
+    level = std::move(next_level);
+  }
+  return root;
+}
+
+/*
+ * Simulates real per-node work.
+ */
+class Work : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  atomic<long> count = 0;
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    double x = 1.0;
+    for (int i = 0; i < 200; ++i) {
+      x = sqrt(x + i);
+    }
+    if (0 < x) {
+      ++count;
+    }
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+class Nothing : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+} /* namespace ParallelTraversalBenchmark */
+
+using namespace ParallelTraversalBenchmark;
+
+/*
+ * Benchmark: applies a compute-bound action to every node of a large
+ * tree, sequentially and then in parallel on pools of one, two, four,
+ * and so on up to every hardware thread. Speedup requires more than
+ * one core; on a single core the parallel runs only add overhead.
+ */
+TEST(ParallelTraversal, Benchmark) {
+  auto root = bushy(8, 6);
+  Work sequential_work;
+  Nothing nothing;
+  BorrowingTraversal<BaseAttrNode> sequential(
+      sequential_work,
+      nothing,
+      VacuousVoidFunction::INSTANCE,
+      VacuousVoidFunction::INSTANCE);
+  auto sequential_start = chrono::steady_clock::now();
+  sequential(root);
+  chrono::duration<double, milli> sequential_time =
+      chrono::steady_clock::now() - sequential_start;
+  cout << "Processing " << sequential_work.count << " nodes: sequential "
+      << sequential_time.count() << " ms." << endl;
+
+  size_t hardware_threads = max(1u, thread::hardware_concurrency());
+  for (size_t threads = 1; ; threads = min(2 * threads, hardware_threads)) {
+    WorkStealingPool pool(threads);
+    Work parallel_work;
+    ParallelTraversal<BaseAttrNode> parallel(parallel_work, nothing, pool);
+    auto parallel_start = chrono::steady_clock::now();
+    parallel(root);
+    chrono::duration<double, milli> parallel_time =
+        chrono::steady_clock::now() - parallel_start;
+
+    ASSERT_EQ(sequential_work.count, parallel_work.count);
+    cout << "Parallel on " << pool.thread_count() << " threads: "
+        << parallel_time.count() << " ms, speedup "
+        << sequential_time.count() / parallel_time.count() << "." << endl;
+    if (threads == hardware_threads) {
+      break;
+    }
+  }
+}
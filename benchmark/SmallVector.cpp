@@ -0,0 +1,153 @@
+/*
+ * SmallVector.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Compares the inline-storage vector that holds node children with
+ * std::vector, and measures expression-shaped trees built from nodes
+ * that use it.
+ */
+
+#include <malloc.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "IntegerNode.h"
+#include "PlusNode.h"
+#include "SmallVector.h"
+#include "TestAttribute.h"
+#include "VacuousVoidFunction.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace SmallVectorBenchmark {
+
+/*
+ * Builds a complete binary tree of sums of the specified depth whose
+ * leaves are integers.
+ */
+static shared_ptr<BaseAttrNode> expression(int depth) {
+  if (depth <= 1) {
+    auto leaf = IntegerNode::SUPPLIER.make_shared();
+    leaf->set(TestAttribute::VALUE, "1");
+    return leaf;
+  }
+  auto sum = PlusNode::SUPPLIER.make_shared();
+  sum->append_child(expression(depth - 1));
+  sum->append_child(expression(depth - 1));
+  return sum;
+}
+
+class Count : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  long count = 0;
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    ++count;
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+class Nothing : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+} /* namespace SmallVectorBenchmark */
+
+using namespace SmallVectorBenchmark;
+
+/*
+ * Benchmark: builds the child lists of an expression-shaped tree, in
+ * which half the nodes are leaves and the rest are binary operators.
+ */
+TEST(SmallVector, Benchmark) {
+  constexpr size_t NODE_COUNT = 1000000;
+  auto child = make_shared<int>(0);
+
+  auto vector_start = chrono::steady_clock::now();
+  vector<vector<shared_ptr<int>>> vectors(NODE_COUNT);
+  for (size_t i = 0; i < NODE_COUNT; i += 2) {
+    vectors[i].push_back(child);
+    vectors[i].push_back(child);
+  }
+  vectors.clear();
+  chrono::duration<double, milli> vector_time =
+      chrono::steady_clock::now() - vector_start;
+
+  auto small_start = chrono::steady_clock::now();
+  vector<SmallVector<shared_ptr<int>, 2>> smalls(NODE_COUNT);
+  for (size_t i = 0; i < NODE_COUNT; i += 2) {
+    smalls[i].push_back(child);
+    smalls[i].push_back(child);
+  }
+  smalls.clear();
+  chrono::duration<double, milli> small_time =
+      chrono::steady_clock::now() - small_start;
+
+  ASSERT_EQ(1, child.use_count());
+  // A binary node's std::vector allocates twice as it grows to two
+  // children, ending with a 32 byte buffer plus allocator overhead.
+  cout << "Child lists for " << NODE_COUNT << " expression nodes:"
+      << " std::vector " << sizeof(vector<shared_ptr<int>>)
+      << " bytes per node plus 32 per binary node, "
+      << vector_time.count() << " ms; SmallVector "
+      << sizeof(SmallVector<shared_ptr<int>, 2>)
+      << " bytes per node, " << small_time.count() << " ms." << endl;
+}
+
+/*
+ * Benchmark: heap bytes per node, build time, five traversals, and
+ * teardown of a binary expression tree with about two million nodes.
+ * Each leaf holds one attribute.
+ */
+TEST(SmallVector, ExpressionTree) {
+  constexpr int DEPTH = 21;
+  constexpr long NODE_COUNT = (1L << DEPTH) - 1;
+  constexpr int PASSES = 5;
+
+  size_t before = mallinfo2().uordblks;
+  auto build_start = chrono::steady_clock::now();
+  auto root = expression(DEPTH);
+  chrono::duration<double, milli> build_time =
+      chrono::steady_clock::now() - build_start;
+  size_t bytes = mallinfo2().uordblks - before;
+
+  Count count;
+  Nothing nothing;
+  BorrowingTraversal<BaseAttrNode> traversal(
+      count,
+      nothing,
+      VacuousVoidFunction::INSTANCE,
+      VacuousVoidFunction::INSTANCE);
+  auto traversal_start = chrono::steady_clock::now();
+  for (int pass = 0; pass < PASSES; ++pass) {
+    traversal(root);
+  }
+  chrono::duration<double, milli> traversal_time =
+      chrono::steady_clock::now() - traversal_start;
+  ASSERT_EQ(PASSES * NODE_COUNT, count.count);
+
+  auto teardown_start = chrono::steady_clock::now();
+  root.reset();
+  chrono::duration<double, milli> teardown_time =
+      chrono::steady_clock::now() - teardown_start;
+
+  cout << "Expression tree of " << NODE_COUNT << " nodes: "
+      << bytes / NODE_COUNT << " bytes per node, built in "
+      << build_time.count() << " ms, " << PASSES << " traversals in "
+      << traversal_time.count() << " ms, torn down in "
+      << teardown_time.count() << " ms." << endl;
+}
@@ -0,0 +1,70 @@
+/*
+ * Teardown.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Compares destroying a large tree on the releasing thread with
+ * handing it to a background reclaimer.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TreeReclaimer.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace TeardownBenchmark {
+
+static shared_ptr<BaseAttrNode> bushy(int fanout, int depth) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  vector<shared_ptr<BaseAttrNode>> level = {root};
+  for (int d = 0; d < depth; ++d) {
+    vector<shared_ptr<BaseAttrNode>> next_level;
+    for (auto& node : level) {
+      for (int i = 0; i < fanout; ++i) {
+        next_level.push_back(node->append_child(PlusNode::SUPPLIER));
+      }
+    }
+    level = std::move(next_level);
+  }
+  return root;
+}
+
+} /* namespace TeardownBenchmark */
+
+using namespace TeardownBenchmark;
+
+/*
+ * Benchmark: compares the time that the releasing thread spends
+ * destroying a large tree itself with the time it spends handing the
+ * tree to a reclaimer.
+ */
+TEST(Teardown, Benchmark) {
+  auto tree = bushy(10, 6);
+  auto start = chrono::steady_clock::now();
+  tree.reset();
+  chrono::duration<double, milli> direct_time =
+      chrono::steady_clock::now() - start;
+
+  TreeReclaimer reclaimer;
+  tree = bushy(10, 6);
+  start = chrono::steady_clock::now();
+  reclaimer.reclaim(std::move(tree));
+  chrono::duration<double, milli> deferred_time =
+      chrono::steady_clock::now() - start;
+  reclaimer.drain();
+
+  cout << "Releasing 1111111 nodes: destroyed directly in "
+      << direct_time.count() << " ms, handed to a reclaimer in "
+      << deferred_time.count() << " ms." << endl;
+}
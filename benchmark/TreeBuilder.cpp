@@ -0,0 +1,70 @@
+/*
+ * TreeBuilder.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Compares building speed with the tree builder and with chained
+ * append_child() and parent() calls.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "IntegerNode.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+#include "TreeBuilder.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+/*
+ * Benchmark: builds a tree of about a million nodes with the builder
+ * and with append_child() and parent().
+ */
+TEST(TreeBuilder, Benchmark) {
+  constexpr int SUM_COUNT = 1 << 16;
+  constexpr int LEAVES_PER_SUM = 15;
+
+  auto builder_start = chrono::steady_clock::now();
+  TreeBuilder<BaseAttrNode> builder;
+  builder.open(RootNode::SUPPLIER, SUM_COUNT);
+  for (int i = 0; i < SUM_COUNT; ++i) {
+    builder.open(PlusNode::SUPPLIER, LEAVES_PER_SUM);
+    for (int j = 0; j < LEAVES_PER_SUM; ++j) {
+      builder.open(IntegerNode::SUPPLIER)
+          .attr(TestAttribute::COUNT, int64_t(j))
+          .close();
+    }
+    builder.close();
+  }
+  auto built = builder.close().finish();
+  chrono::duration<double, milli> builder_time =
+      chrono::steady_clock::now() - builder_start;
+
+  auto append_start = chrono::steady_clock::now();
+  auto appended = RootNode::SUPPLIER.make_shared();
+  for (int i = 0; i < SUM_COUNT; ++i) {
+    auto sum = appended->append_child(PlusNode::SUPPLIER);
+    for (int j = 0; j < LEAVES_PER_SUM; ++j) {
+      sum = sum->append_child(IntegerNode::SUPPLIER)
+          ->set(TestAttribute::COUNT, int64_t(j))
+          ->parent();
+    }
+  }
+  chrono::duration<double, milli> append_time =
+      chrono::steady_clock::now() - append_start;
+
+  ASSERT_TRUE(built->structurally_equals(*appended));
+  cout << "Building " << SUM_COUNT * (LEAVES_PER_SUM + 1) + 1
+      << " nodes: builder " << builder_time.count()
+      << " ms, append_child() and parent() " << append_time.count()
+      << " ms." << endl;
+}
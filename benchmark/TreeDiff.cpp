@@ -0,0 +1,125 @@
+/*
+ * TreeDiff.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Times a diff of two trees with about a million nodes.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "IntegerNode.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+#include "TreeDiff.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace TreeDiffBenchmark {
+
+using Kind = TreeDiff::EditKind;
+
+static shared_ptr<BaseAttrNode> integer(const string& value) {
+  auto node = IntegerNode::SUPPLIER.make_shared();
+  node->put(TestAttribute::VALUE, value);
+  return node;
+}
+
+/*
+ * Verifies that the matching is one to one and pairs nodes of the
+ * same type, and that the script inserts and deletes exactly the
+ * unmatched nodes.
+ */
+static void assert_consistent(const TreeDiff& diff) {
+  size_t deletions = 0;
+  size_t insertions = 0;
+  for (auto& edit : diff.edits()) {
+    deletions += Kind::DELETE == edit.kind;
+    insertions += Kind::INSERT == edit.kind;
+  }
+  size_t unmatched = 0;
+  for (size_t o = 0; o < diff.old_tree().size(); ++o) {
+    size_t n = diff.new_counterpart(o);
+    if (TreeDiff::NO_NODE == n) {
+      ++unmatched;
+      continue;
+    }
+    ASSERT_EQ(o, diff.old_counterpart(n));
+    ASSERT_EQ(diff.old_tree().supplier(o), diff.new_tree().supplier(n));
+  }
+  ASSERT_EQ(unmatched, deletions);
+  unmatched = 0;
+  for (size_t n = 0; n < diff.new_tree().size(); ++n) {
+    unmatched += TreeDiff::NO_NODE == diff.old_counterpart(n);
+  }
+  ASSERT_EQ(unmatched, insertions);
+}
+
+/*
+ * Builds a complete binary tree of sums of the specified depth whose
+ * leaves carry distinct values.
+ */
+static shared_ptr<BaseAttrNode> balanced(int depth) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  vector<shared_ptr<BaseAttrNode>> level = {root};
+  long leaves = 0;
+  for (int d = 0; d < depth; ++d) {
+    vector<shared_ptr<BaseAttrNode>> next_level;
+    for (auto& parent : level) {
+      for (int i = 0; i < 2; ++i) {
+        next_level.push_back(d + 1 < depth
+            ? parent->append_child(PlusNode::SUPPLIER)
+            : parent->append_child(integer(to_string(leaves++))));
+      }
+    }
+    level = std::move(next_level);
+  }
+  return root;
+}
+
+} /* namespace TreeDiffBenchmark */
+
+using namespace TreeDiffBenchmark;
+
+TEST(TreeDiff, Benchmark) {
+  auto before = balanced(19);
+  auto after = before->deep_clone();
+  auto leaf = after;
+  for (int d = 0; d < 19; ++d) {
+    leaf = leaf->child(d % 2);
+  }
+  leaf->set(TestAttribute::VALUE, "changed");
+  after->child(1)->child(1)->append_child(integer("inserted"));
+  auto parent = after->child(0)->child(0)->child(0)->child(0);
+  auto moved = parent->child(1);
+  moved->detach();
+  parent->insert_child(0, moved);
+
+  auto start = chrono::steady_clock::now();
+  auto diff = TreeDiff::compare(before, after);
+  chrono::duration<double, milli> elapsed =
+      chrono::steady_clock::now() - start;
+
+  size_t counts[4] = {};
+  for (auto& edit : diff.edits()) {
+    ++counts[static_cast<int>(edit.kind)];
+  }
+  ASSERT_EQ(1, counts[static_cast<int>(Kind::INSERT)]);
+  ASSERT_EQ(0, counts[static_cast<int>(Kind::DELETE)]);
+  ASSERT_EQ(1, counts[static_cast<int>(Kind::MOVE)]);
+  ASSERT_EQ(1, counts[static_cast<int>(Kind::UPDATE)]);
+  assert_consistent(diff);
+  cout << "Diffing trees of " << diff.old_tree().size()
+      << " nodes: " << elapsed.count() << " ms, "
+      << diff.edits().size() << " edits." << endl;
+}
@@ -0,0 +1,101 @@
+/*
+ * TreeExporter.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Times exporting a large tree as JSON and as DOT.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <span>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "ByteSink.h"
+#include "DotExporter.h"
+#include "IntegerNode.h"
+#include "JsonExporter.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+#include "TreeBuilder.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace TreeExporterBenchmark {
+
+/*
+ * Counts the bytes written to it, and records the largest write.
+ */
+class CountingSink : public ByteSink {
+public:
+  size_t size = 0;
+  size_t largest_write = 0;
+
+  virtual void write(
+      span<const span<const unsigned char>> buffers) override {
+    size_t written = 0;
+    for (const auto& buffer : buffers) {
+      written += buffer.size();
+    }
+    size += written;
+    largest_write = max(largest_write, written);
+  }
+};
+
+/*
+ * A root with sum_count sums of leaves_per_sum leaves each.
+ */
+static shared_ptr<BaseAttrNode> sums(int sum_count, int leaves_per_sum) {
+  TreeBuilder<BaseAttrNode> builder;
+  builder.open(RootNode::SUPPLIER, sum_count);
+  for (int i = 0; i < sum_count; ++i) {
+    builder.open(PlusNode::SUPPLIER, leaves_per_sum);
+    for (int j = 0; j < leaves_per_sum; ++j) {
+      builder.open(IntegerNode::SUPPLIER)
+          .attr(TestAttribute::COUNT, int64_t(j))
+          .close();
+    }
+    builder.close();
+  }
+  return builder.close().finish();
+}
+
+} /* namespace TreeExporterBenchmark */
+
+using namespace TreeExporterBenchmark;
+
+/*
+ * Benchmark: exports a tree of about a million nodes as JSON and
+ * as DOT.
+ */
+TEST(TreeExporter, Benchmark) {
+  auto root = sums(1 << 16, 15);
+
+  CountingSink json_sink;
+  JsonExporter json(json_sink);
+  auto json_start = chrono::steady_clock::now();
+  json.write(root);
+  chrono::duration<double, milli> json_time =
+      chrono::steady_clock::now() - json_start;
+
+  CountingSink dot_sink;
+  DotExporter dot(dot_sink);
+  auto dot_start = chrono::steady_clock::now();
+  dot.write(root);
+  chrono::duration<double, milli> dot_time =
+      chrono::steady_clock::now() - dot_start;
+
+  cout << "Exporting " << (1 << 16) * 16 + 1 << " nodes: JSON "
+      << json_sink.size / (1024 * 1024) << " MiB in "
+      << json_time.count() << " ms, DOT "
+      << dot_sink.size / (1024 * 1024) << " MiB in "
+      << dot_time.count() << " ms." << endl;
+}
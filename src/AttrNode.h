@@ -32,12 +32,21 @@
 #ifndef ATTRNODE_H_
 #define ATTRNODE_H_
 
-#include <unordered_map>
 #include <utility>
 
 #include "Attribute.h"
 #include "AttributeFunction.h"
+#include "AttributeMap.h"
+#include "AttributeValue.h"
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "HashCombine.h"
 #include "Host.h"
+#include "IllegalOperation.h"
+#include "NodeArena.h"
+#include "TraversalStatus.h"
+#include "TypedAttribute.h"
+#include "VacuousVoidFunction.h"
 
 /*
  * Base class for nodes containing string-valued attributes.
@@ -57,14 +66,22 @@
 
 #include "Attribute.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
 
 namespace VisitingParseTree {
 
 static const std::string empty_string;
 
+template <typename T> class Journal;
+
 /**
  * @brief Base class for nodes that have \c std::string valued attributes.
  *
@@ -72,14 +89,173 @@ static const std::string empty_string;
  *           \c AttrNode<T>
  */
 template <typename T> class AttrNode : public Host<T> {
+  friend class Journal<T>;
+
   /**
    * @brief Attributes of this node
    *
    * An attribute is a pair containing its type and its value, often
    * written (type, value). The type is a an instance of a class that
-   * inherits \c Attribute; the value is a \c std::string.
+   * inherits \c Attribute; the value is a \c std::string or, for a
+   * \c TypedAttribute, a scalar. Nodes
+   * typically have few attributes, so the map stores them within
+   * the node.
+   */
+  AttributeMap attributes_;
+
+  /**
+   * @brief Grants write access to this node's attributes
+   *
+   * Records the change that the caller is about to make, so every
+   * modification \b must go through here.
+   *
+   * @return this node's attributes
+   */
+  AttributeMap& mutable_attributes(void) {
+    this->record_change();
+    return attributes_;
+  }
+
+  /**
+   * @brief Skips subtrees whose structural hash is cached
+   */
+  class UncachedHashFilter : public BorrowedNodeAction<T> {
+  public:
+    virtual TraversalStatus operator()(T *node) override {
+      return node->cached_structural_hash()
+          ? TraversalStatus::BYPASS_CHILDREN
+          : TraversalStatus::CONTINUE;
+    }
+  };
+
+  /**
+   * @brief Mixes child hashes into a running hash
+   */
+  class ChildHashCombiner : public BorrowedNodeAction<T> {
+  public:
+    std::uint64_t hash = 0;
+
+    virtual TraversalStatus operator()(T *node) override {
+      hash = hash_combine(hash, node->cached_structural_hash());
+      return TraversalStatus::CONTINUE;
+    }
+  };
+
+  /**
+   * @brief Computes and caches the structural hash of a node whose
+   *        children's hashes are cached
+   */
+  class HashingAction : public BorrowedNodeAction<T> {
+  public:
+    virtual TraversalStatus operator()(T *node) override {
+      if (node->cached_structural_hash()) {
+        return TraversalStatus::CONTINUE;
+      }
+      ChildHashCombiner combiner;
+      combiner.hash = hash_combine(
+          static_cast<std::uint64_t>(node->supplier().id()),
+          node->child_count());
+      for (const auto& entry : static_cast<AttrNode<T>&>(*node).attributes_) {
+        combiner.hash = hash_combine(
+            hash_combine(combiner.hash, static_cast<std::uint64_t>(entry.id)),
+            hash_value(entry.value));
+      }
+      node->for_each_child(combiner);
+      node->cache_structural_hash(combiner.hash ? combiner.hash : 1);
+      return TraversalStatus::CONTINUE;
+    }
+  };
+
+  /**
+   * @brief Collects a node's children
+   */
+  class ChildCollector : public BorrowedNodeAction<T> {
+    std::vector<T *>& children_;
+
+  public:
+    ChildCollector(std::vector<T *>& children) :
+        children_(children) {
+    }
+
+    virtual TraversalStatus operator()(T *node) override {
+      children_.push_back(node);
+      return TraversalStatus::CONTINUE;
+    }
+  };
+
+  /**
+   * @brief Copies each node it enters as the youngest child of the
+   *        copy of the node's parent
    */
-  std::unordered_map<const Attribute*, std::string> attributes_;
+  class CloningAction : public BorrowedNodeAction<T> {
+    NodeArena *arena_;
+    std::vector<std::shared_ptr<T>> path_;  /** Copies of the current path */
+    std::shared_ptr<T> root_;
+
+  public:
+    CloningAction(NodeArena *arena) :
+        arena_(arena) {
+    }
+
+    std::shared_ptr<T>& root(void) {
+      return root_;
+    }
+
+    std::vector<std::shared_ptr<T>>& path(void) {
+      return path_;
+    }
+
+    virtual TraversalStatus operator()(T *node) override {
+      std::shared_ptr<T> copy = arena_
+          ? node->supplier().allocate_shared(*arena_)
+          : node->supplier().make_shared();
+      static_cast<AttrNode<T>&>(*copy).attributes_ = node->attributes_;
+      copy->accommodate_additional_children(node->child_count());
+      if (path_.empty()) {
+        root_ = copy;
+      } else {
+        path_.back()->append_child(copy);
+      }
+      path_.push_back(std::move(copy));
+      return TraversalStatus::CONTINUE;
+    }
+  };
+
+  /**
+   * @brief Pops the current node's copy when the clone exits it
+   */
+  class PoppingAction : public BorrowedNodeAction<T> {
+    std::vector<std::shared_ptr<T>>& path_;
+
+  public:
+    PoppingAction(std::vector<std::shared_ptr<T>>& path) :
+        path_(path) {
+    }
+
+    virtual TraversalStatus operator()(T *node) override {
+      path_.pop_back();
+      return TraversalStatus::CONTINUE;
+    }
+  };
+
+  /**
+   * @brief Copies this node's subtree
+   *
+   * @param arena provides the copies' storage, or \c NULL to
+   *        allocate them from the heap
+   * @return the copy of this node
+   */
+  std::shared_ptr<T> clone_subtree(NodeArena *arena) {
+    CloningAction on_entry(arena);
+    PoppingAction on_exit(on_entry.path());
+    BorrowingTraversal<T> traversal(
+        on_entry,
+        on_exit,
+        VacuousVoidFunction::INSTANCE,
+        VacuousVoidFunction::INSTANCE);
+    traversal(static_cast<T *>(this));
+    return std::move(on_entry.root());
+  }
 
 protected:
   AttrNode() = default;
@@ -97,6 +273,14 @@ public:
     return attributes_.size();
   }
 
+  /**
+   * @return this node's attributes, for read-only access in ascending
+   *         attribute identifier order
+   */
+  const AttributeMap& attribute_map(void) const {
+    return attributes_;
+  }
+
   /**
    * @brief Clones this node
    *
@@ -107,7 +291,121 @@ public:
    */
   std::shared_ptr<T> clone() {
     auto copy = AttrNode<T>::empty_copy();
-    return copy_attributes_to(copy);
+    static_cast<AttrNode<T>&>(*copy).attributes_ = attributes_;
+    return copy;
+  }
+
+  /**
+   * @brief Clones this node and its descendants
+   *
+   * Copies the subtree in a single iterative pass. Each copy receives
+   * its original's attribute map wholesale, and its child storage is
+   * sized for all of its children up front. The copy is a root.
+   *
+   * @return the copy of this node, as described above.
+   */
+  std::shared_ptr<T> deep_clone() {
+    return clone_subtree(nullptr);
+  }
+
+  /**
+   * @brief Clones this node and its descendants into an arena
+   *
+   * As \c deep_clone(), but allocates the copies from \c arena,
+   * where nodes whose suppliers support arenas sit together in
+   * memory.
+   *
+   * @param arena provides the copies' storage
+   * @return the copy of this node
+   *
+   * \see Supplier::allocate_shared()
+   */
+  std::shared_ptr<T> deep_clone(NodeArena& arena) {
+    return clone_subtree(&arena);
+  }
+
+  /**
+   * @brief Hashes this node's subtree by structure
+   *
+   * Combines each node's type (i.e. its supplier), its attributes,
+   * and its children's hashes, in order, so structurally equal
+   * subtrees hash alike wherever they are. Every node caches its
+   * hash, and changing a node's attributes or children discards the
+   * cached hashes of the node and its ancestors, so rehashing after
+   * an edit revisits only the edited path. Hashes depend on supplier
+   * and attribute identifiers, and are only comparable within a
+   * process.
+   *
+   * @return the subtree's hash, which is never 0
+   */
+  std::uint64_t structural_hash(void) {
+    if (auto hash = this->cached_structural_hash()) {
+      return hash;
+    }
+    UncachedHashFilter on_entry;
+    HashingAction on_exit;
+    BorrowingTraversal<T> traversal(
+        on_entry,
+        on_exit,
+        VacuousVoidFunction::INSTANCE,
+        VacuousVoidFunction::INSTANCE);
+    traversal(static_cast<T *>(this));
+    return this->cached_structural_hash();
+  }
+
+  /**
+   * @brief Compares subtrees by structure
+   *
+   * Two subtrees are structurally equal when their roots have the
+   * same type and equal attributes, and their children, in order,
+   * are structurally equal. Cached structural hashes, when present,
+   * settle inequality early.
+   *
+   * @param that the root of the subtree to compare
+   * @return \c true if and only if this node's subtree is
+   *         structurally equal to \c that's
+   */
+  bool structurally_equals(AttrNode<T>& that) {
+    std::vector<std::pair<T *, T *>> pending = {
+        {static_cast<T *>(this), static_cast<T *>(&that)}};
+    std::vector<T *> these;
+    std::vector<T *> those;
+    while (!pending.empty()) {
+      auto [left, right] = pending.back();
+      pending.pop_back();
+      if (left == right) {
+        continue;
+      }
+      auto left_hash = left->cached_structural_hash();
+      auto right_hash = right->cached_structural_hash();
+      const AttributeMap& left_attributes =
+          static_cast<AttrNode<T>&>(*left).attributes_;
+      const AttributeMap& right_attributes =
+          static_cast<AttrNode<T>&>(*right).attributes_;
+      if ((left_hash && right_hash && left_hash != right_hash)
+          || left->supplier() != right->supplier()
+          || left->child_count() != right->child_count()
+          || left_attributes.size() != right_attributes.size()
+          || !std::equal(
+              left_attributes.begin(),
+              left_attributes.end(),
+              right_attributes.begin(),
+              [](const auto& a, const auto& b) {
+                return a.id == b.id && a.value == b.value;
+              })) {
+        return false;
+      }
+      these.clear();
+      those.clear();
+      ChildCollector left_collector(these);
+      ChildCollector right_collector(those);
+      left->for_each_child(left_collector);
+      right->for_each_child(right_collector);
+      for (size_t i = these.size(); 0 < i; --i) {
+        pending.emplace_back(these[i - 1], those[i - 1]);
+      }
+    }
+    return true;
   }
 
   /**
@@ -125,37 +423,11 @@ public:
    *         chaining.
    */
   std::shared_ptr<T> copy_attributes_to(std::shared_ptr<T> that) {
-
-    /**
-     * @brief Copies attributes from one \c AttrNode to another. The
-     *        source node is not changed.
-     */
-    class Copy: public AttributeFunction {
-      std::shared_ptr<T> destination_; /** Node to receive attributes */
-
-    public:
-      /**
-       * @brief Sets the node to receive the copied attributes
-       *
-       * @param destination receiving node
-       */
-      void set_destination(std::shared_ptr<T> destination) {
-        destination_ = destination;
-      }
-
-      /**
-       * @brief copies an attribute to the destination node
-       *
-       * @param attr attribute type
-       * @param value \c std::string attribute value
-       */
-      virtual void operator() (
-          const Attribute* const& attr, const std::string& value) {
-        destination_->set(*attr, value);
-      }
-    } action;
-    action.set_destination(that);
-    for_all_attributes(action);
+    AttributeMap& destination =
+        static_cast<AttrNode<T>&>(*that).mutable_attributes();
+    for (const auto& entry : attributes_) {
+      destination.insert_or_assign(*entry.attribute, entry.value);
+    }
     return that;
   }
 
@@ -173,24 +445,57 @@ public:
    * Returns: a shared pointer to this node to support chaining
    */
   std::shared_ptr<T> erase(const Attribute& attribute) {
-    if (has(attribute)) {
-      attributes_.erase(&attribute);
-    }
+    mutable_attributes().erase(attribute);
     return std::enable_shared_from_this<T>::shared_from_this();
   }
 
   /**
-   * @brief Applies an
+   * @brief Applies an \c AttributeFunction to every attribute
    *
-   * @param f Applied to each attribute. Application
-   *          order is arbitrary.
+   * @param f Applied to each attribute. Application is in ascending
+   *          attribute identifier order, i.e. attribute creation
+   *          order.
    */
   void for_all_attributes(AttributeFunction& f) {
-    for (const auto&[key, value] : attributes_) {
-      f(key, value);
+    for (const auto& entry : attributes_) {
+      if (auto text = std::get_if<std::string>(&entry.value)) {
+        f(entry.attribute, *text);
+      } else if (auto interned = std::get_if<InternedString>(&entry.value)) {
+        f(entry.attribute, interned->str());
+      } else {
+        f(entry.attribute, to_string(entry.value));
+      }
     }
   }
 
+  /**
+   * @brief Locates the specified attribute's string value
+   *
+   * Looks the attribute up once and neither copies nor allocates.
+   *
+   * @param attribute the attribute to find
+   * @return a pointer to the attribute's value, which remains valid
+   *         until the attribute is next modified, or \c NULL if the
+   *         attribute has not been set
+   *
+   * @throws IllegalOperation if the attribute is a scalar
+   *         \c TypedAttribute
+   */
+  const std::string *get_if(const Attribute& attribute) const {
+    const AttributeValue *value = attributes_.find(attribute);
+    if (!value) {
+      return nullptr;
+    }
+    if (auto text = std::get_if<std::string>(value)) {
+      return text;
+    }
+    if (auto interned = std::get_if<InternedString>(value)) {
+      return &interned->str();
+    }
+    throw IllegalOperation(
+        "Attribute " + attribute.name() + " does not have a string value.");
+  }
+
   /** Returns the specified attribute's value
    *
    * Parameters:
@@ -203,11 +508,44 @@ public:
    * Returns: the attribute's value if it has been set, an empty string
    *          otherwise. Note that attributes CANNOT be set to an
    *          empty value.
+   *
+   * Throws: IllegalOperation if the attribute is a scalar
+   *         TypedAttribute, whose values must be retrieved with the
+   *         typed get().
    */
   const std::string& get(const Attribute& attribute) const {
-    return has(attribute)
-        ? attributes_.at(&attribute)
-        : empty_string;
+    const std::string *value = get_if(attribute);
+    return value ? *value : empty_string;
+  }
+
+  /**
+   * @brief Returns a view of the specified attribute's value
+   *
+   * @param attribute the attribute to return
+   * @return the attribute's value if it has been set, an empty view
+   *         otherwise. The view remains valid until the attribute is
+   *         next modified.
+   *
+   * @throws IllegalOperation if the attribute is a scalar
+   *         \c TypedAttribute
+   */
+  std::string_view view(const Attribute& attribute) const {
+    const std::string *value = get_if(attribute);
+    return value ? std::string_view(*value) : std::string_view();
+  }
+
+  /**
+   * @brief Returns the specified typed attribute's value
+   *
+   * @tparam V the attribute's value type
+   * @param attribute the attribute to return
+   * @return the attribute's value if it has been set, a
+   *         value-initialized \c V (i.e. 0, \c false, or the empty
+   *         \c InternedString) otherwise
+   */
+  template <typename V> V get(const TypedAttribute<V>& attribute) const {
+    const AttributeValue *value = attributes_.find(attribute);
+    return value ? std::get<V>(*value) : V{};
   }
 
   /** Tests if this node has a specified attribute, i.e. the attribute has a value
@@ -222,7 +560,108 @@ public:
    * Returns: true if and only if the attribute has been set.
    */
   bool has(const Attribute& attribute) const {
-    return attributes_.contains(&attribute);
+    return attributes_.contains(attribute);
+  }
+
+  /**
+   * @brief Sets an attribute's value from text without returning a
+   *        pointer to this node
+   *
+   * The \c put() family does the work of the corresponding \c set()
+   * overloads but skips the \c shared_from_this() call (an atomic
+   * reference count increment and decrement) that chaining requires,
+   * which matters in attribute-heavy passes. Setting an empty value
+   * erases the attribute.
+   *
+   * Replacing an existing string value reuses its buffer, so
+   * repeatedly setting values that fit does not allocate. The value
+   * may view another of this node's attributes.
+   *
+   * @param attribute the attribute to set
+   * @param value the value to set
+   *
+   * @throws IllegalOperation if the attribute is a \c TypedAttribute
+   *         and the value does not parse as the attribute's type
+   */
+  void put(const Attribute& attribute, std::string_view value) {
+    if (value.empty()) {
+      mutable_attributes().erase(attribute);
+    } else if (AttributeType::STRING != attribute.type()) {
+      mutable_attributes().insert_or_assign(attribute, attribute.parse(value));
+    } else if (!attributes_.contains(attribute)) {
+      // Inserting can move the other values, and value can view one
+      // of them, so copy it first.
+      std::string copy(value);
+      mutable_attributes().find_or_insert(attribute) = std::move(copy);
+    } else {
+      AttributeValue& slot = mutable_attributes().find_or_insert(attribute);
+      if (auto text = std::get_if<std::string>(&slot)) {
+        text->assign(value);
+      } else {
+        slot.template emplace<std::string>(value);
+      }
+    }
+  }
+
+  void put(const Attribute& attribute, const std::string& value) {
+    put(attribute, std::string_view(value));
+  }
+
+  void put(const Attribute& attribute, const char *value) {
+    put(attribute, std::string_view(value));
+  }
+
+  /**
+   * @brief Sets an attribute's value, taking ownership of the
+   *        provided string
+   *
+   * @param attribute the attribute to set
+   * @param value the value to set, which is moved into the node
+   *
+   * @throws IllegalOperation as for the \c std::string_view overload
+   */
+  void put(const Attribute& attribute, std::string&& value) {
+    if (value.empty() || AttributeType::STRING != attribute.type()) {
+      put(attribute, std::string_view(value));
+    } else {
+      mutable_attributes().find_or_insert(attribute) = std::move(value);
+    }
+  }
+
+  /**
+   * @brief Sets a typed attribute's value from text without returning
+   *        a pointer to this node
+   *
+   * Resolves calls that pass a string literal, which would otherwise
+   * convert to \c bool.
+   */
+  template <typename V> void put(
+      const TypedAttribute<V>& attribute, const char *value) {
+    put(static_cast<const Attribute&>(attribute), std::string_view(value));
+  }
+
+  /**
+   * @brief Sets a typed attribute's value without returning a pointer
+   *        to this node
+   *
+   * The value is stored unboxed; setting it does not allocate. As
+   * with string values, setting an empty \c InternedString erases
+   * the attribute.
+   *
+   * @tparam V the attribute's value type
+   * @param attribute the attribute to set
+   * @param value the value to set. \c InternedString values can come
+   *        from any pool that outlives this node.
+   */
+  template <typename V> void put(
+      const TypedAttribute<V>& attribute, std::type_identity_t<V> value) {
+    if constexpr (std::is_same_v<V, InternedString>) {
+      if (value.empty()) {
+        mutable_attributes().erase(attribute);
+        return;
+      }
+    }
+    mutable_attributes().find_or_insert(attribute).template emplace<V>(value);
   }
 
   /** Sets a non-empty attribute value, erases the attribute if value is empty
@@ -235,16 +674,66 @@ public:
    * attribute                The attribute to set
    * value                    The value to set. SHOULD not be empty,
    *                          as the attribute will be erased if it is.
+   *                          Accepts a std::string (moved in when it
+   *                          is an rvalue), std::string_view, or C
+   *                          string; see put().
    *
    * Returns: a shared pointer to this node to support chaining
+   *
+   * Throws: IllegalOperation if the attribute is a TypedAttribute and
+   *         the value does not parse as the attribute's type.
    */
-  std::shared_ptr<T> set(const Attribute& attribute, const std::string value) {
-    if (value.empty()) {
-      return erase(attribute);
-    } else {
-      attributes_.insert_or_assign(&attribute, value);
-      return std::enable_shared_from_this<T>::shared_from_this();
-    }
+  std::shared_ptr<T> set(const Attribute& attribute, std::string_view value) {
+    put(attribute, value);
+    return std::enable_shared_from_this<T>::shared_from_this();
+  }
+
+  std::shared_ptr<T> set(const Attribute& attribute, const std::string& value) {
+    put(attribute, std::string_view(value));
+    return std::enable_shared_from_this<T>::shared_from_this();
+  }
+
+  std::shared_ptr<T> set(const Attribute& attribute, const char *value) {
+    put(attribute, std::string_view(value));
+    return std::enable_shared_from_this<T>::shared_from_this();
+  }
+
+  std::shared_ptr<T> set(const Attribute& attribute, std::string&& value) {
+    put(attribute, std::move(value));
+    return std::enable_shared_from_this<T>::shared_from_this();
+  }
+
+  /**
+   * @brief Sets a typed attribute's value from text
+   *
+   * Resolves calls that pass a string literal, which would otherwise
+   * convert to \c bool.
+   *
+   * @param attribute the attribute to set
+   * @param value textual value, which is parsed as for the
+   *        \c std::string overload
+   * @return a shared pointer to this node to support chaining
+   */
+  template <typename V> std::shared_ptr<T> set(
+      const TypedAttribute<V>& attribute, const char *value) {
+    put(attribute, value);
+    return std::enable_shared_from_this<T>::shared_from_this();
+  }
+
+  /**
+   * @brief Sets a typed attribute's value
+   *
+   * See the corresponding \c put() overload.
+   *
+   * @tparam V the attribute's value type
+   * @param attribute the attribute to set
+   * @param value the value to set
+   * @return a shared pointer to this node to support chaining
+   */
+  template <typename V> std::shared_ptr<T> set(
+      const TypedAttribute<V>& attribute, std::type_identity_t<V> value) {
+    put(attribute, value);
+    return std::enable_shared_from_this<T>::shared_from_this();
   }
 };
 
@@ -27,11 +27,15 @@
  * @brief Pretty print logic
  */
 
+#include <cstdint>
+#include <string>
 #include <vector>
 
-#include "AttributeFunction.h"
+#include "AttributeValue.h"
 #include "AttrNodePrinter.h"
 #include "NodeAction.h"
+#include "StreamSink.h"
+#include "TextBuffer.h"
 #include "Traversal.h"
 #include "VoidFunction.h"
 
@@ -39,95 +43,92 @@ namespace VisitingParseTree {
 
 namespace TreePrinter {
 
+/**
+ * Prefix segment width, which every ancestor level contributes
+ */
+static constexpr size_t SEGMENT_SIZE = 4;
+
 /**
  * Tracks state during recursive descent
  *
  * Level-specific state must be preserved as the print traversal
  * descends. Level-specific state includes
  *
- * * Top of stack
- * * Number of nodes at this level
+ * * Number of lines at this level, which counts an elision
+ *   line when children are truncated
  * * Current position
  *
- * The state determines how to prefix the current node.
+ * The state determines how to prefix the current node's descendants.
  *
  * Note that application code \b SHOULD not use this class, and that
  * all logic is private to prevent meddling.
  */
 class Level {
-  friend class AscendAction;
   friend class Context;
-  friend class DescendAction;
-  const int node_count_;  /** Number of nodes in this level */
-  int node_index_;  /** 0-based node index */
-  bool at_top_; /** \c true if and only if this is the top level */
-
-  /**
-   * Sets the top of stack indicator. The indicator should be
-   * set \c true
-   *
-   * * on construction, where the new instance is placed on the stack
-   * * when a stack pop reveals this \c Level
-   *
-   * @param at_top[in] \c true if and only if this \c Level
-   *                   is at the top of the \c Level stack.
-   */
-  void set_top(bool at_top) {
-    at_top_ = at_top;
-  }
+  friend class OnEntry;
+  const size_t child_count_;  /** Number of nodes in this level */
+  const size_t line_count_;  /** Number of lines printed at this level */
+  size_t node_index_;  /** 0-based index of the next node */
 
   /**
-   * Prints a print level prefix to the specified \c stream
+   * Selects the prefix segment that this level contributes to the
+   * lines of its current node's descendants.
    *
-   * @param stream receives pretty printed output
+   * @return a pipe to connect the current node to a later line at
+   *         this level, or spaces if there is none
    */
-  void print_prefix(std::ostream& stream) {
-    if (at_top_) {
-      ++node_index_;
-      stream << " +--";
-    } else {
-      stream <<
-          (node_index_ < node_count_
-              ? " |  "
-              : "    ");
-    }
+  const char *segment(void) const {
+    return node_index_ < line_count_
+        ? " |  "
+        : "    ";
   }
 
 public:
   /**
    * Constructor
    *
-   * @param node_count the number of nodes at this traversal level
+   * @param child_count the number of nodes at this traversal level
+   * @param max_children the number of nodes to print
    */
-  Level(int node_count) :
-    node_count_(node_count),
-    node_index_(0),
-    at_top_(true) {
-  }
-
-  /**
-   * Move constructor
-   *
-   * @param from source
-   */
-  Level(Level&& from) :
-    node_count_(std::move(from.node_count_)),
-    node_index_(std::move(from.node_index_)),
-    at_top_(std::move(from.at_top_)) {
+  Level(size_t child_count, size_t max_children) :
+    child_count_(child_count),
+    line_count_(
+        child_count <= max_children
+            ? child_count
+            : max_children + 1),
+    node_index_(0) {
   }
 };
 
 /**
  * @brief Holds state during printing
+ *
+ * The context keeps the prefix shared by all nodes at the current
+ * level, which it extends on descent and trims on ascent, and
+ * formats lines into the printer's buffer.
  */
 class Context {
   friend class AscendAction;
   friend class VisitingParseTree::AttrNodePrinter;
   friend class DescendAction;
   friend class OnEntry;
+  TextBuffer& buffer_;
+  ByteSink& sink_;
+  const size_t max_depth_;
+  const size_t max_children_;
   std::vector<Level> levels_;
-  int current_child_count_;
-  Context() :
+  std::string prefix_;
+  size_t current_child_count_;
+
+  Context(
+      TextBuffer& buffer,
+      ByteSink& sink,
+      size_t max_depth,
+      size_t max_children) :
+    buffer_(buffer),
+    sink_(sink),
+    max_depth_(max_depth),
+    max_children_(max_children),
     current_child_count_(0) {
   }
 
@@ -144,9 +145,9 @@ class Context {
    */
   void descend() {
     if (!levels_.empty()) {
-      levels_.back().set_top(false);
+      prefix_.append(levels_.back().segment());
     }
-    levels_.emplace_back(current_child_count_);
+    levels_.emplace_back(current_child_count_, max_children_);
   }
 
   /**
@@ -162,7 +163,7 @@ class Context {
   void ascend() {
     levels_.pop_back();
     if (!levels_.empty()) {
-      levels_.back().set_top(true);
+      prefix_.resize(prefix_.size() - SEGMENT_SIZE);
     }
   }
 
@@ -192,44 +193,58 @@ class Context {
    * @param child_count the number of children owned by the
    *        node being printed.
    */
-  void current_child_count(int child_count) {
+  void current_child_count(size_t child_count) {
     current_child_count_ = child_count;
   }
 
-public:
   /**
-   * @brief prints this context
-   *
-   * Prints the prefix for the current node. Note that this operation
-   * does \b not print the node itself.
-   *
-   * @param stream std::ostream to receive the output
-   * @return \c stream, for chaining
+   * @brief Starts a line at the current level
    */
-  std::ostream&  operator<< (std::ostream& stream) {
-    for (
-        auto iter = levels_.begin();
-        iter != levels_.end();
-        ++iter) {
-      iter->print_prefix(stream);
+  void begin_line(void) {
+    buffer_.append(prefix_);
+    if (!levels_.empty()) {
+      buffer_.append(" +--");
     }
-    return stream;
   }
-};
 
-/**
- * @brief Standard print operation
- *
- * Invokes \c Context::operator<<(std::stream) to print a node's
- * prefix.
- *
- * @param stream receives the output
- * @param context the context to print
- * @return \b stream
- */
-std::ostream& operator<<(std::ostream& stream, Context& context) {
-  return context.operator<<(stream);
-}
+  /**
+   * @brief Starts a line one level below the current level, where
+   *        the current node's children would appear
+   */
+  void begin_child_line(void) {
+    buffer_.append(prefix_);
+    if (!levels_.empty()) {
+      buffer_.append(levels_.back().segment());
+    }
+    buffer_.append(" +--");
+  }
+
+  /**
+   * @brief Writes the body of an elision line
+   *
+   * @param count the number of elided nodes
+   */
+  void elide(size_t count) {
+    buffer_.append("... (");
+    buffer_.append_number(std::uint64_t(count));
+    buffer_.append(" more)");
+  }
+
+  /**
+   * @brief Ends the current line, writing the buffer once it fills
+   */
+  void end_line(void) {
+    buffer_.append('\n');
+    buffer_.write_if_full(sink_);
+  }
+
+  /**
+   * @brief Writes and empties the buffer, which keeps its capacity
+   */
+  void flush(void) {
+    buffer_.write_to(sink_);
+  }
+};
 
 /**
  * @brief Traversal descent action
@@ -285,44 +300,37 @@ public:
 };
 
 /**
- * @brief Attribute printer
+ * @brief Appends an attribute value as \c to_string() renders it,
+ *        without creating a temporary string
  *
- * Passed to \c AttrNode::for_all_attributes() to print the invoked
- * node's attributes.
+ * @param buffer receives the value
+ * @param value the value to format
  */
-class AttributePrinter : public AttributeFunction {
-  friend class OnEntry;
-
-  std::ostream& stream_;
-
-  /**
-   * @brief Constructor
-   *
-   * @param stream destination for the attribute values
-   */
-  AttributePrinter(std::ostream& stream) :
-    stream_(stream) {
+void append_value(TextBuffer& buffer, const AttributeValue& value) {
+  switch (value.index()) {
+  case 0:
+    buffer.append(std::get<std::string>(value));
+    break;
+  case 1:
+    buffer.append_number(std::get<std::int64_t>(value));
+    break;
+  case 2:
+    buffer.append_number(std::get<double>(value));
+    break;
+  case 3:
+    buffer.append(std::get<bool>(value) ? "true" : "false");
+    break;
+  default:
+    buffer.append(std::get<InternedString>(value).view());
+    break;
   }
-
-public:
-  /**
-   * @brief Prints an attribute, value pair
-   *
-   * @param attribute attribute time
-   * @param value attribute's \c std::string value
-   */
-  virtual void operator() (
-      const Attribute* const& attribute,
-      const std::string& value) override {
-    stream_ << attribute->name() << "->" << value << " ";
-  }
-};
+}
 
 /**
  * @brief node entry processor
  *
- * Writes a formatted representation of the entered node to
- * an output stream
+ * Formats the entered node into the context's buffer, and elides
+ * nodes beyond the context's depth and breadth limits.
  */
 class OnEntry : public NodeAction<BaseAttrNode> {
   friend class VisitingParseTree::AttrNodePrinter;
@@ -332,38 +340,62 @@ class OnEntry : public NodeAction<BaseAttrNode> {
    */
   Context& context_;
 
-  /**
-   * @brief receives the formatted output
-   */
-  std::ostream& stream_;
-
   /**
    * @brief Constructor
    *
    * @param context traversal context
-   * @param stream receives the formatted output
    */
-  OnEntry(Context& context, std::ostream& stream) :
-    context_(context),
-    stream_(stream) {
+  OnEntry(Context& context) :
+    context_(context) {
   }
 public:
   /**
    * @brief Node entry processor
    *
-   * Prints the newly encountered node
+   * Prints the newly encountered node, or the line that elides it
+   * and its younger siblings.
    *
    * @param node the node that the traversal has entered
-   * @return \c TraversalStatus::CONTINUE, always
+   * @return \c TraversalStatus::BYPASS_CHILDREN if the node's
+   *         children are elided, \c TraversalStatus::CONTINUE
+   *         otherwise
    */
   virtual TraversalStatus operator() (
       std::shared_ptr<BaseAttrNode> node) override {
-    context_.current_child_count(node->child_count());
-    stream_ << context_ << node->type_name() << " [";
-    AttributePrinter attribute_printer(stream_);
-    node->for_all_attributes(attribute_printer);
+    if (!context_.levels_.empty()) {
+      Level& level = context_.levels_.back();
+      size_t index = level.node_index_++;
+      if (context_.max_children_ <= index) {
+        if (context_.max_children_ == index) {
+          context_.begin_line();
+          context_.elide(level.child_count_ - index);
+          context_.end_line();
+        }
+        return TraversalStatus::BYPASS_CHILDREN;
+      }
+    }
 
-    stream_ << ']' << std::endl;
+    TextBuffer& buffer = context_.buffer_;
+    context_.begin_line();
+    buffer.append(node->type_name());
+    buffer.append(" [");
+    for (const auto& entry : node->attribute_map()) {
+      buffer.append(entry.attribute->name());
+      buffer.append("->");
+      append_value(buffer, entry.value);
+      buffer.append(' ');
+    }
+    buffer.append(']');
+    context_.end_line();
+
+    size_t child_count = node->child_count();
+    if (0 < child_count && context_.max_depth_ <= context_.levels_.size()) {
+      context_.begin_child_line();
+      context_.elide(child_count);
+      context_.end_line();
+      return TraversalStatus::BYPASS_CHILDREN;
+    }
+    context_.current_child_count(child_count);
     return TraversalStatus::CONTINUE;
   }
 };
@@ -394,14 +426,21 @@ using namespace TreePrinter;
 
 
 void AttrNodePrinter::print(std::shared_ptr<BaseAttrNode> root, std::ostream& output_stream) {
-  Context context;
+  StreamSink sink(output_stream);
+  print(std::move(root), sink);
+  output_stream.flush();
+}
+
+void AttrNodePrinter::print(std::shared_ptr<BaseAttrNode> root, ByteSink& sink) {
+  buffer_.clear();
+  Context context(buffer_, sink, max_depth_, max_children_);
   DescendAction descend_action(context);
   AscendAction ascend_action(context);
-  OnEntry on_entry(context, output_stream);
+  OnEntry on_entry(context);
   OnExit on_exit;
   Traversal traversal(on_entry, on_exit, descend_action, ascend_action);
   traversal(root);
-
+  context.flush();
 }
 
 } /* namespace VisitingParseTree */
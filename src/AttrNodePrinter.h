@@ -59,6 +59,9 @@
  *
  * It is hoped that the resulting output portrays the tree structure
  * clearly and unambiguously.
+ *
+ * Huge trees can be truncated by depth, by breadth, or both. Elided
+ * children are replaced by a single \c ... line that counts them.
  */
 
 /**
@@ -70,10 +73,14 @@
 #ifndef SRC_ATTRNODEPRINTER_H_
 #define SRC_ATTRNODEPRINTER_H_
 
+#include <cstddef>
 #include <iostream>
+#include <limits>
 #include <memory>
 
 #include "BaseAttrNode.h"
+#include "ByteSink.h"
+#include "TextBuffer.h"
 
 namespace VisitingParseTree {
 
@@ -81,9 +88,29 @@ namespace VisitingParseTree {
  * @brief Pretty prints a tree of \c BaseAttrNode nodes
  *
  * Thin wrapper around a \c TreeTraversal that pretty-prints a
- * \c BaseAttrNode tree
+ * \c BaseAttrNode tree. The printer formats into a buffer that it
+ * reuses across calls and writes the buffer out only when it fills,
+ * so printing never flushes per line. It keeps the current line
+ * prefix as it descends and ascends rather than rebuilding it for
+ * every node.
  */
 class AttrNodePrinter {
+public:
+  /**
+   * Limit value that disables truncation
+   */
+  static constexpr size_t UNLIMITED = std::numeric_limits<size_t>::max();
+
+  /**
+   * Buffered output size that triggers a write
+   */
+  static constexpr size_t BUFFER_SIZE = TextBuffer::CAPACITY;
+
+private:
+  size_t max_depth_ = UNLIMITED;  /** Deepest printed level, root is 0 */
+  size_t max_children_ = UNLIMITED;  /** Most children printed per node */
+  TextBuffer buffer_;  /** Formatted output, reused across prints */
+
 public:
   AttrNodePrinter() = default;
   virtual ~AttrNodePrinter() = default;
@@ -94,14 +121,48 @@ public:
 
 public:
 
+  /**
+   * @brief Limits the printed depth
+   *
+   * @param max_depth the depth of the deepest printed nodes, where the
+   *        root's depth is 0, or \c UNLIMITED to print every level.
+   *        The children of nodes at \c max_depth are elided.
+   */
+  void set_max_depth(size_t max_depth) {
+    max_depth_ = max_depth;
+  }
+
+  /**
+   * @brief Limits the number of children printed per node
+   *
+   * @param max_children the number of leading children to print, or
+   *        \c UNLIMITED to print them all. The remaining children and
+   *        their subtrees are elided.
+   */
+  void set_max_children(size_t max_children) {
+    max_children_ = max_children;
+  }
+
   /**
    * @brief pretty prints a \c BaseAttrNode tree
    *
    * @param root the tree to print. Note that printing a tree does
    *        not change it
-   * @param output_stream[in] receives the pretty printed tree
+   * @param output_stream[in] receives the pretty printed tree, and
+   *        is flushed before this method returns
    */
   void print(std::shared_ptr<BaseAttrNode> root, std::ostream& output_stream);
+
+  /**
+   * @brief pretty prints a \c BaseAttrNode tree to a \c ByteSink
+   *
+   * @param root the tree to print
+   * @param sink receives the pretty printed tree in buffer-sized
+   *        writes
+   *
+   * @throws IllegalOperation if \c sink cannot write the output
+   */
+  void print(std::shared_ptr<BaseAttrNode> root, ByteSink& sink);
 };
 
 } /* namespace VisitingParseTree */
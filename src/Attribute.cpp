@@ -32,10 +32,11 @@
 
 namespace VisitingParseTree {
 
-Attribute::Attribute(const char *name) :
+Attribute::Attribute(const char *name, AttributeType type) :
     BaseAttribute(),
     hash_(id_hash(id())),
-    name_(name) {
+    name_(name),
+    type_(type) {
 }
 
 } /* namespace VisitingParseTree */
@@ -24,23 +24,27 @@
 /*******************************
  * @file Attribute.h
  *
- * @brief Base class for attribute key classes. Subtype instances are
- *        used to identify attributes within unordered maps of
- *        <Attribute, std::string> pairs.
+ * @brief Base class for attribute key classes. Subtype instances
+ *        identify attributes within attributed nodes.
  ********************************/
 
 #pragma once
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 
+#include "AttributeValue.h"
 #include "BaseAttribute.h"
 
 namespace VisitingParseTree {
 
 /**
  * @brief Base class for attribute types, which are used
- * as keys in an std::unordered:map of std::string values.
+ * as keys for node attribute values.
+ *
+ * An \c Attribute instance's values are \c std::string by default.
+ * \c TypedAttribute subclasses have scalar values.
  *
  * Subtype constructors \b MUST be \c private and
  * all instances \b MUST be static const. Application
@@ -53,14 +57,16 @@ class Attribute : public BaseAttribute {
 
   const size_t hash_;  /** Attribute hash value. TODO: move to base class. */
   const std::string name_;  /** Fully qualified node class name. */
+  const AttributeType type_;  /** Value type */
 
 protected:
   /**
    * @brief Construct an Attribute instance
    *
    * @param name the instance's name, which __should__ be globally unique
+   * @param type the instance's value type
    */
-  Attribute(const char *name);
+  Attribute(const char *name, AttributeType type = AttributeType::STRING);
 
 public:
   Attribute(const Attribute&) = delete;
@@ -83,6 +89,27 @@ public:
   const std::string& name(void) const {
     return name_;
   }
+
+  /**
+   * @return the type of value this attribute holds
+   */
+  AttributeType type(void) const {
+    return type_;
+  }
+
+  /**
+   * @brief Converts text to a value of this attribute's type
+   *
+   * @param text the text to convert
+   * @return the converted value. The default implementation returns
+   *         \c text unchanged.
+   *
+   * @throws IllegalOperation if \c text does not represent a valid
+   *         value
+   */
+  virtual AttributeValue parse(std::string_view text) const {
+    return std::string(text);
+  }
 };
 
 } /* namespace VisitingParseTree */
@@ -92,8 +119,7 @@ namespace std {
 /**
  * Attribute-specific hash function. Providing an attribute-specific
  * std::hash implementation allows attributes to be used to key an
- * unordered map, which is how attributed nodes store their attribute
- * values.
+ * unordered map.
  */
 template<>
 class hash<VisitingParseTree::Attribute> {
@@ -0,0 +1,368 @@
+/*
+ * AttributeMap.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file AttributeMap.h
+ *
+ * @brief Compact attribute storage for \c AttrNode
+ */
+
+#ifndef ATTRIBUTEMAP_H_
+#define ATTRIBUTEMAP_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "Attribute.h"
+#include "AttributeValue.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief A small map from \c Attribute to \c AttributeValue
+ *
+ * Most nodes carry few attributes or none, so the map itself is a
+ * single pointer. An empty map allocates nothing. A non-empty map
+ * keeps its entries in one heap block, behind a small header that
+ * holds the entry count and capacity. The capacity starts at one
+ * entry and doubles as the map grows, so a map with one or two
+ * attributes costs one small allocation. Erasing the last entry frees
+ * the block.
+ *
+ * Entries are kept sorted by attribute identifier (see
+ * \c BaseAttribute::id()), which makes iteration order deterministic:
+ * ascending identifier, i.e. attribute creation order.
+ *
+ * Each entry caches its attribute's identifier, so lookups compare
+ * integers without touching the attributes themselves.
+ */
+class AttributeMap {
+public:
+  /**
+   * @brief An (attribute, value) pair
+   */
+  struct Entry {
+    int id = 0;  /** Cached attribute identifier, the sort key */
+    const Attribute *attribute = nullptr;  /** Attribute type */
+    AttributeValue value;  /** Attribute value */
+  };
+
+private:
+  /**
+   * @brief Heads the heap block. The entries follow it.
+   */
+  struct Header {
+    std::uint32_t size;  /** Number of entries */
+    std::uint32_t capacity;  /** Number of entries that fit */
+  };
+  static_assert(sizeof(Header) % alignof(Entry) == 0);
+  static_assert(alignof(Header) <= alignof(Entry));
+
+  /**
+   * Maps no larger than this are searched linearly, which beats a
+   * binary search over a handful of entries.
+   */
+  static constexpr size_t LINEAR_SEARCH_LIMIT = 4;
+
+  Header *header_ = nullptr;  /** Heap block, or NULL if the map is empty */
+
+  /**
+   * @brief Allocates an empty heap block
+   *
+   * @param capacity the number of entries the block can hold
+   * @return the block's header
+   */
+  static Header *allocate(size_t capacity) {
+    void *block = ::operator new(sizeof(Header) + capacity * sizeof(Entry));
+    return ::new (block) Header{0, static_cast<std::uint32_t>(capacity)};
+  }
+
+  /**
+   * @param header a heap block's header
+   * @return the block's first entry
+   */
+  static Entry *entries_of(Header *header) {
+    return reinterpret_cast<Entry *>(header + 1);
+  }
+
+  /**
+   * @brief Destroys a heap block's entries and frees it
+   *
+   * @param header the block's header, or \c NULL
+   */
+  static void release(Header *header) {
+    if (header) {
+      std::destroy_n(entries_of(header), header->size);
+      ::operator delete(header);
+    }
+  }
+
+  /**
+   * @brief Moves the entries to a block with twice the capacity, or
+   *        allocates a one-entry block for an empty map
+   */
+  void grow(void) {
+    Header *grown = allocate(header_ ? 2 * size_t{header_->capacity} : 1);
+    if (header_) {
+      Entry *first = entries_of(header_);
+      std::uninitialized_move(
+          first, first + header_->size, entries_of(grown));
+      grown->size = header_->size;
+      release(header_);
+    }
+    header_ = grown;
+  }
+
+  /**
+   * @brief Copies another map's entries into an exactly sized block
+   *
+   * The map must be empty.
+   *
+   * @param other the map to copy
+   */
+  void copy(const AttributeMap &other) {
+    if (other.empty()) {
+      return;
+    }
+    Header *copied = allocate(other.size());
+    try {
+      std::uninitialized_copy(
+          other.begin(), other.end(), entries_of(copied));
+    } catch (...) {
+      ::operator delete(copied);
+      throw;
+    }
+    copied->size = other.header_->size;
+    header_ = copied;
+  }
+
+  /**
+   * @brief Locates an attribute's entry, or the position where it
+   *        would be inserted
+   *
+   * @param id attribute identifier
+   * @return the first entry whose identifier is not less than \c id
+   */
+  const Entry *lower_bound(int id) const {
+    const Entry *first = begin();
+    const Entry *last = end();
+    if (size() <= LINEAR_SEARCH_LIMIT) {
+      while (first != last && first->id < id) {
+        ++first;
+      }
+      return first;
+    }
+    return std::lower_bound(
+        first,
+        last,
+        id,
+        [](const Entry& entry, int id) { return entry.id < id; });
+  }
+
+  Entry *lower_bound(int id) {
+    return const_cast<Entry *>(std::as_const(*this).lower_bound(id));
+  }
+
+public:
+  AttributeMap() {
+  }
+
+  /**
+   * @brief Copies another map's entries into a block no larger than
+   *        they need
+   *
+   * @param other the map to copy
+   */
+  AttributeMap(const AttributeMap &other) {
+    copy(other);
+  }
+
+  /**
+   * @brief Takes another map's entries, leaving it empty
+   *
+   * @param other the map to move from
+   */
+  AttributeMap(AttributeMap &&other) noexcept :
+      header_(std::exchange(other.header_, nullptr)) {
+  }
+
+  AttributeMap& operator=(const AttributeMap &other) {
+    if (this != &other) {
+      AttributeMap copied(other);
+      std::swap(header_, copied.header_);
+    }
+    return *this;
+  }
+
+  AttributeMap& operator=(AttributeMap &&other) noexcept {
+    if (this != &other) {
+      release(header_);
+      header_ = std::exchange(other.header_, nullptr);
+    }
+    return *this;
+  }
+
+  ~AttributeMap() {
+    release(header_);
+  }
+
+  /**
+   * @return the number of entries in the map
+   */
+  size_t size(void) const {
+    return header_ ? header_->size : 0;
+  }
+
+  /**
+   * @return the number of entries the map can hold before it must
+   *         reallocate its heap block
+   */
+  size_t capacity(void) const {
+    return header_ ? header_->capacity : 0;
+  }
+
+  /**
+   * @return \c true if and only if the map is empty
+   */
+  bool empty(void) const {
+    return !header_;
+  }
+
+  /**
+   * @return the first entry, in ascending attribute identifier order
+   */
+  const Entry *begin(void) const {
+    return header_ ? entries_of(header_) : nullptr;
+  }
+
+  /**
+   * @return just past the last entry
+   */
+  const Entry *end(void) const {
+    return begin() + size();
+  }
+
+  /**
+   * @brief Retrieves an attribute's value
+   *
+   * @param attribute the attribute to find
+   * @return a pointer to the attribute's value, or \c NULL if the map
+   *         does not contain the attribute
+   */
+  const AttributeValue *find(const Attribute& attribute) const {
+    const Entry *found = lower_bound(attribute.id());
+    return found != end() && found->id == attribute.id()
+        ? &found->value
+        : nullptr;
+  }
+
+  AttributeValue *find(const Attribute& attribute) {
+    return const_cast<AttributeValue *>(std::as_const(*this).find(attribute));
+  }
+
+  /**
+   * @param attribute the attribute to find
+   * @return \c true if and only if the map contains the attribute
+   */
+  bool contains(const Attribute& attribute) const {
+    return find(attribute);
+  }
+
+  /**
+   * @brief Retrieves an attribute's value, adding the attribute with
+   *        an empty \c std::string value if necessary
+   *
+   * Lets callers update a value in place with a single lookup, e.g.
+   * to reuse an existing string's buffer.
+   *
+   * @param attribute the attribute to find or add
+   * @return the attribute's value, which remains valid until the map
+   *         is next modified
+   */
+  AttributeValue& find_or_insert(const Attribute& attribute) {
+    const int id = attribute.id();
+    Entry *position = lower_bound(id);
+    if (position != end() && position->id == id) {
+      return position->value;
+    }
+    size_t index = position - begin();
+    if (size() == capacity()) {
+      grow();
+    }
+    Entry *first = entries_of(header_);
+    Entry *last = first + header_->size;
+    Entry inserted{id, &attribute, AttributeValue()};
+    if (first + index == last) {
+      std::construct_at(last, std::move(inserted));
+    } else {
+      std::construct_at(last, std::move(last[-1]));
+      std::move_backward(first + index, last - 1, last);
+      first[index] = std::move(inserted);
+    }
+    ++header_->size;
+    return first[index].value;
+  }
+
+  /**
+   * @brief Sets an attribute's value, adding the attribute if
+   *        necessary
+   *
+   * @param attribute the attribute to set
+   * @param value its new value
+   */
+  void insert_or_assign(const Attribute& attribute, AttributeValue value) {
+    find_or_insert(attribute) = std::move(value);
+  }
+
+  /**
+   * @brief Removes an attribute. Does nothing if the map does not
+   *        contain the attribute. Removing the last attribute frees
+   *        the heap block.
+   *
+   * @param attribute the attribute to remove
+   */
+  void erase(const Attribute& attribute) {
+    const int id = attribute.id();
+    Entry *position = lower_bound(id);
+    if (position == end() || position->id != id) {
+      return;
+    }
+    if (1 == header_->size) {
+      release(std::exchange(header_, nullptr));
+      return;
+    }
+    Entry *last = entries_of(header_) + header_->size;
+    std::move(position + 1, last, position);
+    std::destroy_at(last - 1);
+    --header_->size;
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* ATTRIBUTEMAP_H_ */
@@ -0,0 +1,91 @@
+/*
+ * AttributeValue.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file AttributeValue.cpp
+ *
+ * Attribute value formatting
+ */
+
+#include "AttributeValue.h"
+
+#include <bit>
+#include <charconv>
+#include <functional>
+#include <string_view>
+
+#include "HashCombine.h"
+
+namespace VisitingParseTree {
+
+namespace {
+
+template <typename V> std::string format_number(V number) {
+  char buffer[32];
+  auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), number);
+  return std::string(buffer, end);
+}
+
+}
+
+std::string to_string(const AttributeValue& value) {
+  switch (value.index()) {
+  case 0:
+    return std::get<std::string>(value);
+  case 1:
+    return format_number(std::get<std::int64_t>(value));
+  case 2:
+    return format_number(std::get<double>(value));
+  case 3:
+    return std::get<bool>(value) ? "true" : "false";
+  default:
+    return std::get<InternedString>(value).str();
+  }
+}
+
+std::uint64_t hash_value(const AttributeValue& value) {
+  std::uint64_t hash;
+  switch (value.index()) {
+  case 0:
+    hash = std::hash<std::string_view>()(std::get<std::string>(value));
+    break;
+  case 1:
+    hash = static_cast<std::uint64_t>(std::get<std::int64_t>(value));
+    break;
+  case 2: {
+    // 0.0 and -0.0 are equal, so they must hash alike.
+    double number = std::get<double>(value);
+    hash = std::bit_cast<std::uint64_t>(0.0 == number ? 0.0 : number);
+    break;
+  }
+  case 3:
+    hash = std::get<bool>(value);
+    break;
+  default:
+    hash = std::hash<std::string_view>()(std::get<InternedString>(value).view());
+    break;
+  }
+  return hash_combine(value.index(), hash);
+}
+
+} /* namespace VisitingParseTree */
@@ -0,0 +1,109 @@
+/*
+ * AttributeValue.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file AttributeValue.h
+ *
+ * @brief Attribute value representation
+ */
+
+#ifndef ATTRIBUTEVALUE_H_
+#define ATTRIBUTEVALUE_H_
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <variant>
+
+#include "InternedString.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief The kinds of value that an attribute can hold
+ */
+enum class AttributeType {
+  STRING,  /** \c std::string, the default */
+  INT64,  /** \c std::int64_t */
+  DOUBLE,  /** \c double */
+  BOOL,  /** \c bool */
+  INTERNED,  /** \c InternedString, a handle to a pooled string */
+};
+
+/**
+ * @brief An attribute value, as stored in a node
+ *
+ * Scalar values and interned string handles are held directly, so
+ * setting and getting them neither allocates nor parses.
+ */
+using AttributeValue = std::variant<
+    std::string, std::int64_t, double, bool, InternedString>;
+
+/**
+ * @brief Maps a scalar C++ type to its \c AttributeType
+ *
+ * @tparam V the C++ type, which must be \c std::int64_t, \c double,
+ *         \c bool, or \c InternedString
+ */
+template <typename V> constexpr AttributeType attribute_type_of = [] {
+  if constexpr (std::is_same_v<V, std::int64_t>) {
+    return AttributeType::INT64;
+  } else if constexpr (std::is_same_v<V, double>) {
+    return AttributeType::DOUBLE;
+  } else if constexpr (std::is_same_v<V, bool>) {
+    return AttributeType::BOOL;
+  } else {
+    static_assert(
+        std::is_same_v<V, InternedString>, "Unsupported attribute type");
+    return AttributeType::INTERNED;
+  }
+}();
+
+/**
+ * @brief Renders an attribute value as text
+ *
+ * Integers are rendered in decimal, \c double values in the shortest
+ * form that parses back to the same value, \c bool values as
+ * \c true or \c false, and interned strings as their text.
+ *
+ * @param value the value to render
+ * @return the rendered value
+ */
+std::string to_string(const AttributeValue& value);
+
+/**
+ * @brief Hashes an attribute value
+ *
+ * Equal values hash equally. Values of different types hash
+ * differently even when they render the same, as they are unequal.
+ * Interned strings hash by content, so handles to equal text from
+ * different pools hash alike.
+ *
+ * @param value the value to hash
+ * @return the value's hash
+ */
+std::uint64_t hash_value(const AttributeValue& value);
+
+} /* namespace VisitingParseTree */
+
+#endif /* ATTRIBUTEVALUE_H_ */
@@ -25,11 +25,14 @@
 
 namespace VisitingParseTree {
 
+DispatchTag<BaseAttrNode> BaseAttrNode::DISPATCH_TAG =
+    DispatchTag<BaseAttrNode>::make<
+        BaseAttrNode,
+        BaseAttrNodeVisitor,
+        &BaseAttrNodeVisitor::processBaseAttrNode>(nullptr);
+
 TraversalStatus BaseAttrNode::accept(Visitor *visitor) {
-  auto concrete_visitor = dynamic_cast<BaseAttrNodeVisitor *>(visitor);
-  return concrete_visitor
-      ? concrete_visitor->processBaseAttrNode(this)
-      : TraversalStatus::CONTINUE;
+  return DISPATCH_TAG.dispatch(visitor, this);
 }
 
 } /* namespace VisitingParseTree */
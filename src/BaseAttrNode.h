@@ -31,6 +31,7 @@
 #define BASEATTRNODE_H_
 
 #include "AttrNode.h"
+#include "DispatchTag.h"
 #include "Supplier.h"
 #include "TraversalStatus.h"
 #include "Visitor.h"
@@ -97,6 +98,12 @@ public:
 
   virtual ~BaseAttrNode() = default;
 
+  /**
+   * Dispatch tag for the root of the generated hierarchy. Every
+   * generated node's tag descends from it.
+   */
+  static DispatchTag<BaseAttrNode> DISPATCH_TAG;
+
   virtual TraversalStatus accept(Visitor *visitor) override;
 };
 
@@ -0,0 +1,145 @@
+/*
+ * BinaryTreeFormat.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file BinaryTreeFormat.h
+ *
+ * @brief Constants and primitive encodings shared by the binary tree
+ *        writer and reader
+ */
+#ifndef BINARYTREEFORMAT_H_
+#define BINARYTREEFORMAT_H_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace VisitingParseTree {
+
+/**
+ * @brief The binary tree format
+ *
+ * A stream starts with the four \c MAGIC bytes and a \c VERSION byte,
+ * followed by any number of trees. Each tree is a preorder sequence
+ * of node records:
+ *
+ * - the node's type reference,
+ * - the number of attributes, then for each attribute, its reference
+ *   and value,
+ * - the number of children, whose records follow, in order.
+ *
+ * Numbers are unsigned LEB128 varints. Types and attributes are
+ * referenced by their index in a table that persists for the whole
+ * stream. A reference equal to the table's current size defines the
+ * next entry in place: a type definition is its
+ * \c Supplier::class_name(), and an attribute definition is its
+ * \c Attribute::name() followed by its \c AttributeType as one byte.
+ * Names are a varint length followed by that many bytes.
+ *
+ * Values are encoded according to their attribute's type:
+ *
+ * - \c STRING and \c INTERNED values as names are,
+ * - \c INT64 values as zigzag varints,
+ * - \c DOUBLE values as the eight little endian bytes of their
+ *   IEEE 754 representation, and
+ * - \c BOOL values as a single 0 or 1 byte.
+ */
+namespace BinaryTreeFormat {
+
+/** Identifies a binary tree stream */
+constexpr unsigned char MAGIC[] = {'V', 'P', 'T', 'B'};
+
+/** Format version, which follows \c MAGIC */
+constexpr unsigned char VERSION = 1;
+
+/** The most bytes that a 64-bit varint occupies */
+constexpr size_t MAX_VARINT_SIZE = 10;
+
+/**
+ * @brief Encodes an unsigned varint
+ *
+ * @param value the value to encode
+ * @param out destination, which must have room for
+ *        \c MAX_VARINT_SIZE bytes
+ * @return just past the last byte written
+ */
+inline unsigned char *put_varint(std::uint64_t value, unsigned char *out) {
+  while (0x80 <= value) {
+    *out++ = static_cast<unsigned char>(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = static_cast<unsigned char>(value);
+  return out;
+}
+
+/**
+ * @brief Maps a signed value to an unsigned one whose varint is short
+ *        when the value's magnitude is small
+ */
+constexpr std::uint64_t zigzag(std::int64_t value) {
+  return (static_cast<std::uint64_t>(value) << 1)
+      ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+/**
+ * @brief Inverts \c zigzag()
+ */
+constexpr std::int64_t unzigzag(std::uint64_t value) {
+  return static_cast<std::int64_t>(value >> 1)
+      ^ -static_cast<std::int64_t>(value & 1);
+}
+
+/**
+ * @brief Encodes a \c double as eight little endian bytes
+ *
+ * @param value the value to encode
+ * @param out destination, which must have room for eight bytes
+ * @return just past the last byte written
+ */
+inline unsigned char *put_double(double value, unsigned char *out) {
+  auto bits = std::bit_cast<std::uint64_t>(value);
+  for (int i = 0; i < 8; ++i, bits >>= 8) {
+    *out++ = static_cast<unsigned char>(bits);
+  }
+  return out;
+}
+
+/**
+ * @brief Decodes a \c double encoded by \c put_double()
+ *
+ * @param in the first of eight bytes
+ * @return the decoded value
+ */
+inline double get_double(const unsigned char *in) {
+  std::uint64_t bits = 0;
+  for (int i = 7; 0 <= i; --i) {
+    bits = (bits << 8) | in[i];
+  }
+  return std::bit_cast<double>(bits);
+}
+
+} /* namespace BinaryTreeFormat */
+
+} /* namespace VisitingParseTree */
+
+#endif /* BINARYTREEFORMAT_H_ */
@@ -0,0 +1,240 @@
+/*
+ * BinaryTreeReader.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file BinaryTreeReader.cpp
+ *
+ * Binary tree reader implementation
+ */
+
+#include "BinaryTreeReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include "BinaryTreeFormat.h"
+#include "TreeCorruptError.h"
+#include "TypedAttribute.h"
+
+namespace VisitingParseTree {
+
+BinaryTreeReader::BinaryTreeReader(
+    std::istream& in,
+    InternPool& pool,
+    size_t buffer_size) :
+        in_(in),
+        pool_(pool),
+        buffer_(std::max(buffer_size, BinaryTreeFormat::MAX_VARINT_SIZE)) {
+}
+
+BinaryTreeReader& BinaryTreeReader::add(Supplier<BaseAttrNode>& supplier) {
+  suppliers_[supplier.class_name()] = &supplier;
+  return *this;
+}
+
+BinaryTreeReader& BinaryTreeReader::add(const Attribute& attribute) {
+  attributes_by_name_[attribute.name()] = &attribute;
+  return *this;
+}
+
+bool BinaryTreeReader::fill(size_t size) {
+  if (size <= available_ - position_) {
+    return true;
+  }
+  std::memmove(
+      buffer_.data(), buffer_.data() + position_, available_ - position_);
+  available_ -= position_;
+  position_ = 0;
+  while (available_ < size && in_) {
+    // Grow the buffer only as the stream delivers data, so a corrupt
+    // length costs at most twice the bytes actually present.
+    if (available_ == buffer_.size()) {
+      buffer_.resize(std::min(size, 2 * buffer_.size()));
+    }
+    in_.read(
+        reinterpret_cast<char *>(buffer_.data() + available_),
+        buffer_.size() - available_);
+    available_ += in_.gcount();
+  }
+  return size <= available_;
+}
+
+const unsigned char *BinaryTreeReader::require(size_t size) {
+  if (!fill(size)) {
+    throw TreeCorruptError("Tree stream ends prematurely.");
+  }
+  const unsigned char *data = buffer_.data() + position_;
+  position_ += size;
+  return data;
+}
+
+std::uint64_t BinaryTreeReader::read_varint(void) {
+  // Varints are short, so fetch the longest possible one at once
+  // unless the stream is about to end.
+  fill(BinaryTreeFormat::MAX_VARINT_SIZE);
+  const unsigned char *data = buffer_.data() + position_;
+  const unsigned char *end = buffer_.data() + available_;
+  std::uint64_t value = 0;
+  for (int shift = 0; data != end && shift < 64; shift += 7) {
+    unsigned char byte = *data++;
+    value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      position_ = data - buffer_.data();
+      return value;
+    }
+  }
+  throw TreeCorruptError("Tree stream contains an invalid number.");
+}
+
+std::string_view BinaryTreeReader::read_text(void) {
+  size_t size = read_varint();
+  return std::string_view(
+      reinterpret_cast<const char *>(require(size)), size);
+}
+
+Supplier<BaseAttrNode>& BinaryTreeReader::read_type(void) {
+  auto ref = read_varint();
+  if (ref < types_.size()) {
+    return *types_[ref];
+  }
+  if (ref != types_.size()) {
+    throw TreeCorruptError("Tree stream refers to an undefined type.");
+  }
+  auto name = read_text();
+  auto found = suppliers_.find(name);
+  if (found == suppliers_.end()) {
+    throw TreeCorruptError(
+        "Tree stream contains unknown type " + std::string(name) + '.');
+  }
+  types_.push_back(found->second);
+  return *found->second;
+}
+
+const Attribute& BinaryTreeReader::read_attribute(void) {
+  auto ref = read_varint();
+  if (ref < attributes_.size()) {
+    return *attributes_[ref];
+  }
+  if (ref != attributes_.size()) {
+    throw TreeCorruptError("Tree stream refers to an undefined attribute.");
+  }
+  auto name = read_text();
+  auto found = attributes_by_name_.find(name);
+  if (found == attributes_by_name_.end()) {
+    throw TreeCorruptError(
+        "Tree stream contains unknown attribute " + std::string(name) + '.');
+  }
+  const Attribute& attribute = *found->second;
+  if (static_cast<unsigned char>(attribute.type()) != *require(1)) {
+    throw TreeCorruptError(
+        "Tree stream attribute " + attribute.name() + " has the wrong type.");
+  }
+  attributes_.push_back(&attribute);
+  return attribute;
+}
+
+void BinaryTreeReader::read_value(
+    const Attribute& attribute, BaseAttrNode& node) {
+  // The attribute's definition verified its type, so the casts are
+  // safe.
+  switch (attribute.type()) {
+  case AttributeType::STRING:
+    node.put(attribute, read_text());
+    break;
+  case AttributeType::INT64:
+    node.put(
+        static_cast<const TypedAttribute<std::int64_t>&>(attribute),
+        BinaryTreeFormat::unzigzag(read_varint()));
+    break;
+  case AttributeType::DOUBLE:
+    node.put(
+        static_cast<const TypedAttribute<double>&>(attribute),
+        BinaryTreeFormat::get_double(require(8)));
+    break;
+  case AttributeType::BOOL:
+    node.put(
+        static_cast<const TypedAttribute<bool>&>(attribute),
+        0 != *require(1));
+    break;
+  case AttributeType::INTERNED:
+    node.put(
+        static_cast<const TypedAttribute<InternedString>&>(attribute),
+        pool_.intern(read_text()));
+    break;
+  }
+}
+
+std::uint64_t BinaryTreeReader::read_node(
+    TreeBuilder<BaseAttrNode>& builder) {
+  builder.open(read_type());
+  BaseAttrNode& node = *builder.top();
+  for (auto count = read_varint(); count; --count) {
+    read_value(read_attribute(), node);
+  }
+  auto child_count = read_varint();
+  // A corrupt count must not exhaust memory; larger families grow as
+  // their children arrive.
+  builder.reserve(std::min<std::uint64_t>(child_count, 1 << 16));
+  return child_count;
+}
+
+std::shared_ptr<BaseAttrNode> BinaryTreeReader::read(NodeArena *arena) {
+  if (!started_) {
+    if (!fill(1)) {
+      return nullptr;
+    }
+    const unsigned char *header = require(sizeof(BinaryTreeFormat::MAGIC) + 1);
+    if (!std::equal(
+        std::begin(BinaryTreeFormat::MAGIC),
+        std::end(BinaryTreeFormat::MAGIC),
+        header)) {
+      throw TreeCorruptError("Stream does not contain binary trees.");
+    }
+    if (BinaryTreeFormat::VERSION != header[sizeof(BinaryTreeFormat::MAGIC)]) {
+      throw TreeCorruptError("Tree stream has an unsupported version.");
+    }
+    started_ = true;
+  }
+  if (!fill(1)) {
+    return nullptr;
+  }
+  // Counts of the children still to be read for each open node
+  std::vector<std::uint64_t> remaining;
+  TreeBuilder<BaseAttrNode> builder(arena);
+  remaining.push_back(read_node(builder));
+  while (true) {
+    while (!remaining.back()) {
+      builder.close();
+      remaining.pop_back();
+      if (remaining.empty()) {
+        return builder.finish();
+      }
+      --remaining.back();
+    }
+    remaining.push_back(read_node(builder));
+  }
+}
+
+} /* namespace VisitingParseTree */
@@ -0,0 +1,203 @@
+/*
+ * BinaryTreeReader.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file BinaryTreeReader.h
+ *
+ * @brief Reconstructs \c BaseAttrNode trees from the binary tree
+ *        format
+ */
+#ifndef BINARYTREEREADER_H_
+#define BINARYTREEREADER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Attribute.h"
+#include "AttributeValue.h"
+#include "BaseAttrNode.h"
+#include "InternPool.h"
+#include "NodeArena.h"
+#include "Supplier.h"
+#include "TreeBuilder.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Reads trees written by \c BinaryTreeWriter from a
+ *        \c std::istream
+ *
+ * The stream names node types and attributes, so the reader must be
+ * told which \c Supplier and \c Attribute each name denotes: register
+ * every type and attribute that the stream can contain with \c add()
+ * before reading. Nodes are created by their suppliers, optionally in
+ * an arena, and interned values are interned in the reader's pool.
+ *
+ * The reader consumes the stream in large blocks, so it may read past
+ * the end of the last tree it returns. Other code \b must \b not read
+ * from the stream while the reader is in use.
+ *
+ * \see BinaryTreeFormat for the encoding
+ */
+class BinaryTreeReader {
+  std::istream& in_;  /** Source */
+  InternPool& pool_;  /** Interns \c INTERNED values */
+  std::vector<unsigned char> buffer_;  /** Input read but not yet decoded */
+  size_t position_ = 0;  /** Next byte to decode */
+  size_t available_ = 0;  /** Bytes of \c buffer_ holding input */
+  bool started_ = false;  /** Whether the stream header has been read */
+
+  /*
+   * Registered types and attributes, by name.
+   */
+  std::unordered_map<std::string_view, Supplier<BaseAttrNode> *> suppliers_;
+  std::unordered_map<std::string_view, const Attribute *> attributes_by_name_;
+
+  /*
+   * Types and attributes defined by the stream, by reference.
+   */
+  std::vector<Supplier<BaseAttrNode> *> types_;
+  std::vector<const Attribute *> attributes_;
+
+  /**
+   * @brief Makes at least the specified number of bytes available
+   *        for decoding, unless the stream ends first
+   *
+   * The buffer grows as data arrives rather than up front, so a
+   * corrupt size cannot exhaust memory.
+   *
+   * @param size number of bytes required
+   * @return \c true if and only if \c size bytes are available
+   */
+  bool fill(size_t size);
+
+  /**
+   * @brief Like \c fill(), but a premature end of the stream is an
+   *        error
+   *
+   * @throws TreeCorruptError if the stream ends first
+   */
+  const unsigned char *require(size_t size);
+
+  std::uint64_t read_varint(void);
+
+  std::string_view read_text(void);
+
+  Supplier<BaseAttrNode>& read_type(void);
+
+  const Attribute& read_attribute(void);
+
+  /**
+   * @brief Decodes an attribute value and sets it in a node
+   */
+  void read_value(const Attribute& attribute, BaseAttrNode& node);
+
+  /**
+   * @brief Decodes a node, excluding its children, and opens it
+   *
+   * @param builder receives the node
+   * @return the number of children that follow
+   */
+  std::uint64_t read_node(TreeBuilder<BaseAttrNode>& builder);
+
+  std::shared_ptr<BaseAttrNode> read(NodeArena *arena);
+
+public:
+  /**
+   * Default buffer size, in bytes
+   */
+  static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+  /**
+   * @brief Creates a reader bound to an input stream
+   *
+   * @param in source, which must outlive the reader
+   * @param pool interns \c InternedString values, and must outlive the
+   *        trees that the reader returns
+   * @param buffer_size input buffer size, in bytes
+   */
+  BinaryTreeReader(
+      std::istream& in,
+      InternPool& pool = InternPool::global(),
+      size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+  BinaryTreeReader(const BinaryTreeReader&) = delete;
+  BinaryTreeReader& operator=(const BinaryTreeReader&) = delete;
+  ~BinaryTreeReader() = default;
+
+  /**
+   * @brief Registers a node type
+   *
+   * @param supplier the type's supplier, which is identified by its
+   *        \c class_name()
+   * @return \c *this, for chaining
+   */
+  BinaryTreeReader& add(Supplier<BaseAttrNode>& supplier);
+
+  /**
+   * @brief Registers an attribute
+   *
+   * @param attribute the attribute, which is identified by its
+   *        \c name()
+   * @return \c *this, for chaining
+   */
+  BinaryTreeReader& add(const Attribute& attribute);
+
+  /**
+   * @brief Reads the next tree
+   *
+   * @return the tree's root, or an empty pointer if the stream has
+   *         no more trees
+   *
+   * @throws TreeCorruptError if the stream is not in the binary tree
+   *         format, is truncated, names an unregistered type or
+   *         attribute, or defines an attribute whose value type
+   *         differs from the registered attribute's.
+   */
+  std::shared_ptr<BaseAttrNode> read(void) {
+    return read(nullptr);
+  }
+
+  /**
+   * @brief Reads the next tree into an arena
+   *
+   * As \c read(), but creates the nodes in \c arena.
+   *
+   * \see Supplier::allocate_shared()
+   *
+   * @param arena provides the nodes' storage
+   */
+  std::shared_ptr<BaseAttrNode> read(NodeArena& arena) {
+    return read(&arena);
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* BINARYTREEREADER_H_ */
@@ -0,0 +1,196 @@
+/*
+ * BinaryTreeWriter.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file BinaryTreeWriter.cpp
+ *
+ * Binary tree writer implementation
+ */
+
+#include "BinaryTreeWriter.h"
+
+#include <algorithm>
+#include <iterator>
+#include <variant>
+
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "InternedString.h"
+#include "VacuousVoidFunction.h"
+
+namespace VisitingParseTree {
+
+namespace {
+
+class ContinuingAction : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+/*
+ * Returns a table reference, adding an entry if necessary. Sets
+ * defined if the reference defines a new entry.
+ */
+std::uint32_t reference(
+    std::vector<std::uint32_t>& refs,
+    size_t id,
+    std::uint32_t& count,
+    bool& defined) {
+  if (refs.size() <= id) {
+    refs.resize(id + 1);
+  }
+  defined = !refs[id];
+  if (defined) {
+    refs[id] = ++count;
+  }
+  return refs[id] - 1;
+}
+
+}
+
+BinaryTreeWriter::BinaryTreeWriter(ByteSink& sink, size_t buffer_size) :
+    sink_(sink),
+    buffer_(std::max(buffer_size, 2 * LARGE_TEXT_SIZE)),
+    encoder_(*this) {
+}
+
+BinaryTreeWriter::BinaryTreeWriter(std::ostream& out, size_t buffer_size) :
+    stream_sink_(std::make_unique<StreamSink>(out)),
+    sink_(*stream_sink_),
+    buffer_(std::max(buffer_size, 2 * LARGE_TEXT_SIZE)),
+    encoder_(*this) {
+}
+
+void BinaryTreeWriter::seal(void) {
+  if (pending_start_ < used_) {
+    pending_.emplace_back(
+        buffer_.data() + pending_start_, used_ - pending_start_);
+    pending_start_ = used_;
+  }
+}
+
+void BinaryTreeWriter::flush(void) {
+  seal();
+  used_ = 0;
+  pending_start_ = 0;
+  // A failed write still discards the pending buffers, so that the
+  // writer remains usable.
+  try {
+    sink_.write(pending_);
+  } catch (...) {
+    pending_.clear();
+    throw;
+  }
+  pending_.clear();
+}
+
+void BinaryTreeWriter::write_text(std::string_view text) {
+  write_varint(text.size());
+  if (LARGE_TEXT_SIZE <= text.size()) {
+    seal();
+    pending_.emplace_back(
+        reinterpret_cast<const unsigned char *>(text.data()), text.size());
+    if (MAX_PENDING_BUFFERS <= pending_.size()) {
+      flush();
+    }
+    return;
+  }
+  std::copy(text.begin(), text.end(), reserve(text.size()));
+  used_ += text.size();
+}
+
+void BinaryTreeWriter::write_value(const AttributeValue& value) {
+  switch (value.index()) {
+  case 0:
+    write_text(std::get<std::string>(value));
+    break;
+  case 1:
+    write_varint(BinaryTreeFormat::zigzag(std::get<std::int64_t>(value)));
+    break;
+  case 2:
+    commit(BinaryTreeFormat::put_double(std::get<double>(value), reserve(8)));
+    break;
+  case 3:
+    *reserve(1) = std::get<bool>(value);
+    ++used_;
+    break;
+  default:
+    write_text(std::get<InternedString>(value).view());
+    break;
+  }
+}
+
+void BinaryTreeWriter::write_type(Supplier<BaseAttrNode>& supplier) {
+  bool defined;
+  write_varint(reference(type_refs_, supplier.id(), type_count_, defined));
+  if (defined) {
+    write_text(supplier.class_name());
+  }
+}
+
+void BinaryTreeWriter::write_attribute(const Attribute& attribute) {
+  bool defined;
+  write_varint(reference(
+      attribute_refs_, attribute.id(), attribute_count_, defined));
+  if (defined) {
+    write_text(attribute.name());
+    *reserve(1) = static_cast<unsigned char>(attribute.type());
+    ++used_;
+  }
+}
+
+void BinaryTreeWriter::write_node(BaseAttrNode *node) {
+  if (!started_) {
+    unsigned char *header = reserve(sizeof(BinaryTreeFormat::MAGIC) + 1);
+    header = std::copy(
+        std::begin(BinaryTreeFormat::MAGIC),
+        std::end(BinaryTreeFormat::MAGIC),
+        header);
+    *header++ = BinaryTreeFormat::VERSION;
+    commit(header);
+    started_ = true;
+  }
+  write_type(node->supplier());
+  const AttributeMap& attributes = node->attribute_map();
+  write_varint(attributes.size());
+  for (const auto& entry : attributes) {
+    write_attribute(*entry.attribute);
+    write_value(entry.value);
+  }
+  write_varint(node->child_count());
+}
+
+void BinaryTreeWriter::write(BaseAttrNode *root) {
+  ContinuingAction on_exit;
+  BorrowingTraversal<BaseAttrNode> traversal(
+      encoder_,
+      on_exit,
+      VacuousVoidFunction::INSTANCE,
+      VacuousVoidFunction::INSTANCE);
+  traversal(root);
+  flush();
+}
+
+} /* namespace VisitingParseTree */
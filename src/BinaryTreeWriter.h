@@ -0,0 +1,251 @@
+/*
+ * BinaryTreeWriter.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file BinaryTreeWriter.h
+ *
+ * @brief Writes \c BaseAttrNode trees in the binary tree format
+ */
+#ifndef BINARYTREEWRITER_H_
+#define BINARYTREEWRITER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Attribute.h"
+#include "AttributeValue.h"
+#include "BaseAttrNode.h"
+#include "BinaryTreeFormat.h"
+#include "BorrowedNodeAction.h"
+#include "ByteSink.h"
+#include "NodeAction.h"
+#include "StreamSink.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Streams trees to a \c ByteSink in the binary tree format
+ *
+ * The writer encodes nodes into a fixed-size buffer and hands the
+ * buffer to the sink when it fills and when a tree is complete, so
+ * the per-node cost is a few table lookups and byte stores, and
+ * memory use does not grow with the tree. Strings of
+ * \c LARGE_TEXT_SIZE bytes or more are not copied: the sink writes
+ * them from the nodes that hold them, between the buffered bytes
+ * around them. Type and attribute names are written once per writer,
+ * the first time they occur, so a stream of many trees pays for each
+ * name once. \c BinaryTreeReader reconstructs the trees.
+ *
+ * The format records each node's child count ahead of its children,
+ * so encoding a node needs nothing but the node. \c write() traverses
+ * a tree and encodes each node on entry. To serialize a tree during a
+ * traversal made for another purpose, bind \c on_entry() as, or call
+ * it from, the traversal's entry action, have the traversal enter
+ * every node of the tree exactly once, in order, and \c flush() the
+ * writer afterward. Nodes \b must \b not change or be released
+ * until the writer has been flushed, as the sink may refer to their
+ * strings.
+ *
+ * \see BinaryTreeFormat for the encoding
+ */
+class BinaryTreeWriter {
+public:
+  /**
+   * Strings of this size or larger are written in place.
+   */
+  static constexpr size_t LARGE_TEXT_SIZE = 1024;
+
+  /**
+   * Default buffer size, in bytes
+   */
+  static constexpr size_t DEFAULT_BUFFER_SIZE = 256 * 1024;
+
+  /**
+   * @brief Encodes every node to which it is applied
+   *
+   * Usable as the entry action of a \c Traversal, a
+   * \c BorrowingTraversal, or a traversal built on either.
+   */
+  class Encoder :
+      public NodeAction<BaseAttrNode>,
+      public BorrowedNodeAction<BaseAttrNode> {
+    BinaryTreeWriter& writer_;
+
+  public:
+    Encoder(BinaryTreeWriter& writer) :
+        writer_(writer) {
+    }
+
+    virtual TraversalStatus operator()(
+        std::shared_ptr<BaseAttrNode> node) override {
+      writer_.write_node(node.get());
+      return TraversalStatus::CONTINUE;
+    }
+
+    virtual TraversalStatus operator()(BaseAttrNode *node) override {
+      writer_.write_node(node);
+      return TraversalStatus::CONTINUE;
+    }
+  };
+
+private:
+  /**
+   * Flushes once this many buffers are pending, bounding their number
+   */
+  static constexpr size_t MAX_PENDING_BUFFERS = 256;
+
+  std::unique_ptr<StreamSink> stream_sink_;  /** Owned sink, if any */
+  ByteSink& sink_;  /** Destination */
+  std::vector<unsigned char> buffer_;  /** Encoded bytes */
+  size_t used_ = 0;  /** Bytes of \c buffer_ in use */
+  size_t pending_start_ = 0;  /** Start of the bytes not yet in \c pending_ */
+  std::vector<std::span<const unsigned char>> pending_;  /** Buffers to write */
+  bool started_ = false;  /** Whether the stream header has been written */
+  Encoder encoder_;
+
+  /*
+   * Table indices by supplier and attribute identifier, plus 1, or
+   * 0 for types and attributes not yet defined.
+   */
+  std::vector<std::uint32_t> type_refs_;
+  std::vector<std::uint32_t> attribute_refs_;
+  std::uint32_t type_count_ = 0;  /** Defined types */
+  std::uint32_t attribute_count_ = 0;  /** Defined attributes */
+
+  /**
+   * @brief Ensures room for the specified number of bytes, flushing
+   *        the buffer if necessary
+   *
+   * @param size number of bytes required, at most \c LARGE_TEXT_SIZE
+   * @return where to store them
+   */
+  unsigned char *reserve(size_t size) {
+    if (buffer_.size() < used_ + size) {
+      flush();
+    }
+    return buffer_.data() + used_;
+  }
+
+  void commit(unsigned char *end) {
+    used_ = end - buffer_.data();
+  }
+
+  void write_varint(std::uint64_t value) {
+    commit(BinaryTreeFormat::put_varint(
+        value, reserve(BinaryTreeFormat::MAX_VARINT_SIZE)));
+  }
+
+  /**
+   * @brief Moves the buffered bytes that are not yet pending to the
+   *        pending buffers
+   */
+  void seal(void);
+
+  void write_text(std::string_view text);
+
+  void write_value(const AttributeValue& value);
+
+  void write_type(Supplier<BaseAttrNode>& supplier);
+
+  void write_attribute(const Attribute& attribute);
+
+  /**
+   * @brief Encodes a node, excluding its children
+   */
+  void write_node(BaseAttrNode *node);
+
+public:
+  /**
+   * @brief Creates a writer bound to a sink
+   *
+   * Nothing is written until the first tree.
+   *
+   * @param sink destination, which must outlive the writer
+   * @param buffer_size output buffer size, in bytes
+   */
+  BinaryTreeWriter(
+      ByteSink& sink,
+      size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+  /**
+   * @brief Creates a writer bound to an output stream
+   *
+   * @param out destination, which must outlive the writer
+   * @param buffer_size output buffer size, in bytes
+   */
+  BinaryTreeWriter(
+      std::ostream& out,
+      size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+  BinaryTreeWriter(const BinaryTreeWriter&) = delete;
+  BinaryTreeWriter& operator=(const BinaryTreeWriter&) = delete;
+  ~BinaryTreeWriter() = default;
+
+  /**
+   * @brief Writes a tree
+   *
+   * Every byte of the tree reaches the sink before this method
+   * returns, so trees can be written and read back one at a time.
+   *
+   * @param root the root of the tree to write, which can be any node
+   *        in a containing tree. Must not be \c NULL.
+   *
+   * @throws IllegalOperation if the sink fails
+   */
+  void write(BaseAttrNode *root);
+
+  /**
+   * @brief Writes a tree
+   *
+   * Convenience overload for callers that own the root.
+   *
+   * @param root the root of the tree to write. Must not be empty.
+   */
+  void write(const std::shared_ptr<BaseAttrNode>& root) {
+    write(root.get());
+  }
+
+  /**
+   * @return the entry action that encodes nodes, for callers that
+   *         drive their own traversal
+   */
+  Encoder& on_entry(void) {
+    return encoder_;
+  }
+
+  /**
+   * @brief Hands everything encoded so far to the sink
+   *
+   * @throws IllegalOperation if the sink fails
+   */
+  void flush(void);
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* BINARYTREEWRITER_H_ */
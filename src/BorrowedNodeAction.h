@@ -0,0 +1,75 @@
+/*
+ * BorrowedNodeAction.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file BorrowedNodeAction.h
+ *
+ * API for acting on a borrowed \c Node
+ */
+#ifndef BORROWEDNODEACTION_H_
+#define BORROWEDNODEACTION_H_
+
+#include "TraversalStatus.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Base class for actions that are applied to borrowed nodes
+ *
+ * The borrowing counterpart of \c NodeAction. Actions receive a plain
+ * pointer to the node instead of a \c std::shared_ptr, so applying
+ * them does not touch the node's reference count. This makes them
+ * well suited to read-only passes over large trees, especially trees
+ * that several threads traverse at once.
+ *
+ * The node is borrowed from its tree, which owns it. Implementations
+ * \b must \b not retain the pointer beyond the call, and \b must \b not
+ * detach, excise, or otherwise release any node in the tree being
+ * traversed. Actions that need ownership should use \c NodeAction.
+ *
+ * @tparam T node type.
+ *
+ * \see Node for restrictions on \c T
+ * \see BorrowingTraversal for main use case
+ */
+template <typename T> class BorrowedNodeAction {
+protected:
+  BorrowedNodeAction(void) = default;
+
+public:
+  virtual ~BorrowedNodeAction() = default;
+
+  /**
+   * Apply implementation's logic to the specified \c node.
+   *
+   * @param node \c Node (or subclass thereof) to process. Never \c NULL.
+   * @return \c TraversalStatus that governs the containing traversal.
+   *
+   * @see TraversalStatus for traversal control details
+   */
+  virtual TraversalStatus operator()(T *node) = 0;
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* BORROWEDNODEACTION_H_ */
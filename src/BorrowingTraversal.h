@@ -0,0 +1,116 @@
+/*
+ * BorrowingTraversal.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file BorrowingTraversal.h
+ *
+ * @brief Depth-first in-order tree traversal that borrows nodes
+ *        instead of sharing their ownership
+ */
+#ifndef SRC_BORROWINGTRAVERSAL_H_
+#define SRC_BORROWINGTRAVERSAL_H_
+
+#include <memory>
+
+#include "BorrowedNodeAction.h"
+#include "TraversalEngine.h"
+#include "TraversalStatus.h"
+#include "VoidFunction.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Depth-first in-order tree traversal that does not touch node
+ *        reference counts
+ *
+ * Behaves exactly like \c Traversal, invoking the same actions in the
+ * same order with the same \c TraversalStatus semantics, but refers
+ * to nodes by plain pointer and applies \c BorrowedNodeAction
+ * instances. A \c Traversal copies a \c std::shared_ptr for every node
+ * it visits, which costs a pair of atomic reference count updates per
+ * node and, when several threads traverse the same tree, contention
+ * for the cache lines holding the counts. A \c BorrowingTraversal
+ * costs neither.
+ *
+ * In exchange, the tree must remain intact for the duration of the
+ * traversal: actions \b must \b not detach, excise, or otherwise
+ * release nodes in the traversed tree.
+ *
+ * @tparam T node type being traversed. All traversed nodes must inherit
+ *         this class directly or indirectly
+ */
+template <typename T> class BorrowingTraversal : public BorrowedNodeAction<T> {
+  TraversalEngine<T, T*, BorrowedNodeAction<T>> engine_;
+
+public:
+
+  /**
+   * Creates a \c BorrowingTraversal bound to the specified actions
+   *
+   * @param on_entry applied to a newly entered node
+   * @param on_exit applied after traversing a node's children
+   * @param after_descent invoked between node entry application and
+   *        traversing the node's children. Not invoked on leaf nodes.
+   * @param before_ascent applied after processing a node's children and
+   *        before invoking the exit action on the parent node. Not
+   *        invoked on leaf nodes.
+   */
+  BorrowingTraversal(
+      BorrowedNodeAction<T>& on_entry,
+      BorrowedNodeAction<T>& on_exit,
+      VoidFunction& after_descent,
+      VoidFunction& before_ascent) :
+          engine_(on_entry, on_exit, after_descent, before_ascent) {
+  }
+
+  virtual ~BorrowingTraversal() = default;
+
+  /**
+   * @brief Processes the specified node and its descendants
+   *
+   * @param node traversal starting point, which can be any node in a
+   *        tree. Must not be \c NULL.
+   * @return status that governs the traversal
+   *
+   * \see TraversalStatus for return value semantics
+   */
+  virtual TraversalStatus operator() (T *node) override {
+    return engine_(node);
+  }
+
+  /**
+   * @brief Processes the specified node and its descendants
+   *
+   * Convenience overload for callers that own the starting node.
+   *
+   * @param node traversal starting point. Must not be empty.
+   * @return status that governs the traversal
+   */
+  TraversalStatus operator() (const std::shared_ptr<T>& node) {
+    return engine_(node.get());
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* SRC_BORROWINGTRAVERSAL_H_ */
@@ -0,0 +1,118 @@
+/*
+ * BorrowingVisitingTraversal.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+/**
+ * @file BorrowingVisitingTraversal.h
+ *
+ * A tree traversal that applies visitors to encountered nodes without
+ * sharing their ownership
+ */
+
+#ifndef SRC_BORROWINGVISITINGTRAVERSAL_H_
+#define SRC_BORROWINGVISITINGTRAVERSAL_H_
+
+#include "BorrowingTraversal.h"
+#include "VisitingAction.h"
+#include "VacuousVoidFunction.h"
+#include "Visitor.h"
+#include "VoidFunction.h"
+
+#include <memory>
+
+namespace VisitingParseTree {
+
+/**
+ * @brief traverses a tree of \c Host<T> applying entry and exit
+ *        visitors to all encountered nodes
+ *
+ * Visitors receive plain node pointers, so unlike
+ * \c VisitingTraversal, this traversal borrows nodes rather than
+ * sharing their ownership, and does not update reference counts as it
+ * goes. Visitors \b must \b not release nodes in the tree being
+ * traversed.
+ *
+ * @tparam T node class, which must inherit \c Host<T>
+ */
+template <typename T> class BorrowingVisitingTraversal {
+  VisitingAction<T> on_entry_;
+  VisitingAction<T> on_exit_;
+
+  BorrowingTraversal<T> traversal_;
+
+public:
+
+  /**
+   * Constructor
+   *
+   * @param on_entry \c Visitor to apply on node entry. Does nothing
+   *                 if \c NULL.
+   * @param on_exit \c Visitor to apply on node exit. Does nothing if
+   *                \c NULL.
+   * @param before_descent action to take after applying the entry visitor
+   *                       and before processing the first child.
+   * @param after_ascent action to take between processing a node's last
+   *                     and applying the exit visitor.
+   */
+  BorrowingVisitingTraversal(
+      Visitor *on_entry,
+      Visitor *on_exit,
+      VoidFunction& before_descent = VacuousVoidFunction::INSTANCE,
+      VoidFunction& after_ascent = VacuousVoidFunction::INSTANCE) :
+          on_entry_(on_entry),
+          on_exit_(on_exit),
+          traversal_(
+              on_entry_,
+              on_exit_,
+              before_descent,
+              after_ascent) {
+  }
+
+  virtual ~BorrowingVisitingTraversal() = default;
+
+  /**
+   * @brief traverses a tree
+   *
+   * @param root start of the traversal; root of the traversed tree.
+   *             Note that a traversal can start at any node; the
+   *             starting node could be an interior node of a containing
+   *             tree.
+   *
+   * @return traversal status
+   */
+  virtual TraversalStatus operator() (T *root) {
+    return traversal_(root);
+  }
+
+  /**
+   * @brief traverses a tree
+   *
+   * As above, but accepts a shared root, which the caller continues
+   * to own.
+   */
+  TraversalStatus operator() (const std::shared_ptr<T>& root) {
+    return (*this)(root.get());
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* SRC_BORROWINGVISITINGTRAVERSAL_H_ */
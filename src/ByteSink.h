@@ -0,0 +1,69 @@
+/*
+ * ByteSink.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ByteSink.h
+ *
+ * @brief Destination for serialized bytes
+ */
+#ifndef BYTESINK_H_
+#define BYTESINK_H_
+
+#include <span>
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Base class for destinations of serialized trees
+ *
+ * Serializers hand a sink several buffers at once, in the spirit of
+ * \c writev(), so that large values can be written from where they
+ * lie instead of being copied into the serializer's buffer first.
+ *
+ * \see StreamSink
+ * \see FileSink
+ */
+class ByteSink {
+protected:
+  ByteSink(void) = default;
+
+public:
+  ByteSink(const ByteSink&) = delete;
+  ByteSink& operator=(const ByteSink&) = delete;
+  virtual ~ByteSink() = default;
+
+  /**
+   * @brief Writes buffers, in order
+   *
+   * @param buffers the buffers to write, which are no longer needed
+   *        once this method returns
+   *
+   * @throws IllegalOperation if the bytes cannot be written
+   */
+  virtual void write(
+      std::span<const std::span<const unsigned char>> buffers) = 0;
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* BYTESINK_H_ */
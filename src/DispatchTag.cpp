@@ -0,0 +1,67 @@
+/*
+ * DispatchTag.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file DispatchTag.cpp
+ *
+ * Dispatch tag implementation
+ */
+
+#include "DispatchTag.h"
+
+namespace VisitingParseTree {
+
+std::atomic<size_t> BaseDispatchTag::next_id(0);
+
+BaseDispatchTag::BaseDispatchTag(
+    const BaseDispatchTag *superclass_tag,
+    void *(*cast)(Visitor *visitor)) :
+        id_(next_id++),
+        superclass_tag_(superclass_tag),
+        cast_(cast) {
+}
+
+BaseDispatchTag::Resolution BaseDispatchTag::resolve(Visitor *visitor) const {
+  auto& entry = visitor->dispatch_entry(id_);
+  Resolution resolution{entry.handler.load(std::memory_order_acquire)};
+  if (resolution.tag) {
+    resolution.concrete_visitor =
+        entry.concrete_visitor.load(std::memory_order_relaxed);
+    return resolution;
+  }
+  if (void *concrete_visitor = cast_(visitor)) {
+    resolution = Resolution{this, concrete_visitor};
+  } else if (superclass_tag_) {
+    resolution = superclass_tag_->resolve(visitor);
+  } else {
+    resolution = Resolution{this, nullptr};
+  }
+  // Racing threads store identical values, so the last store wins
+  // harmlessly.
+  entry.concrete_visitor.store(
+      resolution.concrete_visitor, std::memory_order_relaxed);
+  entry.handler.store(resolution.tag, std::memory_order_release);
+  return resolution;
+}
+
+} /* namespace VisitingParseTree */
@@ -0,0 +1,235 @@
+/*
+ * DispatchTag.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file DispatchTag.h
+ *
+ * @brief Constant time visitor dispatch
+ *
+ * Every node class in a visitable hierarchy owns a static
+ * \c DispatchTag that identifies the class, its superclass, and its
+ * visitor interface. \c accept() hands the visitor to the tag, which
+ * finds the visitor's handler in a per-visitor table instead of
+ * attempting a \c dynamic_cast at each level of the hierarchy.
+ */
+
+#ifndef DISPATCHTAG_H_
+#define DISPATCHTAG_H_
+
+#include <atomic>
+#include <cstddef>
+
+#include "TraversalStatus.h"
+#include "Visitor.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Type-independent dispatch tag logic
+ *
+ * Assigns each tag a small, dense integer identifier that indexes
+ * the dispatch table in every \c Visitor, and resolves table entries
+ * on first use.
+ */
+class BaseDispatchTag {
+  static std::atomic<size_t> next_id;  /** Next identifier to assign */
+
+  const size_t id_;  /** Table index */
+  const BaseDispatchTag *superclass_tag_;  /** NULL for hierarchy roots */
+
+  /**
+   * Casts a visitor to the tag's visitor interface, returning \c NULL
+   * if the visitor does not implement the interface.
+   */
+  void *(*cast_)(Visitor *visitor);
+
+protected:
+  /**
+   * @brief Constructor
+   *
+   * @param superclass_tag the tag belonging to the node class's
+   *        immediate superclass, or \c NULL if the class is the root
+   *        of its hierarchy.
+   * @param cast casts a \c Visitor to the node class's visitor interface
+   */
+  BaseDispatchTag(
+      const BaseDispatchTag *superclass_tag,
+      void *(*cast)(Visitor *visitor));
+
+  /**
+   * @brief A visitor's handler for a node class
+   */
+  struct Resolution {
+    /**
+     * The nearest handling tag, or the hierarchy root's tag if the
+     * visitor handles no class in the chain
+     */
+    const BaseDispatchTag *tag = nullptr;
+    /** Visitor cast to \c tag's interface, or NULL if unhandled */
+    void *concrete_visitor = nullptr;
+  };
+
+  /**
+   * @brief Finds the handler for this tag's node class in the
+   *        specified visitor
+   *
+   * The handler is the one belonging to the nearest class, starting
+   * from this tag's class and moving toward the hierarchy root, whose
+   * visitor interface the visitor implements. The search runs once
+   * per visitor and tag; its result is cached in the visitor. Threads
+   * may resolve concurrently.
+   *
+   * @param visitor the visitor to search. Must not be \c NULL.
+   * @return the handler, whose \c concrete_visitor is \c NULL if the
+   *         visitor does not handle the class
+   */
+  Resolution resolve(Visitor *visitor) const;
+
+public:
+  BaseDispatchTag(const BaseDispatchTag &other) = delete;
+  BaseDispatchTag(BaseDispatchTag &&other) = delete;
+  BaseDispatchTag& operator=(const BaseDispatchTag &other) = delete;
+  BaseDispatchTag& operator=(BaseDispatchTag &&other) = delete;
+
+  virtual ~BaseDispatchTag() = default;
+
+  /**
+   * @return the number of tags created so far, which bounds the
+   *         tag identifiers.
+   */
+  static size_t count(void) {
+    return next_id.load();
+  }
+
+  /**
+   * @return this tag's identifier
+   */
+  size_t id(void) const {
+    return id_;
+  }
+};
+
+/**
+ * @brief Dispatch tag for a node class in the hierarchy rooted at \c T
+ *
+ * Node classes declare a tag as a static member named \c DISPATCH_TAG,
+ * create it with \c make(), and implement \c accept() as follows:
+ *
+ *     VisitingParseTree::DispatchTag<BaseAttrNode> FooNode::DISPATCH_TAG =
+ *         VisitingParseTree::DispatchTag<BaseAttrNode>::make<
+ *             FooNode,
+ *             FooNodeVisitor,
+ *             &FooNodeVisitor::processFooNode>(&BarNode::DISPATCH_TAG);
+ *
+ *     VisitingParseTree::TraversalStatus FooNode::accept(
+ *         VisitingParseTree::Visitor *visitor) {
+ *       return DISPATCH_TAG.dispatch(visitor, this);
+ *     }
+ *
+ * where \c BarNode is \c FooNode's immediate superclass.
+ *
+ * @tparam T hierarchy root
+ */
+template <typename T> class DispatchTag : public BaseDispatchTag {
+  /**
+   * Passes a host to a visitor that implements this tag's visitor
+   * interface.
+   */
+  TraversalStatus (*process_)(void *concrete_visitor, T *host);
+
+  DispatchTag(
+      const DispatchTag *superclass_tag,
+      void *(*cast)(Visitor *visitor),
+      TraversalStatus (*process)(void *concrete_visitor, T *host)) :
+        BaseDispatchTag(superclass_tag, cast),
+        process_(process) {
+  }
+
+public:
+  virtual ~DispatchTag() = default;
+
+  /**
+   * @brief Creates the dispatch tag for a node class
+   *
+   * @tparam Host the node class
+   * @tparam HostVisitor the node class's visitor interface
+   * @tparam process the visitor interface's processing method
+   *
+   * @param superclass_tag the tag of \c Host's immediate superclass,
+   *        or \c NULL if \c Host is \c T
+   *
+   * @return the newly created tag
+   */
+  template <
+      typename Host,
+      typename HostVisitor,
+      TraversalStatus (HostVisitor::*process)(Host *host)>
+  static DispatchTag make(const DispatchTag *superclass_tag) {
+    return DispatchTag(
+        superclass_tag,
+        [](Visitor *visitor) -> void * {
+          return dynamic_cast<HostVisitor *>(visitor);
+        },
+        [](void *concrete_visitor, T *host) {
+          return (static_cast<HostVisitor *>(concrete_visitor)->*process)(
+              static_cast<Host *>(host));
+        });
+  }
+
+  /**
+   * @brief Applies a visitor to a host
+   *
+   * Invokes the processing method of the nearest visitor interface
+   * that \c visitor implements, starting at \c host's class and
+   * proceeding toward the hierarchy root. This has the same effect
+   * as attempting a \c dynamic_cast at each level, but takes constant
+   * time once the visitor has encountered the host's class.
+   *
+   * @param visitor the visitor to apply. Does nothing if \c NULL.
+   * @param host the node to visit, whose class \b must own this tag
+   *
+   * @return the handler's result, or \c TraversalStatus::CONTINUE if
+   *         the visitor does not handle the host
+   */
+  TraversalStatus dispatch(Visitor *visitor, T *host) const {
+    if (!visitor) {
+      return TraversalStatus::CONTINUE;
+    }
+    Resolution handler;
+    auto& entry = visitor->dispatch_entry(id());
+    if ((handler.tag = entry.handler.load(std::memory_order_acquire))) {
+      handler.concrete_visitor =
+          entry.concrete_visitor.load(std::memory_order_relaxed);
+    } else {
+      handler = resolve(visitor);
+    }
+    return handler.concrete_visitor
+        ? static_cast<const DispatchTag *>(handler.tag)->process_(
+            handler.concrete_visitor, host)
+        : TraversalStatus::CONTINUE;
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* DISPATCHTAG_H_ */
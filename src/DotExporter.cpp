@@ -0,0 +1,137 @@
+/*
+ * DotExporter.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "DotExporter.h"
+
+#include <variant>
+
+#include "InternedString.h"
+
+namespace VisitingParseTree {
+
+void DotExporter::append_id(std::uint64_t id) {
+  append('n');
+  append_number(id);
+}
+
+void DotExporter::append_label(std::string_view text) {
+  size_t run = 0;
+  for (size_t i = 0; i < text.size(); ++i) {
+    unsigned char c = text[i];
+    if (c >= 0x20 && c != '"' && c != '\\') {
+      continue;
+    }
+    append(text.substr(run, i - run));
+    run = i + 1;
+    switch (c) {
+    case '"':
+      append("\\\"");
+      break;
+    case '\\':
+      append("\\\\");
+      break;
+    case '\n':
+      append("\\n");
+      break;
+    default:
+      append(' ');
+      break;
+    }
+  }
+  append(text.substr(run));
+}
+
+void DotExporter::append_value(const AttributeValue& value) {
+  switch (value.index()) {
+  case 0:
+    append_label(std::get<std::string>(value));
+    break;
+  case 1:
+    append_number(std::get<std::int64_t>(value));
+    break;
+  case 2:
+    append_number(std::get<double>(value));
+    break;
+  case 3:
+    append(std::get<bool>(value) ? "true" : "false");
+    break;
+  default:
+    append_label(std::get<InternedString>(value).view());
+    break;
+  }
+}
+
+void DotExporter::append_edge(std::uint64_t from, std::uint64_t to) {
+  append("  ");
+  append_id(from);
+  append(" -> ");
+  append_id(to);
+  append(";\n");
+}
+
+void DotExporter::begin_tree(void) {
+  next_id_ = 0;
+  parents_.clear();
+  append("digraph tree {\n  node [shape=box];\n");
+}
+
+void DotExporter::enter(BaseAttrNode& node, size_t elided) {
+  entered_ = next_id_++;
+  append("  ");
+  append_id(entered_);
+  append(" [label=\"");
+  append_label(node.type_name());
+  for (const auto& entry : node.attribute_map()) {
+    append("\\n");
+    append_label(entry.attribute->name());
+    append('=');
+    append_value(entry.value);
+  }
+  append("\"];\n");
+  if (!parents_.empty()) {
+    append_edge(parents_.back(), entered_);
+  }
+  if (elided) {
+    std::uint64_t more = next_id_++;
+    append("  ");
+    append_id(more);
+    append(" [label=\"... (");
+    append_number(std::uint64_t(elided));
+    append(" more)\", shape=plaintext];\n");
+    append_edge(entered_, more);
+  }
+}
+
+void DotExporter::descend(void) {
+  parents_.push_back(entered_);
+}
+
+void DotExporter::ascend(void) {
+  parents_.pop_back();
+}
+
+void DotExporter::end_tree(void) {
+  append("}\n");
+}
+
+} /* namespace VisitingParseTree */
@@ -0,0 +1,95 @@
+/*
+ * DotExporter.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file DotExporter.h
+ *
+ * @brief Exports \c BaseAttrNode trees in the Graphviz DOT language
+ */
+#ifndef DOTEXPORTER_H_
+#define DOTEXPORTER_H_
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "AttributeValue.h"
+#include "TreeExporter.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Streams trees as Graphviz \c digraph documents
+ *
+ * Nodes are named \c n0, \c n1, ... in preorder, and each is labeled
+ * with its type followed by one \c NAME=value line per attribute.
+ * Every node but the root is followed by the edge from its parent.
+ * When a node's children fall below the depth limit, a single
+ * plain-text node that counts them stands in for them.
+ */
+class DotExporter : public TreeExporter {
+  std::uint64_t next_id_ = 0;  /** Name of the next node */
+  std::uint64_t entered_ = 0;  /** Name of the last entered node */
+  std::vector<std::uint64_t> parents_;  /** Names of the open ancestors */
+
+  /**
+   * @brief Appends a node name
+   */
+  void append_id(std::uint64_t id);
+
+  /**
+   * @brief Appends text escaped for a quoted DOT label
+   */
+  void append_label(std::string_view text);
+
+  void append_value(const AttributeValue& value);
+
+  void append_edge(std::uint64_t from, std::uint64_t to);
+
+protected:
+  virtual void begin_tree(void) override;
+  virtual void enter(BaseAttrNode& node, size_t elided) override;
+  virtual void descend(void) override;
+  virtual void ascend(void) override;
+  virtual void end_tree(void) override;
+
+public:
+  /**
+   * @param sink destination, which must outlive the exporter
+   */
+  DotExporter(ByteSink& sink) :
+      TreeExporter(sink) {
+  }
+
+  /**
+   * @param out destination, which must outlive the exporter
+   */
+  DotExporter(std::ostream& out) :
+      TreeExporter(out) {
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* DOTEXPORTER_H_ */
@@ -0,0 +1,90 @@
+/*
+ * FileSink.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file FileSink.cpp
+ *
+ * File descriptor sink implementation
+ */
+
+#include "FileSink.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+
+#include "IllegalOperation.h"
+
+namespace VisitingParseTree {
+
+FileSink::FileSink(const std::string& path) :
+    descriptor_(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666)),
+    owned_(true) {
+  if (descriptor_ < 0) {
+    throw IllegalOperation("Cannot open " + path + " for writing.");
+  }
+}
+
+FileSink::~FileSink() {
+  if (owned_) {
+    ::close(descriptor_);
+  }
+}
+
+void FileSink::write(
+    std::span<const std::span<const unsigned char>> buffers) {
+  vectors_.clear();
+  for (const auto& buffer : buffers) {
+    if (!buffer.empty()) {
+      vectors_.push_back(iovec{
+          const_cast<unsigned char *>(buffer.data()), buffer.size()});
+    }
+  }
+  iovec *next = vectors_.data();
+  iovec *end = next + vectors_.size();
+  while (next != end) {
+    int count = static_cast<int>(std::min<ptrdiff_t>(end - next, IOV_MAX));
+    ssize_t written = ::writev(descriptor_, next, count);
+    if (written < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      throw IllegalOperation("Cannot write: file write failed.");
+    }
+    // Skip the buffers written in full, and trim a partial one.
+    size_t remaining = written;
+    while (next != end && next->iov_len <= remaining) {
+      remaining -= next->iov_len;
+      ++next;
+    }
+    if (next != end) {
+      next->iov_base = static_cast<unsigned char *>(next->iov_base) + remaining;
+      next->iov_len -= remaining;
+    }
+  }
+}
+
+} /* namespace VisitingParseTree */
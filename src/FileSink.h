@@ -0,0 +1,86 @@
+/*
+ * FileSink.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file FileSink.h
+ *
+ * @brief Writes serialized bytes to a file with gathering writes
+ */
+#ifndef FILESINK_H_
+#define FILESINK_H_
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include <sys/uio.h>
+
+#include "ByteSink.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief A \c ByteSink that writes to a POSIX file descriptor
+ *
+ * Hands every batch of buffers to the kernel with \c writev(), so a
+ * serializer's buffer and the large values it refers to reach the
+ * file in a single system call, without an intermediate copy.
+ */
+class FileSink : public ByteSink {
+  int descriptor_;  /** Destination */
+  bool owned_;  /** Whether the sink closes the descriptor */
+  std::vector<iovec> vectors_;  /** Reused \c writev() argument */
+
+public:
+  /**
+   * @brief Creates a sink that writes to an open file descriptor
+   *
+   * @param descriptor destination, which the caller closes after
+   *        the sink is destroyed
+   */
+  explicit FileSink(int descriptor) :
+      descriptor_(descriptor),
+      owned_(false) {
+  }
+
+  /**
+   * @brief Creates or truncates a file and opens a sink on it
+   *
+   * @param path the file's path
+   *
+   * @throws IllegalOperation if the file cannot be opened
+   */
+  explicit FileSink(const std::string& path);
+
+  /**
+   * @brief Closes the file if the sink opened it
+   */
+  virtual ~FileSink();
+
+  virtual void write(
+      std::span<const std::span<const unsigned char>> buffers) override;
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* FILESINK_H_ */
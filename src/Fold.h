@@ -0,0 +1,201 @@
+/*
+ * Fold.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file Fold.h
+ *
+ * @brief Bottom-up computation of a value for every node in a tree
+ */
+#ifndef FOLD_H_
+#define FOLD_H_
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "FoldFunction.h"
+#include "TraversalStatus.h"
+#include "VacuousVoidFunction.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Computes a value for every node in a tree from the values
+ *        of its children
+ *
+ * The fold replaces hand-rolled exit actions that store intermediate
+ * results in side tables. It stores the values in a dense vector
+ * indexed by the nodes' preorder positions, the order in which a
+ * \c Traversal enters them, so the value of the fold's starting node
+ * is always at index 0. The positions match those of a
+ * \c FrozenTree of the same tree.
+ *
+ * While it runs, the fold keeps the values of the children of the
+ * nodes on the current path on a stack, so each node's child values
+ * are contiguous when its function runs. Every value is copied once,
+ * from the stack into the result.
+ *
+ * Like \c BorrowingTraversal, the fold borrows nodes, and the
+ * function \b must \b not detach or otherwise release nodes in the
+ * tree.
+ *
+ * @tparam T node type being folded, which must inherit \c Node<T>
+ * @tparam R value type, which must be default constructible and
+ *         copyable
+ *
+ * \see ParallelFold for a fold that processes subtrees concurrently
+ */
+template <typename T, typename R> class Fold {
+  /**
+   * @brief A node on the current path
+   */
+  struct Frame {
+    size_t index;  /** The node's position in the result */
+    size_t first_child;  /** Position of its first child's value on the stack */
+  };
+
+  class EntryAction : public BorrowedNodeAction<T> {
+    Fold& fold_;
+
+  public:
+    EntryAction(Fold& fold) :
+        fold_(fold) {
+    }
+
+    virtual TraversalStatus operator()(T *node) override {
+      fold_.frames_.push_back(
+          Frame{fold_.results_->size(), fold_.stack_.size()});
+      fold_.results_->emplace_back();
+      return TraversalStatus::CONTINUE;
+    }
+  };
+
+  class ExitAction : public BorrowedNodeAction<T> {
+    Fold& fold_;
+
+  public:
+    ExitAction(Fold& fold) :
+        fold_(fold) {
+    }
+
+    virtual TraversalStatus operator()(T *node) override {
+      Frame frame = fold_.frames_.back();
+      fold_.frames_.pop_back();
+      auto& stack = fold_.stack_;
+      R value = fold_.function_(
+          node,
+          std::span<const R>(
+              stack.data() + frame.first_child,
+              stack.size() - frame.first_child));
+      stack.erase(stack.begin() + frame.first_child, stack.end());
+      (*fold_.results_)[frame.index] = value;
+      stack.push_back(std::move(value));
+      return TraversalStatus::CONTINUE;
+    }
+  };
+
+  FoldFunction<T, R>& function_;
+  std::vector<Frame> frames_;
+  std::vector<R> stack_;
+  std::vector<R> *results_;
+
+public:
+  /**
+   * Constructor
+   *
+   * @param function computes each node's value
+   */
+  Fold(FoldFunction<T, R>& function) :
+      function_(function),
+      results_(nullptr) {
+  }
+
+  Fold(const Fold &other) = delete;
+  Fold(Fold &&other) = delete;
+  Fold& operator=(const Fold &other) = delete;
+  Fold& operator=(Fold &&other) = delete;
+
+  virtual ~Fold() = default;
+
+  /**
+   * @brief Folds a subtree, appending its values to a vector
+   *
+   * @param node subtree root. Must not be \c NULL.
+   * @param results receives the values of the subtree's nodes in
+   *        preorder. The root's value lands at the vector's original
+   *        size.
+   * @return the root's value
+   */
+  const R& append(T *node, std::vector<R>& results) {
+    size_t root_index = results.size();
+    results_ = &results;
+    EntryAction on_entry(*this);
+    ExitAction on_exit(*this);
+    BorrowingTraversal<T> traversal(
+        on_entry,
+        on_exit,
+        VacuousVoidFunction::INSTANCE,
+        VacuousVoidFunction::INSTANCE);
+    try {
+      traversal(node);
+    } catch (...) {
+      frames_.clear();
+      stack_.clear();
+      results_ = nullptr;
+      throw;
+    }
+    stack_.clear();
+    results_ = nullptr;
+    return results[root_index];
+  }
+
+  /**
+   * @brief Folds a subtree
+   *
+   * @param node subtree root. Must not be \c NULL.
+   * @return the values of the subtree's nodes, in preorder
+   */
+  std::vector<R> operator() (T *node) {
+    std::vector<R> results;
+    append(node, results);
+    return results;
+  }
+
+  /**
+   * @brief Folds a subtree
+   *
+   * @param node subtree root. Must not be empty.
+   * @return the values of the subtree's nodes, in preorder
+   */
+  std::vector<R> operator() (const std::shared_ptr<T>& node) {
+    return (*this)(node.get());
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* FOLD_H_ */
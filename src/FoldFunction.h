@@ -0,0 +1,74 @@
+/*
+ * FoldFunction.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file FoldFunction.h
+ *
+ * API for computing a node's value from its children's values
+ */
+#ifndef FOLDFUNCTION_H_
+#define FOLDFUNCTION_H_
+
+#include <span>
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Base class for functions that \c Fold and \c ParallelFold
+ *        apply to every node in a tree
+ *
+ * A fold function synthesizes a node's value, its size, type, or
+ * constant value, say, from the values of its children. The fold
+ * applies the function to every node after it has applied it to all
+ * of the node's children.
+ *
+ * Like \c BorrowedNodeAction, the function borrows the node, and
+ * \b must \b not retain the pointer or release any node in the tree.
+ *
+ * @tparam T node type.
+ * @tparam R value type
+ *
+ * \see Fold
+ * \see ParallelFold
+ */
+template <typename T, typename R> class FoldFunction {
+protected:
+  FoldFunction(void) = default;
+
+public:
+  virtual ~FoldFunction() = default;
+
+  /**
+   * Compute the specified node's value
+   *
+   * @param node \c Node (or subclass thereof) to process. Never \c NULL.
+   * @param children the values of the node's children, in child order.
+   *        Empty for leaves. Valid only for the duration of the call.
+   * @return the node's value
+   */
+  virtual R operator()(T *node, std::span<const R> children) = 0;
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* FOLDFUNCTION_H_ */
@@ -0,0 +1,71 @@
+/*
+ * FrozenNodeAction.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file FrozenNodeAction.h
+ *
+ * API for acting on a node in a \c FrozenTree
+ */
+#ifndef FROZENNODEACTION_H_
+#define FROZENNODEACTION_H_
+
+#include <cstddef>
+
+#include "TraversalStatus.h"
+
+namespace VisitingParseTree {
+
+class FrozenTree;
+
+/**
+ * @brief Base class for actions that \c FrozenTree::traverse() applies
+ *
+ * The \c FrozenTree counterpart of \c BorrowedNodeAction. Actions
+ * receive the snapshot and the node's preorder index, so they can
+ * read the node's structure and attributes from the snapshot's
+ * contiguous arrays without touching the node itself.
+ *
+ * \see FrozenTree
+ */
+class FrozenNodeAction {
+protected:
+  FrozenNodeAction(void) = default;
+
+public:
+  virtual ~FrozenNodeAction() = default;
+
+  /**
+   * Apply implementation's logic to the specified node.
+   *
+   * @param tree the snapshot being traversed
+   * @param index the node's preorder index within \c tree
+   * @return \c TraversalStatus that governs the containing traversal.
+   *
+   * @see TraversalStatus for traversal control details
+   */
+  virtual TraversalStatus operator()(const FrozenTree& tree, size_t index) = 0;
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* FROZENNODEACTION_H_ */
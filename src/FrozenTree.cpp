@@ -0,0 +1,211 @@
+/*
+ * FrozenTree.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file FrozenTree.cpp
+ *
+ * Flattened tree snapshot implementation
+ */
+
+#include "FrozenTree.h"
+
+#include <limits>
+
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "IllegalOperation.h"
+#include "InternedString.h"
+
+namespace VisitingParseTree {
+
+/*
+ * Appends nodes to a snapshot in preorder on entry, and records
+ * their subtree ends on exit.
+ */
+class FreezingAction : public BorrowedNodeAction<BaseAttrNode> {
+  FrozenTree& tree_;
+  std::vector<FrozenTree::Index>& open_;  /* Nodes whose subtrees are incomplete */
+
+public:
+  FreezingAction(
+      FrozenTree& tree,
+      std::vector<FrozenTree::Index>& open) :
+          tree_(tree),
+          open_(open) {
+  }
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    size_t index = tree_.nodes_.size();
+    if (std::numeric_limits<FrozenTree::Index>::max() <= index) {
+      throw IllegalOperation("Tree is too large to freeze.");
+    }
+    tree_.nodes_.push_back(node);
+    tree_.types_.push_back(&node->supplier());
+    tree_.parents_.push_back(open_.empty() ? 0 : open_.back());
+    tree_.subtree_ends_.push_back(0);
+    tree_.attributes_.insert(
+        tree_.attributes_.end(),
+        node->attribute_map().begin(),
+        node->attribute_map().end());
+    tree_.attribute_offsets_.push_back(tree_.attributes_.size());
+    open_.push_back(index);
+    return TraversalStatus::CONTINUE;
+  }
+
+  /*
+   * Closes the most recently entered node that is still open.
+   */
+  void close(void) {
+    tree_.subtree_ends_[open_.back()] = tree_.nodes_.size();
+    open_.pop_back();
+  }
+};
+
+namespace {
+
+class ClosingAction : public BorrowedNodeAction<BaseAttrNode> {
+  FreezingAction& freezer_;
+
+public:
+  ClosingAction(FreezingAction& freezer) :
+      freezer_(freezer) {
+  }
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    freezer_.close();
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+class VisitingFrozenAction : public FrozenNodeAction {
+  Visitor *visitor_;
+
+public:
+  VisitingFrozenAction(Visitor *visitor) :
+      visitor_(visitor) {
+  }
+
+  virtual TraversalStatus operator()(
+      const FrozenTree& tree, size_t index) override {
+    return tree.node(index)->accept(visitor_);
+  }
+};
+
+}
+
+FrozenTree FrozenTree::freeze(std::shared_ptr<BaseAttrNode> root) {
+  FrozenTree tree;
+  tree.attribute_offsets_.push_back(0);
+  std::vector<Index> open;
+  FreezingAction on_entry(tree, open);
+  ClosingAction on_exit(on_entry);
+  BorrowingTraversal<BaseAttrNode> traversal(
+      on_entry,
+      on_exit,
+      VacuousVoidFunction::INSTANCE,
+      VacuousVoidFunction::INSTANCE);
+  traversal(root.get());
+  tree.root_ = std::move(root);
+  return tree;
+}
+
+const AttributeValue *FrozenTree::find(
+    size_t index, const Attribute& attribute) const {
+  const int id = attribute.id();
+  for (const auto& entry : attributes(index)) {
+    if (id <= entry.id) {
+      return id == entry.id ? &entry.value : nullptr;
+    }
+  }
+  return nullptr;
+}
+
+const std::string& FrozenTree::get(
+    size_t index, const Attribute& attribute) const {
+  static const std::string empty;
+  const AttributeValue *value = find(index, attribute);
+  if (!value) {
+    return empty;
+  }
+  if (auto text = std::get_if<std::string>(value)) {
+    return *text;
+  }
+  if (auto interned = std::get_if<InternedString>(value)) {
+    return interned->str();
+  }
+  throw IllegalOperation(
+      "Attribute " + attribute.name() + " does not have a string value.");
+}
+
+TraversalStatus FrozenTree::traverse(
+    FrozenNodeAction& on_entry,
+    FrozenNodeAction& on_exit,
+    VoidFunction& after_descent,
+    VoidFunction& before_ascent,
+    size_t start) const {
+  // Nodes whose children are being traversed. A node's children are
+  // done when the traversal reaches its subtree end.
+  std::vector<size_t> open;
+  size_t next = start;
+  TraversalStatus status;
+  do {
+    status = on_entry(*this, next);
+    if (TraversalStatus::CONTINUE == status && has_children(next)) {
+      after_descent();
+      open.push_back(next++);
+    } else {
+      if (TraversalStatus::CANCEL != status) {
+        status = exit(on_exit, next);
+      }
+      next = subtree_ends_[next];
+    }
+    while (TraversalStatus::CANCEL != status
+        && !open.empty()
+        && subtree_ends_[open.back()] == next) {
+      size_t exiting = open.back();
+      open.pop_back();
+      before_ascent();
+      status = exit(on_exit, exiting);
+    }
+  } while (TraversalStatus::CANCEL != status && !open.empty());
+  // As in Traversal, cancellation skips the exit action of every node
+  // still being processed, but each of them still ascends.
+  for (; !open.empty(); open.pop_back()) {
+    before_ascent();
+  }
+  return status;
+}
+
+TraversalStatus FrozenTree::visit(
+    Visitor *on_entry,
+    Visitor *on_exit,
+    VoidFunction& after_descent,
+    VoidFunction& before_ascent,
+    size_t start) const {
+  VisitingFrozenAction entry_action(on_entry);
+  VisitingFrozenAction exit_action(on_exit);
+  return traverse(
+      entry_action, exit_action, after_descent, before_ascent, start);
+}
+
+} /* namespace VisitingParseTree */
@@ -0,0 +1,311 @@
+/*
+ * FrozenTree.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file FrozenTree.h
+ *
+ * @brief Read-only, flattened snapshot of a \c BaseAttrNode tree
+ */
+#ifndef FROZENTREE_H_
+#define FROZENTREE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "Attribute.h"
+#include "AttributeMap.h"
+#include "AttributeValue.h"
+#include "BaseAttrNode.h"
+#include "FrozenNodeAction.h"
+#include "Supplier.h"
+#include "TraversalStatus.h"
+#include "TypedAttribute.h"
+#include "VacuousVoidFunction.h"
+#include "Visitor.h"
+#include "VoidFunction.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief A cache-friendly, read-only snapshot of a tree
+ *
+ * Trees built from \c Node are linked by pointers scattered across
+ * the heap, so every step of a traversal risks a cache miss. A
+ * \c FrozenTree compiles a tree into contiguous arrays indexed by
+ * preorder position: for each node, its type (i.e. its \c Supplier),
+ * parent, the end of its subtree, and the range of its attributes in
+ * a single attribute array. Read-only passes over the snapshot scan
+ * memory sequentially.
+ *
+ * A node's descendants immediately follow it, and its subtree ends at
+ * \c subtree_end(), so its first child, if any, is at the next index
+ * and its next sibling is at \c subtree_end(). Traversals skip a
+ * subtree by jumping to its end.
+ *
+ * The snapshot copies attribute values, so it does not observe
+ * changes made to the tree after \c freeze(). It holds the tree's
+ * root, which keeps the tree alive, and refers to the other nodes by
+ * plain pointer, so that visitors can be applied to them. Nodes
+ * \b must \b not be detached or otherwise released from the tree
+ * while the snapshot is in use.
+ *
+ * Snapshots are immutable, so any number of threads can read one
+ * concurrently.
+ */
+class FrozenTree {
+  using Index = std::uint32_t;  /** Compact node index */
+
+  std::shared_ptr<BaseAttrNode> root_;  /** Keeps the tree alive */
+  std::vector<BaseAttrNode *> nodes_;  /** Nodes, for visitation */
+  std::vector<Supplier<BaseAttrNode> *> types_;  /** Node types */
+  std::vector<Index> parents_;  /** Parent indices; root's is 0 */
+  std::vector<Index> subtree_ends_;  /** One past each subtree's end */
+  std::vector<Index> attribute_offsets_;  /** Attribute ranges, size() + 1 */
+  std::vector<AttributeMap::Entry> attributes_;  /** All attributes */
+
+  friend class FreezingAction;
+
+  FrozenTree(void) = default;
+
+  /**
+   * @param index node index
+   * @param attribute attribute to find
+   * @return the node's value for \c attribute, or \c NULL if it has
+   *         none
+   */
+  const AttributeValue *find(size_t index, const Attribute& attribute) const;
+
+  /**
+   * @brief Applies an exit action, mapping \c BYPASS_CHILDREN to
+   *        \c CONTINUE as \c Traversal does
+   */
+  TraversalStatus exit(FrozenNodeAction& on_exit, size_t index) const {
+    auto status = on_exit(*this, index);
+    return TraversalStatus::BYPASS_CHILDREN != status
+        ? status
+        : TraversalStatus::CONTINUE;
+  }
+
+public:
+  /**
+   * Returned by navigation methods when the requested node does not
+   * exist.
+   */
+  static constexpr size_t NO_NODE = static_cast<size_t>(-1);
+
+  FrozenTree(const FrozenTree &other) = delete;
+  FrozenTree(FrozenTree &&other) = default;
+  FrozenTree& operator=(const FrozenTree &other) = delete;
+  FrozenTree& operator=(FrozenTree &&other) = default;
+  ~FrozenTree() = default;
+
+  /**
+   * @brief Compiles a tree into a snapshot
+   *
+   * @param root the root of the tree to freeze, which can be any node
+   *        in a containing tree. Must not be empty.
+   * @return the snapshot. \c root has index 0.
+   *
+   * @throws IllegalOperation if the tree has 2^32 or more nodes
+   */
+  static FrozenTree freeze(std::shared_ptr<BaseAttrNode> root);
+
+  /**
+   * @return the number of nodes in the snapshot
+   */
+  size_t size(void) const {
+    return nodes_.size();
+  }
+
+  /**
+   * @return the root of the frozen tree
+   */
+  const std::shared_ptr<BaseAttrNode>& root(void) const {
+    return root_;
+  }
+
+  /**
+   * @param index node index, which must be less than \c size()
+   * @return the node at \c index
+   */
+  BaseAttrNode *node(size_t index) const {
+    return nodes_[index];
+  }
+
+  /**
+   * @param index node index
+   * @return the supplier that created the node, which identifies its
+   *         type
+   */
+  Supplier<BaseAttrNode>& supplier(size_t index) const {
+    return *types_[index];
+  }
+
+  /**
+   * @param index node index
+   * @return the parent's index, or \c NO_NODE for the root
+   */
+  size_t parent(size_t index) const {
+    return index ? parents_[index] : NO_NODE;
+  }
+
+  /**
+   * @param index node index
+   * @return the index just past the node's last descendant
+   */
+  size_t subtree_end(size_t index) const {
+    return subtree_ends_[index];
+  }
+
+  /**
+   * @param index node index
+   * @return \c true if and only if the node has at least one child
+   */
+  bool has_children(size_t index) const {
+    return index + 1 < subtree_ends_[index];
+  }
+
+  /**
+   * @param index node index
+   * @return the node's first child's index, or \c NO_NODE if the node
+   *         is a leaf
+   */
+  size_t first_child(size_t index) const {
+    return has_children(index) ? index + 1 : NO_NODE;
+  }
+
+  /**
+   * @param index node index
+   * @return the node's next sibling's index, or \c NO_NODE if the node
+   *         is its parent's last child or is the root
+   */
+  size_t next_sibling(size_t index) const {
+    if (!index) {
+      return NO_NODE;
+    }
+    size_t end = subtree_ends_[index];
+    return end < subtree_ends_[parents_[index]] ? end : NO_NODE;
+  }
+
+  /**
+   * @param index node index
+   * @return the node's attributes, in ascending attribute identifier
+   *         order
+   */
+  std::span<const AttributeMap::Entry> attributes(size_t index) const {
+    return std::span<const AttributeMap::Entry>(
+        attributes_.data() + attribute_offsets_[index],
+        attributes_.data() + attribute_offsets_[index + 1]);
+  }
+
+  /**
+   * @param index node index
+   * @param attribute the attribute to check
+   * @return \c true if and only if the node had the attribute when
+   *         frozen
+   */
+  bool has(size_t index, const Attribute& attribute) const {
+    return find(index, attribute);
+  }
+
+  /**
+   * @brief Returns a node's string attribute value
+   *
+   * \see AttrNode::get()
+   *
+   * @param index node index
+   * @param attribute the attribute to return
+   * @return the attribute's value, or an empty string if the node did
+   *         not have the attribute
+   *
+   * @throws IllegalOperation if the attribute is a scalar
+   *         \c TypedAttribute
+   */
+  const std::string& get(size_t index, const Attribute& attribute) const;
+
+  /**
+   * @brief Returns a node's typed attribute value
+   *
+   * @tparam V the attribute's value type
+   * @param index node index
+   * @param attribute the attribute to return
+   * @return the attribute's value, or a value-initialized \c V if the
+   *         node did not have the attribute
+   */
+  template <typename V> V get(
+      size_t index, const TypedAttribute<V>& attribute) const {
+    const AttributeValue *value = find(index, attribute);
+    return value ? std::get<V>(*value) : V{};
+  }
+
+  /**
+   * @brief Traverses the subtree rooted at the specified node
+   *
+   * Applies actions in the same order, and with the same
+   * \c TraversalStatus semantics, as \c Traversal.
+   *
+   * @param on_entry applied to a newly entered node
+   * @param on_exit applied after traversing a node's children
+   * @param after_descent invoked before traversing a node's children
+   * @param before_ascent invoked after traversing a node's children
+   * @param start index of the node where the traversal starts
+   * @return status that governs the traversal
+   */
+  TraversalStatus traverse(
+      FrozenNodeAction& on_entry,
+      FrozenNodeAction& on_exit,
+      VoidFunction& after_descent = VacuousVoidFunction::INSTANCE,
+      VoidFunction& before_ascent = VacuousVoidFunction::INSTANCE,
+      size_t start = 0) const;
+
+  /**
+   * @brief Applies entry and exit visitors to the subtree rooted at
+   *        the specified node
+   *
+   * The snapshot's counterpart of \c VisitingTraversal.
+   *
+   * @param on_entry \c Visitor to apply on node entry. Does nothing if
+   *        \c NULL.
+   * @param on_exit \c Visitor to apply on node exit. Does nothing if
+   *        \c NULL.
+   * @param after_descent invoked before traversing a node's children
+   * @param before_ascent invoked after traversing a node's children
+   * @param start index of the node where the traversal starts
+   * @return status that governs the traversal
+   */
+  TraversalStatus visit(
+      Visitor *on_entry,
+      Visitor *on_exit,
+      VoidFunction& after_descent = VacuousVoidFunction::INSTANCE,
+      VoidFunction& before_ascent = VacuousVoidFunction::INSTANCE,
+      size_t start = 0) const;
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* FROZENTREE_H_ */
@@ -0,0 +1,69 @@
+/*
+ * HashCombine.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file HashCombine.h
+ *
+ * @brief Mixes hash values into a running hash
+ */
+#ifndef HASHCOMBINE_H_
+#define HASHCOMBINE_H_
+
+#include <cstdint>
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Scrambles a 64-bit value
+ *
+ * The SplitMix64 finalizer, which spreads every input bit over the
+ * result.
+ *
+ * @param x the value to scramble
+ * @return the scrambled value
+ */
+constexpr std::uint64_t hash_mix(std::uint64_t x) {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+/**
+ * @brief Mixes a value into a running 64-bit hash
+ *
+ * Order sensitive: combining \c a then \c b differs from combining
+ * \c b then \c a. The value is scrambled before it meets the seed,
+ * so pairs with the same sum, such as (1, 2) and (2, 1), do not
+ * collide.
+ *
+ * @param seed the running hash
+ * @param value the value to mix in
+ * @return the new running hash
+ */
+constexpr std::uint64_t hash_combine(std::uint64_t seed, std::uint64_t value) {
+  return hash_mix(seed ^ hash_mix(value + 0x9e3779b97f4a7c15ULL));
+}
+
+} /* namespace VisitingParseTree */
+
+#endif /* HASHCOMBINE_H_ */
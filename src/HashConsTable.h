@@ -0,0 +1,264 @@
+/*
+ * HashConsTable.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file HashConsTable.h
+ *
+ * @brief Maps subtrees to canonical, structurally equal instances
+ */
+#ifndef HASHCONSTABLE_H_
+#define HASHCONSTABLE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "AttributeMap.h"
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "TraversalStatus.h"
+#include "VacuousVoidFunction.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Deduplicates structurally equal subtrees
+ *
+ * The table keeps one canonical instance of every distinct subtree
+ * that it has seen, keyed by \c AttrNode::structural_hash(). The
+ * table interns subtrees bottom up, so a candidate is confirmed by
+ * comparing its type and attributes and the identities of its
+ * canonical children, in time independent of the subtree's size. Interning a
+ * subtree returns the canonical instance equal to it, which makes
+ * common subexpressions, or duplicates across files, share a single
+ * instance that passes can compare by identity and analyze once.
+ *
+ * Because every node has at most one parent, a canonical subtree
+ * stays where it was first seen; duplicates are left in place for the
+ * caller to replace or annotate. The table holds references to its
+ * canonical subtrees, which \b must \b not be modified while they are
+ * in the table.
+ *
+ * @tparam T node type, which must inherit \c AttrNode<T>
+ */
+template <typename T> class HashConsTable {
+public:
+  /**
+   * @brief A subtree that duplicates a canonical one
+   */
+  struct Duplicate {
+    std::shared_ptr<T> subtree;  /** The duplicate */
+    std::shared_ptr<T> canonical;  /** The canonical instance it equals */
+  };
+
+private:
+  /**
+   * @brief A canonical subtree
+   */
+  struct Entry {
+    std::shared_ptr<T> subtree;  /** The subtree's root */
+    std::vector<T *> children;  /** Canonical instances of its children */
+  };
+
+  std::unordered_multimap<std::uint64_t, Entry> canonical_;
+
+  /**
+   * @brief Interns every subtree, children before parents, and
+   *        records the duplicates
+   *
+   * Keeps the canonical instances of the exited nodes whose parents
+   * are still pending on a stack, so a node's canonical children are
+   * the top \c child_count() entries when the node exits.
+   */
+  class InterningAction : public BorrowedNodeAction<T> {
+    HashConsTable& table_;
+    std::vector<Duplicate> *duplicates_;
+    std::vector<T *> canonical_;
+
+  public:
+    InterningAction(
+        HashConsTable& table,
+        std::vector<Duplicate> *duplicates) :
+            table_(table),
+            duplicates_(duplicates) {
+    }
+
+    T *canonical(void) const {
+      return canonical_.back();
+    }
+
+    virtual TraversalStatus operator()(T *node) override {
+      size_t first_child = canonical_.size() - node->child_count();
+      const Entry& entry = table_.find_or_add(
+          node,
+          canonical_.data() + first_child,
+          canonical_.size() - first_child);
+      if (duplicates_ && entry.subtree.get() != node) {
+        duplicates_->push_back(
+            Duplicate{node->shared_from_this(), entry.subtree});
+      }
+      canonical_.resize(first_child);
+      canonical_.push_back(entry.subtree.get());
+      return TraversalStatus::CONTINUE;
+    }
+  };
+
+  class ContinuingAction : public BorrowedNodeAction<T> {
+  public:
+    virtual TraversalStatus operator()(T *node) override {
+      return TraversalStatus::CONTINUE;
+    }
+  };
+
+  /**
+   * @brief Finds the entry equal to a node whose children have been
+   *        interned, adding the node if there is none
+   *
+   * Because the children are canonical, comparing them by identity
+   * settles their equality, and the comparison is shallow.
+   *
+   * @param node the node, whose structural hash is cached
+   * @param children canonical instances of the node's children
+   * @param child_count the number of children
+   * @return the node's entry
+   */
+  const Entry& find_or_add(T *node, T *const *children, size_t child_count) {
+    auto hash = node->structural_hash();
+    const AttributeMap& attributes = node->attribute_map();
+    auto [first, last] = canonical_.equal_range(hash);
+    for (; first != last; ++first) {
+      const Entry& entry = first->second;
+      const AttributeMap& entry_attributes = entry.subtree->attribute_map();
+      if (entry.subtree->supplier() == node->supplier()
+          && std::equal(
+              entry.children.begin(),
+              entry.children.end(),
+              children,
+              children + child_count)
+          && std::equal(
+              entry_attributes.begin(),
+              entry_attributes.end(),
+              attributes.begin(),
+              attributes.end(),
+              [](const auto& a, const auto& b) {
+                return a.id == b.id && a.value == b.value;
+              })) {
+        return entry;
+      }
+    }
+    return canonical_.emplace(
+        hash,
+        Entry{
+            node->shared_from_this(),
+            std::vector<T *>(children, children + child_count)})->second;
+  }
+
+  /**
+   * @brief Interns a subtree and its descendants, children before
+   *        parents
+   *
+   * @param root the subtree's root
+   * @param duplicates receives the duplicates, if not \c NULL
+   * @return the canonical instance of the subtree
+   */
+  T *intern_subtree(T *root, std::vector<Duplicate> *duplicates) {
+    root->structural_hash();
+    ContinuingAction on_entry;
+    InterningAction on_exit(*this, duplicates);
+    BorrowingTraversal<T> traversal(
+        on_entry,
+        on_exit,
+        VacuousVoidFunction::INSTANCE,
+        VacuousVoidFunction::INSTANCE);
+    traversal(root);
+    return on_exit.canonical();
+  }
+
+public:
+  HashConsTable(void) = default;
+
+  HashConsTable(const HashConsTable &other) = delete;
+  HashConsTable(HashConsTable &&other) = default;
+  HashConsTable& operator=(const HashConsTable &other) = delete;
+  HashConsTable& operator=(HashConsTable &&other) = default;
+
+  virtual ~HashConsTable() = default;
+
+  /**
+   * @return the number of distinct subtrees in the table
+   */
+  size_t size(void) const {
+    return canonical_.size();
+  }
+
+  /**
+   * @brief Releases every canonical subtree
+   */
+  void clear(void) {
+    canonical_.clear();
+  }
+
+  /**
+   * @brief Finds the canonical instance of a subtree, making the
+   *        subtree canonical if the table has no equal one
+   *
+   * Interns the subtree's descendants first, as \c intern_all()
+   * does, so the subtree is compared with the table's entries one
+   * node deep.
+   *
+   * @param subtree the subtree's root. Must not be empty.
+   * @return the canonical subtree structurally equal to \c subtree,
+   *         which is \c subtree itself if it is new
+   */
+  std::shared_ptr<T> intern(const std::shared_ptr<T>& subtree) {
+    T *canonical = intern_subtree(subtree.get(), nullptr);
+    return canonical == subtree.get()
+        ? subtree
+        : canonical->shared_from_this();
+  }
+
+  /**
+   * @brief Interns every subtree of a tree
+   *
+   * Finds every duplicate subtree in one pass, which hashes each node
+   * once and compares each node with its candidates one node deep.
+   * Descendants of a duplicate subtree are themselves duplicates, and
+   * are reported as well.
+   *
+   * @param root the tree's root. Must not be empty.
+   * @return the subtrees that duplicate canonical ones, in the order
+   *         that the pass exited them, i.e. children before parents
+   */
+  std::vector<Duplicate> intern_all(const std::shared_ptr<T>& root) {
+    std::vector<Duplicate> duplicates;
+    intern_subtree(root.get(), &duplicates);
+    return duplicates;
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* HASHCONSTABLE_H_ */
@@ -24,8 +24,7 @@
 /**
  * @file Host.h
  *
- * @brief extends the \c Node template to support runtime type
- *        identification-based double dispatch
+ * @brief extends the \c Node template to support double dispatch
  */
 
 #ifndef HOST_H_
@@ -50,7 +49,7 @@ template<typename T> class HostVisitor;
  * TODO: enforce
  */
 /**
- * @brief Adds runtime type identification-based double dispatch to \c Node.
+ * @brief Adds double dispatch to \c Node.
  *
  * @tparam T subtype. When the subtype inherits directly from \c Host,
  *         T must be that subtype. For example, if \c MyHost is a direct
@@ -78,29 +77,38 @@ public:
    *      virtual VisitingParseTree::TraversalStatus processFoo(Foo *host) = 0;
    *     };
    *
-   * \c FooNode::accept() then becomes:
+   * Each node class also owns a static \c DispatchTag that names its
+   * visitor interface and links to its superclass's tag. The generator
+   * emits
+   *
+   *     VisitingParseTree::DispatchTag<VisitingParseTree::BaseAttrNode>
+   *     Foo::DISPATCH_TAG =
+   *         VisitingParseTree::DispatchTag<VisitingParseTree::BaseAttrNode>::make<
+   *             Foo,
+   *             FooVisitor,
+   *             &FooVisitor::processFoo>(
+   *                 &VisitingParseTree::BaseAttrNode::DISPATCH_TAG);
    *
    *     VisitingParseTree::TraversalStatus Foo::accept(
    *         VisitingParseTree::Visitor *visitor) {
-   *       auto concrete_visitor = dynamic_cast<FooVisitor *>(visitor);
-   *       return concrete_visitor
-   *           ? concrete_visitor->processFoo(this)
-   *           : VisitingParseTree::BaseAttrNode::accept(visitor);
+   *       return DISPATCH_TAG.dispatch(visitor, this);
    *     }
    *
    * Visitation proceeds as follows:
    *
-   *   -# If \c visitor inherits \c FooVisitor, \c dynamic_cast will
-   *      return a valid (i.e. non-null) pointer. Otherwise it returns
-   *      \c NULL.
-   *   -# If \c concrete_visitor is valid, \c accept() passes \c this to
-   *      the visitor's \c processFoo implementation for processing.
-   *   -# Otherwise, \c concrete_visitor is \c NULL, meaning that \c visitor
-   *      does not implement \c FooVisitor::processFoo(). It \c might,
-   *      however, implement the visitor associated with its superclass,
-   *      \c BaseAttrNodeVisitor, the "last chance" visitor, so it
-   *      passes \c visitor to \c BaseAttrNode::accept() for possible
-   *      handling.
+   *   -# If \c visitor inherits \c FooVisitor, the tag passes \c this
+   *      to the visitor's \c processFoo implementation for processing.
+   *   -# Otherwise, \c visitor does not implement \c FooVisitor. It
+   *      \c might, however, implement the visitor associated with a
+   *      superclass, ultimately \c BaseAttrNodeVisitor, the "last
+   *      chance" visitor. The nearest such superclass's visitor
+   *      method processes the node.
+   *   -# If the visitor implements none of them, \c accept() does
+   *      nothing and returns \c TraversalStatus::CONTINUE.
+   *
+   * The visitor records which of its interfaces handles each node
+   * class the first time it encounters the class, so subsequent
+   * visits take constant time regardless of hierarchy depth.
    *
    * The node generator emits all required classes and logic automatically.
    *
@@ -0,0 +1,233 @@
+/*
+ * IncrementalTraversal.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file IncrementalTraversal.h
+ *
+ * @brief Depth-first traversal that skips subtrees unchanged since
+ *        its previous run
+ */
+#ifndef INCREMENTALTRAVERSAL_H_
+#define INCREMENTALTRAVERSAL_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "TraversalStatus.h"
+#include "VacuousVoidFunction.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief A repeatable traversal that revisits only changed subtrees
+ *
+ * Every change to a node's attributes or children stamps the node and
+ * its ancestors with the current revision (see \c Node::revision()),
+ * so a subtree that has not changed since a traversal is recognizable
+ * from its root alone. An \c IncrementalTraversal remembers the
+ * revision of its last complete run. On the next run, it traverses
+ * changed subtrees as a \c BorrowingTraversal would, and offers each
+ * unchanged subtree to a \a clean action instead of descending into
+ * it. The clean action returns
+ *
+ * - \c BYPASS_CHILDREN to reuse the results of the previous run,
+ *   skipping the subtree entirely, neither entry nor exit actions
+ *   included,
+ * - \c CONTINUE to traverse the subtree anyway, for example because
+ *   the previous run never saw it, or
+ * - \c CANCEL to cancel the traversal.
+ *
+ * A run after a small edit to a large tree therefore costs time
+ * proportional to the edited paths and their siblings. The first run
+ * traverses the whole tree.
+ *
+ * Attaching a subtree stamps only its root (see
+ * \c Node::attach_revision()), so the run treats every node below a
+ * root attached since the last run as changed, and never offers any
+ * of them to the clean action. This holds even for a subtree that
+ * was built, or evaluated elsewhere, before the last run.
+ *
+ * Changes made by the actions themselves, such as attributes that
+ * record results, belong to the run's revision, so they do not make
+ * the next run revisit their nodes. Other passes see them as
+ * changes. A run that is canceled, or that throws, is forgotten, so
+ * the next run revisits everything that changed before it.
+ *
+ * Like \c BorrowingTraversal, the actions \b must \b not detach,
+ * excise, or otherwise release nodes in the traversed tree.
+ *
+ * @tparam T node type, which must inherit \c Node<T>
+ */
+template <typename T> class IncrementalTraversal {
+  /*
+   * Offers unchanged subtrees to the clean action, and remembers the
+   * subtree being reused so that its exit action can be skipped. Also
+   * remembers the outermost subtree attached since the last run, so
+   * that every node within it is entered as changed.
+   */
+  class EntryFilter : public BorrowedNodeAction<T> {
+    BorrowedNodeAction<T>& on_entry_;
+    BorrowedNodeAction<T>& on_clean_;
+
+  public:
+    std::uint64_t since = 0;
+    T *reused = nullptr;
+    T *attached = nullptr;
+
+    EntryFilter(
+        BorrowedNodeAction<T>& on_entry,
+        BorrowedNodeAction<T>& on_clean) :
+            on_entry_(on_entry),
+            on_clean_(on_clean) {
+    }
+
+    virtual TraversalStatus operator()(T *node) override {
+      if (attached) {
+        return on_entry_(node);
+      }
+      if (since < node->attach_revision()) {
+        attached = node;
+        return on_entry_(node);
+      }
+      if (since < node->revision()) {
+        return on_entry_(node);
+      }
+      auto status = on_clean_(node);
+      switch (status) {
+      case TraversalStatus::CONTINUE:
+        return on_entry_(node);
+      case TraversalStatus::BYPASS_CHILDREN:
+        reused = node;
+        break;
+      default:
+        break;
+      }
+      return status;
+    }
+  };
+
+  /*
+   * Applies the exit action to every node except a reused one, and
+   * notes leaving the attached subtree.
+   */
+  class ExitFilter : public BorrowedNodeAction<T> {
+    BorrowedNodeAction<T>& on_exit_;
+    EntryFilter& entry_filter_;
+
+  public:
+    ExitFilter(
+        BorrowedNodeAction<T>& on_exit,
+        EntryFilter& entry_filter) :
+            on_exit_(on_exit),
+            entry_filter_(entry_filter) {
+    }
+
+    virtual TraversalStatus operator()(T *node) override {
+      if (node == entry_filter_.reused) {
+        entry_filter_.reused = nullptr;
+        return TraversalStatus::CONTINUE;
+      }
+      if (node == entry_filter_.attached) {
+        entry_filter_.attached = nullptr;
+      }
+      return on_exit_(node);
+    }
+  };
+
+  EntryFilter entry_filter_;
+  ExitFilter exit_filter_;
+  BorrowingTraversal<T> traversal_;
+  std::uint64_t revision_ = 0;  /* Revision of the last complete run */
+
+public:
+  /**
+   * @brief Creates an incremental traversal bound to the specified
+   *        actions
+   *
+   * @param on_entry applied to a newly entered node
+   * @param on_exit applied after traversing a node's children
+   * @param on_clean applied, instead of \c on_entry, to the root of
+   *        every subtree that has not changed since the last run
+   */
+  IncrementalTraversal(
+      BorrowedNodeAction<T>& on_entry,
+      BorrowedNodeAction<T>& on_exit,
+      BorrowedNodeAction<T>& on_clean) :
+          entry_filter_(on_entry, on_clean),
+          exit_filter_(on_exit, entry_filter_),
+          traversal_(
+              entry_filter_,
+              exit_filter_,
+              VacuousVoidFunction::INSTANCE,
+              VacuousVoidFunction::INSTANCE) {
+  }
+
+  IncrementalTraversal(const IncrementalTraversal&) = delete;
+  IncrementalTraversal& operator=(const IncrementalTraversal&) = delete;
+
+  /**
+   * @brief Traverses the subtrees of the specified node that changed
+   *        since the last complete run
+   *
+   * @param node traversal starting point, which should be the same
+   *        node on every run. Must not be \c NULL.
+   * @return status that governs the traversal
+   */
+  TraversalStatus operator()(T *node) {
+    entry_filter_.since = revision_;
+    entry_filter_.reused = nullptr;
+    entry_filter_.attached = nullptr;
+    auto status = traversal_(node);
+    if (TraversalStatus::CANCEL != status) {
+      revision_ = T::next_revision();
+    }
+    return status;
+  }
+
+  /**
+   * @brief Traverses the subtrees of the specified node that changed
+   *        since the last complete run
+   *
+   * Convenience overload for callers that own the starting node.
+   *
+   * @param node traversal starting point. Must not be empty.
+   * @return status that governs the traversal
+   */
+  TraversalStatus operator()(const std::shared_ptr<T>& node) {
+    return (*this)(node.get());
+  }
+
+  /**
+   * @brief Forgets the previous runs, so the next run traverses the
+   *        whole tree
+   */
+  void reset(void) {
+    revision_ = 0;
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* INCREMENTALTRAVERSAL_H_ */
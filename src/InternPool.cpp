@@ -0,0 +1,58 @@
+/*
+ * InternPool.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file InternPool.cpp
+ *
+ * Attribute value intern pool implementation
+ */
+
+#include "InternPool.h"
+
+namespace VisitingParseTree {
+
+InternPool& InternPool::global(void) {
+  // Deliberately leaked so that handles held by static nodes remain
+  // valid during static destruction.
+  static InternPool *pool = new InternPool();
+  return *pool;
+}
+
+InternedString InternPool::intern(std::string_view text) {
+  if (text.empty()) {
+    return InternedString();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = strings_.find(text);
+  if (found == strings_.end()) {
+    found = strings_.emplace(text).first;
+  }
+  return InternedString(&*found);
+}
+
+size_t InternPool::size(void) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return strings_.size();
+}
+
+} /* namespace VisitingParseTree */
@@ -0,0 +1,108 @@
+/*
+ * InternPool.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file InternPool.h
+ *
+ * @brief Shared, immutable storage for repeated attribute values
+ */
+
+#ifndef INTERNPOOL_H_
+#define INTERNPOOL_H_
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+#include "InternedString.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Holds one immutable copy of each distinct string it is given
+ *
+ * Parse trees repeat the same attribute values over and over: type
+ * names, flags, common identifiers. Storing an \c InternedString
+ * instead of a \c std::string lets every node share a single copy,
+ * so setting a repeated value does not allocate, and comparing values
+ * is a pointer comparison.
+ *
+ * Applications can use the process-wide pool returned by \c global()
+ * or create a pool per tree. Strings are never removed from a pool,
+ * so a pool \b MUST outlive every node that holds one of its
+ * handles. Pools are thread safe.
+ */
+class InternPool {
+  /*
+   * Transparent hashing lets lookups take a std::string_view, so
+   * finding an existing value does not construct a std::string.
+   */
+  struct Hash {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view text) const {
+      return std::hash<std::string_view>()(text);
+    }
+  };
+
+  mutable std::mutex mutex_;  /** Guards \c strings_ */
+  std::unordered_set<std::string, Hash, std::equal_to<>> strings_;  /** Pooled text */
+
+public:
+  InternPool() = default;
+  InternPool(const InternPool&) = delete;
+  InternPool(InternPool&&) = delete;
+  InternPool& operator=(const InternPool&) = delete;
+  InternPool& operator=(InternPool&&) = delete;
+  ~InternPool() = default;
+
+  /**
+   * @brief Returns the process-wide pool, which is never destroyed
+   *
+   * @return the global pool
+   */
+  static InternPool& global(void);
+
+  /**
+   * @brief Returns the handle to the specified text, adding the text
+   *        to the pool if it is not already present
+   *
+   * Allocates only when the text is new to the pool.
+   *
+   * @param text the text to intern
+   * @return a handle to the pooled copy of \c text
+   */
+  InternedString intern(std::string_view text);
+
+  /**
+   * @return the number of distinct strings in the pool
+   */
+  size_t size(void) const;
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* INTERNPOOL_H_ */
@@ -0,0 +1,104 @@
+/*
+ * InternedString.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file InternedString.h
+ *
+ * @brief Handle to an immutable string owned by an \c InternPool
+ */
+
+#ifndef INTERNEDSTRING_H_
+#define INTERNEDSTRING_H_
+
+#include <string>
+#include <string_view>
+
+namespace VisitingParseTree {
+
+class InternPool;
+
+/**
+ * @brief A handle to an immutable, pooled string
+ *
+ * Handles are a single pointer, so copying one never allocates. A
+ * pool holds exactly one copy of each distinct string, so two handles
+ * from the same pool are equal if and only if their strings are
+ * equal, and comparing them compares pointers. Handles from different
+ * pools compare unequal even when their text matches. All pools map
+ * the empty string to the default-constructed handle.
+ *
+ * A handle is valid only while the pool that issued it exists. The
+ * global pool (see \c InternPool::global()) is never destroyed.
+ */
+class InternedString {
+  friend class InternPool;
+
+  const std::string *text_;  /** Pooled text, never NULL */
+
+  static const std::string& empty_text(void) {
+    static const std::string empty;
+    return empty;
+  }
+
+  explicit InternedString(const std::string *text) :
+    text_(text) {
+  }
+
+public:
+  /**
+   * @brief Creates a handle to the empty string
+   */
+  InternedString(void) :
+    text_(&empty_text()) {
+  }
+
+  /**
+   * @return the interned text
+   */
+  const std::string& str(void) const {
+    return *text_;
+  }
+
+  /**
+   * @return a view of the interned text
+   */
+  std::string_view view(void) const {
+    return *text_;
+  }
+
+  /**
+   * @return \c true if and only if the interned text is empty
+   */
+  bool empty(void) const {
+    return text_->empty();
+  }
+
+  /**
+   * @brief Compares handles by identity, which is constant time
+   */
+  bool operator==(const InternedString& other) const = default;
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* INTERNEDSTRING_H_ */
@@ -0,0 +1,322 @@
+/*
+ * Journal.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file Journal.h
+ *
+ * @brief Undo log for speculative tree edits
+ */
+#ifndef JOURNAL_H_
+#define JOURNAL_H_
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "Attribute.h"
+#include "AttributeValue.h"
+#include "IllegalOnRoot.h"
+#include "Supplier.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Records tree edits so that they can be rolled back
+ *
+ * Lets an optimizer try a speculative rewrite in place and undo it,
+ * rather than deep copying the tree for every attempt. Make the edits
+ * through the journal, which applies each one and records how to
+ * invert it. Taking a checkpoint costs constant time, and rolling
+ * back to it costs time proportional to the edits made since. Nodes
+ * keep their identity throughout, so pointers to them, and their
+ * attributes, remain valid across rollbacks.
+ *
+ * Edits made directly on nodes bypass the journal, and rolling back
+ * over them is undefined. The journal holds references to the nodes
+ * that it might restore, including detached ones, until the entries
+ * are committed or rolled back.
+ *
+ * A typical speculative pass:
+ *
+ *     Journal<BaseAttrNode> journal;
+ *     auto mark = journal.checkpoint();
+ *     rewrite(tree, journal);
+ *     if (!better(tree)) {
+ *       journal.rollback(mark);
+ *     }
+ *     journal.commit();
+ *
+ * @tparam T node type, which must inherit \c AttrNode<T>
+ */
+template <typename T> class Journal {
+  /**
+   * @brief Kinds of recorded edit
+   */
+  enum class Kind {
+    ATTRIBUTE,  /** An attribute was set or erased */
+    ATTACHED,  /** \c node was inserted into a parent */
+    DETACHED,  /** \c node was detached from \c parent */
+    EXCISED,  /** \c node was excised from \c parent */
+  };
+
+  /**
+   * @brief A recorded edit and what is needed to invert it
+   */
+  struct Entry {
+    Kind kind;
+    std::shared_ptr<T> node;  /** The edited node */
+    std::shared_ptr<T> parent;  /** Former parent, if detached or excised */
+    size_t index = 0;  /** Former child index, if detached or excised */
+    const Attribute *attribute = nullptr;  /** The changed attribute */
+    std::optional<AttributeValue> value;  /** Its former value, if any */
+    std::vector<std::shared_ptr<T>> children;  /** An excised node's children */
+
+    Entry(
+        Kind kind,
+        std::shared_ptr<T> node,
+        std::shared_ptr<T> parent = nullptr,
+        size_t index = 0) :
+            kind(kind),
+            node(std::move(node)),
+            parent(std::move(parent)),
+            index(index) {
+    }
+  };
+
+  std::vector<Entry> entries_;
+
+  /**
+   * @brief Captures an attribute's current value
+   *
+   * @param node the node about to change
+   * @param attribute the attribute about to change
+   * @return an entry that restores the value
+   */
+  static Entry attribute_entry(
+      const std::shared_ptr<T>& node,
+      const Attribute& attribute) {
+    Entry entry{Kind::ATTRIBUTE, node};
+    entry.attribute = &attribute;
+    if (const AttributeValue *value =
+        static_cast<AttrNode<T>&>(*node).attributes_.find(attribute)) {
+      entry.value = *value;
+    }
+    return entry;
+  }
+
+  /**
+   * @brief Inverts an edit
+   *
+   * @param entry the edit to invert, which must be the most recent
+   *        edit not yet inverted
+   */
+  static void undo(Entry& entry) {
+    switch (entry.kind) {
+    case Kind::ATTRIBUTE: {
+      auto& attributes =
+          static_cast<AttrNode<T>&>(*entry.node).mutable_attributes();
+      if (entry.value) {
+        attributes.insert_or_assign(*entry.attribute, std::move(*entry.value));
+      } else {
+        attributes.erase(*entry.attribute);
+      }
+      break;
+    }
+    case Kind::ATTACHED:
+      entry.node->detach();
+      break;
+    case Kind::DETACHED:
+      entry.parent->insert_child(entry.index, entry.node);
+      break;
+    case Kind::EXCISED:
+      for (auto& child : entry.children) {
+        child->detach();
+        entry.node->append_child(child);
+      }
+      entry.parent->insert_child(entry.index, entry.node);
+      break;
+    }
+  }
+
+public:
+  Journal(void) = default;
+
+  Journal(const Journal &other) = delete;
+  Journal(Journal &&other) = default;
+  Journal& operator=(const Journal &other) = delete;
+  Journal& operator=(Journal &&other) = default;
+
+  virtual ~Journal() = default;
+
+  /**
+   * @return the number of recorded edits
+   */
+  size_t size(void) const {
+    return entries_.size();
+  }
+
+  /**
+   * @brief Marks the current state of the journaled trees
+   *
+   * @return a mark that \c rollback() accepts
+   */
+  size_t checkpoint(void) const {
+    return entries_.size();
+  }
+
+  /**
+   * @brief Undoes every edit recorded after a checkpoint, most recent
+   *        first
+   *
+   * @param mark the checkpoint's mark. Marks taken after it become
+   *        invalid.
+   */
+  void rollback(size_t mark) {
+    while (mark < entries_.size()) {
+      undo(entries_.back());
+      entries_.pop_back();
+    }
+  }
+
+  /**
+   * @brief Keeps every recorded edit, discarding the records and
+   *        every checkpoint
+   */
+  void commit(void) {
+    entries_.clear();
+  }
+
+  /**
+   * @brief Sets an attribute
+   *
+   * Accepts every value that \c AttrNode::put() accepts.
+   *
+   * @param node the node to change
+   * @param attribute the attribute to set
+   * @param value its new value
+   */
+  template <typename A, typename V> void put(
+      const std::shared_ptr<T>& node,
+      const A& attribute,
+      V&& value) {
+    Entry entry = attribute_entry(node, attribute);
+    node->put(attribute, std::forward<V>(value));
+    entries_.push_back(std::move(entry));
+  }
+
+  /**
+   * @brief Erases an attribute
+   *
+   * @param node the node to change
+   * @param attribute the attribute to erase
+   */
+  void erase(const std::shared_ptr<T>& node, const Attribute& attribute) {
+    Entry entry = attribute_entry(node, attribute);
+    node->erase(attribute);
+    entries_.push_back(std::move(entry));
+  }
+
+  /**
+   * @brief Appends a root node as a node's youngest child
+   *
+   * @param parent the node to receive the child
+   * @param child the node to append, which must be a root
+   * @return \c child
+   */
+  std::shared_ptr<T> append_child(
+      const std::shared_ptr<T>& parent,
+      std::shared_ptr<T> child) {
+    parent->append_child(child);
+    entries_.push_back(Entry{Kind::ATTACHED, child});
+    return child;
+  }
+
+  /**
+   * @brief Creates a node as a node's youngest child
+   *
+   * @param parent the node to receive the child
+   * @param supplier creates the child
+   * @return the new child
+   */
+  std::shared_ptr<T> append_child(
+      const std::shared_ptr<T>& parent,
+      Supplier<T>& supplier) {
+    return append_child(parent, supplier.make_shared());
+  }
+
+  /**
+   * @brief Inserts a root node among a node's children
+   *
+   * @param parent the node to receive the child
+   * @param index the new child's index
+   * @param child the node to insert, which must be a root
+   * @return \c child
+   */
+  std::shared_ptr<T> insert_child(
+      const std::shared_ptr<T>& parent,
+      size_t index,
+      std::shared_ptr<T> child) {
+    parent->insert_child(index, child);
+    entries_.push_back(Entry{Kind::ATTACHED, child});
+    return child;
+  }
+
+  /**
+   * @brief Detaches a node from its parent. Does nothing to a root.
+   *
+   * @param node the node to detach
+   */
+  void detach(const std::shared_ptr<T>& node) {
+    if (auto parent = node->parent()) {
+      Entry entry{Kind::DETACHED, node, parent, node->child_index()};
+      node->detach();
+      entries_.push_back(std::move(entry));
+    }
+  }
+
+  /**
+   * @brief Excises a node, promoting its children into its place
+   *
+   * @param node the node to excise, which must not be a root
+   *
+   * \throws IllegalOnRoot if \c node is a root
+   */
+  void excise(const std::shared_ptr<T>& node) {
+    auto parent = node->parent();
+    if (!parent) {
+      throw IllegalOnRoot("Cannot invoke excise() on a root node");
+    }
+    Entry entry{Kind::EXCISED, node, parent, node->child_index()};
+    for (size_t i = 0; i < node->child_count(); ++i) {
+      entry.children.push_back(node->child(i));
+    }
+    node->excise();
+    entries_.push_back(std::move(entry));
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* JOURNAL_H_ */
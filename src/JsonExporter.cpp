@@ -0,0 +1,145 @@
+/*
+ * JsonExporter.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "JsonExporter.h"
+
+#include <cmath>
+#include <variant>
+
+#include "InternedString.h"
+
+namespace VisitingParseTree {
+
+void JsonExporter::append_string(std::string_view text) {
+  static constexpr char HEX[] = "0123456789abcdef";
+  append('"');
+  size_t run = 0;
+  for (size_t i = 0; i < text.size(); ++i) {
+    unsigned char c = text[i];
+    if (c >= 0x20 && c != '"' && c != '\\') {
+      continue;
+    }
+    append(text.substr(run, i - run));
+    run = i + 1;
+    switch (c) {
+    case '"':
+      append("\\\"");
+      break;
+    case '\\':
+      append("\\\\");
+      break;
+    case '\n':
+      append("\\n");
+      break;
+    case '\r':
+      append("\\r");
+      break;
+    case '\t':
+      append("\\t");
+      break;
+    default:
+      append("\\u00");
+      append(HEX[c >> 4]);
+      append(HEX[c & 0xF]);
+      break;
+    }
+  }
+  append(text.substr(run));
+  append('"');
+}
+
+void JsonExporter::append_value(const AttributeValue& value) {
+  switch (value.index()) {
+  case 0:
+    append_string(std::get<std::string>(value));
+    break;
+  case 1:
+    append_number(std::get<std::int64_t>(value));
+    break;
+  case 2: {
+    double number = std::get<double>(value);
+    if (std::isfinite(number)) {
+      append_number(number);
+    } else {
+      append("null");
+    }
+    break;
+  }
+  case 3:
+    append(std::get<bool>(value) ? "true" : "false");
+    break;
+  default:
+    append_string(std::get<InternedString>(value).view());
+    break;
+  }
+}
+
+void JsonExporter::begin_tree(void) {
+  first_ = true;
+}
+
+void JsonExporter::enter(BaseAttrNode& node, size_t elided) {
+  if (!first_) {
+    append(',');
+  }
+  first_ = false;
+  append("{\"type\":");
+  append_string(node.type_name());
+  const AttributeMap& attributes = node.attribute_map();
+  if (attributes.size()) {
+    append(",\"attributes\":{");
+    for (const auto& entry : attributes) {
+      if (&entry != attributes.begin()) {
+        append(',');
+      }
+      append_string(entry.attribute->name());
+      append(':');
+      append_value(entry.value);
+    }
+    append('}');
+  }
+  if (elided) {
+    append(",\"elided\":");
+    append_number(std::uint64_t(elided));
+    append('}');
+  } else if (node.has_children()) {
+    append(",\"children\":[");
+  } else {
+    append('}');
+  }
+}
+
+void JsonExporter::descend(void) {
+  first_ = true;
+}
+
+void JsonExporter::ascend(void) {
+  append("]}");
+  first_ = false;
+}
+
+void JsonExporter::end_tree(void) {
+  append('\n');
+}
+
+} /* namespace VisitingParseTree */
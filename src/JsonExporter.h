@@ -0,0 +1,89 @@
+/*
+ * JsonExporter.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file JsonExporter.h
+ *
+ * @brief Exports \c BaseAttrNode trees as JSON
+ */
+#ifndef JSONEXPORTER_H_
+#define JSONEXPORTER_H_
+
+#include <ostream>
+#include <string_view>
+
+#include "AttributeValue.h"
+#include "TreeExporter.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Streams trees as JSON documents, one per line
+ *
+ * Each node becomes an object such as
+ *
+ *        {"type":"PlusNode","attributes":{"VALUE":"7"},"children":[...]}
+ *
+ * where \c attributes and \c children are omitted when empty. String
+ * values are JSON strings, integer and finite \c double values are
+ * numbers, non-finite values are \c null, and \c bool values are
+ * \c true or \c false. A node whose children fall below the depth
+ * limit has an \c elided member that counts them instead of
+ * \c children.
+ */
+class JsonExporter : public TreeExporter {
+  bool first_ = true;  /** Whether the next node is its parent's first */
+
+  /**
+   * @brief Appends text as a quoted, escaped JSON string
+   */
+  void append_string(std::string_view text);
+
+  void append_value(const AttributeValue& value);
+
+protected:
+  virtual void begin_tree(void) override;
+  virtual void enter(BaseAttrNode& node, size_t elided) override;
+  virtual void descend(void) override;
+  virtual void ascend(void) override;
+  virtual void end_tree(void) override;
+
+public:
+  /**
+   * @param sink destination, which must outlive the exporter
+   */
+  JsonExporter(ByteSink& sink) :
+      TreeExporter(sink) {
+  }
+
+  /**
+   * @param out destination, which must outlive the exporter
+   */
+  JsonExporter(std::ostream& out) :
+      TreeExporter(out) {
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* JSONEXPORTER_H_ */
@@ -0,0 +1,70 @@
+/*
+ * MappedNodeAction.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file MappedNodeAction.h
+ *
+ * API for acting on a node in a \c MappedTree
+ */
+#ifndef MAPPEDNODEACTION_H_
+#define MAPPEDNODEACTION_H_
+
+#include <cstddef>
+
+#include "TraversalStatus.h"
+
+namespace VisitingParseTree {
+
+class MappedTree;
+
+/**
+ * @brief Base class for actions that \c MappedTree::traverse() applies
+ *
+ * The \c MappedTree counterpart of \c FrozenNodeAction. Actions
+ * receive the mapped tree and the node's handle, and read the node's
+ * structure and attributes in place.
+ *
+ * \see MappedTree
+ */
+class MappedNodeAction {
+protected:
+  MappedNodeAction(void) = default;
+
+public:
+  virtual ~MappedNodeAction() = default;
+
+  /**
+   * Apply implementation's logic to the specified node.
+   *
+   * @param tree the mapped tree being traversed
+   * @param node the node's handle within \c tree
+   * @return \c TraversalStatus that governs the containing traversal.
+   *
+   * @see TraversalStatus for traversal control details
+   */
+  virtual TraversalStatus operator()(const MappedTree& tree, size_t node) = 0;
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* MAPPEDNODEACTION_H_ */
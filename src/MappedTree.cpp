@@ -0,0 +1,458 @@
+/*
+ * MappedTree.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file MappedTree.cpp
+ *
+ * Memory-mapped tree implementation
+ */
+
+#include "MappedTree.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <limits>
+#include <variant>
+#include <vector>
+
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "IllegalOperation.h"
+#include "TreeCorruptError.h"
+
+namespace VisitingParseTree {
+
+namespace {
+
+/*
+ * File header layout. Offsets and sizes are 64 bits, and every region
+ * starts on an 8-byte boundary.
+ */
+constexpr unsigned char MAGIC[] = {'V', 'P', 'T', 'M'};
+constexpr std::uint32_t VERSION = 1;
+constexpr size_t VERSION_AT = 4;  /* 32 bits */
+constexpr size_t FILE_SIZE_AT = 8;
+constexpr size_t NODE_COUNT_AT = 16;
+constexpr size_t TYPES_AT = 24;
+constexpr size_t TYPE_COUNT_AT = 32;
+constexpr size_t ATTRIBUTES_AT = 40;
+constexpr size_t ATTRIBUTE_COUNT_AT = 48;
+constexpr size_t NODES_AT = 56;
+constexpr size_t NODES_SIZE_AT = 64;
+constexpr size_t STRINGS_AT = 72;
+constexpr size_t STRINGS_SIZE_AT = 80;
+constexpr size_t HEADER_SIZE = 88;
+
+/*
+ * Type and attribute table entries: a 64-bit name offset, a 32-bit
+ * name length and, for attributes, the 32-bit AttributeType.
+ */
+constexpr size_t TABLE_ENTRY_SIZE = 16;
+
+constexpr size_t align(size_t size) {
+  return (size + 7) & ~size_t(7);
+}
+
+template <typename U> void store(std::vector<unsigned char>& bytes, size_t at, U value) {
+  std::memcpy(bytes.data() + at, &value, sizeof(U));
+}
+
+template <typename U> void append(std::vector<unsigned char>& bytes, U value) {
+  bytes.resize(bytes.size() + sizeof(U));
+  store(bytes, bytes.size() - sizeof(U), value);
+}
+
+class ContinuingAction : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+}
+
+/*
+ * Encodes a tree's nodes, types, attributes, and strings in the
+ * mapped tree layout.
+ */
+class MappedTreeEncoder : public BorrowedNodeAction<BaseAttrNode> {
+  std::vector<size_t> open_;  /* Records whose subtrees are incomplete */
+  std::unordered_map<std::string, std::uint64_t> string_offsets_;
+  std::unordered_map<const Supplier<BaseAttrNode> *, std::uint32_t> types_;
+  std::unordered_map<const Attribute *, std::uint32_t> keys_;
+
+public:
+  std::vector<unsigned char> nodes;
+  std::vector<unsigned char> types;
+  std::vector<unsigned char> attributes;
+  std::vector<unsigned char> strings;
+  size_t node_count = 0;
+
+  /*
+   * Returns a string's offset, adding the string if it is new.
+   */
+  std::uint64_t intern(std::string_view text) {
+    auto [position, added] =
+        string_offsets_.try_emplace(std::string(text), strings.size());
+    if (added) {
+      strings.insert(strings.end(), text.begin(), text.end());
+    }
+    return position->second;
+  }
+
+  void append_name(std::vector<unsigned char>& table, std::string_view name) {
+    append(table, intern(name));
+    append(table, static_cast<std::uint32_t>(name.size()));
+  }
+
+  std::uint32_t type(Supplier<BaseAttrNode>& supplier) {
+    auto [position, added] = types_.try_emplace(&supplier, types_.size());
+    if (added) {
+      append_name(types, supplier.class_name());
+      append(types, std::uint32_t(0));
+    }
+    return position->second;
+  }
+
+  MappedTree::Key key(const Attribute& attribute) {
+    auto [position, added] = keys_.try_emplace(&attribute, keys_.size());
+    if (added) {
+      append_name(attributes, attribute.name());
+      append(attributes, static_cast<std::uint32_t>(attribute.type()));
+    }
+    return position->second;
+  }
+
+  void append_value(const AttributeValue& value) {
+    std::string_view text;
+    std::uint64_t payload = 0;
+    switch (value.index()) {
+    case 0:
+      text = std::get<std::string>(value);
+      break;
+    case 1:
+      payload = std::bit_cast<std::uint64_t>(std::get<std::int64_t>(value));
+      break;
+    case 2:
+      payload = std::bit_cast<std::uint64_t>(std::get<double>(value));
+      break;
+    case 3:
+      payload = std::get<bool>(value);
+      break;
+    default:
+      text = std::get<InternedString>(value).view();
+      break;
+    }
+    if (std::numeric_limits<std::uint32_t>::max() < text.size()) {
+      throw IllegalOperation("Attribute value is too long to map.");
+    }
+    if (!text.empty()) {
+      payload = intern(text);
+    }
+    append(nodes, static_cast<std::uint32_t>(text.size()));
+    append(nodes, payload);
+  }
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    size_t offset = nodes.size();
+    append(nodes, type(node->supplier()));
+    append(nodes, static_cast<std::uint32_t>(
+        open_.empty() ? 0 : offset - open_.back()));
+    append(nodes, std::uint32_t(0));
+    append(nodes, static_cast<std::uint32_t>(node->attribute_map().size()));
+    for (const auto& entry : node->attribute_map()) {
+      append(nodes, key(*entry.attribute));
+      append_value(entry.value);
+    }
+    open_.push_back(offset);
+    ++node_count;
+    return TraversalStatus::CONTINUE;
+  }
+
+  /*
+   * Closes the most recently entered node that is still open.
+   */
+  void close(void) {
+    size_t subtree_size = nodes.size() - open_.back();
+    if (std::numeric_limits<std::uint32_t>::max() < subtree_size) {
+      throw IllegalOperation("Tree is too large to map.");
+    }
+    store(
+        nodes,
+        open_.back() + MappedTree::SUBTREE,
+        static_cast<std::uint32_t>(subtree_size));
+    open_.pop_back();
+  }
+};
+
+namespace {
+
+class ClosingAction : public BorrowedNodeAction<BaseAttrNode> {
+  MappedTreeEncoder& encoder_;
+
+public:
+  ClosingAction(MappedTreeEncoder& encoder) :
+      encoder_(encoder) {
+  }
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    encoder_.close();
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+}
+
+void MappedTree::write(BaseAttrNode *root, std::ostream& out) {
+  MappedTreeEncoder on_entry;
+  ClosingAction on_exit(on_entry);
+  BorrowingTraversal<BaseAttrNode> traversal(
+      on_entry,
+      on_exit,
+      VacuousVoidFunction::INSTANCE,
+      VacuousVoidFunction::INSTANCE);
+  traversal(root);
+
+  std::vector<unsigned char> header(HEADER_SIZE);
+  std::copy(std::begin(MAGIC), std::end(MAGIC), header.begin());
+  store(header, VERSION_AT, VERSION);
+  size_t at = align(HEADER_SIZE);
+  auto locate = [&](size_t offset_at, size_t size) {
+    store(header, offset_at, std::uint64_t(at));
+    at = align(at + size);
+  };
+  locate(TYPES_AT, on_entry.types.size());
+  locate(ATTRIBUTES_AT, on_entry.attributes.size());
+  locate(NODES_AT, on_entry.nodes.size());
+  locate(STRINGS_AT, on_entry.strings.size());
+  store(header, FILE_SIZE_AT, std::uint64_t(at));
+  store(header, NODE_COUNT_AT, std::uint64_t(on_entry.node_count));
+  store(header, TYPE_COUNT_AT,
+      std::uint64_t(on_entry.types.size() / TABLE_ENTRY_SIZE));
+  store(header, ATTRIBUTE_COUNT_AT,
+      std::uint64_t(on_entry.attributes.size() / TABLE_ENTRY_SIZE));
+  store(header, NODES_SIZE_AT, std::uint64_t(on_entry.nodes.size()));
+  store(header, STRINGS_SIZE_AT, std::uint64_t(on_entry.strings.size()));
+
+  static const char padding[8] = {};
+  for (const auto *region : {
+      &header,
+      &on_entry.types,
+      &on_entry.attributes,
+      &on_entry.nodes,
+      &on_entry.strings}) {
+    out.write(reinterpret_cast<const char *>(region->data()), region->size());
+    out.write(padding, align(region->size()) - region->size());
+  }
+  if (!out) {
+    throw IllegalOperation("Cannot write mapped tree: output stream failed.");
+  }
+}
+
+void MappedTree::attach(const void *data, size_t size) {
+  if (std::endian::native != std::endian::little) {
+    throw IllegalOperation("Mapped trees require a little endian host.");
+  }
+  auto bytes = static_cast<const unsigned char *>(data);
+  if (reinterpret_cast<std::uintptr_t>(bytes) % 8) {
+    throw IllegalOperation("Mapped tree data must be 8-byte aligned.");
+  }
+  if (size < HEADER_SIZE
+      || !std::equal(std::begin(MAGIC), std::end(MAGIC), bytes)) {
+    throw TreeCorruptError("Data does not contain a mapped tree.");
+  }
+  if (VERSION != load<std::uint32_t>(bytes + VERSION_AT)) {
+    throw TreeCorruptError("Mapped tree has an unsupported version.");
+  }
+  if (size != load<std::uint64_t>(bytes + FILE_SIZE_AT)) {
+    throw TreeCorruptError("Mapped tree is truncated.");
+  }
+  // Every region must lie within the data and be 8-byte aligned.
+  auto region = [&](size_t offset_at, std::uint64_t region_size) {
+    auto offset = load<std::uint64_t>(bytes + offset_at);
+    if (offset % 8 || size < offset || size - offset < region_size) {
+      throw TreeCorruptError("Mapped tree header is corrupt.");
+    }
+    return bytes + offset;
+  };
+  size_ = load<std::uint64_t>(bytes + NODE_COUNT_AT);
+  type_count_ = load<std::uint64_t>(bytes + TYPE_COUNT_AT);
+  attribute_count_ = load<std::uint64_t>(bytes + ATTRIBUTE_COUNT_AT);
+  nodes_size_ = load<std::uint64_t>(bytes + NODES_SIZE_AT);
+  strings_size_ = load<std::uint64_t>(bytes + STRINGS_SIZE_AT);
+  if (size / TABLE_ENTRY_SIZE < type_count_
+      || size / TABLE_ENTRY_SIZE < attribute_count_
+      || nodes_size_ < RECORD_SIZE) {
+    throw TreeCorruptError("Mapped tree header is corrupt.");
+  }
+  types_ = region(TYPES_AT, type_count_ * TABLE_ENTRY_SIZE);
+  attributes_ = region(ATTRIBUTES_AT, attribute_count_ * TABLE_ENTRY_SIZE);
+  nodes_ = region(NODES_AT, nodes_size_);
+  strings_ = reinterpret_cast<const char *>(
+      region(STRINGS_AT, strings_size_));
+
+  // Index the names, checking that they lie within the string region.
+  auto index = [&](const unsigned char *table, size_t count, auto& names) {
+    for (std::uint32_t i = 0; i < count; ++i) {
+      auto offset = load<std::uint64_t>(table + i * TABLE_ENTRY_SIZE);
+      auto length = load<std::uint32_t>(table + i * TABLE_ENTRY_SIZE + 8);
+      if (strings_size_ < offset || strings_size_ - offset < length) {
+        throw TreeCorruptError("Mapped tree name table is corrupt.");
+      }
+      names.emplace(text(offset, length), i);
+    }
+  };
+  index(types_, type_count_, type_index_);
+  index(attributes_, attribute_count_, key_index_);
+}
+
+MappedTree MappedTree::open(const std::string& path) {
+  int descriptor = ::open(path.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    throw IllegalOperation("Cannot open mapped tree " + path + '.');
+  }
+  struct stat status;
+  void *data = MAP_FAILED;
+  if (0 == fstat(descriptor, &status) && 0 < status.st_size) {
+    data = mmap(
+        nullptr, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+  }
+  ::close(descriptor);
+  if (MAP_FAILED == data) {
+    throw IllegalOperation("Cannot map tree " + path + '.');
+  }
+  size_t size = status.st_size;
+  MappedTree tree;
+  tree.storage_ = std::shared_ptr<const void>(
+      data,
+      [size](const void *data) { munmap(const_cast<void *>(data), size); });
+  tree.attach(data, size);
+  return tree;
+}
+
+MappedTree MappedTree::view(const void *data, size_t size) {
+  MappedTree tree;
+  tree.attach(data, size);
+  return tree;
+}
+
+std::string_view MappedTree::type_name(std::uint32_t type) const {
+  const unsigned char *entry = types_ + type * TABLE_ENTRY_SIZE;
+  return text(
+      load<std::uint64_t>(entry), load<std::uint32_t>(entry + 8));
+}
+
+std::uint32_t MappedTree::find_type(Supplier<BaseAttrNode>& supplier) const {
+  auto found = type_index_.find(supplier.class_name());
+  return found != type_index_.end() ? found->second : NOT_FOUND;
+}
+
+MappedTree::Key MappedTree::key(const Attribute& attribute) const {
+  auto found = key_index_.find(attribute.name());
+  if (found == key_index_.end()) {
+    return NOT_FOUND;
+  }
+  auto type = load<std::uint32_t>(
+      attributes_ + found->second * TABLE_ENTRY_SIZE + 12);
+  return static_cast<std::uint32_t>(attribute.type()) == type
+      ? found->second
+      : NOT_FOUND;
+}
+
+const unsigned char *MappedTree::find(size_t node, Key key) const {
+  const unsigned char *entry = record(node) + RECORD_SIZE;
+  const unsigned char *end = entry + ENTRY_SIZE * attribute_count(node);
+  for (; entry != end; entry += ENTRY_SIZE) {
+    if (key == load<Key>(entry + KEY)) {
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
+std::string_view MappedTree::get(size_t node, Key key) const {
+  const unsigned char *entry = find(node, key);
+  if (!entry) {
+    return std::string_view();
+  }
+  auto type = static_cast<AttributeType>(
+      load<std::uint32_t>(attributes_ + key * TABLE_ENTRY_SIZE + 12));
+  if (AttributeType::STRING != type && AttributeType::INTERNED != type) {
+    throw IllegalOperation(
+        "Attribute " + std::string(text(
+            load<std::uint64_t>(attributes_ + key * TABLE_ENTRY_SIZE),
+            load<std::uint32_t>(attributes_ + key * TABLE_ENTRY_SIZE + 8)))
+        + " does not have a string value.");
+  }
+  return text(
+      load<std::uint64_t>(entry + PAYLOAD),
+      load<std::uint32_t>(entry + LENGTH));
+}
+
+TraversalStatus MappedTree::traverse(
+    MappedNodeAction& on_entry,
+    MappedNodeAction& on_exit,
+    VoidFunction& after_descent,
+    VoidFunction& before_ascent,
+    size_t start) const {
+  // Nodes whose children are being traversed, and their subtree ends.
+  // A node's children are done when the traversal reaches its end.
+  std::vector<std::pair<size_t, size_t>> open;
+  size_t next = start;
+  TraversalStatus status;
+  do {
+    status = on_entry(*this, next);
+    if (TraversalStatus::CONTINUE == status && has_children(next)) {
+      after_descent();
+      open.emplace_back(next, subtree_end(next));
+      next = first_child(next);
+    } else {
+      if (TraversalStatus::CANCEL != status) {
+        status = exit(on_exit, next);
+      }
+      next = subtree_end(next);
+    }
+    while (TraversalStatus::CANCEL != status
+        && !open.empty()
+        && open.back().second == next) {
+      size_t exiting = open.back().first;
+      open.pop_back();
+      before_ascent();
+      status = exit(on_exit, exiting);
+    }
+  } while (TraversalStatus::CANCEL != status && !open.empty());
+  // As in Traversal, cancellation skips the exit action of every node
+  // still being processed, but each of them still ascends.
+  for (; !open.empty(); open.pop_back()) {
+    before_ascent();
+  }
+  return status;
+}
+
+} /* namespace VisitingParseTree */
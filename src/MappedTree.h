@@ -0,0 +1,427 @@
+/*
+ * MappedTree.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file MappedTree.h
+ *
+ * @brief Read-only tree that is traversed in place in a memory-mapped
+ *        file
+ */
+#ifndef MAPPEDTREE_H_
+#define MAPPEDTREE_H_
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#include "Attribute.h"
+#include "AttributeValue.h"
+#include "BaseAttrNode.h"
+#include "InternedString.h"
+#include "MappedNodeAction.h"
+#include "Supplier.h"
+#include "TraversalStatus.h"
+#include "TypedAttribute.h"
+#include "VacuousVoidFunction.h"
+#include "VoidFunction.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief A tree stored in a file that is used where it lies
+ *
+ * Deserializing a large tree costs time proportional to its size
+ * before the first node can be processed. A \c MappedTree file is
+ * laid out so that it can be mapped into memory and read in place:
+ * opening one validates a fixed-size header and nothing else, so the
+ * cost of a cold start is the page faults of the nodes actually
+ * visited.
+ *
+ * Nodes are records in a single region, in preorder, so a node's
+ * first child, if any, immediately follows it. Each record holds the
+ * node's type, the distances in bytes back to its parent and forward
+ * past its subtree, and its attributes. Strings, including type and
+ * attribute names, are offsets into a shared, deduplicated string
+ * region. Nodes are identified by handles, which are their records'
+ * offsets; the root's handle is 0.
+ *
+ * The tree mirrors \c FrozenTree: \c traverse() applies
+ * \c MappedNodeAction instances with \c Traversal semantics, and
+ * accessors read a node's structure and attributes. Since the nodes
+ * are not \c BaseAttrNode instances, types are identified by name,
+ * as are attributes, which callers in hot loops should resolve once
+ * with \c key().
+ *
+ * Files are written by \c write() in little endian byte order, and
+ * are limited to subtrees and strings of less than 4 GiB each.
+ * Mapped trees are immutable, so any number of threads can read one
+ * concurrently. Opening trusts the node records, so files \b must
+ * come from \c write().
+ */
+class MappedTree {
+public:
+  /**
+   * Identifies an attribute within a mapped tree.
+   */
+  using Key = std::uint32_t;
+
+  /**
+   * Returned by navigation methods when the requested node does not
+   * exist.
+   */
+  static constexpr size_t NO_NODE = static_cast<size_t>(-1);
+
+  /**
+   * Returned by \c key() and \c find_type() for attributes and types
+   * that the tree does not contain.
+   */
+  static constexpr std::uint32_t NOT_FOUND = static_cast<std::uint32_t>(-1);
+
+private:
+  /*
+   * Record layout. All fields are 32 bits unless stated otherwise.
+   */
+  static constexpr size_t TYPE = 0;  /** Type index */
+  static constexpr size_t PARENT = 4;  /** Bytes back to the parent */
+  static constexpr size_t SUBTREE = 8;  /** Bytes to the subtree's end */
+  static constexpr size_t ATTRIBUTE_COUNT = 12;  /** Number of attributes */
+  static constexpr size_t RECORD_SIZE = 16;  /** Fixed part of a record */
+
+  /*
+   * Attribute entry layout, following the fixed part of a record
+   */
+  static constexpr size_t KEY = 0;  /** Attribute key */
+  static constexpr size_t LENGTH = 4;  /** String length */
+  static constexpr size_t PAYLOAD = 8;  /** 64-bit value or string offset */
+  static constexpr size_t ENTRY_SIZE = 16;
+
+  friend class MappedTreeEncoder;
+
+  std::shared_ptr<const void> storage_;  /** Unmaps a mapped file */
+  const unsigned char *nodes_ = nullptr;  /** Node records */
+  size_t nodes_size_ = 0;  /** Bytes of node records */
+  size_t size_ = 0;  /** Number of nodes */
+  const unsigned char *types_ = nullptr;  /** Type table */
+  size_t type_count_ = 0;
+  const unsigned char *attributes_ = nullptr;  /** Attribute table */
+  size_t attribute_count_ = 0;
+  const char *strings_ = nullptr;  /** String region */
+  size_t strings_size_ = 0;
+  std::unordered_map<std::string_view, std::uint32_t> type_index_;
+  std::unordered_map<std::string_view, Key> key_index_;
+
+  MappedTree(void) = default;
+
+  /**
+   * @brief Validates a file's header and locates its regions
+   *
+   * @throws TreeCorruptError if the header is invalid
+   */
+  void attach(const void *data, size_t size);
+
+  template <typename U> static U load(const unsigned char *at) {
+    U value;
+    std::memcpy(&value, at, sizeof(U));
+    return value;
+  }
+
+  const unsigned char *record(size_t node) const {
+    return nodes_ + node;
+  }
+
+  std::string_view text(std::uint64_t offset, std::uint32_t length) const {
+    return std::string_view(strings_ + offset, length);
+  }
+
+  /**
+   * @return the node's entry for the attribute, or \c NULL if it has
+   *         none
+   */
+  const unsigned char *find(size_t node, Key key) const;
+
+  TraversalStatus exit(MappedNodeAction& on_exit, size_t node) const {
+    auto status = on_exit(*this, node);
+    return TraversalStatus::BYPASS_CHILDREN != status
+        ? status
+        : TraversalStatus::CONTINUE;
+  }
+
+public:
+  MappedTree(const MappedTree &other) = delete;
+  MappedTree(MappedTree &&other) = default;
+  MappedTree& operator=(const MappedTree &other) = delete;
+  MappedTree& operator=(MappedTree &&other) = default;
+  ~MappedTree() = default;
+
+  /**
+   * @brief Writes a tree in the mapped tree format
+   *
+   * @param root the root of the tree to write, which can be any node
+   *        in a containing tree. Must not be \c NULL.
+   * @param out destination
+   *
+   * @throws IllegalOperation if the tree exceeds the format's limits
+   *         or the stream fails
+   */
+  static void write(BaseAttrNode *root, std::ostream& out);
+
+  static void write(const std::shared_ptr<BaseAttrNode>& root, std::ostream& out) {
+    write(root.get(), out);
+  }
+
+  /**
+   * @brief Maps a file written by \c write() into memory
+   *
+   * @param path the file's path
+   * @return the mapped tree, which unmaps the file when destroyed
+   *
+   * @throws IllegalOperation if the file cannot be mapped
+   * @throws TreeCorruptError if the file is not a mapped tree
+   */
+  static MappedTree open(const std::string& path);
+
+  /**
+   * @brief Reads a tree from memory that already holds the bytes
+   *        that \c write() wrote
+   *
+   * @param data the bytes, which must be aligned on an 8-byte boundary
+   *        and must outlive the returned tree
+   * @param size the number of bytes
+   * @return the tree
+   *
+   * @throws TreeCorruptError if the bytes are not a mapped tree
+   */
+  static MappedTree view(const void *data, size_t size);
+
+  /**
+   * @return the number of nodes in the tree
+   */
+  size_t size(void) const {
+    return size_;
+  }
+
+  /**
+   * @return the root's handle
+   */
+  size_t root(void) const {
+    return 0;
+  }
+
+  /**
+   * @param node node handle
+   * @return the index of the node's type, which is less than
+   *         \c type_count()
+   */
+  std::uint32_t type(size_t node) const {
+    return load<std::uint32_t>(record(node) + TYPE);
+  }
+
+  /**
+   * @return the number of distinct node types in the tree
+   */
+  size_t type_count(void) const {
+    return type_count_;
+  }
+
+  /**
+   * @param type type index
+   * @return the class name of the type's \c Supplier
+   */
+  std::string_view type_name(std::uint32_t type) const;
+
+  /**
+   * @param supplier a node type
+   * @return the type's index, or \c NOT_FOUND if the tree does not
+   *         contain any node of the type
+   */
+  std::uint32_t find_type(Supplier<BaseAttrNode>& supplier) const;
+
+  /**
+   * @brief Resolves an attribute
+   *
+   * @param attribute the attribute to resolve
+   * @return the attribute's key in this tree, or \c NOT_FOUND if no
+   *         node in the tree has an attribute of the same name and
+   *         value type
+   */
+  Key key(const Attribute& attribute) const;
+
+  /**
+   * @param node node handle
+   * @return the parent's handle, or \c NO_NODE for the root
+   */
+  size_t parent(size_t node) const {
+    auto distance = load<std::uint32_t>(record(node) + PARENT);
+    return distance ? node - distance : NO_NODE;
+  }
+
+  /**
+   * @param node node handle
+   * @return the handle just past the node's last descendant
+   */
+  size_t subtree_end(size_t node) const {
+    return node + load<std::uint32_t>(record(node) + SUBTREE);
+  }
+
+  /**
+   * @param node node handle
+   * @return the number of attributes the node has
+   */
+  size_t attribute_count(size_t node) const {
+    return load<std::uint32_t>(record(node) + ATTRIBUTE_COUNT);
+  }
+
+  /**
+   * @param node node handle
+   * @return \c true if and only if the node has at least one child
+   */
+  bool has_children(size_t node) const {
+    return RECORD_SIZE + ENTRY_SIZE * attribute_count(node)
+        < load<std::uint32_t>(record(node) + SUBTREE);
+  }
+
+  /**
+   * @param node node handle
+   * @return the node's first child's handle, or \c NO_NODE if the node
+   *         is a leaf
+   */
+  size_t first_child(size_t node) const {
+    return has_children(node)
+        ? node + RECORD_SIZE + ENTRY_SIZE * attribute_count(node)
+        : NO_NODE;
+  }
+
+  /**
+   * @param node node handle
+   * @return the node's next sibling's handle, or \c NO_NODE if the
+   *         node is its parent's last child or is the root
+   */
+  size_t next_sibling(size_t node) const {
+    size_t up = parent(node);
+    if (NO_NODE == up) {
+      return NO_NODE;
+    }
+    size_t end = subtree_end(node);
+    return end < subtree_end(up) ? end : NO_NODE;
+  }
+
+  /**
+   * @param node node handle
+   * @param key attribute key
+   * @return \c true if and only if the node has the attribute
+   */
+  bool has(size_t node, Key key) const {
+    return find(node, key);
+  }
+
+  bool has(size_t node, const Attribute& attribute) const {
+    return find(node, key(attribute));
+  }
+
+  /**
+   * @brief Returns a node's string or interned attribute value, in
+   *        place
+   *
+   * @param node node handle
+   * @param key attribute key
+   * @return the attribute's value, or an empty view if the node does
+   *         not have the attribute. The view remains valid as long as
+   *         the tree does.
+   *
+   * @throws IllegalOperation if the attribute is a scalar
+   *         \c TypedAttribute
+   */
+  std::string_view get(size_t node, Key key) const;
+
+  std::string_view get(size_t node, const Attribute& attribute) const {
+    return get(node, key(attribute));
+  }
+
+  /**
+   * @brief Returns a node's scalar attribute value
+   *
+   * @tparam V the attribute's value type
+   * @param node node handle
+   * @param attribute the attribute to return
+   * @return the attribute's value, or a value-initialized \c V if the
+   *         node does not have the attribute
+   */
+  template <typename V>
+  requires (!std::same_as<V, InternedString>)
+  V get(size_t node, const TypedAttribute<V>& attribute) const {
+    return get<V>(node, key(attribute));
+  }
+
+  /**
+   * @brief Returns a node's scalar attribute value by key
+   *
+   * @tparam V the attribute's value type: \c std::int64_t, \c double,
+   *         or \c bool
+   * @param node node handle
+   * @param key the key of an attribute whose values are \c V
+   * @return the attribute's value, or a value-initialized \c V if the
+   *         node does not have the attribute
+   */
+  template <typename V> V get(size_t node, Key key) const {
+    const unsigned char *entry = find(node, key);
+    if (!entry) {
+      return V{};
+    }
+    if constexpr (std::is_same_v<V, bool>) {
+      return 0 != load<std::uint64_t>(entry + PAYLOAD);
+    } else {
+      return load<V>(entry + PAYLOAD);
+    }
+  }
+
+  /**
+   * @brief Traverses the subtree rooted at the specified node
+   *
+   * Applies actions in the same order, and with the same
+   * \c TraversalStatus semantics, as \c Traversal.
+   *
+   * @param on_entry applied to a newly entered node
+   * @param on_exit applied after traversing a node's children
+   * @param after_descent invoked before traversing a node's children
+   * @param before_ascent invoked after traversing a node's children
+   * @param start handle of the node where the traversal starts
+   * @return status that governs the traversal
+   */
+  TraversalStatus traverse(
+      MappedNodeAction& on_entry,
+      MappedNodeAction& on_exit,
+      VoidFunction& after_descent = VacuousVoidFunction::INSTANCE,
+      VoidFunction& before_ascent = VacuousVoidFunction::INSTANCE,
+      size_t start = 0) const;
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* MAPPEDTREE_H_ */
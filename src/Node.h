@@ -40,22 +40,31 @@
 #define NODE_H_
 
 #include <algorithm>
+#include <atomic>
 #include <concepts>
+#include <cstdint>
 #include <iterator>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "BaseNode.h"
+#include "BorrowedNodeAction.h"
 #include "IllegalOperation.h"
 #include "IllegalOnRoot.h"
 #include "NodeAction.h"
+#include "SlotIndex.h"
+#include "SmallVector.h"
 #include "TraversalStatus.h"
 #include "TreeCorruptError.h"
 
 namespace VisitingParseTree {
 
+class NodeArena;
 template <typename T> class Supplier;
+template <typename T, typename Pointer, typename Action>
+class TraversalEngine;
+template <typename T> class TreeBuilder;
 
 /*
  * Base class of all nodes. Note that implementations MUST
@@ -80,35 +89,190 @@ template <typename T> class Node :
     public BaseNode,
     public std::enable_shared_from_this<T> {
 //  static_assert(std::is_base_of_v<BaseNode, T>);
+  template <typename U, typename Pointer, typename Action>
+  friend class TraversalEngine;
+  friend class TreeBuilder<T>;
+
   Node(Node&) = delete;
   Node(const Node&) = delete;
   Node& operator=(Node&) = delete;
   Node& operator=(const Node&) = delete;
 
+  /**
+   * When a child count exceeds this value, detaching compacts the
+   * child vector once more than half of its slots are vacant. Smaller
+   * child vectors are compacted whenever a vacancy opens between two
+   * children.
+   */
+  static constexpr size_t COMPACTION_THRESHOLD = 16;
+
+  /**
+   * Number of children stored inside the node itself. Most nodes in
+   * expression trees have at most two children, so most nodes never
+   * allocate a separate child array.
+   */
+  static constexpr size_t INLINE_CHILDREN = 2;
+
+  using ChildVector = SmallVector<std::shared_ptr<T>, INLINE_CHILDREN>;
+
   std::weak_ptr<T> parent_;
-  std::vector<std::shared_ptr<T>> children_;
 
   /**
-   * @brief expands this nodes child vector to hold additional children
+   * @brief This node's children, in order.
    *
-   * @param number_of_additional_children the number of new child nodes
-   *        that the expanded child list must be able to hold \a without
-   *        requiring expansion
+   * Detaching a child vacates its slot (i.e. sets it empty) rather
+   * than erasing it, so that detach does not shift the child's younger
+   * siblings. Vacant slots never appear at the end of the vector;
+   * vacant slots at the front are counted separately so that detaching
+   * children oldest first does not require compaction.
    */
-  void accommodate_additional_children(size_t number_of_additional_children) {
-    children_.reserve(children_.size() + number_of_additional_children);
+  ChildVector children_;
+
+  /**
+   * @brief Locates the children when vacancies separate them, empty
+   *        otherwise
+   *
+   * Lets positional reads skip vacant slots without compacting the
+   * child vector, so reading never modifies the node.
+   */
+  std::unique_ptr<SlotIndex> slot_index_;
+
+  /**
+   * @brief Cached structural hash of this node's subtree, or 0 if none
+   *
+   * A node caches a hash only after all of its descendants have, so
+   * whenever a node's cache is empty, so are its ancestors'.
+   */
+  std::atomic<std::uint64_t> structural_hash_ = 0;
+
+  /**
+   * @brief The current revision, which stamps every change
+   *
+   * Revision 0 precedes every node, so a node is always newer than it.
+   */
+  static inline std::atomic<std::uint64_t> current_revision_{1};
+
+  /**
+   * @brief The latest revision in which this node or any of its
+   *        descendants changed
+   *
+   * Whenever a node is stamped with the current revision, so are all
+   * of its ancestors.
+   */
+  std::uint64_t revision_ =
+      current_revision_.load(std::memory_order_relaxed);
+
+  /**
+   * @brief The latest revision in which this node was created or
+   *        attached to a parent
+   */
+  std::uint64_t attach_revision_ = revision_;
+
+  size_t index_in_parent_ = 0;  /** This node's slot in its parent */
+  size_t leading_vacancies_ = 0;  /** Vacant slots preceding the first child */
+  size_t vacancies_ = 0;  /** Vacant slots, including the leading ones */
+
+  /**
+   * @brief Removes vacant slots from the child vector and renumbers
+   *        the remaining children.
+   */
+  void compact_children() {
+    if (0 < vacancies_) {
+      erase_if(
+          children_,
+          [](const std::shared_ptr<T>& child) { return !child; });
+      renumber_children(0);
+      leading_vacancies_ = 0;
+      vacancies_ = 0;
+    }
+    slot_index_.reset();
+  }
+
+  /**
+   * @brief Indexes the child vector if vacancies separate children,
+   *        and discards the index otherwise
+   */
+  void reindex_children() {
+    if (leading_vacancies_ == vacancies_) {
+      slot_index_.reset();
+    } else {
+      slot_index_ = std::make_unique<SlotIndex>(children_);
+    }
+  }
+
+  /**
+   * @brief Records each child's slot, starting from the specified slot
+   *
+   * @param first_slot first slot to renumber
+   */
+  void renumber_children(size_t first_slot) {
+    for (size_t slot = first_slot; slot < children_.size(); ++slot) {
+      if (children_[slot]) {
+        children_[slot]->index_in_parent_ = slot;
+      }
+    }
+  }
+
+  /**
+   * @brief Empties the specified child slot without moving any other
+   *        child.
+   *
+   * Trailing vacancies are trimmed immediately, and the child vector
+   * is compacted once vacancies outnumber children. A wide node is
+   * indexed when the first vacancy opens between its children, and
+   * the index is kept and updated in logarithmic time until the next
+   * compaction, whatever order the children leave in. Building the
+   * index costs no more than the detaches that precede the next
+   * compaction, so a sequence of detaches costs amortized logarithmic
+   * time per detach, and constant time if the children are detached
+   * oldest or youngest first.
+   *
+   * @param slot slot to vacate, which \b must hold a child
+   * @return the removed child
+   */
+  std::shared_ptr<T> vacate(size_t slot) {
+    record_change();
+    std::shared_ptr<T> removed = std::move(children_[slot]);
+    ++vacancies_;
+    if (slot_index_) {
+      slot_index_->vacate(slot);
+    }
+    while (leading_vacancies_ < children_.size()
+        && !children_[leading_vacancies_]) {
+      ++leading_vacancies_;
+    }
+    while (!children_.empty() && !children_.back()) {
+      children_.pop_back();
+      --vacancies_;
+      if (slot_index_) {
+        slot_index_->pop_back();
+      }
+    }
+    leading_vacancies_ = std::min(leading_vacancies_, children_.size());
+    if (COMPACTION_THRESHOLD < children_.size()
+        && children_.size() < 2 * vacancies_) {
+      compact_children();
+    } else if (leading_vacancies_ == vacancies_) {
+      // Every vacancy precedes the first child; keep any index.
+    } else if (children_.size() <= COMPACTION_THRESHOLD) {
+      compact_children();
+    } else if (!slot_index_) {
+      slot_index_ = std::make_unique<SlotIndex>(children_);
+    }
+    return removed;
   }
 
   /**
    * @brief Disconnects this node and its children from its parent. Does
    *        nothing if invoked on a root.
-   *
-   * @param position
    */
-  void disconnect_from_parent(
-      std::vector<std::shared_ptr<T>>::const_iterator position) {
+  void disconnect_from_parent() {
     if (auto p = parent()) {
-      p->children_.erase(position);
+      if (index_in_parent_ >= p->children_.size()
+          || this != p->children_[index_in_parent_].get()) {
+        throw TreeCorruptError("Child not found in parent.");
+      }
+      auto self = p->vacate(index_in_parent_);
       parent_.reset();
     }
   }
@@ -131,6 +295,116 @@ template <typename T> class Node :
 protected:
   Node() = default;
 
+  /**
+   * @return this node's cached structural hash, or 0 if it has none
+   */
+  std::uint64_t cached_structural_hash(void) const {
+    return structural_hash_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Caches this node's structural hash
+   *
+   * @param hash the hash, which must not be 0, computed after every
+   *        child's hash was cached
+   */
+  void cache_structural_hash(std::uint64_t hash) {
+    structural_hash_.store(hash, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Discards the cached structural hashes of this node and its
+   *        ancestors
+   *
+   * Stops at the first node without a cached hash, whose ancestors
+   * have none either, so repeated changes to an uncached tree cost
+   * constant time.
+   */
+  void invalidate_structural_hash(void) {
+    if (!cached_structural_hash()) {
+      return;
+    }
+    structural_hash_.store(0, std::memory_order_relaxed);
+    for (auto node = parent();
+        node && node->cached_structural_hash();
+        node = node->parent()) {
+      node->structural_hash_.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Records a change to this node's attributes or children
+   *
+   * Discards the cached structural hashes that the change invalidates
+   * and stamps this node and its ancestors with the current revision.
+   * Stamping stops at the first node already stamped, whose ancestors
+   * are stamped too, so repeated changes within a revision cost
+   * constant time.
+   */
+  void record_change(void) {
+    invalidate_structural_hash();
+    auto revision = current_revision_.load(std::memory_order_relaxed);
+    if (revision_ == revision) {
+      return;
+    }
+    revision_ = revision;
+    for (auto node = parent();
+        node && node->revision_ != revision;
+        node = node->parent()) {
+      node->revision_ = revision;
+    }
+  }
+
+  /**
+   * @brief Stamps a node that is being attached to a parent with the
+   *        current revision
+   *
+   * The parent's path is stamped by its own \c record_change().
+   * Stamping the attached node, rather than every node below it,
+   * keeps attaching constant time; \c attach_revision() tells readers
+   * that the whole subtree is new to its tree.
+   *
+   * @param child the node being attached
+   */
+  static void stamp_attached(T *child) {
+    auto revision = current_revision_.load(std::memory_order_relaxed);
+    child->revision_ = revision;
+    child->attach_revision_ = revision;
+  }
+
+  /**
+   * @brief Adds the specified node as this node's youngest child,
+   *        taking over the caller's reference
+   *
+   * The node must be a root, as for \c append_child().
+   *
+   * @param new_child child node to append
+   * @return the appended child
+   */
+  T *adopt_child(std::shared_ptr<T> new_child) {
+    record_change();
+    T *child = new_child.get();
+    stamp_attached(child);
+    child->index_in_parent_ = children_.size();
+    child->parent_ = std::enable_shared_from_this<T>::weak_from_this();
+    children_.push_back(std::move(new_child));
+    if (slot_index_) {
+      slot_index_->push_back();
+    }
+    return child;
+  }
+
+  /**
+   * @brief expands this nodes child vector to hold additional children
+   *
+   * @param number_of_additional_children the number of new child nodes
+   *        that the expanded child list must be able to hold \a without
+   *        requiring expansion
+   */
+  void accommodate_additional_children(size_t number_of_additional_children) {
+    children_.reserve(children_.size() + number_of_additional_children);
+  }
+
   /**
    * @brief Dummy constructor parameter type for concrete generated
    *        nodes.
@@ -168,21 +442,72 @@ protected:
    *         the returned iterator to \c insert_start, as the former
    *         is guaranteed to be valid and the latter is not.
    */
-  std::vector<std::shared_ptr<T>>::iterator insert_before(
-      std::vector<std::shared_ptr<T>>::iterator insert_start,
+  ChildVector::iterator insert_before(
+      ChildVector::iterator insert_start,
       const std::vector<std::shared_ptr<T>>& to_insert) {
+    record_change();
     const auto w = std::enable_shared_from_this<T>::weak_from_this();
     std::for_each(
         to_insert.begin(),
         to_insert.end(),
-        [w](std::shared_ptr<T> t) { t->parent_ = w; });
+        [w](const std::shared_ptr<T>& t) {
+          t->parent_ = w;
+          stamp_attached(t.get());
+        });
     auto p = children_.insert(insert_start, to_insert.begin(), to_insert.end());
+    size_t first_inserted = p - children_.begin();
+    leading_vacancies_ = std::min(leading_vacancies_, first_inserted);
+    renumber_children(first_inserted);
+    reindex_children();
     return p;
   }
 
 public:
 
-  virtual ~Node() = default;
+  /**
+   * @brief Destroys this node and every descendant that nothing else
+   *        owns
+   *
+   * Dismantles the subtree iteratively, so that destroying a deep
+   * tree does not recurse once per level and exhaust the stack. The
+   * outermost node destructor running on a thread releases the
+   * references to its children one at a time. A descendant destroyed
+   * while it runs hands its own children to the outermost destructor
+   * instead of releasing them itself, so the destructor never nests
+   * more than one level deep.
+   *
+   * A descendant's children are taken only once its own destructors,
+   * including those of derived classes, have run, so those
+   * destructors see the descendant intact. Releasing a reference
+   * never strips a node that something else owns, so a descendant
+   * that another thread owns, or is locking through a
+   * \c std::weak_ptr, survives along with its subtree.
+   */
+  virtual ~Node() {
+    if (children_.empty()) {
+      return;
+    }
+    static thread_local std::vector<std::shared_ptr<T>> *doomed = nullptr;
+    if (doomed) {
+      for (auto& child : children_) {
+        if (child) {
+          doomed->push_back(std::move(child));
+        }
+      }
+      return;
+    }
+    std::vector<std::shared_ptr<T>> pending(
+        std::make_move_iterator(children_.begin()),
+        std::make_move_iterator(children_.end()));
+    children_.clear();
+    doomed = &pending;
+    while (!pending.empty()) {
+      // Releasing the node can append its children to pending.
+      std::shared_ptr<T> node = std::move(pending.back());
+      pending.pop_back();
+    }
+    doomed = nullptr;
+  }
 
   /**
    * @brief Adds the specified node as this node's youngest child.
@@ -199,8 +524,7 @@ public:
    * @return \c new_child, for chaining
    */
   std::shared_ptr<T> append_child(std::shared_ptr<T> new_child) {
-    children_.push_back(new_child);
-    new_child->parent_ = std::enable_shared_from_this<T>::weak_from_this();
+    adopt_child(new_child);
     return new_child;
   }
 
@@ -216,6 +540,22 @@ public:
     return append_child(supplier.make_shared());
   }
 
+  /**
+   * @brief Creates a node in the specified arena as this node's
+   *        youngest child.
+   *
+   * @param supplier the factory that will allocate the new
+   *        child node
+   * @param arena provides the new child's storage
+   * @return the newly appended child. Note that its parent will be
+   *         set to \c this.
+   *
+   * \see Supplier::allocate_shared()
+   */
+  std::shared_ptr<T> append_child(Supplier<T>& supplier, NodeArena& arena) {
+    return append_child(supplier.allocate_shared(arena));
+  }
+
   /**
    * @brief Adds the specified node as this node's youngest
    *        sibling.
@@ -263,6 +603,26 @@ public:
     }
   }
 
+  /**
+   * @brief Creates a new node in the specified arena as this node's
+   *        youngest sibling
+   *
+   * @param supplier the Supplier (i.e. factory) to provide the
+   *                 added node
+   * @param arena provides the new sibling's storage
+   *
+   * @return the newly appended sibling
+   *
+   * \throws IllegalOnRoot if this node is a root
+   */
+  std::shared_ptr<T> append_sibling(Supplier<T>& supplier, NodeArena& arena) {
+    if (auto p = parent()) {
+      return p->append_child(supplier, arena);
+    } else {
+      throw IllegalOnRoot("Cannot append a sibling to a root node.");
+    }
+  }
+
   /**
    * @brief Retrieves the child at the specified index
    *
@@ -273,9 +633,54 @@ public:
    *         otherwise
    */
   std::shared_ptr<T> child(size_t index) {
-    return 0 <= index && index < child_count()
-        ? children_[index]
-        : std::shared_ptr<T>();
+    if (index >= child_count()) {
+      return std::shared_ptr<T>();
+    }
+    return children_[
+        slot_index_ ? slot_index_->slot(index) : leading_vacancies_ + index];
+  }
+
+  /**
+   * @brief Provides this node's position among its siblings
+   *
+   * @return the index for which this node's parent's \c child()
+   *         returns this node
+   *
+   * \throws IllegalOnRoot if invoked on a root node
+   */
+  size_t child_index() {
+    auto my_parent = parent();
+    if (!my_parent) {
+      throw IllegalOnRoot("A root node has no child index.");
+    }
+    return my_parent->slot_index_
+        ? my_parent->slot_index_->position(index_in_parent_)
+        : index_in_parent_ - my_parent->leading_vacancies_;
+  }
+
+  /**
+   * @brief Inserts a node among this node's children
+   *
+   * The node to insert \b must be a root, otherwise both its
+   * containing tree and the tree that contains this node become
+   * corrupt.
+   *
+   * @param index the new child's index, in [0 .. \c child_count()].
+   *        Children at and after \c index move one place to the right.
+   * @param new_child the node to insert
+   * @return \c new_child, for chaining
+   *
+   * \throws IllegalOperation if \c index exceeds the child count
+   */
+  std::shared_ptr<T> insert_child(size_t index, std::shared_ptr<T> new_child) {
+    if (child_count() < index) {
+      throw IllegalOperation("Child index out of range.");
+    }
+    compact_children();
+    insert_before(
+        children_.begin() + index,
+        std::vector<std::shared_ptr<T>>{new_child});
+    return new_child;
   }
 
   /**
@@ -285,7 +690,7 @@ public:
    *         0 for a leaf node.
    */
   size_t child_count() const {
-    return children_.size();
+    return children_.size() - vacancies_;
   }
 
   /**
@@ -295,11 +700,13 @@ public:
    * This node becomes a root.
    * Its descendants (its children, their children, etc.) will be
    * unchanged and the newly liberated tree remains valid.
+   *
+   * Detaching takes at most amortized logarithmic time: it neither
+   * searches for this node in its parent nor shifts this node's
+   * younger siblings.
    */
   void detach() {
-    if (auto p = parent()) {
-      disconnect_from_parent(find_in_parent());
-    }
+    disconnect_from_parent();
   }
 
   /**
@@ -311,7 +718,11 @@ public:
    *         leaf.
    */
   std::vector<std::shared_ptr<T>> disconnect_all_children() {
-    std::vector<std::shared_ptr<T>> destination(children_);
+    record_change();
+    compact_children();
+    std::vector<std::shared_ptr<T>> destination(
+        std::make_move_iterator(children_.begin()),
+        std::make_move_iterator(children_.end()));
     children_.clear();
     std::for_each(
         destination.begin(),
@@ -348,8 +759,7 @@ public:
   void excise() {
     if (auto my_parent = parent()) {
       if (has_children()) {
-        size_t child_count = children_.size();
-        my_parent->accommodate_additional_children(child_count);
+        my_parent->accommodate_additional_children(child_count());
         auto insert_point = find_in_parent();
         std::vector<std::shared_ptr<T>> children_to_promote = disconnect_all_children();
         my_parent->insert_before(insert_point, children_to_promote);
@@ -364,6 +774,9 @@ public:
   /**
    * @brief Finds this node in its parent
    *
+   * Every node records its position in its parent's child list, so
+   * finding a node takes constant time.
+   *
    * @return an iterator pointing to this node within its
    *         parent's child list.
    *
@@ -371,20 +784,17 @@ public:
    * \throws TreeCorruptError if this node is not a child of its parent
    */
 
-  std::vector<std::shared_ptr<T>>::iterator find_in_parent() {
+  ChildVector::iterator find_in_parent() {
     auto my_parent = parent();
     if (!my_parent) {
       throw TreeCorruptError(
           "Cannot find a root in its parent.");
     }
-    for (auto it = my_parent->children_.begin();
-        it != my_parent->children_.end();
-        ++it) {
-      if (this == (*it).get()) {
-        return it;
-      }
+    if (index_in_parent_ >= my_parent->children_.size()
+        || this != my_parent->children_[index_in_parent_].get()) {
+      throw TreeCorruptError("Child not found in parent.");
     }
-    throw TreeCorruptError("Child not found in parent.");
+    return my_parent->children_.begin() + index_in_parent_;
   }
 
   /**
@@ -408,13 +818,41 @@ public:
   TraversalStatus for_each_child(NodeAction<T>& action) {
     auto result = TraversalStatus::CONTINUE;
 
-    for (auto current = children_.begin();
-        TraversalStatus::CANCEL != result && current != children_.end();
-        ++current) {
-      if (!(*current)) {
-        throw TreeCorruptError("NULL child node encountered.");
+    for (size_t slot = leading_vacancies_;
+        TraversalStatus::CANCEL != result && slot < children_.size();
+        ++slot) {
+      if (children_[slot]) {
+        result = action(children_[slot]);
+      }
+    }
+
+    return TraversalStatus::BYPASS_CHILDREN == result
+        ? TraversalStatus::CONTINUE
+        : result;
+  }
+
+  /**
+   * @brief Applies a borrowed node action to each of this node's
+   *        children
+   *
+   * Behaves like \c for_each_child(NodeAction<T>&), but lends each
+   * child to the action instead of sharing its ownership, so no
+   * reference counts change.
+   *
+   * @param action \c BorrowedNodeAction to apply. It \b must \b not
+   *        release any of this node's children.
+   * @return \c TraversalStatus::CANCEL when the action cancels traversal;
+   *         \c TraversalStatus::CONTINUE otherwise.
+   */
+  TraversalStatus for_each_child(BorrowedNodeAction<T>& action) {
+    auto result = TraversalStatus::CONTINUE;
+
+    for (size_t slot = leading_vacancies_;
+        TraversalStatus::CANCEL != result && slot < children_.size();
+        ++slot) {
+      if (T *child = children_[slot].get()) {
+        result = action(child);
       }
-      result = action(*current);
     }
 
     return TraversalStatus::BYPASS_CHILDREN == result
@@ -437,6 +875,46 @@ public:
     return !children_.empty();
   }
 
+  /**
+   * @brief Provides this node's next younger sibling
+   *
+   * @return the sibling that immediately follows this node in its
+   *         parent's child list, or a vacuous value if this node is
+   *         the youngest child or a root.
+   */
+  std::shared_ptr<T> next_sibling() {
+    if (auto p = parent()) {
+      size_t slot = p->slot_index_
+          ? p->slot_index_->next(index_in_parent_)
+          : index_in_parent_ + 1;
+      if (slot < p->children_.size()) {
+        return p->children_[slot];
+      }
+    }
+    return std::shared_ptr<T>();
+  }
+
+  /**
+   * @brief Provides this node's next older sibling
+   *
+   * @return the sibling that immediately precedes this node in its
+   *         parent's child list, or a vacuous value if this node is
+   *         the oldest child or a root.
+   */
+  std::shared_ptr<T> previous_sibling() {
+    if (auto p = parent()) {
+      if (p->slot_index_) {
+        size_t slot = p->slot_index_->previous(index_in_parent_);
+        if (slot < p->children_.size()) {
+          return p->children_[slot];
+        }
+      } else if (p->leading_vacancies_ < index_in_parent_) {
+        return p->children_[index_in_parent_ - 1];
+      }
+    }
+    return std::shared_ptr<T>();
+  }
+
   /*
    * A convenience method that returns true if and only if
    * this node is a leaf, i.e. if it has no children.
@@ -477,6 +955,53 @@ public:
     return parent_.lock();
   }
 
+  /**
+   * @brief Returns the latest revision in which this subtree changed
+   *
+   * Every change to a node's attributes or children is stamped with
+   * the current revision, as are the node's ancestors. New nodes start
+   * in the current revision, and so do nodes attached to a parent. A
+   * subtree is therefore unchanged since revision \c r if and only if
+   * its root's revision does not exceed \c r.
+   *
+   * @return the latest revision in which this node or one of its
+   *         descendants was created, attached, or changed
+   */
+  std::uint64_t revision() const {
+    return revision_;
+  }
+
+  /**
+   * @brief Returns the latest revision in which this node was created
+   *        or attached to a parent
+   *
+   * Attaching a subtree stamps only its root. If the root was attached
+   * after revision \c r, the whole subtree is new to a reader that
+   * last looked at the tree in revision \c r, even where the
+   * descendants' own revisions are older.
+   *
+   * @return the revision in which this node was last attached, or
+   *         created if it has never been attached
+   */
+  std::uint64_t attach_revision() const {
+    return attach_revision_;
+  }
+
+  /**
+   * @brief Starts a new revision
+   *
+   * Callers that record a revision and later look for newer changes,
+   * such as \c IncrementalTraversal, start a new revision so that
+   * subsequent changes are distinguishable from earlier ones.
+   * Revisions are shared by all trees of type \c T.
+   *
+   * @return the revision that ended, which stamps every change made
+   *         before this call
+   */
+  static std::uint64_t next_revision() {
+    return current_revision_.fetch_add(1, std::memory_order_relaxed);
+  }
+
   /*
    * Returns this node type's supplier. To be implemented
    * ONLY by concrete classes.
@@ -0,0 +1,43 @@
+/*
+ * NodeArena.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file NodeArena.cpp
+ *
+ * Node arena implementation
+ */
+
+#include "NodeArena.h"
+
+namespace VisitingParseTree {
+
+NodeArena::NodeArena(size_t initial_size) :
+    resource_(initial_size) {
+}
+
+std::shared_ptr<NodeArena> NodeArena::make_shared(size_t initial_size) {
+  // The constructor is private, so std::make_shared cannot reach it.
+  return std::shared_ptr<NodeArena>(new NodeArena(initial_size));
+}
+
+} /* namespace VisitingParseTree */
@@ -0,0 +1,196 @@
+/*
+ * NodeArena.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file NodeArena.h
+ *
+ * @brief Bulk node storage
+ *
+ * A \c NodeArena hands out node storage from large, contiguous blocks
+ * instead of allocating each node separately from the heap. All nodes
+ * in an arena are released together when the last of them dies.
+ */
+
+#ifndef NODEARENA_H_
+#define NODEARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Per-tree node storage
+ *
+ * Suppliers allocate nodes into an arena via
+ * \c Supplier::allocate_shared(). Each node's \c std::shared_ptr
+ * control block and the node itself share a single allocation carved
+ * from the arena's current block, so building a tree costs one heap
+ * allocation per block rather than one per node, and nodes that are
+ * created together sit together in memory.
+ *
+ * Arena storage is never returned piecemeal. Every node allocated
+ * from an arena holds a reference to it, and the arena releases all
+ * of its blocks at once when its last node (and the last external
+ * reference) goes away. Detaching a node from an arena-backed tree
+ * is safe: the detached node keeps the arena alive.
+ *
+ * Arenas are \b not thread-safe. Concurrent allocation from a single
+ * arena is forbidden; use one arena per thread (e.g. per parse).
+ */
+class NodeArena : public std::enable_shared_from_this<NodeArena> {
+  template <typename U> friend class ArenaAllocator;
+
+  std::pmr::monotonic_buffer_resource resource_;  /** Block storage */
+
+  /**
+   * @brief Constructor
+   *
+   * @param initial_size size of the first block in bytes. Subsequent
+   *        blocks grow geometrically.
+   */
+  NodeArena(size_t initial_size);
+
+public:
+  /**
+   * Size of the first block when the caller does not specify one.
+   */
+  static constexpr size_t DEFAULT_INITIAL_SIZE = 64 * 1024;
+
+  NodeArena(const NodeArena &other) = delete;
+  NodeArena(NodeArena &&other) = delete;
+  NodeArena& operator=(const NodeArena &other) = delete;
+  NodeArena& operator=(NodeArena &&other) = delete;
+
+  virtual ~NodeArena() = default;
+
+  /**
+   * @brief Creates an arena
+   *
+   * Arenas must be managed by \c std::shared_ptr because the nodes
+   * they contain share ownership of them.
+   *
+   * @param initial_size size of the first storage block, in bytes
+   *
+   * @return the newly created arena
+   */
+  static std::shared_ptr<NodeArena> make_shared(
+      size_t initial_size = DEFAULT_INITIAL_SIZE);
+
+  /**
+   * @brief Allocates and constructs an object in this arena
+   *
+   * The arena's counterpart to \c std::make_shared. Generated suppliers
+   * invoke it from \c allocate_shared().
+   *
+   * @tparam U type to construct
+   * @tparam Args constructor argument types
+   *
+   * @param args arguments to forward to the \c U constructor
+   *
+   * @return the newly constructed object
+   */
+  template <typename U, typename... Args>
+  std::shared_ptr<U> make_shared(Args&&... args);
+};
+
+/**
+ * @brief Standard allocator that draws its storage from a \c NodeArena
+ *
+ * Copies of the allocator, including the copy that
+ * \c std::allocate_shared stores in each control block, share
+ * ownership of the arena, which keeps the arena alive for as long
+ * as any node allocated from it.
+ *
+ * @tparam U allocated type
+ */
+template <typename U> class ArenaAllocator {
+  template <typename V> friend class ArenaAllocator;
+
+  std::shared_ptr<NodeArena> arena_;  /** Storage source */
+
+public:
+  using value_type = U;
+
+  /**
+   * @brief Constructor
+   *
+   * @param arena the arena to allocate from
+   */
+  explicit ArenaAllocator(std::shared_ptr<NodeArena> arena) :
+    arena_(std::move(arena)) {
+  }
+
+  /**
+   * @brief Rebinding constructor required by the standard allocator
+   *        model
+   *
+   * @param other allocator to rebind
+   */
+  template <typename V> ArenaAllocator(const ArenaAllocator<V>& other) :
+    arena_(other.arena_) {
+  }
+
+  /**
+   * @brief Allocates uninitialized arena storage
+   *
+   * @param n number of objects to accommodate
+   *
+   * @return a pointer to the allocated storage
+   */
+  U* allocate(size_t n) {
+    return static_cast<U*>(
+        arena_->resource_.allocate(n * sizeof(U), alignof(U)));
+  }
+
+  /**
+   * @brief Does nothing. Arena storage is released when the arena dies.
+   */
+  void deallocate(U*, size_t) noexcept {
+  }
+
+  /**
+   * Comparison
+   *
+   * @param that allocator to compare
+   *
+   * @return \c true if and only if both allocators draw from the same
+   *         arena
+   */
+  template <typename V> bool operator==(const ArenaAllocator<V>& that) const {
+    return arena_ == that.arena_;
+  }
+};
+
+template <typename U, typename... Args>
+std::shared_ptr<U> NodeArena::make_shared(Args&&... args) {
+  return std::allocate_shared<U>(
+      ArenaAllocator<U>(shared_from_this()),
+      std::forward<Args>(args)...);
+}
+
+} /* namespace VisitingParseTree */
+
+#endif /* NODEARENA_H_ */
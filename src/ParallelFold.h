@@ -0,0 +1,372 @@
+/*
+ * ParallelFold.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ParallelFold.h
+ *
+ * @brief Bottom-up computation of a value for every node in a tree
+ *        that processes independent subtrees concurrently
+ */
+#ifndef PARALLELFOLD_H_
+#define PARALLELFOLD_H_
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "BorrowedNodeAction.h"
+#include "Fold.h"
+#include "FoldFunction.h"
+#include "SubtreeSize.h"
+#include "TaskGroup.h"
+#include "TraversalStatus.h"
+#include "WorkStealingPool.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Computes a value for every node in a tree from the values of
+ *        its children, folding large sibling subtrees concurrently
+ *
+ * Produces the same values, in the same preorder layout, as \c Fold,
+ * but forks subtrees of at least \c grain_size nodes to a
+ * \c WorkStealingPool, so the function \b must be thread safe.
+ * Functions for sibling subtrees can run in any order, but a node's
+ * function always runs after those of its children.
+ *
+ * Each task writes its values to a private piece of the result, and
+ * records where the pieces that it forked belong. Once every task
+ * completes, the fold splices the pieces into the dense result in
+ * preorder. As in \c ParallelTraversal, subtrees smaller than
+ * \c grain_size run sequentially, and consecutive small siblings are
+ * batched into tasks of about \c grain_size nodes.
+ *
+ * If the function throws, the fold waits for running tasks to finish
+ * and rethrows the first exception.
+ *
+ * @tparam T node type being folded, which must inherit \c Node<T>
+ * @tparam R value type, which must be default constructible and
+ *         copyable
+ */
+template <typename T, typename R> class ParallelFold {
+  /**
+   * @brief Values computed by one task, in preorder, and the pieces
+   *        that belong between them
+   */
+  struct Piece {
+    std::vector<R> values;  /** Values, in preorder */
+
+    /** Forked pieces, each preceding the value at its position */
+    std::vector<std::pair<size_t, std::unique_ptr<Piece>>> splices;
+  };
+
+  /**
+   * @brief Where to find a computed value
+   */
+  struct ValueReference {
+    Piece *piece;  /** The piece containing the value */
+    size_t index;  /** The value's position in the piece */
+  };
+
+  /**
+   * @brief A node folded in parallel whose value is pending
+   */
+  struct Frame {
+    T *node;  /** The node */
+    Piece *piece;  /** The piece that holds its value */
+    size_t index;  /** The value's position in the piece */
+    std::vector<ValueReference> children;  /** Its children's values */
+    std::unique_ptr<TaskGroup> tasks;  /** Its children's tasks */
+  };
+
+  /**
+   * @brief Collects a node's children
+   */
+  class CollectingAction : public BorrowedNodeAction<T> {
+    std::vector<T *>& children_;
+
+  public:
+    CollectingAction(std::vector<T *>& children) :
+        children_(children) {
+    }
+
+    virtual TraversalStatus operator()(T *node) override {
+      children_.push_back(node);
+      return TraversalStatus::CONTINUE;
+    }
+  };
+
+  FoldFunction<T, R>& function_;
+  WorkStealingPool& pool_;
+  const size_t grain_size_;
+
+  /**
+   * @brief Folds small subtrees sequentially
+   *
+   * @param roots subtree roots
+   * @param piece receives the subtrees' values
+   */
+  void run_sequentially(const std::vector<T *>& roots, Piece& piece) {
+    Fold<T, R> fold(function_);
+    for (T *root : roots) {
+      fold.append(root, piece.values);
+    }
+  }
+
+  /**
+   * @brief Folds a batch of small siblings
+   *
+   * Folds large batches in a separate task and small ones on the
+   * current thread.
+   *
+   * @param batch sibling subtree roots, emptied on return
+   * @param sizes the siblings' subtree sizes, emptied on return
+   * @param batch_size total number of nodes in the batch
+   * @param frame the siblings' parent
+   */
+  void flush(
+      std::vector<T *>& batch,
+      std::vector<size_t>& sizes,
+      size_t batch_size,
+      Frame& frame) {
+    Piece *piece = frame.piece;
+    if (grain_size_ <= batch_size) {
+      auto forked = std::make_unique<Piece>();
+      piece = forked.get();
+      frame.piece->splices.emplace_back(
+          frame.piece->values.size(),
+          std::move(forked));
+    }
+    size_t index = piece->values.size();
+    for (size_t size : sizes) {
+      frame.children.push_back(ValueReference{piece, index});
+      index += size;
+    }
+    if (piece == frame.piece) {
+      run_sequentially(batch, *piece);
+    } else {
+      frame.tasks->run([this, batch = std::move(batch), piece]() {
+        run_sequentially(batch, *piece);
+      });
+    }
+    batch.clear();
+    sizes.clear();
+  }
+
+  /**
+   * @brief Folds a subtree into a piece, forking large child subtrees
+   *
+   * Keeps the nodes awaiting their values on an explicit stack, and
+   * continues into one large child on the current thread, so that
+   * deep trees do not exhaust the thread stack. Every large child but
+   * the last gets a piece of its own; the last shares its parent's
+   * piece, because nothing follows its values in preorder.
+   *
+   * @param root subtree root
+   * @param root_piece receives the subtree's values
+   */
+  void run_in_parallel(T *root, Piece& root_piece) {
+    std::vector<Frame> pending;
+    std::vector<T *> children;
+    std::vector<T *> batch;
+    std::vector<size_t> sizes;
+    std::vector<size_t> child_sizes;
+    std::vector<R> child_values;
+    T *current = root;
+    Piece *piece = &root_piece;
+    for (;;) {
+      while (current) {
+        size_t index = piece->values.size();
+        piece->values.emplace_back();
+        if (!current->has_children()) {
+          piece->values[index] = function_(current, std::span<const R>());
+          break;
+        }
+        children.clear();
+        CollectingAction collector(children);
+        current->for_each_child(collector);
+        SubtreeSize<T>::siblings(children, grain_size_, child_sizes);
+        Frame frame{
+            current,
+            piece,
+            index,
+            {},
+            std::make_unique<TaskGroup>(pool_)};
+        T *continuation = nullptr;
+        Piece *continuation_piece = nullptr;
+        size_t batch_size = 0;
+        for (size_t i = 0; i < children.size(); ++i) {
+          T *child = children[i];
+          size_t size = child_sizes[i];
+          if (size < grain_size_) {
+            batch.push_back(child);
+            sizes.push_back(size);
+            batch_size += size;
+            if (grain_size_ <= batch_size) {
+              flush(batch, sizes, batch_size, frame);
+              batch_size = 0;
+            }
+            continue;
+          }
+          if (!batch.empty()) {
+            flush(batch, sizes, batch_size, frame);
+            batch_size = 0;
+          }
+          Piece *child_piece = piece;
+          if (i + 1 < children.size()) {
+            auto forked = std::make_unique<Piece>();
+            child_piece = forked.get();
+            piece->splices.emplace_back(
+                piece->values.size(),
+                std::move(forked));
+          }
+          frame.children.push_back(
+              ValueReference{child_piece, child_piece->values.size()});
+          if (continuation) {
+            frame.tasks->run(
+                [this, continuation, continuation_piece]() {
+                  run_in_parallel(continuation, *continuation_piece);
+                });
+          }
+          continuation = child;
+          continuation_piece = child_piece;
+        }
+        if (!batch.empty()) {
+          flush(batch, sizes, batch_size, frame);
+        }
+        pending.push_back(std::move(frame));
+        current = continuation;
+        piece = continuation_piece;
+      }
+      if (pending.empty()) {
+        return;
+      }
+      Frame frame = std::move(pending.back());
+      pending.pop_back();
+      frame.tasks->wait();
+      child_values.clear();
+      for (const auto& reference : frame.children) {
+        child_values.push_back(reference.piece->values[reference.index]);
+      }
+      frame.piece->values[frame.index] = function_(
+          frame.node,
+          std::span<const R>(child_values));
+      current = nullptr;
+    }
+  }
+
+  /**
+   * @brief Splices pieces into a dense vector, in preorder
+   *
+   * @param root the piece holding the fold's root value
+   * @return the spliced values
+   */
+  static std::vector<R> splice(Piece& root) {
+    struct Cursor {
+      Piece *piece;
+      size_t value;
+      size_t splice;
+    };
+    std::vector<R> results;
+    std::vector<Cursor> stack = {Cursor{&root, 0, 0}};
+    while (!stack.empty()) {
+      Cursor& cursor = stack.back();
+      Piece *piece = cursor.piece;
+      size_t end = cursor.splice < piece->splices.size()
+          ? piece->splices[cursor.splice].first
+          : piece->values.size();
+      for (; cursor.value < end; ++cursor.value) {
+        results.push_back(std::move(piece->values[cursor.value]));
+      }
+      if (cursor.splice < piece->splices.size()) {
+        Piece *next = piece->splices[cursor.splice++].second.get();
+        stack.push_back(Cursor{next, 0, 0});
+      } else {
+        stack.pop_back();
+      }
+    }
+    return results;
+  }
+
+public:
+  /**
+   * Default subtree size below which the fold runs sequentially.
+   */
+  static constexpr size_t DEFAULT_GRAIN_SIZE = 1024;
+
+  /**
+   * Constructor
+   *
+   * @param function computes each node's value. Must be thread safe.
+   * @param pool runs the fold's tasks
+   * @param grain_size minimum number of nodes worth a separate task
+   */
+  ParallelFold(
+      FoldFunction<T, R>& function,
+      WorkStealingPool& pool,
+      size_t grain_size = DEFAULT_GRAIN_SIZE) :
+          function_(function),
+          pool_(pool),
+          grain_size_(grain_size ? grain_size : 1) {
+  }
+
+  ParallelFold(const ParallelFold &other) = delete;
+  ParallelFold(ParallelFold &&other) = delete;
+  ParallelFold& operator=(const ParallelFold &other) = delete;
+  ParallelFold& operator=(ParallelFold &&other) = delete;
+
+  virtual ~ParallelFold() = default;
+
+  /**
+   * @brief Folds a subtree
+   *
+   * The calling thread takes part in the fold and returns when it is
+   * complete.
+   *
+   * @param node subtree root. Must not be \c NULL.
+   * @return the values of the subtree's nodes, in preorder
+   *
+   * @throws the first exception thrown by the function
+   */
+  std::vector<R> operator() (T *node) {
+    Piece root;
+    run_in_parallel(node, root);
+    return splice(root);
+  }
+
+  /**
+   * @brief Folds a subtree
+   *
+   * @param node subtree root. Must not be empty.
+   * @return the values of the subtree's nodes, in preorder
+   */
+  std::vector<R> operator() (const std::shared_ptr<T>& node) {
+    return (*this)(node.get());
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* PARALLELFOLD_H_ */
@@ -0,0 +1,303 @@
+/*
+ * ParallelTraversal.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ParallelTraversal.h
+ *
+ * @brief Depth-first traversal that processes independent subtrees
+ *        concurrently
+ */
+#ifndef PARALLELTRAVERSAL_H_
+#define PARALLELTRAVERSAL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "SubtreeSize.h"
+#include "TaskGroup.h"
+#include "TraversalStatus.h"
+#include "VacuousVoidFunction.h"
+#include "WorkStealingPool.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Depth-first traversal that fans sibling subtrees out to a
+ *        \c WorkStealingPool
+ *
+ * Within every subtree the traversal keeps \c Traversal's ordering: a
+ * node is entered before any of its descendants and exited after all
+ * of them. Siblings and their subtrees, however, can be processed
+ * concurrently and in any order, so the actions \b must be thread
+ * safe and must not depend on sibling order. Because there is no
+ * single current depth, the traversal has no descent or ascent
+ * callbacks.
+ *
+ * Subtrees with fewer than \c grain_size nodes run sequentially on a
+ * single thread, and consecutive small siblings are batched into
+ * tasks of about \c grain_size nodes, so that scheduling costs stay
+ * small relative to the work. Deciding whether a subtree is small
+ * means counting its nodes, up to \c grain_size of them, which
+ * happens once for every child of a node that is processed in
+ * parallel. Only children of nodes with several children are
+ * counted; the single child of a node continues on the same thread.
+ *
+ * \c TraversalStatus semantics follow \c Traversal, with one
+ * difference: when an action cancels the traversal, every worker
+ * stops before applying its next action, but nodes that do not follow
+ * the cancelling node in depth-first order may already have been
+ * processed. As with \c Traversal, cancellation skips the exit actions
+ * of nodes still being processed. An exception thrown by an action
+ * also stops the traversal and is rethrown to the caller.
+ *
+ * Like \c BorrowingTraversal, the traversal borrows nodes, and
+ * actions \b must \b not detach or otherwise release nodes in the
+ * traversed tree. An instance runs one traversal at a time.
+ *
+ * @tparam T node type being traversed, which must inherit \c Node<T>
+ */
+template <typename T> class ParallelTraversal {
+  /**
+   * @brief Applies an action unless the traversal has been cancelled,
+   *        and cancels the traversal when the action says to or throws
+   */
+  class GuardedAction : public BorrowedNodeAction<T> {
+    BorrowedNodeAction<T>& action_;
+    std::atomic<bool>& cancelled_;
+
+  public:
+    GuardedAction(
+        BorrowedNodeAction<T>& action,
+        std::atomic<bool>& cancelled) :
+            action_(action),
+            cancelled_(cancelled) {
+    }
+
+    virtual TraversalStatus operator()(T *node) override {
+      if (cancelled_.load(std::memory_order_relaxed)) {
+        return TraversalStatus::CANCEL;
+      }
+      try {
+        auto status = action_(node);
+        if (TraversalStatus::CANCEL == status) {
+          cancelled_.store(true, std::memory_order_relaxed);
+        }
+        return status;
+      } catch (...) {
+        cancelled_.store(true, std::memory_order_relaxed);
+        throw;
+      }
+    }
+  };
+
+  /**
+   * @brief Collects a node's children
+   */
+  class CollectingAction : public BorrowedNodeAction<T> {
+    std::vector<T *>& children_;
+
+  public:
+    CollectingAction(std::vector<T *>& children) :
+        children_(children) {
+    }
+
+    virtual TraversalStatus operator()(T *node) override {
+      children_.push_back(node);
+      return TraversalStatus::CONTINUE;
+    }
+  };
+
+  /**
+   * @brief A node processed in parallel whose exit is pending
+   */
+  struct Frame {
+    T *node;  /** The node */
+    std::unique_ptr<TaskGroup> children;  /** Its children's tasks */
+  };
+
+  GuardedAction on_entry_;
+  GuardedAction on_exit_;
+  WorkStealingPool& pool_;
+  const size_t grain_size_;
+  std::atomic<bool> cancelled_;
+
+  /**
+   * @brief Traverses small subtrees sequentially
+   *
+   * @param roots subtree roots
+   */
+  void run_sequentially(const std::vector<T *>& roots) {
+    BorrowingTraversal<T> traversal(
+        on_entry_,
+        on_exit_,
+        VacuousVoidFunction::INSTANCE,
+        VacuousVoidFunction::INSTANCE);
+    for (T *root : roots) {
+      if (TraversalStatus::CANCEL == traversal(root)) {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Traverses a subtree, forking large child subtrees
+   *
+   * Keeps the nodes awaiting exit on an explicit stack, and continues
+   * into one large child on the current thread, so that deep trees do
+   * not exhaust the thread stack.
+   *
+   * @param root subtree root
+   */
+  void run_in_parallel(T *root) {
+    std::vector<Frame> pending;
+    std::vector<T *> children;
+    std::vector<size_t> sizes;
+    T *current = root;
+    for (;;) {
+      while (current) {
+        auto status = on_entry_(current);
+        if (TraversalStatus::CONTINUE != status || !current->has_children()) {
+          if (TraversalStatus::CANCEL != status) {
+            on_exit_(current);
+          }
+          break;
+        }
+        children.clear();
+        CollectingAction collector(children);
+        current->for_each_child(collector);
+        SubtreeSize<T>::siblings(children, grain_size_, sizes);
+        auto group = std::make_unique<TaskGroup>(pool_);
+        T *continuation = nullptr;
+        std::vector<T *> batch;
+        size_t batch_size = 0;
+        for (size_t i = 0; i < children.size(); ++i) {
+          T *child = children[i];
+          size_t size = sizes[i];
+          if (grain_size_ <= size) {
+            if (continuation) {
+              group->run([this, continuation]() {
+                run_in_parallel(continuation);
+              });
+            }
+            continuation = child;
+          } else {
+            batch.push_back(child);
+            batch_size += size;
+            if (grain_size_ <= batch_size) {
+              group->run([this, batch = std::move(batch)]() {
+                run_sequentially(batch);
+              });
+              batch.clear();
+              batch_size = 0;
+            }
+          }
+        }
+        if (!batch.empty()) {
+          run_sequentially(batch);
+        }
+        pending.push_back(Frame{current, std::move(group)});
+        current = continuation;
+      }
+      if (pending.empty()) {
+        return;
+      }
+      Frame frame = std::move(pending.back());
+      pending.pop_back();
+      frame.children->wait();
+      on_exit_(frame.node);
+      current = nullptr;
+    }
+  }
+
+public:
+  /**
+   * Default subtree size below which the traversal runs sequentially.
+   */
+  static constexpr size_t DEFAULT_GRAIN_SIZE = 1024;
+
+  /**
+   * Constructor
+   *
+   * @param on_entry applied to a newly entered node. Must be thread
+   *        safe.
+   * @param on_exit applied after traversing a node's children. Must be
+   *        thread safe.
+   * @param pool runs the traversal's tasks
+   * @param grain_size minimum number of nodes worth a separate task
+   */
+  ParallelTraversal(
+      BorrowedNodeAction<T>& on_entry,
+      BorrowedNodeAction<T>& on_exit,
+      WorkStealingPool& pool,
+      size_t grain_size = DEFAULT_GRAIN_SIZE) :
+          on_entry_(on_entry, cancelled_),
+          on_exit_(on_exit, cancelled_),
+          pool_(pool),
+          grain_size_(grain_size ? grain_size : 1),
+          cancelled_(false) {
+  }
+
+  ParallelTraversal(const ParallelTraversal &other) = delete;
+  ParallelTraversal(ParallelTraversal &&other) = delete;
+  ParallelTraversal& operator=(const ParallelTraversal &other) = delete;
+  ParallelTraversal& operator=(ParallelTraversal &&other) = delete;
+
+  virtual ~ParallelTraversal() = default;
+
+  /**
+   * @brief Processes the specified node and its descendants
+   *
+   * The calling thread takes part in the traversal and returns when
+   * it is complete.
+   *
+   * @param node traversal starting point. Must not be \c NULL.
+   * @return \c CANCEL if an action cancelled the traversal,
+   *         \c CONTINUE otherwise
+   *
+   * @throws the first exception thrown by an action
+   */
+  TraversalStatus operator() (T *node) {
+    cancelled_ = false;
+    run_in_parallel(node);
+    return cancelled_ ? TraversalStatus::CANCEL : TraversalStatus::CONTINUE;
+  }
+
+  /**
+   * @brief Processes the specified node and its descendants
+   *
+   * @param node traversal starting point. Must not be empty.
+   * @return status that governs the traversal
+   */
+  TraversalStatus operator() (const std::shared_ptr<T>& node) {
+    return (*this)(node.get());
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* PARALLELTRAVERSAL_H_ */
@@ -0,0 +1,197 @@
+/*
+ * SlotIndex.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file SlotIndex.h
+ *
+ * @brief Locates the occupied slots of a sparse child vector
+ */
+#ifndef SLOTINDEX_H_
+#define SLOTINDEX_H_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Locates the occupied slots of a sparse child vector
+ *
+ * \c Node vacates a detached child's slot instead of erasing it. Once
+ * a wide node has vacancies between its children, a child's position
+ * no longer follows from its slot. The index restores constant or
+ * logarithmic time access without compacting the vector:
+ *
+ * - a Fenwick tree over slot occupancy gives a slot's position, and
+ *   the slot at a position, in logarithmic time;
+ * - the occupied slots are doubly linked, so a child's siblings are
+ *   found in constant time.
+ *
+ * The index tracks only slot occupancy, not the vector's content. Its
+ * owner reports every change in occupancy.
+ */
+class SlotIndex {
+  static constexpr size_t NONE = SIZE_MAX;  /** No such slot */
+
+  /**
+   * Fenwick tree, 1-based: \c counts_[i] holds the number of occupied
+   * slots in [i - lowest bit of i, i).
+   */
+  std::vector<size_t> counts_;
+  std::vector<size_t> next_;  /** Next occupied slot, by slot */
+  std::vector<size_t> previous_;  /** Previous occupied slot, by slot */
+
+  /**
+   * @param end end of the range to count
+   * @return the number of occupied slots in [0, \c end)
+   */
+  size_t prefix(size_t end) const {
+    size_t count = 0;
+    for (; end; end &= end - 1) {
+      count += counts_[end];
+    }
+    return count;
+  }
+
+public:
+  /**
+   * @brief Indexes a child vector
+   *
+   * @tparam Slots random access container whose elements convert to
+   *         \c bool, \c true if and only if occupied
+   * @param slots the vector to index, whose last slot, if any,
+   *        \b must be occupied
+   */
+  template <typename Slots> explicit SlotIndex(const Slots& slots) :
+      counts_(slots.size() + 1),
+      next_(slots.size(), NONE),
+      previous_(slots.size(), NONE) {
+    size_t last = NONE;
+    for (size_t slot = 0; slot < slots.size(); ++slot) {
+      if (slots[slot]) {
+        counts_[slot + 1] = 1;
+        previous_[slot] = last;
+        if (NONE != last) {
+          next_[last] = slot;
+        }
+        last = slot;
+      }
+    }
+    for (size_t i = 1; i < counts_.size(); ++i) {
+      size_t parent = i + (i & -i);
+      if (parent < counts_.size()) {
+        counts_[parent] += counts_[i];
+      }
+    }
+  }
+
+  /**
+   * @brief Records an occupied slot appended to the vector
+   */
+  void push_back(void) {
+    size_t i = counts_.size();
+    counts_.push_back(1 + prefix(i - 1) - prefix(i - (i & -i)));
+    size_t slot = next_.size();
+    size_t last = slot ? slot - 1 : NONE;
+    next_.push_back(NONE);
+    previous_.push_back(last);
+    if (NONE != last) {
+      next_[last] = slot;
+    }
+  }
+
+  /**
+   * @brief Records the removal of the vector's last slot, which
+   *        \b must have been vacated
+   */
+  void pop_back(void) {
+    counts_.pop_back();
+    next_.pop_back();
+    previous_.pop_back();
+  }
+
+  /**
+   * @brief Records that an occupied slot has been vacated
+   *
+   * @param slot the vacated slot
+   */
+  void vacate(size_t slot) {
+    for (size_t i = slot + 1; i < counts_.size(); i += i & -i) {
+      --counts_[i];
+    }
+    size_t before = previous_[slot];
+    size_t after = next_[slot];
+    if (NONE != before) {
+      next_[before] = after;
+    }
+    if (NONE != after) {
+      previous_[after] = before;
+    }
+  }
+
+  /**
+   * @param slot an occupied slot
+   * @return the number of occupied slots preceding \c slot
+   */
+  size_t position(size_t slot) const {
+    return prefix(slot);
+  }
+
+  /**
+   * @param position a position, which \b must be less than the
+   *        number of occupied slots
+   * @return the occupied slot at \c position
+   */
+  size_t slot(size_t position) const {
+    size_t index = 0;
+    for (size_t step = std::bit_floor(counts_.size() - 1); step; step >>= 1) {
+      if (index + step < counts_.size() && counts_[index + step] <= position) {
+        index += step;
+        position -= counts_[index];
+      }
+    }
+    return index;
+  }
+
+  /**
+   * @param slot an occupied slot
+   * @return the next occupied slot, or \c SIZE_MAX if none
+   */
+  size_t next(size_t slot) const {
+    return next_[slot];
+  }
+
+  /**
+   * @param slot an occupied slot
+   * @return the previous occupied slot, or \c SIZE_MAX if none
+   */
+  size_t previous(size_t slot) const {
+    return previous_[slot];
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* SLOTINDEX_H_ */
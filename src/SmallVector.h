@@ -0,0 +1,339 @@
+/*
+ * SmallVector.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file SmallVector.h
+ *
+ * @brief A vector that stores its first few elements inline
+ */
+#ifndef SMALLVECTOR_H_
+#define SMALLVECTOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace VisitingParseTree {
+
+/**
+ * @brief A sequence container that holds up to \c N elements without
+ *        allocating
+ *
+ * Supports the subset of \c std::vector's interface that \c Node uses.
+ * The first \c N elements live inside the container itself; adding
+ * more moves every element to the heap, where the container grows
+ * geometrically like \c std::vector. The inline buffer shares space
+ * with the heap pointer, so the container is no larger than its
+ * inline buffer plus two 32-bit counts.
+ *
+ * Iterators are plain pointers. As with \c std::vector, operations
+ * that add elements can invalidate them. Moving a container that
+ * stores its elements inline moves the elements one by one.
+ *
+ * @tparam E element type, which must be nothrow move constructible
+ * @tparam N inline capacity, at least 1
+ */
+template <typename E, size_t N> class SmallVector {
+  static_assert(0 < N);
+  static_assert(std::is_nothrow_move_constructible_v<E>);
+
+  union {
+    alignas(E) unsigned char inline_[N * sizeof(E)];  /** Inline elements */
+    E *heap_;  /** Heap elements, when \c capacity_ exceeds \c N */
+  };
+  std::uint32_t size_;  /** Number of elements */
+  std::uint32_t capacity_;  /** Number of elements that fit without growing */
+
+  bool is_inline(void) const {
+    return capacity_ <= N;
+  }
+
+  /**
+   * @brief Moves the elements to a larger heap buffer
+   *
+   * @param capacity the new capacity, which must exceed the current
+   *        one
+   */
+  void grow(size_t capacity) {
+    E *elements = std::allocator<E>().allocate(capacity);
+    std::uninitialized_move(begin(), end(), elements);
+    std::destroy(begin(), end());
+    release_heap();
+    heap_ = elements;
+    capacity_ = static_cast<std::uint32_t>(capacity);
+  }
+
+  /**
+   * @brief Makes room for at least one more element
+   */
+  void grow_for_one_more(void) {
+    if (size_ == capacity_) {
+      grow(2 * static_cast<size_t>(capacity_));
+    }
+  }
+
+  /**
+   * @brief Frees the heap buffer, if any, without destroying elements
+   */
+  void release_heap(void) {
+    if (!is_inline()) {
+      std::allocator<E>().deallocate(heap_, capacity_);
+    }
+  }
+
+  /**
+   * @brief Takes the elements of another container, leaving it empty
+   *
+   * @param other the container to take from. Must not be \c this.
+   */
+  void take(SmallVector& other) noexcept {
+    if (other.is_inline()) {
+      std::uninitialized_move(other.begin(), other.end(), begin());
+      std::destroy(other.begin(), other.end());
+    } else {
+      heap_ = other.heap_;
+      capacity_ = other.capacity_;
+      other.capacity_ = N;
+    }
+    size_ = other.size_;
+    other.size_ = 0;
+  }
+
+public:
+  using value_type = E;
+  using size_type = size_t;
+  using iterator = E *;
+  using const_iterator = const E *;
+
+  SmallVector(void) :
+      size_(0),
+      capacity_(N) {
+  }
+
+  SmallVector(SmallVector&& other) noexcept :
+      size_(0),
+      capacity_(N) {
+    take(other);
+  }
+
+  SmallVector& operator=(SmallVector&& other) noexcept {
+    if (this != &other) {
+      clear();
+      release_heap();
+      capacity_ = N;
+      take(other);
+    }
+    return *this;
+  }
+
+  SmallVector(const SmallVector& other) = delete;
+  SmallVector& operator=(const SmallVector& other) = delete;
+
+  ~SmallVector() {
+    clear();
+    release_heap();
+  }
+
+  E *data(void) {
+    return is_inline() ? std::launder(reinterpret_cast<E *>(inline_)) : heap_;
+  }
+
+  const E *data(void) const {
+    return is_inline()
+        ? std::launder(reinterpret_cast<const E *>(inline_))
+        : heap_;
+  }
+
+  iterator begin(void) {
+    return data();
+  }
+
+  iterator end(void) {
+    return data() + size_;
+  }
+
+  const_iterator begin(void) const {
+    return data();
+  }
+
+  const_iterator end(void) const {
+    return data() + size_;
+  }
+
+  size_t size(void) const {
+    return size_;
+  }
+
+  size_t capacity(void) const {
+    return capacity_;
+  }
+
+  bool empty(void) const {
+    return !size_;
+  }
+
+  E& operator[](size_t index) {
+    return data()[index];
+  }
+
+  const E& operator[](size_t index) const {
+    return data()[index];
+  }
+
+  E& back(void) {
+    return data()[size_ - 1];
+  }
+
+  const E& back(void) const {
+    return data()[size_ - 1];
+  }
+
+  /**
+   * @brief Ensures room for the specified number of elements
+   *
+   * @param capacity number of elements that must fit without growing
+   */
+  void reserve(size_t capacity) {
+    if (capacity_ < capacity) {
+      grow(capacity);
+    }
+  }
+
+  void push_back(const E& element) {
+    if (size_ == capacity_) {
+      E copy(element);
+      grow_for_one_more();
+      std::construct_at(end(), std::move(copy));
+    } else {
+      std::construct_at(end(), element);
+    }
+    ++size_;
+  }
+
+  void push_back(E&& element) {
+    if (size_ == capacity_) {
+      // element may live in this container, so take it before growing
+      E moved(std::move(element));
+      grow_for_one_more();
+      std::construct_at(end(), std::move(moved));
+    } else {
+      std::construct_at(end(), std::move(element));
+    }
+    ++size_;
+  }
+
+  void pop_back(void) {
+    --size_;
+    std::destroy_at(end());
+  }
+
+  /**
+   * @brief Destroys every element, keeping the storage
+   */
+  void clear(void) {
+    std::destroy(begin(), end());
+    size_ = 0;
+  }
+
+  /**
+   * @brief Inserts a range of elements before the specified position
+   *
+   * @param position insertion point, in \c [begin(), end()]
+   * @param first start of the range to insert, which must not be in
+   *        this container
+   * @param last end of the range to insert
+   * @return an iterator to the first inserted element
+   */
+  template <typename InputIterator> iterator insert(
+      const_iterator position,
+      InputIterator first,
+      InputIterator last) {
+    size_t offset = position - begin();
+    size_t count = std::distance(first, last);
+    if (capacity_ < size_ + count) {
+      grow(std::max(size_ + count, 2 * static_cast<size_t>(capacity_)));
+    }
+    E *start = begin() + offset;
+    E *old_end = end();
+    size_t tail = old_end - start;
+    if (count) {
+      // Open a gap of count elements by moving the tail right, starting
+      // at the back so that nothing is overwritten before it moves.
+      size_t constructed = std::min(tail, count);
+      std::uninitialized_move(
+          old_end - constructed,
+          old_end,
+          old_end + count - constructed);
+      std::move_backward(start, old_end - constructed, old_end);
+      for (size_t i = 0; i < count; ++i, ++first) {
+        if (i < tail) {
+          start[i] = *first;
+        } else {
+          std::construct_at(start + i, *first);
+        }
+      }
+      size_ += static_cast<std::uint32_t>(count);
+    }
+    return begin() + offset;
+  }
+
+  /**
+   * @brief Removes the elements in the specified range
+   *
+   * @param first first element to remove
+   * @param last one past the last element to remove
+   * @return an iterator to the element that followed the removed ones
+   */
+  iterator erase(const_iterator first, const_iterator last) {
+    E *start = begin() + (first - begin());
+    E *stop = begin() + (last - begin());
+    E *new_end = std::move(stop, end(), start);
+    std::destroy(new_end, end());
+    size_ = static_cast<std::uint32_t>(new_end - begin());
+    return start;
+  }
+};
+
+/**
+ * @brief Removes the elements that satisfy a predicate
+ *
+ * @param container the container to filter
+ * @param predicate returns \c true for elements to remove
+ * @return the number of elements removed
+ */
+template <typename E, size_t N, typename Predicate>
+size_t erase_if(SmallVector<E, N>& container, Predicate predicate) {
+  auto new_end = std::remove_if(container.begin(), container.end(), predicate);
+  size_t removed = container.end() - new_end;
+  container.erase(new_end, container.end());
+  return removed;
+}
+
+} /* namespace VisitingParseTree */
+
+#endif /* SMALLVECTOR_H_ */
@@ -0,0 +1,71 @@
+/*
+ * StreamSink.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file StreamSink.h
+ *
+ * @brief Writes serialized bytes to a \c std::ostream
+ */
+#ifndef STREAMSINK_H_
+#define STREAMSINK_H_
+
+#include <ostream>
+#include <span>
+
+#include "ByteSink.h"
+#include "IllegalOperation.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief A \c ByteSink that writes to a \c std::ostream
+ *
+ * Each buffer costs one \c std::ostream::write() call. Prefer
+ * \c FileSink for files, which writes many buffers per system call.
+ */
+class StreamSink : public ByteSink {
+  std::ostream& out_;  /** Destination */
+
+public:
+  /**
+   * @param out destination, which must outlive the sink
+   */
+  StreamSink(std::ostream& out) :
+      out_(out) {
+  }
+
+  virtual void write(
+      std::span<const std::span<const unsigned char>> buffers) override {
+    for (const auto& buffer : buffers) {
+      out_.write(
+          reinterpret_cast<const char *>(buffer.data()), buffer.size());
+    }
+    if (!out_) {
+      throw IllegalOperation("Cannot write: output stream failed.");
+    }
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* STREAMSINK_H_ */
@@ -0,0 +1,150 @@
+/*
+ * SubtreeSize.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file SubtreeSize.h
+ *
+ * @brief Counts the nodes in a subtree, stopping at a limit
+ */
+#ifndef SUBTREESIZE_H_
+#define SUBTREESIZE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "TraversalStatus.h"
+#include "VacuousVoidFunction.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Counts the nodes in a subtree, stopping at a limit
+ *
+ * Parallel algorithms use the bounded count to decide whether a
+ * subtree is worth a task of its own without paying for a count of
+ * the whole subtree. \c siblings() sizes a node's children together,
+ * so that the child a parallel algorithm continues into is not
+ * counted again at every level of a deep, narrow tree.
+ *
+ * @tparam T node type, which must inherit \c Node<T>
+ */
+template <typename T> class SubtreeSize {
+  class CountingAction : public BorrowedNodeAction<T> {
+    const size_t limit_;
+    size_t count_ = 0;
+
+  public:
+    CountingAction(size_t limit) :
+        limit_(limit) {
+    }
+
+    size_t count(void) const {
+      return count_;
+    }
+
+    virtual TraversalStatus operator()(T *node) override {
+      return ++count_ < limit_
+          ? TraversalStatus::CONTINUE
+          : TraversalStatus::CANCEL;
+    }
+  };
+
+  class ContinuingAction : public BorrowedNodeAction<T> {
+  public:
+    virtual TraversalStatus operator()(T *node) override {
+      return TraversalStatus::CONTINUE;
+    }
+  };
+
+  SubtreeSize(void) = delete;
+
+public:
+  /**
+   * @param node subtree root. Must not be \c NULL.
+   * @param limit count at which to stop, at least 1
+   * @return the number of nodes in the subtree, or \c limit if the
+   *         subtree has at least that many
+   */
+  static size_t bounded(T *node, size_t limit) {
+    CountingAction counter(limit);
+    ContinuingAction nothing;
+    BorrowingTraversal<T> traversal(
+        counter,
+        nothing,
+        VacuousVoidFunction::INSTANCE,
+        VacuousVoidFunction::INSTANCE);
+    traversal(node);
+    return counter.count();
+  }
+
+  /**
+   * @brief Sizes sibling subtrees, counting no further than needed
+   *
+   * Counts the unsized children in rounds whose limit doubles up to
+   * \c limit, and stops as soon as at most one child remains
+   * unsized. Sizing therefore costs a small multiple of the nodes in
+   * the smaller children plus at most \c limit nodes of each child
+   * that has at least \c limit, rather than \c limit nodes of every
+   * large child.
+   *
+   * @param children sibling subtree roots. None may be \c NULL.
+   * @param limit count at which to stop, at least 1
+   * @param sizes receives one entry per child: the number of nodes
+   *        in its subtree, or \c limit if the subtree has at least
+   *        that many or if it is the one child left unsized because
+   *        all of its siblings are smaller
+   */
+  static void siblings(
+      const std::vector<T *>& children,
+      size_t limit,
+      std::vector<size_t>& sizes) {
+    constexpr size_t UNSIZED = 0;
+    sizes.assign(children.size(), UNSIZED);
+    size_t unsized = children.size();
+    for (size_t round = 2; 1 < unsized; round *= 2) {
+      round = std::min(round, limit);
+      unsized = 0;
+      for (size_t i = 0; i < children.size(); ++i) {
+        if (UNSIZED == sizes[i]) {
+          size_t size = bounded(children[i], round);
+          if (size < round) {
+            sizes[i] = size;
+          } else {
+            ++unsized;
+          }
+        }
+      }
+      if (round == limit) {
+        break;
+      }
+    }
+    std::replace(sizes.begin(), sizes.end(), UNSIZED, limit);
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* SUBTREESIZE_H_ */
@@ -35,6 +35,7 @@
 
 #include "BaseSupplier.h"
 #include "Node.h"
+#include "NodeArena.h"
 
 namespace VisitingParseTree {
 
@@ -97,6 +98,27 @@ public:
    * @return the returned shared pointer as described above.
    */
   virtual std::shared_ptr<T> make_shared() = 0;
+
+  /**
+   * @brief Creates a node in the specified arena and returns it wrapped
+   *        in a shared pointer.
+   *
+   * Suppliers whose nodes can be constructed by
+   * \c NodeArena::make_shared() \b should override this method. The
+   * default implementation ignores the arena and delegates to
+   * \c make_shared(), so suppliers that do not override it fall back
+   * to the heap. Arena-aware callers such as \c TreeBuilder and
+   * \c deep_clone() rely on this fallback, so a tree built or cloned
+   * "into an arena" may hold heap allocated nodes from such suppliers.
+   *
+   * @param arena provides the new node's storage, if the supplier
+   *        supports arenas
+   *
+   * @return the returned shared pointer as described above.
+   */
+  virtual std::shared_ptr<T> allocate_shared(NodeArena& /* arena */) {
+    return make_shared();
+  }
 };
 
 } /* namespace VisitingParseTree */
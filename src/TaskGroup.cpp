@@ -0,0 +1,93 @@
+/*
+ * TaskGroup.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file TaskGroup.cpp
+ *
+ * Task group implementation
+ */
+
+#include "TaskGroup.h"
+
+#include <utility>
+
+namespace VisitingParseTree {
+
+TaskGroup::TaskGroup(WorkStealingPool& pool) :
+    pool_(pool),
+    pending_(0) {
+}
+
+TaskGroup::~TaskGroup() {
+  join();
+}
+
+void TaskGroup::join(void) {
+  while (0 < pending_.load(std::memory_order_acquire)) {
+    if (!pool_.run_pending_task()) {
+      // Nothing is queued, so the group's unfinished tasks are running
+      // on other threads. Sleep until one of them queues more work,
+      // which this thread can then help with, or the last one finishes.
+      pool_.wait_for_work([this]() {
+        return 0 == pending_.load(std::memory_order_acquire);
+      });
+    }
+  }
+  // Lets the last task's epilogue release the mutex before the group
+  // can be destroyed.
+  std::lock_guard<std::mutex> lock(mutex_);
+}
+
+void TaskGroup::run(std::function<void()> task) {
+  pending_.fetch_add(1, std::memory_order_relaxed);
+  pool_.submit([this, task = std::move(task)]() {
+    try {
+      task();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!exception_) {
+        exception_ = std::current_exception();
+      }
+    }
+    // Must be last: the group can be destroyed as soon as the count
+    // reaches zero and the mutex is released.
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (1 == pending_.fetch_sub(1, std::memory_order_acq_rel)) {
+      pool_.notify_waiters();
+    }
+  });
+}
+
+void TaskGroup::wait(void) {
+  join();
+  std::exception_ptr exception;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(exception, exception_);
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+} /* namespace VisitingParseTree */
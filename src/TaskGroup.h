@@ -0,0 +1,98 @@
+/*
+ * TaskGroup.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file TaskGroup.h
+ *
+ * @brief A set of tasks, run by a \c WorkStealingPool, that can be
+ *        awaited together
+ */
+#ifndef TASKGROUP_H_
+#define TASKGROUP_H_
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+#include "WorkStealingPool.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Runs tasks in a \c WorkStealingPool and waits for all of them
+ *        to finish
+ *
+ * A thread that waits for a group runs queued tasks until the group
+ * completes, so workers can wait for their own subtasks without
+ * starving the pool. When no task is queued anywhere, it sleeps
+ * instead of spinning, and wakes when any thread queues a task or the
+ * group's last task finishes. If tasks throw, \c wait() rethrows the
+ * first exception after every task has finished.
+ */
+class TaskGroup {
+  WorkStealingPool& pool_;
+  std::atomic<size_t> pending_;  /** Tasks not yet finished */
+  std::mutex mutex_;  /** Guards \c exception_ and task completion */
+  std::exception_ptr exception_;  /** First exception thrown by a task */
+
+  /**
+   * @brief Waits for every task to finish without rethrowing
+   */
+  void join(void);
+
+public:
+  /**
+   * @param pool the pool that runs the group's tasks
+   */
+  explicit TaskGroup(WorkStealingPool& pool);
+
+  TaskGroup(const TaskGroup &other) = delete;
+  TaskGroup(TaskGroup &&other) = delete;
+  TaskGroup& operator=(const TaskGroup &other) = delete;
+  TaskGroup& operator=(TaskGroup &&other) = delete;
+
+  /**
+   * @brief Waits for outstanding tasks, discarding their exceptions
+   */
+  ~TaskGroup();
+
+  /**
+   * @brief Queues a task
+   *
+   * @param task the task to run
+   */
+  void run(std::function<void()> task);
+
+  /**
+   * @brief Waits for every queued task to finish, helping to run them
+   *
+   * @throws the first exception thrown by a task, if any
+   */
+  void wait(void);
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* TASKGROUP_H_ */
@@ -0,0 +1,63 @@
+/*
+ * TextBuffer.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TextBuffer.h"
+
+#include <charconv>
+#include <span>
+
+namespace VisitingParseTree {
+
+namespace {
+
+template <typename V> void format_number(std::string& text, V number) {
+  char digits[32];
+  auto [end, error] = std::to_chars(digits, digits + sizeof(digits), number);
+  text.append(digits, end);
+}
+
+}
+
+void TextBuffer::append_number(std::int64_t number) {
+  format_number(text_, number);
+}
+
+void TextBuffer::append_number(std::uint64_t number) {
+  format_number(text_, number);
+}
+
+void TextBuffer::append_number(double number) {
+  format_number(text_, number);
+}
+
+void TextBuffer::write_to(ByteSink& sink) {
+  if (!text_.empty()) {
+    std::span<const unsigned char> bytes(
+        reinterpret_cast<const unsigned char *>(text_.data()),
+        text_.size());
+    sink.write(std::span(&bytes, 1));
+    text_.clear();
+  }
+}
+
+} /* namespace VisitingParseTree */
@@ -0,0 +1,142 @@
+/*
+ * TextBuffer.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file TextBuffer.h
+ *
+ * @brief Buffered text output to a \c ByteSink
+ */
+#ifndef TEXTBUFFER_H_
+#define TEXTBUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "ByteSink.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Formats text into a buffer that is written to a \c ByteSink
+ *        in large pieces
+ *
+ * Writers append text and numbers, and call \c write_if_full() at
+ * the end of each record so that every write to the sink holds about
+ * \c CAPACITY bytes. The buffer keeps its storage when it is written
+ * out, so a writer can reuse one buffer for any number of outputs.
+ *
+ * \see AttrNodePrinter
+ * \see TreeExporter
+ */
+class TextBuffer {
+public:
+  /**
+   * Buffered output size that triggers a write
+   */
+  static constexpr size_t CAPACITY = 256 * 1024;
+
+private:
+  std::string text_;  /** Formatted output */
+
+public:
+  TextBuffer() {
+    text_.reserve(CAPACITY + CAPACITY / 4);
+  }
+
+  /**
+   * @brief Appends text
+   *
+   * @param text the text to append
+   */
+  void append(std::string_view text) {
+    text_.append(text);
+  }
+
+  /**
+   * @brief Appends a character
+   *
+   * @param c the character to append
+   */
+  void append(char c) {
+    text_.push_back(c);
+  }
+
+  /**
+   * @brief Appends an integer in decimal
+   *
+   * @param number the integer to append
+   */
+  void append_number(std::int64_t number);
+
+  /**
+   * @brief Appends an unsigned integer in decimal
+   *
+   * @param number the integer to append
+   */
+  void append_number(std::uint64_t number);
+
+  /**
+   * @brief Appends a \c double in the shortest form that parses back
+   *        to the same value
+   *
+   * @param number the value to append
+   */
+  void append_number(double number);
+
+  /**
+   * @brief Discards the buffered text
+   */
+  void clear(void) {
+    text_.clear();
+  }
+
+  /**
+   * @brief Writes the buffered text to a sink once it reaches
+   *        \c CAPACITY
+   *
+   * @param sink destination
+   *
+   * @throws IllegalOperation if the sink fails
+   */
+  void write_if_full(ByteSink& sink) {
+    if (CAPACITY <= text_.size()) {
+      write_to(sink);
+    }
+  }
+
+  /**
+   * @brief Writes the buffered text, if any, to a sink and empties
+   *        the buffer
+   *
+   * @param sink destination
+   *
+   * @throws IllegalOperation if the sink fails
+   */
+  void write_to(ByteSink& sink);
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* TEXTBUFFER_H_ */
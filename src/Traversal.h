@@ -30,8 +30,10 @@
 #define SRC_TRAVERSAL_H_
 
 #include <memory>
+#include <utility>
 
 #include "NodeAction.h"
+#include "TraversalEngine.h"
 #include "TraversalStatus.h"
 #include "VoidFunction.h"
 
@@ -47,7 +49,7 @@ namespace VisitingParseTree {
  * @brief Basic depth-first in-order tree traversal for \c Node and its
  *        subclasses.
  *
- * A traversal recurses a parse tree depth first, entering a node, traversing
+ * A traversal walks a parse tree depth first, entering a node, traversing
  * its children, then exiting the previously entered node. It is bound to
  * the following actions:
  *
@@ -69,10 +71,7 @@ namespace VisitingParseTree {
  *         this class directly or indirectly
  */
 template <typename T> class Traversal : public NodeAction<T> {
-  NodeAction<T>& on_entry_;
-  NodeAction<T>& on_exit_;
-  VoidFunction& after_descent_;
-  VoidFunction& before_ascent_;
+  TraversalEngine<T, std::shared_ptr<T>, NodeAction<T>> engine_;
 
 public:
 
@@ -97,17 +96,27 @@ public:
       NodeAction<T>& on_exit,
       VoidFunction& after_descent,
       VoidFunction& before_ascent) :
-          on_entry_(on_entry),
-          on_exit_(on_exit),
-          after_descent_(after_descent),
-          before_ascent_(before_ascent) {
+          engine_(on_entry, on_exit, after_descent, before_ascent) {
   }
 
   /**
    * @brief Processes this node and its children
    *
-   * Recursive descent that processes a tree of \c Node<T>, depth-first,
-   * in-order. Note that this method is recursive.
+   * Processes a tree of \c Node<T>, depth-first, in-order. The
+   * traversal is iterative: it keeps its position in an explicit,
+   * heap-allocated stack rather than on the thread stack, so tree
+   * depth is limited only by available memory.
+   *
+   * The traversal holds a reference to every node that it is
+   * processing, so no node that it will return to is destroyed under
+   * it. It does, however, walk each node's child slots in place, and
+   * detaching a child can compact them. The tree must therefore keep
+   * its shape for the duration of the traversal: actions \b must
+   * \b not append, insert, detach, excise, or otherwise move nodes
+   * in the traversed tree. Collect the changes and apply them
+   * afterward instead. Read-only passes over large trees should
+   * consider \c BorrowingTraversal, which avoids reference count
+   * traffic.
    *
    * @param node current node to process.
    * @return status that governs the traversal
@@ -115,18 +124,7 @@ public:
    * \see TraversalStatus for return value semantics
    */
   virtual TraversalStatus operator() (std::shared_ptr<T> node) override {
-    auto status = on_entry_(node);
-    if (TraversalStatus::CONTINUE == status && node->has_children()) {
-      after_descent_();
-      status = node->for_each_child(*this);
-      before_ascent_();
-    }
-    if (TraversalStatus::CANCEL != status) {
-      status = on_exit_(node);
-    }
-    return TraversalStatus::BYPASS_CHILDREN != status
-        ? status
-        : TraversalStatus::CONTINUE;
+    return engine_(std::move(node));
   }
 };
 
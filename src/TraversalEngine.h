@@ -0,0 +1,180 @@
+/*
+ * TraversalEngine.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file TraversalEngine.h
+ *
+ * @brief Iterative depth-first traversal logic shared by \c Traversal
+ *        and \c BorrowingTraversal
+ */
+#ifndef SRC_TRAVERSALENGINE_H_
+#define SRC_TRAVERSALENGINE_H_
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "TraversalStatus.h"
+#include "VoidFunction.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Depth-first, in-order traversal driven by an explicit stack
+ *
+ * The engine keeps the nodes being processed, together with the slot
+ * of each node's next child, in a heap-allocated stack rather than on
+ * the thread stack, so tree depth is limited only by available memory.
+ * It is not intended for direct use; \c Traversal and
+ * \c BorrowingTraversal wrap it.
+ *
+ * @tparam T node type being traversed, which must inherit \c Node<T>
+ * @tparam Pointer how the engine refers to nodes: \c std::shared_ptr<T>
+ *         to hold each node being processed, or \c T* to borrow it
+ * @tparam Action node action type, which must accept a \c Pointer
+ */
+template <typename T, typename Pointer, typename Action>
+class TraversalEngine {
+  /**
+   * @brief A node whose children are being traversed
+   */
+  struct Frame {
+    Pointer node;  /** Node being processed */
+    size_t next_slot;  /** Slot holding the next child to process */
+  };
+
+  Action& on_entry_;
+  Action& on_exit_;
+  VoidFunction& after_descent_;
+  VoidFunction& before_ascent_;
+
+  /**
+   * @brief Converts a child slot's content to the engine's node
+   *        reference type
+   *
+   * @param child child slot content
+   * @return \c child, possibly borrowed
+   */
+  static Pointer refer_to(const std::shared_ptr<T>& child) {
+    if constexpr (std::is_pointer_v<Pointer>) {
+      return child.get();
+    } else {
+      return child;
+    }
+  }
+
+  /**
+   * @brief Enters a node, preparing to traverse its children if
+   *        required.
+   *
+   * @param node the node to enter
+   * @param stack traversal stack, which receives \c node if its
+   *        children must be processed
+   * @return \c CONTINUE if the node's children are to be processed,
+   *         otherwise the status of processing the node
+   */
+  TraversalStatus enter(Pointer node, std::vector<Frame>& stack) {
+    auto status = on_entry_(node);
+    if (TraversalStatus::CONTINUE == status && node->has_children()) {
+      after_descent_();
+      size_t first_slot = node->leading_vacancies_;
+      stack.push_back(Frame{std::move(node), first_slot});
+      return TraversalStatus::CONTINUE;
+    }
+    return TraversalStatus::CANCEL != status
+        ? exit(node)
+        : status;
+  }
+
+  /**
+   * @brief Exits a node whose children, if any, have been processed
+   *
+   * @param node the node to exit
+   * @return the node's processing status
+   */
+  TraversalStatus exit(const Pointer& node) {
+    auto status = on_exit_(node);
+    return TraversalStatus::BYPASS_CHILDREN != status
+        ? status
+        : TraversalStatus::CONTINUE;
+  }
+
+public:
+  /**
+   * Constructor
+   *
+   * @param on_entry applied to a newly entered node
+   * @param on_exit applied after traversing a node's children
+   * @param after_descent invoked before traversing a node's children
+   * @param before_ascent invoked after traversing a node's children
+   */
+  TraversalEngine(
+      Action& on_entry,
+      Action& on_exit,
+      VoidFunction& after_descent,
+      VoidFunction& before_ascent) :
+          on_entry_(on_entry),
+          on_exit_(on_exit),
+          after_descent_(after_descent),
+          before_ascent_(before_ascent) {
+  }
+
+  /**
+   * @brief Traverses the tree rooted at the specified node
+   *
+   * @param node traversal starting point
+   * @return status that governs the traversal
+   *
+   * \see Traversal for traversal semantics
+   */
+  TraversalStatus operator() (Pointer node) {
+    std::vector<Frame> stack;
+    auto status = enter(std::move(node), stack);
+    while (!stack.empty() && TraversalStatus::CANCEL != status) {
+      Frame& frame = stack.back();
+      auto& children = frame.node->children_;
+      while (frame.next_slot < children.size() && !children[frame.next_slot]) {
+        ++frame.next_slot;
+      }
+      if (frame.next_slot < children.size()) {
+        status = enter(refer_to(children[frame.next_slot++]), stack);
+      } else {
+        auto exiting = std::move(frame.node);
+        stack.pop_back();
+        before_ascent_();
+        status = exit(exiting);
+      }
+    }
+    // Cancellation skips the exit action of every node still being
+    // processed, but each of them still ascends.
+    for (; !stack.empty(); stack.pop_back()) {
+      before_ascent_();
+    }
+    return status;
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* SRC_TRAVERSALENGINE_H_ */
@@ -0,0 +1,233 @@
+/*
+ * TreeBuilder.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file TreeBuilder.h
+ *
+ * @brief Builds trees from a stream of open, attribute, and close
+ *        events
+ */
+#ifndef TREEBUILDER_H_
+#define TREEBUILDER_H_
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "IllegalOperation.h"
+#include "NodeArena.h"
+#include "Supplier.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Builds a tree from preorder events, as a parser emits them
+ *
+ * Building a tree with \c append_child(), \c append_sibling(), and
+ * \c parent() copies a \c std::shared_ptr per call and locks a
+ * \c std::weak_ptr per \c parent(). A builder instead keeps the nodes
+ * under construction on a stack of plain pointers and moves each new
+ * node into its parent:
+ *
+ *     TreeBuilder<BaseAttrNode> builder;
+ *     builder.open(RootNode::SUPPLIER)
+ *         .open(PlusNode::SUPPLIER, 2)
+ *             .open(IntegerNode::SUPPLIER).attr(VALUE, "1").close()
+ *             .open(IntegerNode::SUPPLIER).attr(VALUE, "2").close()
+ *         .close()
+ *     .close();
+ *     auto tree = builder.finish();
+ *
+ * \c open() creates a node as the youngest child of the innermost
+ * open node, or as the root, and opens it. \c attr() sets an
+ * attribute of the innermost open node, and \c close() closes it.
+ * Passing the expected number of children to \c open() reserves room
+ * for them up front.
+ *
+ * A builder builds one tree at a time, and can be reused once
+ * \c finish() returns.
+ *
+ * @tparam T node type, which must inherit \c Node<T>, and
+ *         \c AttrNode<T> to use \c attr()
+ */
+template <typename T> class TreeBuilder {
+  NodeArena *arena_;  /** Node storage, or NULL for the heap */
+  std::shared_ptr<T> root_;  /** The tree under construction */
+  std::vector<T *> open_;  /** Open nodes, innermost last */
+  bool complete_ = false;  /** Whether the root has been closed */
+
+  /**
+   * @return the innermost open node
+   *
+   * @throws IllegalOperation if no node is open
+   */
+  T *current(void) const {
+    if (open_.empty()) {
+      throw IllegalOperation("No node is open.");
+    }
+    return open_.back();
+  }
+
+public:
+  /**
+   * @brief Creates a builder that allocates nodes on the heap, or in
+   *        an arena
+   *
+   * @param arena provides the nodes' storage, or \c NULL to allocate
+   *        them on the heap. Must outlive the builder.
+   */
+  TreeBuilder(NodeArena *arena = nullptr) :
+      arena_(arena) {
+  }
+
+  /**
+   * @brief Creates a builder that allocates nodes in an arena
+   *
+   * \see Supplier::allocate_shared()
+   *
+   * @param arena provides the nodes' storage, and must outlive the
+   *        builder
+   */
+  TreeBuilder(NodeArena& arena) :
+      arena_(&arena) {
+  }
+
+  TreeBuilder(const TreeBuilder&) = delete;
+  TreeBuilder& operator=(const TreeBuilder&) = delete;
+  ~TreeBuilder() = default;
+
+  /**
+   * @brief Creates and opens a node
+   *
+   * @param supplier creates the node
+   * @param expected_children the number of children that the node is
+   *        expected to have, for which room is reserved. The node can
+   *        have any number of children regardless.
+   * @return \c *this, for chaining
+   *
+   * @throws IllegalOperation if the root has already been closed
+   */
+  TreeBuilder& open(Supplier<T>& supplier, size_t expected_children = 0) {
+    if (complete_) {
+      throw IllegalOperation("The tree is complete.");
+    }
+    std::shared_ptr<T> node = arena_
+        ? supplier.allocate_shared(*arena_)
+        : supplier.make_shared();
+    if (expected_children) {
+      node->accommodate_additional_children(expected_children);
+    }
+    if (open_.empty()) {
+      open_.push_back(node.get());
+      root_ = std::move(node);
+    } else {
+      open_.push_back(open_.back()->adopt_child(std::move(node)));
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Reserves room for additional children of the innermost
+   *        open node
+   *
+   * For callers that learn a node's child count only after opening
+   * it.
+   *
+   * @param additional_children the number of children to make room for
+   * @return \c *this, for chaining
+   *
+   * @throws IllegalOperation if no node is open
+   */
+  TreeBuilder& reserve(size_t additional_children) {
+    current()->accommodate_additional_children(additional_children);
+    return *this;
+  }
+
+  /**
+   * @brief Sets an attribute of the innermost open node
+   *
+   * Accepts the same arguments as \c AttrNode::put(), and moves the
+   * value in when possible.
+   *
+   * @param attribute the attribute to set
+   * @param value the value to set
+   * @return \c *this, for chaining
+   *
+   * @throws IllegalOperation if no node is open, or as
+   *         \c AttrNode::put() does
+   */
+  template <typename A, typename V> TreeBuilder& attr(
+      const A& attribute, V&& value) {
+    current()->put(attribute, std::forward<V>(value));
+    return *this;
+  }
+
+  /**
+   * @brief Closes the innermost open node
+   *
+   * @return \c *this, for chaining
+   *
+   * @throws IllegalOperation if no node is open
+   */
+  TreeBuilder& close(void) {
+    current();
+    open_.pop_back();
+    complete_ = open_.empty();
+    return *this;
+  }
+
+  /**
+   * @return the innermost open node, or \c NULL if none is open. The
+   *         builder owns the node until \c finish() returns.
+   */
+  T *top(void) const {
+    return open_.empty() ? nullptr : open_.back();
+  }
+
+  /**
+   * @return the number of open nodes
+   */
+  size_t depth(void) const {
+    return open_.size();
+  }
+
+  /**
+   * @brief Returns the finished tree and resets the builder
+   *
+   * @return the root of the tree
+   *
+   * @throws IllegalOperation unless the root has been closed
+   */
+  std::shared_ptr<T> finish(void) {
+    if (!complete_) {
+      throw IllegalOperation("The tree is incomplete.");
+    }
+    complete_ = false;
+    return std::move(root_);
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* TREEBUILDER_H_ */
@@ -0,0 +1,485 @@
+/*
+ * TreeDiff.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file TreeDiff.cpp
+ *
+ * Tree matching and edit script implementation
+ */
+
+#include "TreeDiff.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+namespace VisitingParseTree {
+
+/*
+ * Matches the nodes of two frozen trees, recording the matching in a
+ * TreeDiff. See TreeDiff for a description of the phases.
+ */
+class TreeMatcher {
+  using Index = TreeDiff::Index;
+  static constexpr Index NO_INDEX = TreeDiff::NO_INDEX;
+
+  /*
+   * How far past the last paired old child recovery looks for a
+   * partner, which bounds the cost of recovering children of nodes
+   * with very many children.
+   */
+  static constexpr size_t RECOVERY_WINDOW = 64;
+
+  /*
+   * The old subtrees that share a structural hash, linked through
+   * next_ in preorder, and the number of new subtrees with the hash.
+   */
+  struct Bucket {
+    Index old_count = 0;
+    Index new_count = 0;
+    Index head = NO_INDEX;
+  };
+
+  TreeDiff& diff_;
+  const FrozenTree& old_;
+  const FrozenTree& new_;
+  std::vector<std::uint64_t> old_hashes_;
+  std::vector<std::uint64_t> new_hashes_;
+  std::unordered_map<std::uint64_t, Bucket> buckets_;
+  std::vector<Index> next_;  /* Next old subtree with the same hash */
+  std::vector<size_t> old_children_;  /* Recovery scratch */
+  std::vector<size_t> new_children_;  /* Recovery scratch */
+
+  static std::vector<std::uint64_t> hashes(const FrozenTree& tree) {
+    tree.root()->structural_hash();
+    std::vector<std::uint64_t> result(tree.size());
+    for (size_t i = 0; i < tree.size(); ++i) {
+      result[i] = tree.node(i)->structural_hash();
+    }
+    return result;
+  }
+
+  bool old_matched(size_t old_index) const {
+    return NO_INDEX != diff_.old_to_new_[old_index];
+  }
+
+  bool new_matched(size_t new_index) const {
+    return NO_INDEX != diff_.new_to_old_[new_index];
+  }
+
+  void match(size_t old_index, size_t new_index) {
+    diff_.old_to_new_[old_index] = static_cast<Index>(new_index);
+    diff_.new_to_old_[new_index] = static_cast<Index>(old_index);
+  }
+
+  /*
+   * Matches structurally equal subtrees node for node, skipping nodes
+   * that already have counterparts.
+   */
+  void match_subtrees(size_t old_index, size_t new_index) {
+    size_t count = new_.subtree_end(new_index) - new_index;
+    for (size_t offset = 0; offset < count; ++offset) {
+      if (!old_matched(old_index + offset)
+          && !new_matched(new_index + offset)) {
+        match(old_index + offset, new_index + offset);
+      }
+    }
+  }
+
+  bool equal(size_t old_index, size_t new_index) const {
+    return old_hashes_[old_index] == new_hashes_[new_index]
+        && old_.node(old_index)->structurally_equals(
+            *new_.node(new_index));
+  }
+
+  void index_hashes(void) {
+    next_.assign(old_.size(), NO_INDEX);
+    buckets_.reserve(old_.size());
+    for (size_t i = old_.size(); 0 < i; --i) {
+      Bucket& bucket = buckets_[old_hashes_[i - 1]];
+      next_[i - 1] = bucket.head;
+      bucket.head = static_cast<Index>(i - 1);
+      ++bucket.old_count;
+    }
+    for (auto hash : new_hashes_) {
+      auto found = buckets_.find(hash);
+      if (buckets_.end() != found) {
+        ++found->second.new_count;
+      }
+    }
+  }
+
+  /*
+   * Phase 1: matches subtrees that occur exactly once in each tree.
+   */
+  void match_unique(void) {
+    for (size_t n = 0; n < new_.size();) {
+      auto found = buckets_.find(new_hashes_[n]);
+      if (buckets_.end() != found
+          && 1 == found->second.old_count
+          && 1 == found->second.new_count
+          && !old_matched(found->second.head)
+          && equal(found->second.head, n)) {
+        match_subtrees(found->second.head, n);
+        n = new_.subtree_end(n);
+      } else {
+        ++n;
+      }
+    }
+  }
+
+  /*
+   * Phase 2: matches unmatched nodes to the old nodes that parent
+   * most of their matched children, leaves first.
+   */
+  void match_bottom_up(void) {
+    std::vector<std::pair<size_t, size_t>> votes;
+    for (size_t n = new_.size(); 0 < n--;) {
+      if (new_matched(n) || !new_.has_children(n)) {
+        continue;
+      }
+      votes.clear();
+      for (size_t child = new_.first_child(n);
+          FrozenTree::NO_NODE != child;
+          child = new_.next_sibling(child)) {
+        size_t counterpart = diff_.old_counterpart(child);
+        if (TreeDiff::NO_NODE == counterpart || !counterpart) {
+          continue;
+        }
+        size_t candidate = old_.parent(counterpart);
+        if (old_matched(candidate)
+            || old_.supplier(candidate) != new_.supplier(n)) {
+          continue;
+        }
+        auto vote = std::find_if(
+            votes.begin(),
+            votes.end(),
+            [candidate](const auto& v) { return v.first == candidate; });
+        if (votes.end() == vote) {
+          votes.emplace_back(candidate, 1);
+        } else {
+          ++vote->second;
+        }
+      }
+      auto best = std::max_element(
+          votes.begin(),
+          votes.end(),
+          [](const auto& a, const auto& b) { return a.second < b.second; });
+      if (votes.end() != best) {
+        match(best->first, n);
+      }
+    }
+  }
+
+  /*
+   * Pairs the unmatched children of a matched pair of nodes that
+   * occupy the same position in their parents, using the specified
+   * criterion.
+   */
+  template <typename Pairing> void pair_in_place(Pairing pairing) {
+    size_t count = std::min(old_children_.size(), new_children_.size());
+    for (size_t i = 0; i < count; ++i) {
+      size_t o = old_children_[i];
+      size_t n = new_children_[i];
+      if (!old_matched(o) && !new_matched(n)) {
+        pairing(o, n);
+      }
+    }
+  }
+
+  /*
+   * Pairs the remaining unmatched children of a matched pair of nodes,
+   * in order, using the specified criterion.
+   */
+  template <typename Pairing> void pair_children(Pairing pairing) {
+    size_t cursor = 0;
+    for (auto n : new_children_) {
+      if (new_matched(n)) {
+        continue;
+      }
+      size_t limit = std::min(
+          old_children_.size(), cursor + RECOVERY_WINDOW);
+      for (size_t j = cursor; j < limit; ++j) {
+        size_t o = old_children_[j];
+        if (!old_matched(o) && pairing(o, n)) {
+          cursor = j + 1;
+          break;
+        }
+      }
+    }
+  }
+
+  /*
+   * Phase 3: pairs the unmatched children of matched nodes, root
+   * first, by structural equality and then by type. Each criterion
+   * first pairs children in the same position, so that an unchanged
+   * child cannot take the partner of an edited sibling when siblings
+   * repeat.
+   */
+  void recover(void) {
+    auto by_equality = [this](size_t old_child, size_t new_child) {
+      if (!equal(old_child, new_child)) {
+        return false;
+      }
+      match_subtrees(old_child, new_child);
+      return true;
+    };
+    auto by_type = [this](size_t old_child, size_t new_child) {
+      if (old_.supplier(old_child) != new_.supplier(new_child)) {
+        return false;
+      }
+      match(old_child, new_child);
+      return true;
+    };
+    for (size_t n = 0; n < new_.size(); ++n) {
+      size_t o = diff_.old_counterpart(n);
+      if (TreeDiff::NO_NODE == o
+          || !new_.has_children(n)
+          || !old_.has_children(o)) {
+        continue;
+      }
+      bool unmatched = false;
+      new_children_.clear();
+      for (size_t child = new_.first_child(n);
+          FrozenTree::NO_NODE != child;
+          child = new_.next_sibling(child)) {
+        unmatched = unmatched || !new_matched(child);
+        new_children_.push_back(child);
+      }
+      if (!unmatched) {
+        continue;
+      }
+      old_children_.clear();
+      for (size_t child = old_.first_child(o);
+          FrozenTree::NO_NODE != child;
+          child = old_.next_sibling(child)) {
+        old_children_.push_back(child);
+      }
+      pair_in_place(by_equality);
+      pair_children(by_equality);
+      pair_in_place(by_type);
+      pair_children(by_type);
+    }
+  }
+
+  /*
+   * Marks the nodes whose subtrees contain no matched nodes.
+   */
+  static std::vector<bool> unmatched_subtrees(
+      const FrozenTree& tree,
+      const std::vector<Index>& counterparts) {
+    std::vector<bool> result(tree.size());
+    for (size_t i = 0; i < tree.size(); ++i) {
+      result[i] = NO_INDEX == counterparts[i];
+    }
+    for (size_t i = tree.size(); 1 < i--;) {
+      if (!result[i]) {
+        result[tree.parent(i)] = false;
+      }
+    }
+    return result;
+  }
+
+  /*
+   * Phase 4: matches wholly unmatched new subtrees to wholly unmatched,
+   * structurally equal old subtrees.
+   */
+  void match_moved(void) {
+    auto old_free = unmatched_subtrees(old_, diff_.old_to_new_);
+    auto new_free = unmatched_subtrees(new_, diff_.new_to_old_);
+    for (size_t n = 0; n < new_.size();) {
+      if (!new_free[n]) {
+        ++n;
+        continue;
+      }
+      auto found = buckets_.find(new_hashes_[n]);
+      if (buckets_.end() == found) {
+        ++n;
+        continue;
+      }
+      Index& head = found->second.head;
+      while (NO_INDEX != head && !old_free[head]) {
+        head = next_[head];
+      }
+      if (NO_INDEX == head || !equal(head, n)) {
+        ++n;
+        continue;
+      }
+      size_t o = head;
+      match_subtrees(o, n);
+      std::fill(
+          old_free.begin() + o,
+          old_free.begin() + old_.subtree_end(o),
+          false);
+      for (size_t ancestor = old_.parent(o);
+          FrozenTree::NO_NODE != ancestor && old_free[ancestor];
+          ancestor = old_.parent(ancestor)) {
+        old_free[ancestor] = false;
+      }
+      n = new_.subtree_end(n);
+    }
+  }
+
+public:
+  TreeMatcher(TreeDiff& diff) :
+      diff_(diff),
+      old_(diff.old_tree_),
+      new_(diff.new_tree_),
+      old_hashes_(hashes(diff.old_tree_)),
+      new_hashes_(hashes(diff.new_tree_)) {
+  }
+
+  void operator()(void) {
+    index_hashes();
+    match_unique();
+    if (!old_matched(0)
+        && !new_matched(0)
+        && old_.supplier(0) == new_.supplier(0)) {
+      match(0, 0);
+    }
+    match_bottom_up();
+    recover();
+    match_moved();
+  }
+};
+
+/*
+ * Returns a mask of the elements of a sequence that belong to one
+ * of its longest increasing subsequences.
+ */
+static std::vector<bool> longest_increasing(
+    const std::vector<size_t>& sequence) {
+  std::vector<size_t> tails;  /* Positions ending increasing runs */
+  std::vector<size_t> predecessors(sequence.size());
+  for (size_t i = 0; i < sequence.size(); ++i) {
+    auto tail = std::lower_bound(
+        tails.begin(),
+        tails.end(),
+        sequence[i],
+        [&sequence](size_t position, size_t value) {
+          return sequence[position] < value;
+        });
+    predecessors[i] = tails.begin() == tail ? sequence.size() : *(tail - 1);
+    if (tails.end() == tail) {
+      tails.push_back(i);
+    } else {
+      *tail = i;
+    }
+  }
+  std::vector<bool> result(sequence.size());
+  for (size_t i = tails.empty() ? sequence.size() : tails.back();
+      i < sequence.size();
+      i = predecessors[i]) {
+    result[i] = true;
+  }
+  return result;
+}
+
+TreeDiff::TreeDiff(FrozenTree&& old_tree, FrozenTree&& new_tree) :
+    old_tree_(std::move(old_tree)),
+    new_tree_(std::move(new_tree)),
+    old_to_new_(old_tree_.size(), NO_INDEX),
+    new_to_old_(new_tree_.size(), NO_INDEX) {
+}
+
+TreeDiff TreeDiff::compare(
+    std::shared_ptr<BaseAttrNode> old_root,
+    std::shared_ptr<BaseAttrNode> new_root) {
+  TreeDiff diff(
+      FrozenTree::freeze(std::move(old_root)),
+      FrozenTree::freeze(std::move(new_root)));
+  TreeMatcher matcher(diff);
+  matcher();
+  diff.script();
+  return diff;
+}
+
+void TreeDiff::script(void) {
+  for (size_t o = 0; o < old_tree_.size(); ++o) {
+    if (NO_INDEX == old_to_new_[o]) {
+      edits_.push_back(Edit{EditKind::DELETE, o, NO_NODE});
+    }
+  }
+
+  /*
+   * A matched node moved if its parent's counterpart is not its old
+   * parent or, among siblings that kept their parent, it is not part
+   * of the longest run that kept its order.
+   */
+  std::vector<bool> moved(new_tree_.size());
+  std::vector<size_t> siblings;
+  std::vector<size_t> positions;
+  for (size_t n = 0; n < new_tree_.size(); ++n) {
+    size_t o = old_counterpart(n);
+    if (NO_NODE != o) {
+      size_t parent = new_tree_.parent(n);
+      if (old_tree_.parent(o)
+          != (NO_NODE == parent ? NO_NODE : old_counterpart(parent))) {
+        moved[n] = true;
+      }
+    }
+    if (NO_NODE == o || !new_tree_.has_children(n)) {
+      continue;
+    }
+    siblings.clear();
+    positions.clear();
+    for (size_t child = new_tree_.first_child(n);
+        NO_NODE != child;
+        child = new_tree_.next_sibling(child)) {
+      size_t counterpart = old_counterpart(child);
+      if (NO_NODE != counterpart && o == old_tree_.parent(counterpart)) {
+        siblings.push_back(child);
+        positions.push_back(counterpart);
+      }
+    }
+    auto in_order = longest_increasing(positions);
+    for (size_t i = 0; i < siblings.size(); ++i) {
+      moved[siblings[i]] = !in_order[i];
+    }
+  }
+
+  for (size_t n = 0; n < new_tree_.size(); ++n) {
+    size_t o = old_counterpart(n);
+    if (NO_NODE == o) {
+      edits_.push_back(Edit{EditKind::INSERT, NO_NODE, n});
+      continue;
+    }
+    if (moved[n]) {
+      edits_.push_back(Edit{EditKind::MOVE, o, n});
+    }
+    auto old_attributes = old_tree_.attributes(o);
+    auto new_attributes = new_tree_.attributes(n);
+    if (!std::equal(
+        old_attributes.begin(),
+        old_attributes.end(),
+        new_attributes.begin(),
+        new_attributes.end(),
+        [](const auto& a, const auto& b) {
+          return a.id == b.id && a.value == b.value;
+        })) {
+      edits_.push_back(Edit{EditKind::UPDATE, o, n});
+    }
+  }
+}
+
+} /* namespace VisitingParseTree */
@@ -0,0 +1,196 @@
+/*
+ * TreeDiff.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file TreeDiff.h
+ *
+ * @brief Matches two trees and describes their differences as an
+ *        edit script
+ */
+#ifndef TREEDIFF_H_
+#define TREEDIFF_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "BaseAttrNode.h"
+#include "FrozenTree.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Differences between an old and a new version of a tree
+ *
+ * Comparing two trees matches each node in the old tree to at most
+ * one node of the same type in the new tree, then derives an edit
+ * script from the matching. The matching proceeds in four phases:
+ *
+ * 1. Subtrees whose structural hashes occur exactly once in each
+ *    tree, and that are structurally equal, match node for node.
+ * 2. Working from the leaves up, an unmatched node matches the old
+ *    node of the same type that parents most of its matched
+ *    children.
+ * 3. Working from the root down, the unmatched children of matched
+ *    nodes match, in order, unmatched old children that are
+ *    structurally equal to them or, failing that, have the same type.
+ * 4. Remaining unmatched subtrees match any unmatched, structurally
+ *    equal old subtree, wherever it is, which detects moved code.
+ *
+ * Each phase takes time roughly proportional to the size of the
+ * trees, and structural hashes are cached in the nodes, so rehashing
+ * an edited tree revisits only the edited paths. The matching is a
+ * heuristic: the resulting edit script is correct but not always the
+ * shortest possible.
+ *
+ * The diff refers to nodes by their indices in \c FrozenTree snapshots
+ * of both trees, which it holds, and which keep both trees alive.
+ * Neither tree \b must be modified while the diff is in use.
+ */
+class TreeDiff {
+public:
+  /**
+   * Returned when a node has no counterpart.
+   */
+  static constexpr size_t NO_NODE = FrozenTree::NO_NODE;
+
+  /**
+   * @brief The kinds of edit in an edit script
+   */
+  enum class EditKind {
+    INSERT,  /** A new node with no counterpart in the old tree */
+    DELETE,  /** An old node with no counterpart in the new tree */
+    MOVE,  /** A node with a different parent or sibling order */
+    UPDATE,  /** A node whose attributes changed */
+  };
+
+  /**
+   * @brief A single edit
+   *
+   * The new node's parent and its position among its siblings are
+   * available from \c new_tree().
+   */
+  struct Edit {
+    EditKind kind;
+    size_t old_index;  /** Old node index, or \c NO_NODE for \c INSERT */
+    size_t new_index;  /** New node index, or \c NO_NODE for \c DELETE */
+
+    bool operator==(const Edit& that) const = default;
+  };
+
+private:
+  using Index = std::uint32_t;  /** Compact node index */
+
+  static constexpr Index NO_INDEX = static_cast<Index>(-1);
+
+  FrozenTree old_tree_;
+  FrozenTree new_tree_;
+  std::vector<Index> old_to_new_;  /** New counterparts, by old index */
+  std::vector<Index> new_to_old_;  /** Old counterparts, by new index */
+  std::vector<Edit> edits_;
+
+  friend class TreeMatcher;
+
+  TreeDiff(FrozenTree&& old_tree, FrozenTree&& new_tree);
+
+  /**
+   * @brief Derives the edit script from the matching
+   */
+  void script(void);
+
+  static size_t unpack(Index index) {
+    return NO_INDEX == index ? NO_NODE : index;
+  }
+
+public:
+  TreeDiff(const TreeDiff &other) = delete;
+  TreeDiff(TreeDiff &&other) = default;
+  TreeDiff& operator=(const TreeDiff &other) = delete;
+  TreeDiff& operator=(TreeDiff &&other) = default;
+  ~TreeDiff() = default;
+
+  /**
+   * @brief Compares two trees
+   *
+   * @param old_root the root of the old tree. Must not be empty.
+   * @param new_root the root of the new tree. Must not be empty.
+   * @return the differences between the trees
+   *
+   * @throws IllegalOperation if either tree has 2^32 or more nodes
+   */
+  static TreeDiff compare(
+      std::shared_ptr<BaseAttrNode> old_root,
+      std::shared_ptr<BaseAttrNode> new_root);
+
+  /**
+   * @return a snapshot of the old tree
+   */
+  const FrozenTree& old_tree(void) const {
+    return old_tree_;
+  }
+
+  /**
+   * @return a snapshot of the new tree
+   */
+  const FrozenTree& new_tree(void) const {
+    return new_tree_;
+  }
+
+  /**
+   * @param old_index old node index
+   * @return the index of the old node's counterpart in the new tree,
+   *         or \c NO_NODE if it was deleted
+   */
+  size_t new_counterpart(size_t old_index) const {
+    return unpack(old_to_new_[old_index]);
+  }
+
+  /**
+   * @param new_index new node index
+   * @return the index of the new node's counterpart in the old tree,
+   *         or \c NO_NODE if it was inserted
+   */
+  size_t old_counterpart(size_t new_index) const {
+    return unpack(new_to_old_[new_index]);
+  }
+
+  /**
+   * @brief Returns the edit script
+   *
+   * The script lists deletions in old preorder, followed by
+   * insertions, moves, and updates in new preorder. A moved node
+   * whose attributes changed has both a \c MOVE and an \c UPDATE.
+   * Nodes that appear in no edit are unchanged, apart from changes to
+   * their descendants.
+   *
+   * @return the edits that transform the old tree into the new one
+   */
+  const std::vector<Edit>& edits(void) const {
+    return edits_;
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* TREEDIFF_H_ */
@@ -28,11 +28,11 @@
  */
 #pragma once
 
-namespace VisitingParseTree {
-
 #include <stdexcept>
 #include <string>
 
+namespace VisitingParseTree {
+
 /**
  * @brief Base for all exception thrown by nodes.
  *
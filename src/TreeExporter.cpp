@@ -0,0 +1,116 @@
+/*
+ * TreeExporter.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TreeExporter.h"
+
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "VoidFunction.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Exports each entered node, eliding children below the
+ *        depth limit
+ */
+class TreeExporter::OnEntry : public BorrowedNodeAction<BaseAttrNode> {
+  TreeExporter& exporter_;
+
+public:
+  OnEntry(TreeExporter& exporter) :
+      exporter_(exporter) {
+  }
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    size_t elided =
+        exporter_.max_depth_ <= exporter_.depth_
+            ? node->child_count()
+            : 0;
+    exporter_.enter(*node, elided);
+    exporter_.end_record();
+    return elided
+        ? TraversalStatus::BYPASS_CHILDREN
+        : TraversalStatus::CONTINUE;
+  }
+};
+
+class TreeExporter::OnExit : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+class TreeExporter::Descent : public VoidFunction {
+  TreeExporter& exporter_;
+
+public:
+  Descent(TreeExporter& exporter) :
+      exporter_(exporter) {
+  }
+
+  virtual void operator()() override {
+    ++exporter_.depth_;
+    exporter_.descend();
+  }
+};
+
+class TreeExporter::Ascent : public VoidFunction {
+  TreeExporter& exporter_;
+
+public:
+  Ascent(TreeExporter& exporter) :
+      exporter_(exporter) {
+  }
+
+  virtual void operator()() override {
+    --exporter_.depth_;
+    exporter_.ascend();
+    exporter_.end_record();
+  }
+};
+
+TreeExporter::TreeExporter(ByteSink& sink) :
+    sink_(sink) {
+}
+
+TreeExporter::TreeExporter(std::ostream& out) :
+    stream_sink_(std::make_unique<StreamSink>(out)),
+    sink_(*stream_sink_) {
+}
+
+void TreeExporter::write(BaseAttrNode *root) {
+  OnEntry on_entry(*this);
+  OnExit on_exit;
+  Descent descent(*this);
+  Ascent ascent(*this);
+  BorrowingTraversal<BaseAttrNode> traversal(
+      on_entry, on_exit, descent, ascent);
+  depth_ = 0;
+  begin_tree();
+  traversal(root);
+  end_tree();
+  flush();
+}
+
+} /* namespace VisitingParseTree */
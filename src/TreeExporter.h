@@ -0,0 +1,242 @@
+/*
+ * TreeExporter.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file TreeExporter.h
+ *
+ * @brief Base class for streaming text exporters
+ */
+#ifndef TREEEXPORTER_H_
+#define TREEEXPORTER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <string_view>
+
+#include "BaseAttrNode.h"
+#include "ByteSink.h"
+#include "StreamSink.h"
+#include "TextBuffer.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Streams \c BaseAttrNode trees to a \c ByteSink as text
+ *
+ * An exporter traverses a tree once and formats each node into a
+ * buffer that it hands to the sink whenever the buffer fills, so
+ * export time is linear in the size of the tree and memory use is
+ * bounded by the buffer and the tree's depth. Subclasses supply the
+ * format through the node and structure callbacks below.
+ *
+ * An exporter exports whatever subtree it is given, and
+ * \c set_max_depth() limits how deep it goes. Nodes whose children
+ * fall below the limit are exported with the number of children
+ * elided.
+ *
+ * \see DotExporter
+ * \see JsonExporter
+ */
+class TreeExporter {
+public:
+  /**
+   * Limit value that disables truncation
+   */
+  static constexpr size_t UNLIMITED = std::numeric_limits<size_t>::max();
+
+  /**
+   * Buffered output size that triggers a write
+   */
+  static constexpr size_t BUFFER_SIZE = TextBuffer::CAPACITY;
+
+private:
+  class OnEntry;
+  class OnExit;
+  class Descent;
+  class Ascent;
+
+  std::unique_ptr<StreamSink> stream_sink_;  /** Owned sink, if any */
+  ByteSink& sink_;  /** Destination */
+  TextBuffer buffer_;  /** Formatted output */
+  size_t max_depth_ = UNLIMITED;  /** Deepest exported level, root is 0 */
+  size_t depth_ = 0;  /** Depth of the children being exported */
+
+protected:
+  /**
+   * @brief Creates an exporter bound to a sink
+   *
+   * @param sink destination, which must outlive the exporter
+   */
+  TreeExporter(ByteSink& sink);
+
+  /**
+   * @brief Creates an exporter bound to an output stream
+   *
+   * @param out destination, which must outlive the exporter
+   */
+  TreeExporter(std::ostream& out);
+
+  /**
+   * @brief Appends text to the output
+   *
+   * @param text the text to append
+   */
+  void append(std::string_view text) {
+    buffer_.append(text);
+  }
+
+  /**
+   * @brief Appends a character to the output
+   *
+   * @param c the character to append
+   */
+  void append(char c) {
+    buffer_.append(c);
+  }
+
+  /**
+   * @brief Appends an integer in decimal
+   *
+   * @param number the integer to append
+   */
+  void append_number(std::int64_t number) {
+    buffer_.append_number(number);
+  }
+
+  /**
+   * @brief Appends an unsigned integer in decimal
+   *
+   * @param number the integer to append
+   */
+  void append_number(std::uint64_t number) {
+    buffer_.append_number(number);
+  }
+
+  /**
+   * @brief Appends a \c double in the shortest form that parses back
+   *        to the same value
+   *
+   * @param number the value to append
+   */
+  void append_number(double number) {
+    buffer_.append_number(number);
+  }
+
+  /**
+   * @brief Ends a unit of output, writing the buffer once it fills
+   *
+   * Subclasses call this after each node so that the buffer stays
+   * close to \c BUFFER_SIZE.
+   */
+  void end_record(void) {
+    buffer_.write_if_full(sink_);
+  }
+
+  /**
+   * @brief Writes the start of a tree
+   */
+  virtual void begin_tree(void) = 0;
+
+  /**
+   * @brief Writes an entered node
+   *
+   * @param node the entered node
+   * @param elided the number of children that are not exported
+   *        because they fall below the depth limit, which is either 0
+   *        or all of the node's children. When \c elided is 0 and the
+   *        node has children, \c descend() follows.
+   */
+  virtual void enter(BaseAttrNode& node, size_t elided) = 0;
+
+  /**
+   * @brief Writes whatever precedes the entered node's first child
+   */
+  virtual void descend(void) = 0;
+
+  /**
+   * @brief Writes whatever follows the last child of the node being
+   *        exited
+   */
+  virtual void ascend(void) = 0;
+
+  /**
+   * @brief Writes the end of a tree
+   */
+  virtual void end_tree(void) = 0;
+
+public:
+  TreeExporter(const TreeExporter&) = delete;
+  TreeExporter& operator=(const TreeExporter&) = delete;
+  virtual ~TreeExporter() = default;
+
+  /**
+   * @brief Limits the exported depth
+   *
+   * @param max_depth the depth of the deepest exported nodes, where
+   *        the root's depth is 0, or \c UNLIMITED to export every
+   *        level
+   */
+  void set_max_depth(size_t max_depth) {
+    max_depth_ = max_depth;
+  }
+
+  /**
+   * @brief Exports a tree
+   *
+   * Every byte of the tree reaches the sink before this method
+   * returns.
+   *
+   * @param root the root of the tree to export, which can be any node
+   *        in a containing tree. Must not be \c NULL.
+   *
+   * @throws IllegalOperation if the sink fails
+   */
+  void write(BaseAttrNode *root);
+
+  /**
+   * @brief Exports a tree
+   *
+   * Convenience overload for callers that own the root.
+   *
+   * @param root the root of the tree to export. Must not be empty.
+   */
+  void write(const std::shared_ptr<BaseAttrNode>& root) {
+    write(root.get());
+  }
+
+  /**
+   * @brief Hands everything formatted so far to the sink
+   *
+   * @throws IllegalOperation if the sink fails
+   */
+  void flush(void) {
+    buffer_.write_to(sink_);
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* TREEEXPORTER_H_ */
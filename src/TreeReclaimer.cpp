@@ -0,0 +1,86 @@
+/*
+ * TreeReclaimer.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file TreeReclaimer.cpp
+ *
+ * Background tree destruction implementation
+ */
+
+#include "TreeReclaimer.h"
+
+#include <utility>
+
+namespace VisitingParseTree {
+
+TreeReclaimer::TreeReclaimer(void) :
+    in_progress_(0),
+    stopping_(false),
+    thread_(&TreeReclaimer::work, this) {
+}
+
+TreeReclaimer::~TreeReclaimer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  changed_.notify_all();
+  thread_.join();
+}
+
+void TreeReclaimer::enqueue(std::shared_ptr<void> tree) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    doomed_.push_back(std::move(tree));
+  }
+  changed_.notify_all();
+}
+
+void TreeReclaimer::drain(void) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  changed_.wait(lock, [this]() {
+    return doomed_.empty() && !in_progress_;
+  });
+}
+
+void TreeReclaimer::work(void) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    changed_.wait(lock, [this]() {
+      return stopping_ || !doomed_.empty();
+    });
+    if (doomed_.empty()) {
+      return;
+    }
+    std::shared_ptr<void> tree = std::move(doomed_.front());
+    doomed_.pop_front();
+    ++in_progress_;
+    lock.unlock();
+    tree.reset();
+    lock.lock();
+    --in_progress_;
+    changed_.notify_all();
+  }
+}
+
+} /* namespace VisitingParseTree */
@@ -0,0 +1,115 @@
+/*
+ * TreeReclaimer.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file TreeReclaimer.h
+ *
+ * @brief Destroys detached trees on a background thread
+ */
+#ifndef TREERECLAIMER_H_
+#define TREERECLAIMER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace VisitingParseTree {
+
+/**
+ * @brief Destroys trees on a background thread, so that releasing a
+ *        large tree does not stall a latency-sensitive one
+ *
+ * Hand a reclaimer the last reference to a detached tree's root, and
+ * the reclaimer's thread destroys the tree. A tree that is still
+ * referenced elsewhere, including by a parent, is not destroyed until
+ * its last reference is released, which might happen on another
+ * thread.
+ *
+ * Destroying the reclaimer destroys every tree it holds before the
+ * destructor returns.
+ */
+class TreeReclaimer {
+  std::mutex mutex_;  /** Guards the fields below */
+  std::condition_variable changed_;  /** Signaled when state changes */
+  std::deque<std::shared_ptr<void>> doomed_;  /** Trees to destroy */
+  size_t in_progress_;  /** Trees being destroyed */
+  bool stopping_;  /** Set on destruction */
+  std::thread thread_;
+
+  /**
+   * @brief Queues a tree for destruction
+   *
+   * @param tree the tree to destroy
+   */
+  void enqueue(std::shared_ptr<void> tree);
+
+  /**
+   * @brief Reclaimer thread body
+   */
+  void work(void);
+
+public:
+  /**
+   * @brief Creates a reclaimer and starts its thread
+   */
+  TreeReclaimer(void);
+
+  TreeReclaimer(const TreeReclaimer &other) = delete;
+  TreeReclaimer(TreeReclaimer &&other) = delete;
+  TreeReclaimer& operator=(const TreeReclaimer &other) = delete;
+  TreeReclaimer& operator=(TreeReclaimer &&other) = delete;
+
+  /**
+   * @brief Destroys pending trees and joins the reclaimer thread
+   */
+  ~TreeReclaimer();
+
+  /**
+   * @brief Hands a tree to the reclaimer for destruction
+   *
+   * Takes an rvalue so that the caller gives up its reference, and
+   * returns without touching the tree's nodes.
+   *
+   * @tparam T node type
+   * @param tree the tree's root, which should be detached and
+   *        otherwise unreferenced. Empty on return.
+   */
+  template <typename T> void reclaim(std::shared_ptr<T>&& tree) {
+    if (tree) {
+      enqueue(std::shared_ptr<void>(std::move(tree)));
+    }
+  }
+
+  /**
+   * @brief Waits until every tree handed to the reclaimer has been
+   *        released
+   */
+  void drain(void);
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* TREERECLAIMER_H_ */
@@ -0,0 +1,123 @@
+/*
+ * TypedAttribute.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file TypedAttribute.h
+ *
+ * @brief Base class for attributes having scalar values
+ */
+
+#ifndef TYPEDATTRIBUTE_H_
+#define TYPEDATTRIBUTE_H_
+
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "Attribute.h"
+#include "AttributeValue.h"
+#include "IllegalOperation.h"
+#include "InternPool.h"
+#include "InternedString.h"
+
+namespace VisitingParseTree {
+
+/**
+ * @brief An attribute whose value is a scalar or an interned string
+ *
+ * Nodes store typed attribute values unboxed, and \c AttrNode provides
+ * typed \c get() and \c set() overloads that neither allocate nor
+ * parse. The string \c set() overload remains available and parses
+ * its argument, interning text for \c InternedString attributes in
+ * the global pool. The string \c get() overload is illegal on scalar
+ * attributes but returns an interned attribute's text.
+ *
+ * Like other attributes, typed attributes must be static members
+ * of an attribute class that controls their construction, e.g.
+ *
+ *     class MyAttributes : public VisitingParseTree::Attribute {
+ *       template <typename V>
+ *       class Typed : public VisitingParseTree::TypedAttribute<V> {
+ *         friend class MyAttributes;
+ *         Typed(const char *name) :
+ *           VisitingParseTree::TypedAttribute<V>(name) {}
+ *       };
+ *       MyAttributes(const char *name);
+ *     public:
+ *       static MyAttributes NAME;
+ *       static Typed<std::int64_t> COUNT;
+ *     };
+ *
+ * @tparam V value type: \c std::int64_t, \c double, \c bool, or
+ *         \c InternedString
+ */
+template <typename V> class TypedAttribute : public Attribute {
+protected:
+  /**
+   * @brief Construct a TypedAttribute instance
+   *
+   * @param name the instance's name, which __should__ be globally unique
+   */
+  TypedAttribute(const char *name) :
+    Attribute(name, attribute_type_of<V>) {
+  }
+
+public:
+  virtual ~TypedAttribute() = default;
+
+  /**
+   * @brief Parses a textual value
+   *
+   * @param text the value to parse. \c bool values must be \c true or
+   *        \c false.
+   * @return the parsed value. \c InternedString values are interned
+   *         in \c InternPool::global().
+   *
+   * @throws IllegalOperation if \c text does not represent a \c V
+   */
+  virtual AttributeValue parse(std::string_view text) const override {
+    V result{};
+    if constexpr (std::is_same_v<V, InternedString>) {
+      return InternPool::global().intern(text);
+    } else if constexpr (std::is_same_v<V, bool>) {
+      if (text == "true" || text == "false") {
+        return text == "true";
+      }
+    } else {
+      const char *last = text.data() + text.size();
+      auto [end, error] = std::from_chars(text.data(), last, result);
+      if (std::errc() == error && end == last) {
+        return result;
+      }
+    }
+    throw IllegalOperation(
+        "Invalid value \"" + std::string(text) + "\" for attribute "
+        + name() + '.');
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* TYPEDATTRIBUTE_H_ */
@@ -29,6 +29,7 @@
 #ifndef SRC_VISITINGACTION_H_
 #define SRC_VISITINGACTION_H_
 
+#include "BorrowedNodeAction.h"
 #include "NodeAction.h"
 #include "TraversalStatus.h"
 #include "TreeCorruptError.h"
@@ -40,13 +41,16 @@ namespace VisitingParseTree {
  * @brief An action that applies a visitor to nodes.
  *
  * A \c VisitingParseTree adapts a \c Visitor for use by a
- * \c Traversal. The \c Visitor is set at construction.
+ * \c Traversal or \c BorrowingTraversal. The \c Visitor is set at
+ * construction.
  *
  * @tparam T node class
  *
  * \see Host for restrictions on \c T.
  */
-template <typename T> class VisitingAction : public NodeAction<T> {
+template <typename T> class VisitingAction :
+    public NodeAction<T>,
+    public BorrowedNodeAction<T> {
   Visitor *visitor_;
 
 public:
@@ -60,6 +64,13 @@ public:
     }
     return node->accept(visitor_);
   }
+
+  virtual TraversalStatus operator() (T *node) override {
+    if (!node) {
+      throw TreeCorruptError("Null node encountered during traversal.");
+    }
+    return node->accept(visitor_);
+  }
 };
 
 } /* namespace VisitingParseTree */
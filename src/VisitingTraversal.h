@@ -52,6 +52,10 @@ namespace VisitingParseTree {
  * @brief traverses a tree of \c Host<T> applying entry and exit
  *        visitors to all encountered nodes
  *
+ * The traversal shares ownership of each node that it visits.
+ * \c BorrowingVisitingTraversal avoids the reference count updates
+ * that this costs.
+ *
  * @tparam T node class, which must inherit \c Host<T>
  */
 template <typename T> class VisitingTraversal {
@@ -30,10 +30,16 @@
 #ifndef VISITOR_H_
 #define VISITOR_H_
 
+#include <atomic>
+#include <bit>
+#include <cstddef>
+
 #include "TraversalStatus.h"
 
 namespace VisitingParseTree {
 
+class BaseDispatchTag;
+
 /*
  * Marker interface for node visitors. All node visitors
  * MUST inherit this class.
@@ -43,13 +49,92 @@ namespace VisitingParseTree {
  *
  * A well known class for visitors, the type passed to `Host::accept()`.
  * \c Node visitors \b must inherit this interface.
+ *
+ * Each visitor carries a dispatch table, filled in as the visitor
+ * encounters node classes, that records which of its visitor
+ * interfaces handles each class. Table entries are written at most
+ * once, with the same value by every writer, and are accessed
+ * atomically, so several threads may apply a visitor at once,
+ * provided that the visitor itself allows it.
+ *
+ * \see DispatchTag
  */
 class Visitor {
+  friend class BaseDispatchTag;
+  template <typename T> friend class DispatchTag;
+
+  /**
+   * @brief How a visitor handles a node class
+   *
+   * An entry whose \c handler is \c NULL has not been resolved.
+   * \c concrete_visitor is written before \c handler, so a thread
+   * that sees the handler also sees the cast visitor.
+   */
+  struct DispatchEntry {
+    std::atomic<const BaseDispatchTag *> handler;  /** Nearest handling tag */
+    /** Visitor cast to the handler's interface, NULL if unhandled */
+    std::atomic<void *> concrete_visitor;
+  };
+
+  /*
+   * The table grows in segments that are never moved, so readers need
+   * no lock. Segment k holds FIRST_SEGMENT_SIZE << k entries.
+   */
+  static constexpr size_t FIRST_SEGMENT_SIZE = 64;
+  static constexpr size_t SEGMENT_COUNT = 32;
+
+  /** Indexed by dispatch tag identifier */
+  std::atomic<DispatchEntry *> dispatch_table_[SEGMENT_COUNT] = {};
+
+  /**
+   * @brief Finds a dispatch tag's table entry, allocating it if
+   *        necessary
+   *
+   * @param id the tag's identifier
+   * @return the entry
+   */
+  DispatchEntry& dispatch_entry(size_t id) {
+    size_t segment = std::bit_width(id / FIRST_SEGMENT_SIZE + 1) - 1;
+    size_t offset = id - FIRST_SEGMENT_SIZE * ((size_t(1) << segment) - 1);
+    DispatchEntry *entries =
+        dispatch_table_[segment].load(std::memory_order_acquire);
+    if (!entries) {
+      DispatchEntry *allocated =
+          new DispatchEntry[FIRST_SEGMENT_SIZE << segment]();
+      if (dispatch_table_[segment].compare_exchange_strong(
+          entries, allocated, std::memory_order_acq_rel)) {
+        entries = allocated;
+      } else {
+        delete[] allocated;
+      }
+    }
+    return entries[offset];
+  }
+
 protected:
   Visitor(void) = default;
 
+  /**
+   * Copy constructor. The dispatch table refers to the original, so
+   * it is not copied.
+   */
+  Visitor(const Visitor&) {
+  }
+
+  /**
+   * Assignment. Leaves the dispatch table unchanged since it depends
+   * only on the visitor's class.
+   */
+  Visitor& operator=(const Visitor&) {
+    return *this;
+  }
+
 public:
-  virtual ~Visitor() = default;
+  virtual ~Visitor() {
+    for (auto& segment : dispatch_table_) {
+      delete[] segment.load(std::memory_order_relaxed);
+    }
+  }
 };
 
 }  /* namespace VisitingParseTree */
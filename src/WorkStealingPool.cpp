@@ -0,0 +1,164 @@
+/*
+ * WorkStealingPool.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file WorkStealingPool.cpp
+ *
+ * Work-stealing thread pool implementation
+ */
+
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+
+namespace VisitingParseTree {
+
+namespace {
+
+/*
+ * Identifies the pool, if any, that owns the current thread, and the
+ * thread's queue within it.
+ */
+struct WorkerIdentity {
+  const WorkStealingPool *pool = nullptr;
+  size_t index = 0;
+};
+
+thread_local WorkerIdentity current_worker;
+
+}
+
+namespace {
+
+size_t worker_count_for(size_t thread_count) {
+  return thread_count
+      ? thread_count
+      : std::max(1u, std::thread::hardware_concurrency());
+}
+
+}
+
+WorkStealingPool::WorkStealingPool(size_t thread_count) :
+    worker_count_(worker_count_for(thread_count)),
+    queued_(0),
+    stopping_(false) {
+  for (size_t i = 0; i <= worker_count_; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  threads_.reserve(worker_count_);
+  for (size_t i = 0; i < worker_count_; ++i) {
+    threads_.emplace_back(&WorkStealingPool::work, this, i);
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    stopping_ = true;
+  }
+  idle_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+size_t WorkStealingPool::home_queue(void) const {
+  return this == current_worker.pool
+      ? current_worker.index
+      : worker_count_;
+}
+
+bool WorkStealingPool::take(
+    size_t index, bool newest, std::function<void()>& task) {
+  Queue& queue = *queues_[index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty()) {
+    return false;
+  }
+  if (newest) {
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+  } else {
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+  }
+  --queued_;
+  return true;
+}
+
+bool WorkStealingPool::run_from(size_t home) {
+  std::function<void()> task;
+  bool found = take(home, home < worker_count_, task);
+  for (size_t i = 1; !found && i < queues_.size(); ++i) {
+    found = take((home + i) % queues_.size(), false, task);
+  }
+  if (found) {
+    task();
+  }
+  return found;
+}
+
+void WorkStealingPool::work(size_t index) {
+  current_worker = WorkerIdentity{this, index};
+  while (!stopping_) {
+    if (!run_from(index)) {
+      std::unique_lock<std::mutex> lock(idle_mutex_);
+      idle_.wait(lock, [this]() { return stopping_ || 0 < queued_; });
+    }
+  }
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+  Queue& queue = *queues_[home_queue()];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+    ++queued_;
+  }
+  {
+    // Synchronizes with idle workers' predicate check, so that none
+    // misses the wakeup.
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+  }
+  idle_.notify_one();
+}
+
+bool WorkStealingPool::run_pending_task(void) {
+  return run_from(home_queue());
+}
+
+void WorkStealingPool::wait_for_work(const std::function<bool()>& done) {
+  std::unique_lock<std::mutex> lock(idle_mutex_);
+  idle_.wait(lock, [this, &done]() { return 0 < queued_ || done(); });
+}
+
+void WorkStealingPool::notify_waiters(void) {
+  {
+    // Orders the caller's state change before waiters' condition
+    // checks, so that none misses the wakeup.
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+  }
+  idle_.notify_all();
+}
+
+} /* namespace VisitingParseTree */
@@ -0,0 +1,184 @@
+/*
+ * WorkStealingPool.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file WorkStealingPool.h
+ *
+ * @brief Thread pool whose idle workers steal queued tasks from busy ones
+ */
+#ifndef WORKSTEALINGPOOL_H_
+#define WORKSTEALINGPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace VisitingParseTree {
+
+/**
+ * @brief A fixed-size pool of worker threads that balance load by
+ *        stealing work
+ *
+ * Each worker owns a task queue. Tasks submitted by a worker go to the
+ * back of its own queue, and the worker takes tasks from the back, so
+ * it works depth first on the tasks it created most recently, whose
+ * data are most likely to be in its cache. An idle worker steals from
+ * the front of another worker's queue, taking the oldest, and in a
+ * recursive decomposition the largest, piece of pending work. Tasks
+ * submitted from outside the pool go to a shared injection queue.
+ *
+ * Tasks \b must \b not throw; use \c TaskGroup, which captures
+ * exceptions, to run work that might. A pool \b must outlive every
+ * \c TaskGroup that uses it. Destroying a pool discards tasks that
+ * have not started.
+ */
+class WorkStealingPool {
+  /**
+   * @brief A mutex-guarded task queue
+   */
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  const size_t worker_count_;  /** Number of worker threads */
+
+  /*
+   * One queue per worker, followed by the injection queue.
+   */
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> threads_;
+  std::mutex idle_mutex_;  /** Guards sleeping */
+  std::condition_variable idle_;  /** Signaled when work arrives */
+  std::atomic<size_t> queued_;  /** Number of queued tasks */
+  std::atomic<bool> stopping_;  /** Set on destruction */
+
+  /**
+   * @return the index of the calling thread's queue: its own if it is
+   *         one of this pool's workers, the injection queue otherwise
+   */
+  size_t home_queue(void) const;
+
+  /**
+   * @brief Removes a task from the specified queue
+   *
+   * @param index queue index
+   * @param newest \c true to take the most recently queued task,
+   *        \c false to take the oldest
+   * @param task receives the removed task
+   * @return \c true if and only if a task was removed
+   */
+  bool take(size_t index, bool newest, std::function<void()>& task);
+
+  /**
+   * @brief Runs a task from the specified queue or, if it is empty,
+   *        one stolen from another queue
+   *
+   * @param home the index of the caller's queue
+   * @return \c true if and only if a task was run
+   */
+  bool run_from(size_t home);
+
+  /**
+   * @brief Worker thread body
+   *
+   * @param index the worker's queue index
+   */
+  void work(size_t index);
+
+public:
+  /**
+   * @brief Creates a pool and starts its workers
+   *
+   * @param thread_count number of worker threads. Zero means one per
+   *        hardware thread.
+   */
+  explicit WorkStealingPool(size_t thread_count = 0);
+
+  WorkStealingPool(const WorkStealingPool &other) = delete;
+  WorkStealingPool(WorkStealingPool &&other) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool &other) = delete;
+  WorkStealingPool& operator=(WorkStealingPool &&other) = delete;
+
+  /**
+   * @brief Stops and joins the workers
+   */
+  ~WorkStealingPool();
+
+  /**
+   * @return the number of worker threads
+   */
+  size_t thread_count(void) const {
+    return worker_count_;
+  }
+
+  /**
+   * @brief Queues a task for execution
+   *
+   * @param task the task to run. Must not throw.
+   */
+  void submit(std::function<void()> task);
+
+  /**
+   * @brief Runs one queued task on the calling thread, if one is
+   *        available
+   *
+   * Lets threads that wait for tasks to complete help with the work
+   * rather than block, which also keeps a worker that waits for its
+   * own subtasks from deadlocking the pool.
+   *
+   * @return \c true if and only if a task was run
+   */
+  bool run_pending_task(void);
+
+  /**
+   * @brief Blocks the calling thread until a task is queued or a
+   *        condition holds
+   *
+   * The caller sleeps alongside idle workers, so a task queued by any
+   * thread can wake it to help. Wake it for the condition with
+   * \c notify_waiters().
+   *
+   * @param done the condition to wait for. Evaluated with the pool's
+   *        idle mutex held, so it must not block.
+   */
+  void wait_for_work(const std::function<bool()>& done);
+
+  /**
+   * @brief Wakes every thread blocked in \c wait_for_work() so that it
+   *        rechecks its condition
+   *
+   * Callers must change the state the condition reads before calling.
+   */
+  void notify_waiters(void);
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* WORKSTEALINGPOOL_H_ */
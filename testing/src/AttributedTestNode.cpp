@@ -17,13 +17,16 @@ std::shared_ptr<VisitingParseTree::BaseAttrNode> AttributedTestNodeSupplier::mak
 
 AttributedTestNodeSupplier AttributedTestNode::SUPPLIER;
 
+VisitingParseTree::DispatchTag<VisitingParseTree::BaseAttrNode> AttributedTestNode::DISPATCH_TAG =
+    VisitingParseTree::DispatchTag<VisitingParseTree::BaseAttrNode>::make<
+        AttributedTestNode,
+        AttributedTestNodeVisitor,
+        &AttributedTestNodeVisitor::process_attributed_test_node>(
+            &VisitingParseTree::BaseAttrNode::DISPATCH_TAG);
+
 VisitingParseTree::TraversalStatus AttributedTestNode::accept(
     VisitingParseTree::Visitor *visitor) {
-  auto concrete_visitor = dynamic_cast<AttributedTestNodeVisitor *> (visitor);
-
-  return concrete_visitor
-      ? concrete_visitor->process_attributed_test_node(this)
-      : VisitingParseTree::BaseAttrNode::accept(visitor);
+  return DISPATCH_TAG.dispatch(visitor, this);
 }
 
 AttributedTestNodeSupplier& AttributedTestNode::supplier() {
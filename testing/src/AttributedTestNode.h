@@ -43,6 +43,8 @@ public:
 
   virtual ~AttributedTestNode() = default;
 
+  static VisitingParseTree::DispatchTag<VisitingParseTree::BaseAttrNode> DISPATCH_TAG;
+
   virtual VisitingParseTree::TraversalStatus accept(
       VisitingParseTree::Visitor *visitor) override;
 
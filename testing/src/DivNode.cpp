@@ -14,11 +14,15 @@ DivNodeSupplier DivNode::SUPPLIER;
 DivNode::DivNode(BaseAttrNode::forbid_public_access) {
 }
 
+DispatchTag<BaseAttrNode> DivNode::DISPATCH_TAG =
+    DispatchTag<BaseAttrNode>::make<
+        DivNode,
+        DivNodeVisitor,
+        &DivNodeVisitor::process_div_node>(
+            &OperatorNode::DISPATCH_TAG);
+
 TraversalStatus DivNode::accept(Visitor *visitor) {
-  DivNodeVisitor *concrete_visitor = dynamic_cast<DivNodeVisitor *>(visitor);
-  return concrete_visitor
-      ? concrete_visitor->process_div_node(this)
-      : OperatorNode::accept(visitor);
+  return DISPATCH_TAG.dispatch(visitor, this);
 }
 
 Supplier<BaseAttrNode>& DivNode::supplier() {
@@ -33,4 +37,9 @@ std::shared_ptr<BaseAttrNode> DivNodeSupplier::make_shared() {
       std::make_shared<DivNode>(BaseAttrNode::forbid_public_access::here));
 }
 
+std::shared_ptr<BaseAttrNode> DivNodeSupplier::allocate_shared(NodeArena& arena) {
+  return std::static_pointer_cast<BaseAttrNode>(
+      arena.make_shared<DivNode>(BaseAttrNode::forbid_public_access::here));
+}
+
 } /* namespace VisitingParseTree */
@@ -32,6 +32,8 @@ public:
 
   static DivNodeSupplier SUPPLIER;
 
+  static DispatchTag<BaseAttrNode> DISPATCH_TAG;
+
   virtual TraversalStatus accept(Visitor *visitor) override;
 
   virtual Supplier<BaseAttrNode>& supplier();
@@ -44,6 +46,8 @@ public:
   virtual ~DivNodeSupplier() = default;
 
   virtual std::shared_ptr<BaseAttrNode> make_shared() override;
+
+  virtual std::shared_ptr<BaseAttrNode> allocate_shared(NodeArena& arena) override;
 };
 
 class DivNodeVisitor {
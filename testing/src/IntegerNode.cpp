@@ -11,11 +11,15 @@ namespace VisitingParseTree {
 
 IntegerNodeSupplier IntegerNode::SUPPLIER;
 
+DispatchTag<BaseAttrNode> IntegerNode::DISPATCH_TAG =
+    DispatchTag<BaseAttrNode>::make<
+        IntegerNode,
+        IntegerNodeVisitor,
+        &IntegerNodeVisitor::process_integer_node>(
+            &ValueNode::DISPATCH_TAG);
+
 TraversalStatus IntegerNode::accept(Visitor *visitor) {
-  IntegerNodeVisitor *concrete_visitor = dynamic_cast<IntegerNodeVisitor *>(visitor);
-  return concrete_visitor
-      ? concrete_visitor->process_integer_node(this)
-      : ValueNode::accept(visitor);
+  return DISPATCH_TAG.dispatch(visitor, this);
 }
 
 Supplier<BaseAttrNode>& IntegerNode::supplier() {
@@ -31,4 +35,9 @@ std::shared_ptr<BaseAttrNode> IntegerNodeSupplier::make_shared() {
       std::make_shared<IntegerNode>(BaseAttrNode::forbid_public_access::here));
 }
 
+std::shared_ptr<BaseAttrNode> IntegerNodeSupplier::allocate_shared(NodeArena& arena) {
+  return std::static_pointer_cast<BaseAttrNode>(
+      arena.make_shared<IntegerNode>(BaseAttrNode::forbid_public_access::here));
+}
+
 } /* namespace VisitingParseTree */
@@ -0,0 +1,42 @@
+/*
+ * LevelNodes.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ */
+
+#include "LevelNodes.h"
+
+namespace VisitingParseTree {
+
+DispatchTag<BaseAttrNode> LevelTwo::DISPATCH_TAG =
+    DispatchTag<BaseAttrNode>::make<
+        LevelTwo,
+        LevelTwoVisitor,
+        &LevelTwoVisitor::process_level_two>(&BaseAttrNode::DISPATCH_TAG);
+
+DispatchTag<BaseAttrNode> LevelThree::DISPATCH_TAG =
+    DispatchTag<BaseAttrNode>::make<
+        LevelThree,
+        LevelThreeVisitor,
+        &LevelThreeVisitor::process_level_three>(&LevelTwo::DISPATCH_TAG);
+
+DispatchTag<BaseAttrNode> LevelFour::DISPATCH_TAG =
+    DispatchTag<BaseAttrNode>::make<
+        LevelFour,
+        LevelFourVisitor,
+        &LevelFourVisitor::process_level_four>(&LevelThree::DISPATCH_TAG);
+
+DispatchTag<BaseAttrNode> LevelFive::DISPATCH_TAG =
+    DispatchTag<BaseAttrNode>::make<
+        LevelFive,
+        LevelFiveVisitor,
+        &LevelFiveVisitor::process_level_five>(&LevelFour::DISPATCH_TAG);
+
+LevelSupplier LevelTwo::SUPPLIER;
+
+std::shared_ptr<BaseAttrNode> LevelSupplier::make_shared(void) {
+  return std::make_shared<LevelFive>();
+}
+
+} /* namespace VisitingParseTree */
@@ -0,0 +1,144 @@
+/*
+ * LevelNodes.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * A five level node hierarchy for dispatch tests and benchmarks
+ */
+
+#ifndef LEVELNODES_H_
+#define LEVELNODES_H_
+
+#include <memory>
+
+#include "BaseAttrNode.h"
+#include "DispatchTag.h"
+#include "Supplier.h"
+#include "TraversalStatus.h"
+#include "Visitor.h"
+
+namespace VisitingParseTree {
+
+/*
+ * A five level hierarchy: BaseAttrNode <- LevelTwo <- LevelThree
+ * <- LevelFour <- LevelFive. Each class also implements
+ * accept_by_cast(), the dynamic_cast chain that generated code
+ * used to emit. All levels are concrete so that each can be
+ * visited, but the supplier only creates LevelFive nodes.
+ */
+
+class LevelTwo;
+class LevelThree;
+class LevelFour;
+class LevelFive;
+
+class LevelTwoVisitor {
+public:
+  virtual ~LevelTwoVisitor() = default;
+  virtual TraversalStatus process_level_two(LevelTwo *host) = 0;
+};
+
+class LevelThreeVisitor {
+public:
+  virtual ~LevelThreeVisitor() = default;
+  virtual TraversalStatus process_level_three(LevelThree *host) = 0;
+};
+
+class LevelFourVisitor {
+public:
+  virtual ~LevelFourVisitor() = default;
+  virtual TraversalStatus process_level_four(LevelFour *host) = 0;
+};
+
+class LevelFiveVisitor {
+public:
+  virtual ~LevelFiveVisitor() = default;
+  virtual TraversalStatus process_level_five(LevelFive *host) = 0;
+};
+
+class LevelSupplier : public Supplier<BaseAttrNode> {
+public:
+  LevelSupplier(void) :
+    Supplier<BaseAttrNode>("LevelFive") {
+  }
+
+  virtual std::shared_ptr<BaseAttrNode> make_shared(void) override;
+};
+
+class LevelTwo : public BaseAttrNode {
+public:
+  static LevelSupplier SUPPLIER;
+  static DispatchTag<BaseAttrNode> DISPATCH_TAG;
+
+  virtual TraversalStatus accept(Visitor *visitor) override {
+    return DISPATCH_TAG.dispatch(visitor, this);
+  }
+
+  virtual TraversalStatus accept_by_cast(Visitor *visitor) {
+    auto concrete_visitor = dynamic_cast<LevelTwoVisitor *>(visitor);
+    if (concrete_visitor) {
+      return concrete_visitor->process_level_two(this);
+    }
+    auto base_visitor = dynamic_cast<BaseAttrNodeVisitor *>(visitor);
+    return base_visitor
+        ? base_visitor->processBaseAttrNode(this)
+        : TraversalStatus::CONTINUE;
+  }
+
+  virtual Supplier<BaseAttrNode>& supplier(void) override {
+    return SUPPLIER;
+  }
+};
+
+class LevelThree : public LevelTwo {
+public:
+  static DispatchTag<BaseAttrNode> DISPATCH_TAG;
+
+  virtual TraversalStatus accept(Visitor *visitor) override {
+    return DISPATCH_TAG.dispatch(visitor, this);
+  }
+
+  virtual TraversalStatus accept_by_cast(Visitor *visitor) override {
+    auto concrete_visitor = dynamic_cast<LevelThreeVisitor *>(visitor);
+    return concrete_visitor
+        ? concrete_visitor->process_level_three(this)
+        : LevelTwo::accept_by_cast(visitor);
+  }
+};
+
+class LevelFour : public LevelThree {
+public:
+  static DispatchTag<BaseAttrNode> DISPATCH_TAG;
+
+  virtual TraversalStatus accept(Visitor *visitor) override {
+    return DISPATCH_TAG.dispatch(visitor, this);
+  }
+
+  virtual TraversalStatus accept_by_cast(Visitor *visitor) override {
+    auto concrete_visitor = dynamic_cast<LevelFourVisitor *>(visitor);
+    return concrete_visitor
+        ? concrete_visitor->process_level_four(this)
+        : LevelThree::accept_by_cast(visitor);
+  }
+};
+
+class LevelFive : public LevelFour {
+public:
+  static DispatchTag<BaseAttrNode> DISPATCH_TAG;
+
+  virtual TraversalStatus accept(Visitor *visitor) override {
+    return DISPATCH_TAG.dispatch(visitor, this);
+  }
+
+  virtual TraversalStatus accept_by_cast(Visitor *visitor) override {
+    auto concrete_visitor = dynamic_cast<LevelFiveVisitor *>(visitor);
+    return concrete_visitor
+        ? concrete_visitor->process_level_five(this)
+        : LevelFour::accept_by_cast(visitor);
+  }
+};
+
+} /* namespace VisitingParseTree */
+
+#endif /* LEVELNODES_H_ */
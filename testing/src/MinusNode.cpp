@@ -11,11 +11,15 @@ namespace VisitingParseTree {
 
 MinusNodeSupplier MinusNode::SUPPLIER;
 
+DispatchTag<BaseAttrNode> MinusNode::DISPATCH_TAG =
+    DispatchTag<BaseAttrNode>::make<
+        MinusNode,
+        MinusNodeVisitor,
+        &MinusNodeVisitor::process_minus_node>(
+            &OperatorNode::DISPATCH_TAG);
+
 TraversalStatus MinusNode::accept(Visitor *visitor) {
-  MinusNodeVisitor *concrete_visitor = dynamic_cast<MinusNodeVisitor *>(visitor);
-  return concrete_visitor
-      ? concrete_visitor->process_minus_node(this)
-      : OperatorNode::accept(visitor);
+  return DISPATCH_TAG.dispatch(visitor, this);
 }
 
 Supplier<BaseAttrNode>& MinusNode::supplier() {
@@ -31,4 +35,9 @@ std::shared_ptr<BaseAttrNode> MinusNodeSupplier::make_shared() {
       std::make_shared<MinusNode>(BaseAttrNode::forbid_public_access::here));
 }
 
+std::shared_ptr<BaseAttrNode> MinusNodeSupplier::allocate_shared(NodeArena& arena) {
+  return std::static_pointer_cast<BaseAttrNode>(
+      arena.make_shared<MinusNode>(BaseAttrNode::forbid_public_access::here));
+}
+
 } /* namespace VisitingParseTree */
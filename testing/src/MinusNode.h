@@ -34,6 +34,8 @@ public:
 
   static MinusNodeSupplier SUPPLIER;
 
+  static DispatchTag<BaseAttrNode> DISPATCH_TAG;
+
   virtual TraversalStatus accept(Visitor *visitor) override;
 
   virtual Supplier<BaseAttrNode>& supplier() override;
@@ -46,6 +48,8 @@ public:
   virtual ~MinusNodeSupplier() = default;
 
   virtual std::shared_ptr<BaseAttrNode> make_shared() override;
+
+  virtual std::shared_ptr<BaseAttrNode> allocate_shared(NodeArena& arena) override;
 };
 
 class MinusNodeVisitor {
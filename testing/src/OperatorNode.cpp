@@ -9,12 +9,15 @@
 
 namespace VisitingParseTree {
 
-TraversalStatus OperatorNode::accept(Visitor *visitor) {
-  auto concrete_visitor = dynamic_cast<OperatorNodeVisitor *> (visitor);
+DispatchTag<BaseAttrNode> OperatorNode::DISPATCH_TAG =
+    DispatchTag<BaseAttrNode>::make<
+        OperatorNode,
+        OperatorNodeVisitor,
+        &OperatorNodeVisitor::process_operator_node>(
+            &BaseAttrNode::DISPATCH_TAG);
 
-  return concrete_visitor
-      ? concrete_visitor->process_operator_node(this)
-      : BaseAttrNode::accept(visitor);
+TraversalStatus OperatorNode::accept(Visitor *visitor) {
+  return DISPATCH_TAG.dispatch(visitor, this);
 }
 
 } /* namespace VisitingParseTree */
@@ -23,6 +23,8 @@ protected:
   OperatorNode() = default;
 public:
   virtual ~OperatorNode() = default;
+  static DispatchTag<BaseAttrNode> DISPATCH_TAG;
+
   virtual TraversalStatus accept(Visitor *visitor) override;
 };
 
@@ -11,11 +11,15 @@ namespace VisitingParseTree {
 
 PlusNodeSupplier PlusNode::SUPPLIER;
 
+DispatchTag<BaseAttrNode> PlusNode::DISPATCH_TAG =
+    DispatchTag<BaseAttrNode>::make<
+        PlusNode,
+        PlusNodeVisitor,
+        &PlusNodeVisitor::process_plus_node>(
+            &OperatorNode::DISPATCH_TAG);
+
 TraversalStatus PlusNode::accept(Visitor *visitor) {
-  PlusNodeVisitor *concrete_visitor = dynamic_cast<PlusNodeVisitor *> (visitor);
-  return concrete_visitor
-      ? concrete_visitor->process_plus_node(this)
-      : OperatorNode::accept(visitor);
+  return DISPATCH_TAG.dispatch(visitor, this);
 }
 
 Supplier<BaseAttrNode>& PlusNode::supplier() {
@@ -31,4 +35,9 @@ std::shared_ptr<BaseAttrNode> PlusNodeSupplier::make_shared() {
       std::make_shared<PlusNode>(BaseAttrNode::forbid_public_access::here));
 }
 
+std::shared_ptr<BaseAttrNode> PlusNodeSupplier::allocate_shared(NodeArena& arena) {
+  return std::static_pointer_cast<BaseAttrNode>(
+      arena.make_shared<PlusNode>(BaseAttrNode::forbid_public_access::here));
+}
+
 } /* namespace VisitingParseTree */
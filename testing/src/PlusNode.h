@@ -33,6 +33,8 @@ public:
 
   static PlusNodeSupplier SUPPLIER;
 
+  static DispatchTag<BaseAttrNode> DISPATCH_TAG;
+
   virtual TraversalStatus accept(Visitor *visitor) override;
 
   virtual Supplier<BaseAttrNode>& supplier() override;
@@ -45,6 +47,8 @@ public:
   virtual ~PlusNodeSupplier() = default;
 
   virtual std::shared_ptr<BaseAttrNode> make_shared() override;
+
+  virtual std::shared_ptr<BaseAttrNode> allocate_shared(NodeArena& arena) override;
 };
 
 class PlusNodeVisitor {
@@ -11,11 +11,15 @@ namespace VisitingParseTree {
 
 RootNodeSupplier RootNode::SUPPLIER;
 
+DispatchTag<BaseAttrNode> RootNode::DISPATCH_TAG =
+    DispatchTag<BaseAttrNode>::make<
+        RootNode,
+        RootNodeVisitor,
+        &RootNodeVisitor::process_root_node>(
+            &BaseAttrNode::DISPATCH_TAG);
+
 TraversalStatus RootNode::accept(Visitor *visitor) {
-  RootNodeVisitor *concrete_visitor = dynamic_cast<RootNodeVisitor *>(visitor);
-  return concrete_visitor
-      ? concrete_visitor->process_root_node(this)
-      : BaseAttrNode::accept(visitor);
+  return DISPATCH_TAG.dispatch(visitor, this);
 }
 
 Supplier<BaseAttrNode>& RootNode::supplier() {
@@ -31,4 +35,9 @@ std::shared_ptr<BaseAttrNode> RootNodeSupplier::make_shared() {
       std::make_shared<RootNode>(BaseAttrNode::forbid_public_access::here));
 }
 
+std::shared_ptr<BaseAttrNode> RootNodeSupplier::allocate_shared(NodeArena& arena) {
+  return std::static_pointer_cast<BaseAttrNode>(
+      arena.make_shared<RootNode>(BaseAttrNode::forbid_public_access::here));
+}
+
 } /* namespace VisitingParseTree */
@@ -23,3 +23,9 @@ TestAttribute TestAttribute::NAME("TestAttribute::NAME");
 TestAttribute TestAttribute::SERIAL_NO("SERIAL_NO");
 TestAttribute TestAttribute::URL("URL");
 TestAttribute TestAttribute::VALUE("VALUE");
+
+TestAttribute::Typed<std::int64_t> TestAttribute::COUNT("TestAttribute::COUNT");
+TestAttribute::Typed<double> TestAttribute::WEIGHT("TestAttribute::WEIGHT");
+TestAttribute::Typed<bool> TestAttribute::VISITED("TestAttribute::VISITED");
+TestAttribute::Typed<VisitingParseTree::InternedString>
+    TestAttribute::TYPE_NAME("TestAttribute::TYPE_NAME");
@@ -8,11 +8,22 @@
 #ifndef TESTATTRIBUTE_H_
 #define TESTATTRIBUTE_H_
 
+#include <cstdint>
+
 #include <Attribute.h>
+#include <InternedString.h>
+#include <TypedAttribute.h>
 
 class TestAttribute : public VisitingParseTree::Attribute {
   TestAttribute(const char *name);
 
+  template <typename V>
+  class Typed : public VisitingParseTree::TypedAttribute<V> {
+    friend class TestAttribute;
+    Typed(const char *name) :
+      VisitingParseTree::TypedAttribute<V>(name) {}
+  };
+
 public:
   virtual ~TestAttribute();
 
@@ -25,6 +36,11 @@ public:
   static TestAttribute SERIAL_NO;
   static TestAttribute URL;
   static TestAttribute VALUE;
+
+  static Typed<std::int64_t> COUNT;
+  static Typed<double> WEIGHT;
+  static Typed<bool> VISITED;
+  static Typed<VisitingParseTree::InternedString> TYPE_NAME;
 };
 
 #endif /* TESTATTRIBUTE_H_ */
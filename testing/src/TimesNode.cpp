@@ -14,11 +14,15 @@ TimesNodeSupplier TimesNode::SUPPLIER;
 TimesNode::TimesNode(BaseAttrNode::forbid_public_access) {
 }
 
+DispatchTag<BaseAttrNode> TimesNode::DISPATCH_TAG =
+    DispatchTag<BaseAttrNode>::make<
+        TimesNode,
+        TimesNodeVisitor,
+        &TimesNodeVisitor::process_times_node>(
+            &OperatorNode::DISPATCH_TAG);
+
 TraversalStatus TimesNode::accept(Visitor *visitor) {
-  TimesNodeVisitor *concrete_visitor = dynamic_cast<TimesNodeVisitor *>(visitor);
-  return concrete_visitor
-      ? concrete_visitor->process_times_node(this)
-      : OperatorNode::accept(visitor);
+  return DISPATCH_TAG.dispatch(visitor, this);
 }
 
 Supplier<BaseAttrNode>& TimesNode::supplier() {
@@ -34,4 +38,9 @@ std::shared_ptr<BaseAttrNode> TimesNodeSupplier::make_shared() {
       std::make_shared<TimesNode>(BaseAttrNode::forbid_public_access::here));
 }
 
+std::shared_ptr<BaseAttrNode> TimesNodeSupplier::allocate_shared(NodeArena& arena) {
+  return std::static_pointer_cast<BaseAttrNode>(
+      arena.make_shared<TimesNode>(BaseAttrNode::forbid_public_access::here));
+}
+
 } /* namespace VisitingParseTree */
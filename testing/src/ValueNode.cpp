@@ -9,11 +9,15 @@
 
 namespace VisitingParseTree {
 
+DispatchTag<BaseAttrNode> ValueNode::DISPATCH_TAG =
+    DispatchTag<BaseAttrNode>::make<
+        ValueNode,
+        ValueNodeVisitor,
+        &ValueNodeVisitor::process_value_node>(
+            &BaseAttrNode::DISPATCH_TAG);
+
 TraversalStatus ValueNode::accept(Visitor *visitor) {
-  ValueNodeVisitor *concrete_visitor = dynamic_cast<ValueNodeVisitor *>(visitor);
-  return concrete_visitor
-      ? concrete_visitor->process_value_node(this)
-      : BaseAttrNode::accept(visitor);
+  return DISPATCH_TAG.dispatch(visitor, this);
 }
 
 } /* namespace VisitingParseTree */
@@ -26,6 +26,8 @@ public:
   ValueNode& operator=(const ValueNode &other) = delete;
   ValueNode& operator=(ValueNode &&other) = delete;
 
+  static DispatchTag<BaseAttrNode> DISPATCH_TAG;
+
   virtual TraversalStatus accept(Visitor *visitor) override;
 };
 
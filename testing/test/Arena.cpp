@@ -0,0 +1,76 @@
+/*
+ * Arena.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests arena-backed node allocation
+ */
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "AttributedTestNode.h"
+#include "IntegerNode.h"
+#include "NodeArena.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+TEST(Arena, AllocateFromArena) {
+  auto arena = NodeArena::make_shared();
+  auto root = RootNode::SUPPLIER.allocate_shared(*arena);
+  ASSERT_TRUE(root);
+  ASSERT_EQ(RootNode::SUPPLIER, root->supplier());
+  ASSERT_NE(nullptr, dynamic_cast<RootNode *>(root.get()));
+
+  auto plus = root->append_child(PlusNode::SUPPLIER, *arena);
+  auto lhs = plus->append_child(IntegerNode::SUPPLIER, *arena)
+      ->set(TestAttribute::VALUE, "137");
+  auto rhs = lhs->append_sibling(IntegerNode::SUPPLIER, *arena)
+      ->set(TestAttribute::VALUE, "314");
+
+  ASSERT_EQ(1, root->child_count());
+  ASSERT_EQ(plus, root->child(0));
+  ASSERT_EQ(2, plus->child_count());
+  ASSERT_EQ(lhs, plus->child(0));
+  ASSERT_EQ(rhs, plus->child(1));
+  ASSERT_EQ(root, plus->parent());
+  ASSERT_STREQ("137", lhs->get(TestAttribute::VALUE).c_str());
+  ASSERT_STREQ("314", rhs->get(TestAttribute::VALUE).c_str());
+}
+
+TEST(Arena, ReleasedWithTree) {
+  auto arena = NodeArena::make_shared(1024);
+  weak_ptr<NodeArena> arena_reference = arena;
+  auto root = RootNode::SUPPLIER.allocate_shared(*arena);
+  for (int i = 0; i < 1000; ++i) {
+    root->append_child(IntegerNode::SUPPLIER, *arena)
+        ->set(TestAttribute::VALUE, to_string(i));
+  }
+  auto survivor = root->child(500);
+  arena.reset();
+  ASSERT_FALSE(arena_reference.expired());
+
+  root.reset();
+  ASSERT_FALSE(arena_reference.expired());
+  ASSERT_TRUE(survivor->is_root());
+  ASSERT_STREQ("500", survivor->get(TestAttribute::VALUE).c_str());
+
+  survivor.reset();
+  ASSERT_TRUE(arena_reference.expired());
+}
+
+TEST(Arena, HeapFallback) {
+  auto arena = NodeArena::make_shared();
+  auto root = RootNode::SUPPLIER.allocate_shared(*arena);
+  auto child = root->append_child(AttributedTestNode::SUPPLIER, *arena);
+  ASSERT_TRUE(child);
+  ASSERT_EQ(AttributedTestNode::SUPPLIER, child->supplier());
+  ASSERT_EQ(root, child->parent());
+}
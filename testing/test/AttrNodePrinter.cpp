@@ -0,0 +1,165 @@
+/*
+ * AttrNodePrinter.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests the tree printer's output format, its depth and breadth
+ * truncation, and its buffered output.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "AttrNodePrinter.h"
+#include "BaseAttrNode.h"
+#include "ByteSink.h"
+#include "IntegerNode.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+#include "TestTrees.h"
+#include "TreeBuilder.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace AttrNodePrinterTest {
+
+/*
+ * Collects its writes, and counts them.
+ */
+class CollectingSink : public ByteSink {
+public:
+  string text;
+  size_t write_count = 0;
+
+  virtual void write(
+      span<const span<const unsigned char>> buffers) override {
+    ++write_count;
+    for (const auto& buffer : buffers) {
+      text.append(
+          reinterpret_cast<const char *>(buffer.data()), buffer.size());
+    }
+  }
+};
+
+static string print(
+    AttrNodePrinter& printer,
+    shared_ptr<BaseAttrNode> root) {
+  ostringstream out;
+  printer.print(root, out);
+  return out.str();
+}
+
+/*
+ * A root with sum_count sums of leaves_per_sum leaves each.
+ */
+static shared_ptr<BaseAttrNode> sums(int sum_count, int leaves_per_sum) {
+  TreeBuilder<BaseAttrNode> builder;
+  builder.open(RootNode::SUPPLIER, sum_count);
+  for (int i = 0; i < sum_count; ++i) {
+    builder.open(PlusNode::SUPPLIER, leaves_per_sum);
+    for (int j = 0; j < leaves_per_sum; ++j) {
+      builder.open(IntegerNode::SUPPLIER)
+          .attr(TestAttribute::COUNT, int64_t(j))
+          .close();
+    }
+    builder.close();
+  }
+  return builder.close().finish();
+}
+
+}
+
+using namespace AttrNodePrinterTest;
+
+TEST(AttrNodePrinter, Format) {
+  AttrNodePrinter printer;
+  ASSERT_EQ(
+      "RootNode []\n"
+      " +--PlusNode []\n"
+      "     +--TimesNode []\n"
+      "     |   +--IntegerNode [VALUE->3 ]\n"
+      "     |   +--IntegerNode [VALUE->4 ]\n"
+      "     +--MinusNode []\n"
+      "         +--IntegerNode [VALUE->5 ]\n"
+      "         +--DivNode []\n"
+      "             +--IntegerNode [VALUE->6 ]\n"
+      "             +--IntegerNode [VALUE->3 ]\n",
+      print(printer, TestTrees::all_operations()));
+}
+
+TEST(AttrNodePrinter, TypedValues) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  root->append_child(IntegerNode::SUPPLIER)
+      ->set(TestAttribute::COUNT, int64_t(-42));
+  AttrNodePrinter printer;
+  ASSERT_EQ(
+      "RootNode []\n"
+      " +--IntegerNode [TestAttribute::COUNT->-42 ]\n",
+      print(printer, root));
+}
+
+TEST(AttrNodePrinter, MaxDepth) {
+  AttrNodePrinter printer;
+  printer.set_max_depth(2);
+  ASSERT_EQ(
+      "RootNode []\n"
+      " +--PlusNode []\n"
+      "     +--TimesNode []\n"
+      "     |   +--... (2 more)\n"
+      "     +--MinusNode []\n"
+      "         +--... (2 more)\n",
+      print(printer, TestTrees::all_operations()));
+
+  printer.set_max_depth(0);
+  ASSERT_EQ(
+      "RootNode []\n"
+      " +--... (1 more)\n",
+      print(printer, TestTrees::all_operations()));
+}
+
+TEST(AttrNodePrinter, MaxChildren) {
+  AttrNodePrinter printer;
+  printer.set_max_children(2);
+  ASSERT_EQ(
+      "RootNode []\n"
+      " +--PlusNode []\n"
+      " |   +--IntegerNode [TestAttribute::COUNT->0 ]\n"
+      " |   +--IntegerNode [TestAttribute::COUNT->1 ]\n"
+      " |   +--... (2 more)\n"
+      " +--PlusNode []\n"
+      " |   +--IntegerNode [TestAttribute::COUNT->0 ]\n"
+      " |   +--IntegerNode [TestAttribute::COUNT->1 ]\n"
+      " |   +--... (2 more)\n"
+      " +--... (3 more)\n",
+      print(printer, sums(5, 4)));
+
+  printer.set_max_children(4);
+  ASSERT_EQ(print(printer, sums(2, 4)), [] {
+    AttrNodePrinter unlimited;
+    return print(unlimited, sums(2, 4));
+  }());
+}
+
+TEST(AttrNodePrinter, Reuse) {
+  AttrNodePrinter printer;
+  auto first = print(printer, TestTrees::all_operations());
+  ASSERT_EQ(first, print(printer, TestTrees::all_operations()));
+}
+
+TEST(AttrNodePrinter, BufferedWrites) {
+  auto root = sums(1 << 12, 15);
+  AttrNodePrinter printer;
+  CollectingSink sink;
+  printer.print(root, sink);
+  ASSERT_EQ(print(printer, root), sink.text);
+  ASSERT_LT(AttrNodePrinter::BUFFER_SIZE, sink.text.size());
+  ASSERT_LE(sink.write_count, sink.text.size() / AttrNodePrinter::BUFFER_SIZE + 1);
+}
@@ -8,15 +8,20 @@
  */
 
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "gtest/gtest.h"
 
 #include "AttributeFunction.h"
+#include "AttributeMap.h"
 #include "AttributedTestNode.h"
 #include "GatherAttributes.h"
+#include "IllegalOperation.h"
+#include "InternPool.h"
 #include "TestAttribute.h"
 
 using namespace std;
@@ -117,3 +122,334 @@ TEST(Attributes, Copy) {
   ASSERT_STREQ("July 16, 1945", destination->get(TestAttribute::BIRTH_DATE).c_str());
   ASSERT_STREQ("Trinity Test", destination->get(TestAttribute::NAME).c_str());
 }
+
+TEST(Attributes, Many) {
+  vector<const Attribute*> all_attributes = {
+      &TestAttribute::BIRTH_DATE,
+      &TestAttribute::BYPASS_CHILDREN_ON_ENTRY,
+      &TestAttribute::BYPASS_CHILDREN_ON_EXIT,
+      &TestAttribute::CANCEL_ON_ENTRY,
+      &TestAttribute::CANCEL_ON_EXIT,
+      &TestAttribute::NAME,
+      &TestAttribute::SERIAL_NO,
+      &TestAttribute::URL,
+      &TestAttribute::VALUE,
+  };
+  sort(
+      all_attributes.begin(),
+      all_attributes.end(),
+      [](const Attribute *lhs, const Attribute *rhs) {
+        return lhs->id() < rhs->id();
+      });
+
+  auto node = AttributedTestNode::SUPPLIER.make_shared();
+  for (auto it = all_attributes.rbegin(); it != all_attributes.rend(); ++it) {
+    node->set(**it, (*it)->name());
+  }
+  ASSERT_EQ(all_attributes.size(), node->attribute_count());
+
+  auto gather = GatherAttributes();
+  node->for_all_attributes(gather.reset());
+  ASSERT_EQ(all_attributes.size(), gather.attributes().size());
+  for (size_t i = 0; i < all_attributes.size(); ++i) {
+    GatherAttributes::Entry expected = {
+        all_attributes[i], all_attributes[i]->name()};
+    ASSERT_EQ(expected, gather.attributes()[i]);
+  }
+
+  for (size_t i = 0; i < all_attributes.size(); i += 2) {
+    node->erase(*all_attributes[i]);
+  }
+  ASSERT_EQ(all_attributes.size() / 2, node->attribute_count());
+  for (size_t i = 0; i < all_attributes.size(); ++i) {
+    ASSERT_EQ(1 == i % 2, node->has(*all_attributes[i]));
+    ASSERT_EQ(
+        1 == i % 2 ? all_attributes[i]->name() : string(),
+        node->get(*all_attributes[i]));
+  }
+
+  node->set(*all_attributes[0], "Restored");
+  ASSERT_STREQ("Restored", node->get(*all_attributes[0]).c_str());
+  node->for_all_attributes(gather.reset());
+  ASSERT_EQ(all_attributes[0], gather.attributes()[0].attribute);
+}
+
+/*
+ * Setting an attribute from another attribute of the same node must
+ * copy the value before inserting, which can move the other values.
+ */
+TEST(Attributes, SetFromOwnValue) {
+  vector<const Attribute*> all_attributes = {
+      &TestAttribute::BIRTH_DATE,
+      &TestAttribute::BYPASS_CHILDREN_ON_ENTRY,
+      &TestAttribute::BYPASS_CHILDREN_ON_EXIT,
+      &TestAttribute::CANCEL_ON_ENTRY,
+      &TestAttribute::CANCEL_ON_EXIT,
+      &TestAttribute::NAME,
+      &TestAttribute::SERIAL_NO,
+      &TestAttribute::URL,
+      &TestAttribute::VALUE,
+  };
+  sort(
+      all_attributes.begin(),
+      all_attributes.end(),
+      [](const Attribute *lhs, const Attribute *rhs) {
+        return lhs->id() < rhs->id();
+      });
+  // Short enough to be stored within the string, so moving the
+  // string moves the characters too
+  const string value("abc");
+
+  // First while adding the first attribute grows the map's block from
+  // four entries to eight, then with a block that has room to spare
+  for (size_t count : {size_t{5}, all_attributes.size()}) {
+    auto node = AttributedTestNode::SUPPLIER.make_shared();
+    for (size_t i = 1; i < count; ++i) {
+      node->set(*all_attributes[i], value + to_string(i));
+    }
+    // all_attributes[0] sorts first, so adding it moves the others.
+    auto& first = *all_attributes[0];
+    node->set(first, node->get(*all_attributes[count - 1]));
+    ASSERT_EQ(value + to_string(count - 1), node->get(first));
+    node->erase(first);
+    node->put(first, node->view(*all_attributes[1]));
+    ASSERT_EQ(value + "1", node->get(first));
+    node->put(first, node->view(first).substr(1));
+    ASSERT_EQ(value.substr(1) + "1", node->get(first));
+    ASSERT_EQ(count, node->attribute_count());
+  }
+}
+
+TEST(Attributes, MoveMap) {
+  const Attribute *attributes[] = {
+      &TestAttribute::BIRTH_DATE,
+      &TestAttribute::NAME,
+      &TestAttribute::SERIAL_NO,
+      &TestAttribute::URL,
+      &TestAttribute::VALUE,
+  };
+  AttributeMap large;
+  for (auto attribute : attributes) {
+    large.insert_or_assign(*attribute, AttributeValue(string(attribute->name())));
+  }
+  ASSERT_EQ(size(attributes), large.size());
+
+  AttributeMap moved(std::move(large));
+  ASSERT_EQ(size(attributes), moved.size());
+  ASSERT_TRUE(large.empty());
+  ASSERT_EQ(large.begin(), large.end());
+  ASSERT_FALSE(large.find(TestAttribute::NAME));
+  large.insert_or_assign(TestAttribute::NAME, AttributeValue(string("reused")));
+  ASSERT_EQ(1, large.size());
+
+  AttributeMap small;
+  small.insert_or_assign(TestAttribute::URL, AttributeValue(string("small")));
+  small = std::move(moved);
+  ASSERT_EQ(size(attributes), small.size());
+  ASSERT_TRUE(moved.empty());
+  ASSERT_TRUE(small.find(TestAttribute::URL));
+
+  moved = std::move(large);
+  ASSERT_EQ(1, moved.size());
+  ASSERT_TRUE(large.empty());
+  ASSERT_FALSE(moved.find(TestAttribute::URL));
+  ASSERT_TRUE(moved.find(TestAttribute::NAME));
+}
+
+TEST(Attributes, GrowAndRelease) {
+  const Attribute *attributes[] = {
+      &TestAttribute::BIRTH_DATE,
+      &TestAttribute::CANCEL_ON_ENTRY,
+      &TestAttribute::NAME,
+      &TestAttribute::SERIAL_NO,
+      &TestAttribute::VALUE,
+  };
+  AttributeMap map;
+  ASSERT_EQ(0, map.capacity());
+  for (auto attribute : attributes) {
+    map.insert_or_assign(*attribute, AttributeValue(string(attribute->name())));
+  }
+  ASSERT_EQ(size(attributes), map.size());
+  ASSERT_EQ(8, map.capacity());
+
+  AttributeMap small;
+  small.insert_or_assign(TestAttribute::URL, AttributeValue(string("small")));
+  AttributeMap copy(small);
+  copy = map;
+  ASSERT_EQ(map.size(), copy.size());
+  ASSERT_EQ(map.size(), copy.capacity());
+  ASSERT_FALSE(copy.find(TestAttribute::URL));
+  small = copy;
+  ASSERT_EQ(map.size(), small.size());
+  copy = AttributeMap();
+  ASSERT_TRUE(copy.empty());
+
+  for (auto attribute : attributes) {
+    ASSERT_EQ(string(attribute->name()), get<string>(*map.find(*attribute)));
+    map.erase(*attribute);
+    ASSERT_FALSE(map.find(*attribute));
+  }
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(0, map.capacity());
+  ASSERT_EQ(map.begin(), map.end());
+  map.insert_or_assign(TestAttribute::NAME, AttributeValue(string("again")));
+  ASSERT_EQ(1, map.capacity());
+  ASSERT_EQ("again", get<string>(*map.find(TestAttribute::NAME)));
+  ASSERT_EQ(size(attributes), small.size());
+}
+
+TEST(Attributes, Typed) {
+  auto node = AttributedTestNode::SUPPLIER.make_shared();
+  ASSERT_EQ(0, node->get(TestAttribute::COUNT));
+  ASSERT_EQ(0.0, node->get(TestAttribute::WEIGHT));
+  ASSERT_FALSE(node->get(TestAttribute::VISITED));
+
+  ASSERT_EQ(node, node->set(TestAttribute::COUNT, 137));
+  ASSERT_EQ(node, node->set(TestAttribute::WEIGHT, 3.14159));
+  ASSERT_EQ(node, node->set(TestAttribute::VISITED, true));
+  node->set(TestAttribute::NAME, "Typed");
+  ASSERT_EQ(4, node->attribute_count());
+  ASSERT_TRUE(node->has(TestAttribute::COUNT));
+  ASSERT_EQ(137, node->get(TestAttribute::COUNT));
+  ASSERT_EQ(3.14159, node->get(TestAttribute::WEIGHT));
+  ASSERT_TRUE(node->get(TestAttribute::VISITED));
+  ASSERT_STREQ("Typed", node->get(TestAttribute::NAME).c_str());
+
+  node->set(TestAttribute::COUNT, -9007199254740993);
+  ASSERT_EQ(-9007199254740993, node->get(TestAttribute::COUNT));
+  node->set(TestAttribute::VISITED, false);
+  ASSERT_TRUE(node->has(TestAttribute::VISITED));
+  ASSERT_FALSE(node->get(TestAttribute::VISITED));
+
+  node->erase(TestAttribute::WEIGHT);
+  ASSERT_FALSE(node->has(TestAttribute::WEIGHT));
+  ASSERT_EQ(0.0, node->get(TestAttribute::WEIGHT));
+}
+
+TEST(Attributes, TypedFromText) {
+  auto node = AttributedTestNode::SUPPLIER.make_shared();
+  node->set(TestAttribute::COUNT, "314");
+  node->set(TestAttribute::WEIGHT, "0.1");
+  node->set(TestAttribute::VISITED, "false");
+  ASSERT_EQ(314, node->get(TestAttribute::COUNT));
+  ASSERT_EQ(0.1, node->get(TestAttribute::WEIGHT));
+  ASSERT_TRUE(node->has(TestAttribute::VISITED));
+  ASSERT_FALSE(node->get(TestAttribute::VISITED));
+
+  const Attribute& untyped_count = TestAttribute::COUNT;
+  node->set(untyped_count, string("2718"));
+  ASSERT_EQ(2718, node->get(TestAttribute::COUNT));
+  ASSERT_THROW(node->get(untyped_count), IllegalOperation);
+  ASSERT_THROW(node->set(TestAttribute::COUNT, "137 apples"), IllegalOperation);
+  ASSERT_THROW(node->set(TestAttribute::VISITED, "Yes"), IllegalOperation);
+  ASSERT_EQ(2718, node->get(TestAttribute::COUNT));
+
+  node->set(TestAttribute::COUNT, "");
+  ASSERT_FALSE(node->has(TestAttribute::COUNT));
+}
+
+TEST(Attributes, TypedFormatAndCopy) {
+  auto source = AttributedTestNode::SUPPLIER.make_shared();
+  source->set(TestAttribute::NAME, "Trinity Test");
+  source->set(TestAttribute::COUNT, 1945);
+  source->set(TestAttribute::WEIGHT, 0.1);
+  source->set(TestAttribute::VISITED, true);
+
+  auto gather = GatherAttributes();
+  source->for_all_attributes(gather.reset());
+  vector<GatherAttributes::Entry> expected = {
+      {&TestAttribute::NAME, "Trinity Test"},
+      {&TestAttribute::COUNT, "1945"},
+      {&TestAttribute::WEIGHT, "0.1"},
+      {&TestAttribute::VISITED, "true"},
+  };
+  ASSERT_EQ(expected, gather.attributes());
+
+  auto destination = AttributedTestNode::SUPPLIER.make_shared();
+  source->copy_attributes_to(destination);
+  ASSERT_EQ(4, destination->attribute_count());
+  ASSERT_EQ(1945, destination->get(TestAttribute::COUNT));
+  ASSERT_EQ(0.1, destination->get(TestAttribute::WEIGHT));
+  ASSERT_TRUE(destination->get(TestAttribute::VISITED));
+}
+
+TEST(Attributes, Interned) {
+  auto first = AttributedTestNode::SUPPLIER.make_shared();
+  auto second = AttributedTestNode::SUPPLIER.make_shared();
+  ASSERT_EQ(InternedString(), first->get(TestAttribute::TYPE_NAME));
+
+  first->set(TestAttribute::TYPE_NAME, "unsigned long long int");
+  second->set(TestAttribute::TYPE_NAME, string("unsigned long long int"));
+  ASSERT_EQ(
+      first->get(TestAttribute::TYPE_NAME),
+      second->get(TestAttribute::TYPE_NAME));
+  ASSERT_EQ(
+      &first->get(static_cast<const Attribute&>(TestAttribute::TYPE_NAME)),
+      &second->get(static_cast<const Attribute&>(TestAttribute::TYPE_NAME)));
+  ASSERT_EQ(
+      InternPool::global().intern("unsigned long long int"),
+      first->get(TestAttribute::TYPE_NAME));
+
+  auto gather = GatherAttributes();
+  first->for_all_attributes(gather.reset());
+  vector<GatherAttributes::Entry> expected = {
+      {&TestAttribute::TYPE_NAME, "unsigned long long int"},
+  };
+  ASSERT_EQ(expected, gather.attributes());
+
+  InternPool tree_pool;
+  auto third = AttributedTestNode::SUPPLIER.make_shared();
+  third->set(TestAttribute::TYPE_NAME, tree_pool.intern("int"));
+  second->set(TestAttribute::TYPE_NAME, tree_pool.intern("int"));
+  ASSERT_EQ(
+      third->get(TestAttribute::TYPE_NAME),
+      second->get(TestAttribute::TYPE_NAME));
+  ASSERT_NE(
+      InternPool::global().intern("int"),
+      third->get(TestAttribute::TYPE_NAME));
+
+  third->copy_attributes_to(first);
+  ASSERT_EQ(
+      third->get(TestAttribute::TYPE_NAME),
+      first->get(TestAttribute::TYPE_NAME));
+
+  third->set(TestAttribute::TYPE_NAME, InternedString());
+  ASSERT_FALSE(third->has(TestAttribute::TYPE_NAME));
+}
+
+TEST(Attributes, ZeroCopy) {
+  auto node = AttributedTestNode::SUPPLIER.make_shared();
+  ASSERT_EQ(nullptr, node->get_if(TestAttribute::NAME));
+  ASSERT_TRUE(node->view(TestAttribute::NAME).empty());
+
+  string long_value("a value too long for the small string optimization");
+  const char *buffer = long_value.data();
+  node->put(TestAttribute::NAME, std::move(long_value));
+  const string *stored = node->get_if(TestAttribute::NAME);
+  ASSERT_NE(nullptr, stored);
+  ASSERT_EQ(buffer, stored->data());
+  ASSERT_EQ(&node->get(TestAttribute::NAME), stored);
+  ASSERT_EQ(
+      "a value too long for the small string optimization",
+      node->view(TestAttribute::NAME));
+
+  string_view shorter("a shorter value, reusing the buffer");
+  node->put(TestAttribute::NAME, shorter);
+  ASSERT_EQ(stored, node->get_if(TestAttribute::NAME));
+  ASSERT_EQ(buffer, node->get_if(TestAttribute::NAME)->data());
+  ASSERT_EQ(shorter, node->view(TestAttribute::NAME));
+
+  ASSERT_EQ(node, node->set(TestAttribute::URL, string_view("https://")));
+  node->put(TestAttribute::COUNT, 137);
+  node->put(TestAttribute::WEIGHT, "2.5");
+  ASSERT_EQ(137, node->get(TestAttribute::COUNT));
+  ASSERT_EQ(2.5, node->get(TestAttribute::WEIGHT));
+  ASSERT_THROW(node->get_if(TestAttribute::COUNT), IllegalOperation);
+  ASSERT_THROW(node->view(TestAttribute::COUNT), IllegalOperation);
+  ASSERT_EQ(4, node->attribute_count());
+
+  node->put(TestAttribute::NAME, "");
+  ASSERT_EQ(nullptr, node->get_if(TestAttribute::NAME));
+  ASSERT_THROW(node->put(TestAttribute::COUNT, "many"), IllegalOperation);
+  ASSERT_EQ(137, node->get(TestAttribute::COUNT));
+}
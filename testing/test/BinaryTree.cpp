@@ -0,0 +1,257 @@
+/*
+ * BinaryTree.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests the binary tree writer and reader.
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "BinaryTreeReader.h"
+#include "BinaryTreeWriter.h"
+#include "DivNode.h"
+#include "FileSink.h"
+#include "IntegerNode.h"
+#include "InternPool.h"
+#include "MinusNode.h"
+#include "NodeArena.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+#include "TestTrees.h"
+#include "TimesNode.h"
+#include "Traversal.h"
+#include "TreeCorruptError.h"
+#include "VacuousVoidFunction.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace BinaryTreeTest {
+
+/*
+ * Registers every test node type and attribute with a reader.
+ */
+static BinaryTreeReader& register_all(BinaryTreeReader& reader) {
+  return reader
+      .add(RootNode::SUPPLIER)
+      .add(PlusNode::SUPPLIER)
+      .add(MinusNode::SUPPLIER)
+      .add(TimesNode::SUPPLIER)
+      .add(DivNode::SUPPLIER)
+      .add(IntegerNode::SUPPLIER)
+      .add(TestAttribute::BYPASS_CHILDREN_ON_ENTRY)
+      .add(TestAttribute::NAME)
+      .add(TestAttribute::SERIAL_NO)
+      .add(TestAttribute::VALUE)
+      .add(TestAttribute::COUNT)
+      .add(TestAttribute::WEIGHT)
+      .add(TestAttribute::VISITED)
+      .add(TestAttribute::TYPE_NAME);
+}
+
+/*
+ * Builds a wide tree of sums with about the specified number of
+ * nodes, each leaf having a string value and typed attributes.
+ */
+static shared_ptr<BaseAttrNode> large_tree(int node_count) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  auto sum = root->append_child(PlusNode::SUPPLIER);
+  auto integer_type = InternPool::global().intern("integer");
+  for (int i = 1; i < node_count; ++i) {
+    if (0 == i % 16) {
+      sum = root->append_child(PlusNode::SUPPLIER);
+      continue;
+    }
+    auto leaf = sum->append_child(IntegerNode::SUPPLIER);
+    leaf->put(TestAttribute::VALUE, to_string(i));
+    leaf->put(TestAttribute::COUNT, int64_t(i) - node_count / 2);
+    leaf->put(TestAttribute::TYPE_NAME, integer_type);
+  }
+  return root;
+}
+
+/*
+ * Sums the COUNT attribute, and reencodes each node it enters.
+ */
+class Summer : public NodeAction<BaseAttrNode> {
+  NodeAction<BaseAttrNode>& encoder_;
+
+public:
+  int64_t sum = 0;
+
+  Summer(NodeAction<BaseAttrNode>& encoder) :
+      encoder_(encoder) {
+  }
+
+  virtual TraversalStatus operator()(shared_ptr<BaseAttrNode> node) override {
+    sum += node->get(TestAttribute::COUNT);
+    return encoder_(node);
+  }
+};
+
+class Continue : public NodeAction<BaseAttrNode> {
+public:
+  virtual TraversalStatus operator()(shared_ptr<BaseAttrNode> node) override {
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+} /* namespace BinaryTreeTest */
+
+using namespace BinaryTreeTest;
+
+TEST(BinaryTree, RoundTrip) {
+  auto tree = TestTrees::complex_tree();
+  auto leaf = tree->child(0)->child(0);
+  leaf->put(TestAttribute::COUNT, int64_t(-1234567890123));
+  leaf->put(TestAttribute::WEIGHT, -0.375);
+  leaf->put(TestAttribute::VISITED, true);
+  leaf->put(TestAttribute::TYPE_NAME, InternPool::global().intern("leaf"));
+  tree->put(TestAttribute::VISITED, false);
+
+  stringstream stream;
+  BinaryTreeWriter writer(stream);
+  writer.write(tree);
+
+  BinaryTreeReader reader(stream);
+  register_all(reader);
+  auto copy = reader.read();
+  ASSERT_TRUE(copy);
+  ASSERT_NE(tree, copy);
+  ASSERT_TRUE(tree->structurally_equals(*copy));
+  ASSERT_EQ(
+      -1234567890123,
+      copy->child(0)->child(0)->get(TestAttribute::COUNT));
+  ASSERT_EQ(-0.375, copy->child(0)->child(0)->get(TestAttribute::WEIGHT));
+  ASSERT_FALSE(reader.read());
+}
+
+TEST(BinaryTree, ManyTrees) {
+  stringstream stream;
+  BinaryTreeWriter writer(stream, 16);
+  auto first = TestTrees::simple_addition();
+  auto second = TestTrees::all_operations();
+  writer.write(first);
+  auto after_first = stream.str().size();
+  writer.write(first);
+  // Names are written once per stream.
+  ASSERT_GT(after_first, stream.str().size() - after_first);
+  writer.write(second->child(0));
+
+  BinaryTreeReader reader(stream, InternPool::global(), 16);
+  register_all(reader);
+  ASSERT_TRUE(first->structurally_equals(*reader.read()));
+  ASSERT_TRUE(first->structurally_equals(*reader.read()));
+  ASSERT_TRUE(second->child(0)->structurally_equals(*reader.read()));
+  ASSERT_FALSE(reader.read());
+}
+
+TEST(BinaryTree, Arena) {
+  auto tree = TestTrees::all_operations();
+  stringstream stream;
+  BinaryTreeWriter(stream).write(tree);
+  auto arena = NodeArena::make_shared();
+  BinaryTreeReader reader(stream);
+  register_all(reader);
+  auto copy = reader.read(*arena);
+  ASSERT_TRUE(tree->structurally_equals(*copy));
+}
+
+TEST(BinaryTree, Malformed) {
+  stringstream empty;
+  BinaryTreeReader empty_reader(empty);
+  ASSERT_FALSE(empty_reader.read());
+
+  stringstream garbage("not a tree");
+  BinaryTreeReader garbage_reader(garbage);
+  ASSERT_THROW(garbage_reader.read(), TreeCorruptError);
+
+  stringstream stream;
+  BinaryTreeWriter(stream).write(TestTrees::simple_addition());
+  string bytes = stream.str();
+
+  stringstream unregistered(bytes);
+  BinaryTreeReader unregistered_reader(unregistered);
+  unregistered_reader.add(RootNode::SUPPLIER);
+  ASSERT_THROW(unregistered_reader.read(), TreeCorruptError);
+
+  stringstream truncated(bytes.substr(0, bytes.size() - 1));
+  BinaryTreeReader truncated_reader(truncated);
+  register_all(truncated_reader);
+  ASSERT_THROW(truncated_reader.read(), TreeCorruptError);
+
+  // A type name claiming to be 2^62 bytes long.
+  stringstream oversized(string("VPTB\x01\x00\x80\x80\x80\x80\x80\x80"
+      "\x80\x80\x40" "abc", 18));
+  BinaryTreeReader oversized_reader(oversized);
+  register_all(oversized_reader);
+  ASSERT_THROW(oversized_reader.read(), TreeCorruptError);
+}
+
+TEST(BinaryTree, LargeText) {
+  auto tree = TestTrees::simple_addition();
+  string large(3 * BinaryTreeWriter::LARGE_TEXT_SIZE, 'x');
+  large[0] = 'a';
+  tree->put(TestAttribute::NAME, large);
+  tree->child(0)->put(TestAttribute::NAME, large.substr(1));
+  tree->child(0)->child(1)->put(TestAttribute::NAME, "small");
+
+  stringstream stream;
+  BinaryTreeWriter writer(stream, 0);
+  writer.write(tree);
+  writer.write(tree->child(0));
+  BinaryTreeReader reader(stream);
+  register_all(reader);
+  ASSERT_TRUE(tree->structurally_equals(*reader.read()));
+  ASSERT_TRUE(tree->child(0)->structurally_equals(*reader.read()));
+  ASSERT_FALSE(reader.read());
+}
+
+TEST(BinaryTree, FileSink) {
+  auto path = filesystem::temp_directory_path() / "BinaryTree.FileSink.vpt";
+  auto tree = large_tree(100000);
+  {
+    FileSink sink(path.string());
+    BinaryTreeWriter writer(sink, 4096);
+    writer.write(tree);
+  }
+  ifstream in(path, ios::binary);
+  BinaryTreeReader reader(in);
+  register_all(reader);
+  ASSERT_TRUE(tree->structurally_equals(*reader.read()));
+  filesystem::remove(path);
+}
+
+TEST(BinaryTree, DuringTraversal) {
+  auto tree = TestTrees::complex_tree();
+  tree->child(0)->put(TestAttribute::COUNT, int64_t(5));
+  tree->child(0)->child(0)->put(TestAttribute::COUNT, int64_t(7));
+
+  stringstream stream;
+  BinaryTreeWriter writer(stream);
+  Summer summer(writer.on_entry());
+  Continue on_exit;
+  Traversal<BaseAttrNode>(
+      summer,
+      on_exit,
+      VacuousVoidFunction::INSTANCE,
+      VacuousVoidFunction::INSTANCE)(tree);
+  writer.flush();
+  ASSERT_EQ(12, summer.sum);
+
+  BinaryTreeReader reader(stream);
+  register_all(reader);
+  ASSERT_TRUE(tree->structurally_equals(*reader.read()));
+}
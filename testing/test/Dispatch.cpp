@@ -0,0 +1,203 @@
+/*
+ * Dispatch.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests dispatch tag-based visitation against the dynamic_cast
+ * chain that it replaced.
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "LevelNodes.h"
+#include "TraversalStatus.h"
+#include "Visitor.h"
+
+using namespace VisitingParseTree;
+using namespace std;
+
+namespace DispatchTest {
+
+/*
+ * Records the level of the handler that processed the most recent node.
+ */
+class RecordingVisitor : public Visitor {
+protected:
+  int handled_by_ = 0;
+
+public:
+  int handled_by(void) const {
+    return handled_by_;
+  }
+
+  void reset(void) {
+    handled_by_ = 0;
+  }
+};
+
+class BaseOnly : public RecordingVisitor, public BaseAttrNodeVisitor {
+public:
+  long count = 0;
+
+  virtual TraversalStatus processBaseAttrNode(BaseAttrNode *host) override {
+    handled_by_ = 1;
+    ++count;
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+class ThreeAndBase :
+    public RecordingVisitor,
+    public LevelThreeVisitor,
+    public BaseAttrNodeVisitor {
+public:
+  virtual TraversalStatus process_level_three(LevelThree *host) override {
+    handled_by_ = 3;
+    return TraversalStatus::BYPASS_CHILDREN;
+  }
+
+  virtual TraversalStatus processBaseAttrNode(BaseAttrNode *host) override {
+    handled_by_ = 1;
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+class TwoAndFour :
+    public RecordingVisitor,
+    public LevelTwoVisitor,
+    public LevelFourVisitor {
+public:
+  virtual TraversalStatus process_level_two(LevelTwo *host) override {
+    handled_by_ = 2;
+    return TraversalStatus::CONTINUE;
+  }
+
+  virtual TraversalStatus process_level_four(LevelFour *host) override {
+    handled_by_ = 4;
+    return TraversalStatus::CANCEL;
+  }
+};
+
+class NoHandlers : public RecordingVisitor {
+};
+
+/*
+ * Counts the nodes handled at each level. Safe to apply from several
+ * threads at once.
+ */
+class ConcurrentTwoAndFour :
+    public Visitor,
+    public LevelTwoVisitor,
+    public LevelFourVisitor {
+public:
+  atomic<long> twos = 0;
+  atomic<long> fours = 0;
+
+  virtual TraversalStatus process_level_two(LevelTwo *host) override {
+    ++twos;
+    return TraversalStatus::CONTINUE;
+  }
+
+  virtual TraversalStatus process_level_four(LevelFour *host) override {
+    ++fours;
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+} /* namespace DispatchTest */
+
+using namespace DispatchTest;
+
+TEST(Dispatch, NearestHandlerWins) {
+  LevelTwo level_two;
+  LevelThree level_three;
+  LevelFour level_four;
+  LevelFive level_five;
+  vector<LevelTwo *> nodes = {
+      &level_two, &level_three, &level_four, &level_five};
+
+  BaseOnly base_only;
+  ThreeAndBase three_and_base;
+  TwoAndFour two_and_four;
+  NoHandlers no_handlers;
+  vector<RecordingVisitor *> visitors = {
+      &base_only, &three_and_base, &two_and_four, &no_handlers};
+
+  vector<vector<int>> expected_handlers = {
+      {1, 1, 1, 1},
+      {1, 3, 3, 3},
+      {2, 2, 4, 4},
+      {0, 0, 0, 0},
+  };
+
+  for (size_t v = 0; v < visitors.size(); ++v) {
+    for (size_t n = 0; n < nodes.size(); ++n) {
+      for (int pass = 0; pass < 2; ++pass) {
+        visitors[v]->reset();
+        auto tagged_status = nodes[n]->accept(visitors[v]);
+        ASSERT_EQ(expected_handlers[v][n], visitors[v]->handled_by());
+        visitors[v]->reset();
+        auto cast_status = nodes[n]->accept_by_cast(visitors[v]);
+        ASSERT_EQ(expected_handlers[v][n], visitors[v]->handled_by());
+        ASSERT_EQ(cast_status, tagged_status);
+      }
+    }
+  }
+}
+
+TEST(Dispatch, NullVisitor) {
+  LevelFive level_five;
+  ASSERT_EQ(TraversalStatus::CONTINUE, level_five.accept(nullptr));
+}
+
+TEST(Dispatch, CopiedVisitor) {
+  LevelFive level_five;
+  ThreeAndBase original;
+  level_five.accept(&original);
+  ThreeAndBase copy(original);
+  original.reset();
+  level_five.accept(&copy);
+  ASSERT_EQ(3, copy.handled_by());
+  ASSERT_EQ(0, original.handled_by());
+}
+
+TEST(Dispatch, ConcurrentResolution) {
+  constexpr int THREAD_COUNT = 8;
+  constexpr long PASSES = 1000;
+  LevelTwo level_two;
+  LevelThree level_three;
+  LevelFour level_four;
+  LevelFive level_five;
+  vector<LevelTwo *> nodes = {
+      &level_two, &level_three, &level_four, &level_five};
+
+  // A fresh visitor, so the threads race to fill its dispatch table
+  ConcurrentTwoAndFour visitor;
+  atomic<bool> go = false;
+  vector<thread> threads;
+  for (int i = 0; i < THREAD_COUNT; ++i) {
+    threads.emplace_back([&]() {
+      while (!go) {
+        this_thread::yield();
+      }
+      for (long pass = 0; pass < PASSES; ++pass) {
+        for (auto node : nodes) {
+          node->accept(&visitor);
+        }
+      }
+    });
+  }
+  go = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(2 * THREAD_COUNT * PASSES, visitor.twos);
+  ASSERT_EQ(2 * THREAD_COUNT * PASSES, visitor.fours);
+}
@@ -0,0 +1,231 @@
+/*
+ * Fold.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests sequential and parallel bottom-up folds
+ */
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "Fold.h"
+#include "FoldFunction.h"
+#include "FrozenTree.h"
+#include "IntegerNode.h"
+#include "ParallelFold.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+#include "VacuousVoidFunction.h"
+#include "WorkStealingPool.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace FoldTest {
+
+/*
+ * Evaluates an expression: integers are their values, and every
+ * other node sums its children.
+ */
+class Evaluate : public FoldFunction<BaseAttrNode, long> {
+public:
+  virtual long operator()(
+      BaseAttrNode *node,
+      span<const long> children) override {
+    if (node->supplier() == IntegerNode::SUPPLIER) {
+      return stol(node->get(TestAttribute::VALUE));
+    }
+    long sum = 0;
+    for (long child : children) {
+      sum += child;
+    }
+    return sum;
+  }
+};
+
+/*
+ * Computes subtree sizes, optionally throwing at a specified node.
+ */
+class Size : public FoldFunction<BaseAttrNode, size_t> {
+public:
+  atomic<long> count = 0;
+  const BaseAttrNode *throw_at = nullptr;
+
+  virtual size_t operator()(
+      BaseAttrNode *node,
+      span<const size_t> children) override {
+    ++count;
+    if (node == throw_at) {
+      throw runtime_error("Thrown from fold function");
+    }
+    size_t size = 1;
+    for (size_t child : children) {
+      size += child;
+    }
+    return size;
+  }
+};
+
+class Collect : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  vector<BaseAttrNode *> nodes;
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    nodes.push_back(node);
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+class Nothing : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+/*
+ * Builds a tree of the specified size, attaching every node to a
+ * randomly chosen earlier one.
+ */
+static shared_ptr<BaseAttrNode> random_tree(size_t size, unsigned seed) {
+  mt19937 random(seed);
+  auto root = RootNode::SUPPLIER.make_shared();
+  vector<shared_ptr<BaseAttrNode>> nodes = {root};
+  while (nodes.size() < size) {
+    uniform_int_distribution<size_t> pick(0, nodes.size() - 1);
+    nodes.push_back(nodes[pick(random)]->append_child(PlusNode::SUPPLIER));
+  }
+  return root;
+}
+
+/*
+ * Builds a tree whose nodes have a deep first child and a leaf second
+ * child.
+ */
+static shared_ptr<BaseAttrNode> comb(long depth) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  auto current = root;
+  for (long i = 1; i < depth; ++i) {
+    auto next = current->append_child(PlusNode::SUPPLIER);
+    current->append_child(PlusNode::SUPPLIER);
+    current = next;
+  }
+  return root;
+}
+
+} /* namespace FoldTest */
+
+using namespace FoldTest;
+
+TEST(Fold, Evaluate) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  auto plus = root->append_child(PlusNode::SUPPLIER);
+  plus->append_child(IntegerNode::SUPPLIER)->set(TestAttribute::VALUE, "137");
+  auto nested = plus->append_child(PlusNode::SUPPLIER);
+  nested->append_child(IntegerNode::SUPPLIER)->set(TestAttribute::VALUE, "2");
+  nested->append_child(IntegerNode::SUPPLIER)->set(TestAttribute::VALUE, "3");
+
+  Evaluate evaluate;
+  Fold<BaseAttrNode, long> fold(evaluate);
+  vector<long> expected = {142, 142, 137, 5, 2, 3};
+  ASSERT_EQ(expected, fold(root));
+  ASSERT_EQ(vector<long>({5, 2, 3}), fold(nested));
+
+  WorkStealingPool pool(2);
+  ParallelFold<BaseAttrNode, long> parallel(evaluate, pool, 1);
+  ASSERT_EQ(expected, parallel(root));
+}
+
+TEST(Fold, PreorderLayout) {
+  auto root = random_tree(2000, 1);
+  Size size;
+  Fold<BaseAttrNode, size_t> fold(size);
+  auto sizes = fold(root);
+  ASSERT_EQ(2000, sizes.size());
+  ASSERT_EQ(2000, sizes[0]);
+
+  Collect collect;
+  Nothing nothing;
+  BorrowingTraversal<BaseAttrNode> traversal(
+      collect,
+      nothing,
+      VacuousVoidFunction::INSTANCE,
+      VacuousVoidFunction::INSTANCE);
+  traversal(root);
+  auto frozen = FrozenTree::freeze(root);
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    ASSERT_EQ(frozen.subtree_end(i) - i, sizes[i]);
+    ASSERT_EQ(frozen.node(i), collect.nodes[i]);
+  }
+}
+
+TEST(Fold, ParallelMatchesSequential) {
+  WorkStealingPool pool(4);
+  Size size;
+  Fold<BaseAttrNode, size_t> sequential(size);
+  for (unsigned seed = 0; seed < 4; ++seed) {
+    auto root = random_tree(20000, seed);
+    auto expected = sequential(root);
+    for (size_t grain_size : {1, 7, 64, 1024}) {
+      ParallelFold<BaseAttrNode, size_t> parallel(size, pool, grain_size);
+      ASSERT_EQ(expected, parallel(root));
+    }
+  }
+}
+
+TEST(Fold, DeepTrees) {
+  constexpr long DEPTH = 100000;
+  WorkStealingPool pool(2);
+  Size size;
+  ParallelFold<BaseAttrNode, size_t> parallel(size, pool, 16);
+
+  auto chain = RootNode::SUPPLIER.make_shared();
+  auto current = chain;
+  for (long i = 1; i < DEPTH; ++i) {
+    current = current->append_child(PlusNode::SUPPLIER);
+  }
+  auto chain_sizes = parallel(chain);
+  ASSERT_EQ(DEPTH, chain_sizes.size());
+  for (long i = 0; i < DEPTH; ++i) {
+    ASSERT_EQ(DEPTH - i, chain_sizes[i]);
+  }
+
+  auto tree = comb(DEPTH);
+  auto comb_sizes = parallel(tree);
+  ASSERT_EQ(2 * DEPTH - 1, comb_sizes.size());
+  for (long i = 0; i < DEPTH - 1; ++i) {
+    ASSERT_EQ(2 * (DEPTH - i) - 1, comb_sizes[i]);
+  }
+
+  // The spine is sized once, not once per ancestor, with any grain.
+  ParallelFold<BaseAttrNode, size_t> coarse(size, pool);
+  ASSERT_EQ(comb_sizes, coarse(tree));
+}
+
+TEST(Fold, Exception) {
+  WorkStealingPool pool(4);
+  auto root = random_tree(20000, 5);
+  Size size;
+  size.throw_at = root->child(0)->child(0).get();
+  Fold<BaseAttrNode, size_t> sequential(size);
+  ASSERT_THROW(sequential(root), runtime_error);
+  ParallelFold<BaseAttrNode, size_t> parallel(size, pool, 16);
+  ASSERT_THROW(parallel(root), runtime_error);
+
+  size.throw_at = nullptr;
+  ASSERT_EQ(20000, sequential(root)[0]);
+  ASSERT_EQ(20000, parallel(root)[0]);
+}
@@ -0,0 +1,254 @@
+/*
+ * FrozenTree.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests flattened tree snapshots.
+ */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "FrozenNodeAction.h"
+#include "FrozenTree.h"
+#include "IntegerNode.h"
+#include "MinusNode.h"
+#include "OperatorNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+#include "TestTrees.h"
+#include "VacuousVoidFunction.h"
+#include "VoidFunction.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace FrozenTreeTest {
+
+/*
+ * Records entries and exits as (serial number, level) pairs, and
+ * honors the traversal control attributes.
+ */
+class Recorder : public VoidFunction {
+  int level_ = 0;
+  vector<pair<string, int>> entries_;
+  vector<pair<string, int>> exits_;
+
+public:
+  TraversalStatus enter(const string& serial_no, bool cancel, bool bypass) {
+    entries_.emplace_back(serial_no, level_);
+    return cancel ? TraversalStatus::CANCEL
+        : bypass ? TraversalStatus::BYPASS_CHILDREN
+        : TraversalStatus::CONTINUE;
+  }
+
+  TraversalStatus exit(const string& serial_no, bool cancel, bool bypass) {
+    exits_.emplace_back(serial_no, level_);
+    return cancel ? TraversalStatus::CANCEL
+        : bypass ? TraversalStatus::BYPASS_CHILDREN
+        : TraversalStatus::CONTINUE;
+  }
+
+  virtual void operator()(void) override {
+    ++level_;
+  }
+
+  const vector<pair<string, int>>& entries() const {
+    return entries_;
+  }
+
+  const vector<pair<string, int>>& exits() const {
+    return exits_;
+  }
+
+  int level() const {
+    return level_;
+  }
+
+  class Ascend : public VoidFunction {
+    Recorder& recorder_;
+  public:
+    Ascend(Recorder& recorder) : recorder_(recorder) {}
+
+    virtual void operator()(void) override {
+      --recorder_.level_;
+    }
+  };
+};
+
+class BorrowedEnter : public BorrowedNodeAction<BaseAttrNode> {
+  Recorder& recorder_;
+public:
+  BorrowedEnter(Recorder& recorder) : recorder_(recorder) {}
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    return recorder_.enter(
+        node->get(TestAttribute::SERIAL_NO),
+        node->has(TestAttribute::CANCEL_ON_ENTRY),
+        node->has(TestAttribute::BYPASS_CHILDREN_ON_ENTRY));
+  }
+};
+
+class BorrowedExit : public BorrowedNodeAction<BaseAttrNode> {
+  Recorder& recorder_;
+public:
+  BorrowedExit(Recorder& recorder) : recorder_(recorder) {}
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    return recorder_.exit(
+        node->get(TestAttribute::SERIAL_NO),
+        node->has(TestAttribute::CANCEL_ON_EXIT),
+        node->has(TestAttribute::BYPASS_CHILDREN_ON_EXIT));
+  }
+};
+
+class FrozenEnter : public FrozenNodeAction {
+  Recorder& recorder_;
+public:
+  FrozenEnter(Recorder& recorder) : recorder_(recorder) {}
+
+  virtual TraversalStatus operator()(
+      const FrozenTree& tree, size_t index) override {
+    return recorder_.enter(
+        tree.get(index, TestAttribute::SERIAL_NO),
+        tree.has(index, TestAttribute::CANCEL_ON_ENTRY),
+        tree.has(index, TestAttribute::BYPASS_CHILDREN_ON_ENTRY));
+  }
+};
+
+class FrozenExit : public FrozenNodeAction {
+  Recorder& recorder_;
+public:
+  FrozenExit(Recorder& recorder) : recorder_(recorder) {}
+
+  virtual TraversalStatus operator()(
+      const FrozenTree& tree, size_t index) override {
+    return recorder_.exit(
+        tree.get(index, TestAttribute::SERIAL_NO),
+        tree.has(index, TestAttribute::CANCEL_ON_EXIT),
+        tree.has(index, TestAttribute::BYPASS_CHILDREN_ON_EXIT));
+  }
+};
+
+class OperatorCounter : public Visitor, public OperatorNodeVisitor {
+public:
+  int count = 0;
+
+  virtual TraversalStatus process_operator_node(OperatorNode *node) override {
+    ++count;
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+/*
+ * Runs a borrowing traversal over a tree and a frozen traversal over
+ * its snapshot, and verifies that they behave identically.
+ */
+static void compare_traversals(shared_ptr<BaseAttrNode> root) {
+  Recorder borrowed;
+  Recorder::Ascend borrowed_ascent(borrowed);
+  BorrowedEnter borrowed_entry(borrowed);
+  BorrowedExit borrowed_exit(borrowed);
+  BorrowingTraversal<BaseAttrNode> traversal(
+      borrowed_entry, borrowed_exit, borrowed, borrowed_ascent);
+  auto borrowed_status = traversal(root);
+
+  Recorder frozen;
+  Recorder::Ascend frozen_ascent(frozen);
+  FrozenEnter frozen_entry(frozen);
+  FrozenExit frozen_exit(frozen);
+  auto snapshot = FrozenTree::freeze(root);
+  auto frozen_status = snapshot.traverse(
+      frozen_entry, frozen_exit, frozen, frozen_ascent);
+
+  ASSERT_EQ(borrowed_status, frozen_status);
+  ASSERT_EQ(borrowed.entries(), frozen.entries());
+  ASSERT_EQ(borrowed.exits(), frozen.exits());
+  ASSERT_EQ(0, frozen.level());
+}
+
+} /* namespace FrozenTreeTest */
+
+using namespace FrozenTreeTest;
+
+TEST(FrozenTree, Structure) {
+  auto root = TestTrees::bypass_on_entry();
+  auto snapshot = FrozenTree::freeze(root);
+  ASSERT_EQ(root, snapshot.root());
+  ASSERT_EQ(7, snapshot.size());
+
+  vector<string> expected_serial_nos = {"1", "2", "3", "4", "5", "6", "8"};
+  vector<size_t> expected_parents = {FrozenTree::NO_NODE, 0, 1, 1, 3, 3, 1};
+  vector<size_t> expected_subtree_ends = {7, 7, 3, 6, 5, 6, 7};
+  vector<size_t> expected_next_siblings = {
+      FrozenTree::NO_NODE, FrozenTree::NO_NODE, 3, 6, 5,
+      FrozenTree::NO_NODE, FrozenTree::NO_NODE};
+  for (size_t i = 0; i < snapshot.size(); ++i) {
+    ASSERT_EQ(expected_serial_nos[i], snapshot.get(i, TestAttribute::SERIAL_NO));
+    ASSERT_EQ(expected_parents[i], snapshot.parent(i));
+    ASSERT_EQ(expected_subtree_ends[i], snapshot.subtree_end(i));
+    ASSERT_EQ(expected_next_siblings[i], snapshot.next_sibling(i));
+    ASSERT_EQ(snapshot.node(i)->supplier(), snapshot.supplier(i));
+  }
+
+  ASSERT_EQ(RootNode::SUPPLIER, snapshot.supplier(0));
+  ASSERT_EQ(MinusNode::SUPPLIER, snapshot.supplier(3));
+  ASSERT_EQ(root->child(0)->child(1).get(), snapshot.node(3));
+  ASSERT_EQ(1, snapshot.first_child(0));
+  ASSERT_EQ(4, snapshot.first_child(3));
+  ASSERT_EQ(FrozenTree::NO_NODE, snapshot.first_child(2));
+  ASSERT_TRUE(snapshot.has_children(3));
+  ASSERT_FALSE(snapshot.has_children(6));
+
+  ASSERT_EQ(2, snapshot.attributes(3).size());
+  ASSERT_EQ(&TestAttribute::BYPASS_CHILDREN_ON_ENTRY,
+      snapshot.attributes(3)[0].attribute);
+  ASSERT_TRUE(snapshot.has(3, TestAttribute::BYPASS_CHILDREN_ON_ENTRY));
+  ASSERT_FALSE(snapshot.has(3, TestAttribute::VALUE));
+  ASSERT_EQ("17", snapshot.get(4, TestAttribute::VALUE));
+  ASSERT_EQ("", snapshot.get(0, TestAttribute::VALUE));
+}
+
+TEST(FrozenTree, Isolated) {
+  auto root = TestTrees::simple_addition();
+  root->child(0)->child(0)->set(TestAttribute::COUNT, 137);
+  auto snapshot = FrozenTree::freeze(root->child(0));
+  ASSERT_EQ(3, snapshot.size());
+  ASSERT_EQ(FrozenTree::NO_NODE, snapshot.parent(0));
+
+  root->child(0)->child(0)->set(TestAttribute::COUNT, 314);
+  root->child(0)->set(TestAttribute::SERIAL_NO, "22");
+  ASSERT_EQ(137, snapshot.get(1, TestAttribute::COUNT));
+  ASSERT_EQ(0, snapshot.get(2, TestAttribute::COUNT));
+  ASSERT_EQ("2", snapshot.get(0, TestAttribute::SERIAL_NO));
+}
+
+TEST(FrozenTree, MatchesTraversal) {
+  compare_traversals(TestTrees::simple_addition());
+  compare_traversals(TestTrees::bypass_on_entry());
+  compare_traversals(TestTrees::bypass_on_exit());
+  compare_traversals(TestTrees::cancel_on_entry());
+  compare_traversals(TestTrees::cancel_on_exit());
+  compare_traversals(TestTrees::addition_and_multiplication());
+  compare_traversals(TestTrees::all_operations());
+  compare_traversals(TestTrees::complex_tree());
+}
+
+TEST(FrozenTree, Visit) {
+  auto snapshot = FrozenTree::freeze(TestTrees::addition_and_multiplication());
+  OperatorCounter on_entry;
+  ASSERT_EQ(TraversalStatus::CONTINUE, snapshot.visit(&on_entry, nullptr));
+  ASSERT_EQ(2, on_entry.count);
+
+  OperatorCounter subtree;
+  snapshot.visit(nullptr, &subtree, VacuousVoidFunction::INSTANCE,
+      VacuousVoidFunction::INSTANCE, snapshot.first_child(0));
+  ASSERT_EQ(2, subtree.count);
+}
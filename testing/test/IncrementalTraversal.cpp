@@ -0,0 +1,257 @@
+/*
+ * IncrementalTraversal.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests revision stamping and incremental traversal.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "BorrowedNodeAction.h"
+#include "IncrementalTraversal.h"
+#include "IntegerNode.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace IncrementalTraversalTest {
+
+/*
+ * Counts entered nodes, and cancels on entering a node with the
+ * CANCEL_ON_ENTRY attribute.
+ */
+class Counter : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  long count = 0;
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    ++count;
+    return node->has(TestAttribute::CANCEL_ON_ENTRY)
+        ? TraversalStatus::CANCEL
+        : TraversalStatus::CONTINUE;
+  }
+};
+
+/*
+ * Stores each node's value, the sum of the leaf values in its
+ * subtree, in its COUNT attribute.
+ */
+class Evaluator : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    int64_t value = 0;
+    if (node->is_leaf()) {
+      value = stoll(node->get(TestAttribute::VALUE));
+    } else {
+      for (size_t i = 0; i < node->child_count(); ++i) {
+        value += node->child(i)->get(TestAttribute::COUNT);
+      }
+    }
+    node->put(TestAttribute::COUNT, value);
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+/*
+ * Reuses the value of every unchanged node that has one.
+ */
+class Reuser : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    return node->has(TestAttribute::COUNT)
+        ? TraversalStatus::BYPASS_CHILDREN
+        : TraversalStatus::CONTINUE;
+  }
+};
+
+/*
+ * Builds a complete binary tree of sums with the specified number of
+ * levels, whose leaves all have the value 1.
+ */
+static shared_ptr<BaseAttrNode> balanced(int depth) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  vector<shared_ptr<BaseAttrNode>> level = {root};
+  for (int d = 1; d < depth; ++d) {
+    vector<shared_ptr<BaseAttrNode>> next_level;
+    for (auto& parent : level) {
+      for (int i = 0; i < 2; ++i) {
+        if (d + 1 < depth) {
+          next_level.push_back(parent->append_child(PlusNode::SUPPLIER));
+        } else {
+          parent->append_child(IntegerNode::SUPPLIER)
+              ->put(TestAttribute::VALUE, "1");
+        }
+      }
+    }
+    level = std::move(next_level);
+  }
+  return root;
+}
+
+/*
+ * Returns the leftmost leaf under a node.
+ */
+static shared_ptr<BaseAttrNode> leftmost_leaf(shared_ptr<BaseAttrNode> node) {
+  while (!node->is_leaf()) {
+    node = node->child(0);
+  }
+  return node;
+}
+
+} /* namespace IncrementalTraversalTest */
+
+using namespace IncrementalTraversalTest;
+
+TEST(IncrementalTraversal, Revisions) {
+  auto root = balanced(3);
+  auto left = root->child(0);
+  auto right = root->child(1);
+  BaseAttrNode::next_revision();
+  auto before = root->revision();
+  ASSERT_EQ(before, left->revision());
+  ASSERT_EQ(before, right->revision());
+
+  left->child(0)->put(TestAttribute::NAME, "changed");
+  ASSERT_LT(before, root->revision());
+  ASSERT_EQ(root->revision(), left->revision());
+  ASSERT_EQ(root->revision(), left->child(0)->revision());
+  ASSERT_EQ(before, left->child(1)->revision());
+  ASSERT_EQ(before, right->revision());
+
+  BaseAttrNode::next_revision();
+  auto changed = root->revision();
+  auto detached = right->child(1);
+  detached->detach();
+  ASSERT_LT(changed, right->revision());
+  ASSERT_EQ(right->revision(), root->revision());
+  ASSERT_EQ(changed, left->revision());
+  ASSERT_EQ(before, detached->revision());
+
+  BaseAttrNode::next_revision();
+  auto fresh = IntegerNode::SUPPLIER.make_shared();
+  ASSERT_LT(root->revision(), fresh->revision());
+}
+
+TEST(IncrementalTraversal, SkipsCleanSubtrees) {
+  constexpr int DEPTH = 10;
+  auto root = balanced(DEPTH);
+  Counter counter;
+  Evaluator evaluator;
+  Reuser reuser;
+  IncrementalTraversal<BaseAttrNode> traversal(counter, evaluator, reuser);
+
+  traversal(root);
+  ASSERT_EQ((1 << DEPTH) - 1, counter.count);
+  ASSERT_EQ(1 << (DEPTH - 1), root->get(TestAttribute::COUNT));
+
+  counter.count = 0;
+  traversal(root);
+  ASSERT_EQ(0, counter.count);
+
+  leftmost_leaf(root)->set(TestAttribute::VALUE, "5");
+  traversal(root);
+  ASSERT_EQ(DEPTH, counter.count);
+  ASSERT_EQ((1 << (DEPTH - 1)) + 4, root->get(TestAttribute::COUNT));
+
+  counter.count = 0;
+  root->child(1)->child(1)->append_child(IntegerNode::SUPPLIER)
+      ->put(TestAttribute::VALUE, "10");
+  traversal(root);
+  ASSERT_EQ(4, counter.count);
+  ASSERT_EQ((1 << (DEPTH - 1)) + 14, root->get(TestAttribute::COUNT));
+
+  counter.count = 0;
+  traversal.reset();
+  traversal(root);
+  ASSERT_EQ((1 << DEPTH), counter.count);
+}
+
+TEST(IncrementalTraversal, UnseenSubtreesAreTraversed) {
+  auto root = balanced(4);
+  auto graft = balanced(3);
+  Counter counter;
+  Evaluator evaluator;
+  Reuser reuser;
+  IncrementalTraversal<BaseAttrNode> traversal(counter, evaluator, reuser);
+  traversal(root);
+
+  // The graft predates the run, but the run never saw it.
+  auto stem = graft->child(0);
+  stem->detach();
+  root->child(0)->append_child(stem);
+  counter.count = 0;
+  traversal(root);
+  ASSERT_EQ(2 + 3, counter.count);
+  ASSERT_EQ(8 + 2, root->get(TestAttribute::COUNT));
+}
+
+TEST(IncrementalTraversal, AttachedSubtreesAreTraversed) {
+  auto root = balanced(4);
+  auto appended = balanced(3);
+  auto inserted = balanced(3);
+  Counter counter;
+  Evaluator evaluator;
+  Reuser reuser;
+  // Evaluated before the run below, so the clean action would reuse
+  // their values if it were offered them.
+  IncrementalTraversal<BaseAttrNode> other(counter, evaluator, reuser);
+  other(appended);
+  other(inserted);
+  IncrementalTraversal<BaseAttrNode> traversal(counter, evaluator, reuser);
+  traversal(root);
+
+  auto stem = appended->child(0);
+  stem->detach();
+  auto seen = stem->revision();
+  root->child(0)->append_child(stem);
+  ASSERT_LT(seen, stem->revision());
+  ASSERT_EQ(stem->revision(), stem->attach_revision());
+  ASSERT_EQ(seen, stem->child(0)->revision());
+
+  auto branch = inserted->child(1);
+  branch->detach();
+  root->child(1)->insert_child(0, branch);
+  ASSERT_EQ(stem->attach_revision(), branch->attach_revision());
+
+  counter.count = 0;
+  traversal(root);
+  ASSERT_EQ(3 + 3 + 3, counter.count);
+  ASSERT_EQ(8 + 2 + 2, root->get(TestAttribute::COUNT));
+
+  counter.count = 0;
+  traversal(root);
+  ASSERT_EQ(0, counter.count);
+}
+
+TEST(IncrementalTraversal, CanceledRunIsForgotten) {
+  auto root = balanced(4);
+  Counter counter;
+  Evaluator evaluator;
+  Reuser reuser;
+  IncrementalTraversal<BaseAttrNode> traversal(counter, evaluator, reuser);
+  traversal(root);
+
+  auto leaf = leftmost_leaf(root);
+  leaf->set(TestAttribute::VALUE, "2");
+  root->child(0)->put(TestAttribute::CANCEL_ON_ENTRY, "yes");
+  counter.count = 0;
+  ASSERT_EQ(TraversalStatus::CANCEL, traversal(root));
+  ASSERT_EQ(2, counter.count);
+
+  root->child(0)->erase(TestAttribute::CANCEL_ON_ENTRY);
+  counter.count = 0;
+  ASSERT_EQ(TraversalStatus::CONTINUE, traversal(root));
+  ASSERT_EQ(4, counter.count);
+  ASSERT_EQ(9, root->get(TestAttribute::COUNT));
+}
@@ -0,0 +1,78 @@
+/*
+ * InternPool.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests attribute value interning
+ */
+
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "InternPool.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+TEST(InternPool, Empty) {
+  InternPool pool;
+  ASSERT_EQ(0, pool.size());
+  InternedString empty = pool.intern("");
+  ASSERT_TRUE(empty.empty());
+  ASSERT_EQ(InternedString(), empty);
+  ASSERT_EQ(InternPool::global().intern(""), empty);
+  ASSERT_EQ(0, pool.size());
+}
+
+TEST(InternPool, Deduplicates) {
+  InternPool pool;
+  string text("a value long enough to defeat the small string optimization");
+  InternedString first = pool.intern(text);
+  InternedString second = pool.intern(string_view(text));
+  InternedString third = pool.intern(text.c_str());
+  ASSERT_EQ(1, pool.size());
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(first, third);
+  ASSERT_EQ(&first.str(), &third.str());
+  ASSERT_EQ(text, first.str());
+  ASSERT_EQ(string_view(text), first.view());
+
+  InternedString other = pool.intern("another value");
+  ASSERT_EQ(2, pool.size());
+  ASSERT_NE(first, other);
+  ASSERT_EQ(first, pool.intern(text));
+}
+
+TEST(InternPool, DistinctPools) {
+  InternPool pool;
+  InternPool other_pool;
+  ASSERT_NE(pool.intern("Yes"), other_pool.intern("Yes"));
+  ASSERT_EQ(pool.intern("Yes").str(), other_pool.intern("Yes").str());
+}
+
+TEST(InternPool, Concurrent) {
+  constexpr int THREAD_COUNT = 8;
+  constexpr int VALUE_COUNT = 1000;
+  InternPool pool;
+  vector<vector<InternedString>> interned(THREAD_COUNT);
+  vector<thread> threads;
+  for (int t = 0; t < THREAD_COUNT; ++t) {
+    threads.emplace_back([&pool, &interned, t]() {
+      for (int i = 0; i < VALUE_COUNT; ++i) {
+        interned[t].push_back(pool.intern("value " + to_string(i)));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(VALUE_COUNT, pool.size());
+  for (int t = 1; t < THREAD_COUNT; ++t) {
+    ASSERT_EQ(interned[0], interned[t]);
+  }
+}
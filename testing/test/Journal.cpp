@@ -0,0 +1,161 @@
+/*
+ * Journal.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests rolling back journaled tree edits
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "FrozenTree.h"
+#include "IllegalOnRoot.h"
+#include "IntegerNode.h"
+#include "Journal.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace JournalTest {
+
+/*
+ * Builds root(plus(1, 2), plus(3, plus(4, 5))) with values on the
+ * integers and serial numbers on every node.
+ */
+static shared_ptr<BaseAttrNode> expression(void) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  auto left = root->append_child(PlusNode::SUPPLIER);
+  left->append_child(IntegerNode::SUPPLIER)->put(TestAttribute::VALUE, "1");
+  left->append_child(IntegerNode::SUPPLIER)->put(TestAttribute::VALUE, "2");
+  auto right = root->append_child(PlusNode::SUPPLIER);
+  right->append_child(IntegerNode::SUPPLIER)->put(TestAttribute::VALUE, "3");
+  auto nested = right->append_child(PlusNode::SUPPLIER);
+  nested->append_child(IntegerNode::SUPPLIER)->put(TestAttribute::VALUE, "4");
+  nested->append_child(IntegerNode::SUPPLIER)->put(TestAttribute::VALUE, "5");
+  auto frozen = FrozenTree::freeze(root);
+  for (size_t i = 0; i < frozen.size(); ++i) {
+    frozen.node(i)->put(TestAttribute::SERIAL_NO, to_string(i));
+  }
+  return root;
+}
+
+/*
+ * Captures a tree's nodes, shape, and attributes in preorder.
+ */
+struct Image {
+  vector<BaseAttrNode *> nodes;
+  vector<size_t> parents;
+  vector<string> values;
+
+  Image(const shared_ptr<BaseAttrNode>& root) {
+    auto frozen = FrozenTree::freeze(root);
+    for (size_t i = 0; i < frozen.size(); ++i) {
+      nodes.push_back(frozen.node(i));
+      parents.push_back(frozen.parent(i));
+      values.push_back(
+          frozen.get(i, TestAttribute::SERIAL_NO) + ":"
+          + frozen.get(i, TestAttribute::VALUE) + ":"
+          + to_string(frozen.get(i, TestAttribute::COUNT)));
+    }
+  }
+
+  bool operator==(const Image& other) const = default;
+};
+
+} /* namespace JournalTest */
+
+using namespace JournalTest;
+
+TEST(Journal, Attributes) {
+  auto root = expression();
+  auto leaf = root->child(0)->child(0);
+  Image original(root);
+  Journal<BaseAttrNode> journal;
+
+  auto mark = journal.checkpoint();
+  journal.put(leaf, TestAttribute::VALUE, "137");
+  journal.put(leaf, TestAttribute::COUNT, 42);
+  journal.put(leaf, TestAttribute::VALUE, string("314"));
+  journal.erase(root, TestAttribute::SERIAL_NO);
+  ASSERT_EQ("314", leaf->get(TestAttribute::VALUE));
+  ASSERT_EQ(42, leaf->get(TestAttribute::COUNT));
+  ASSERT_FALSE(root->has(TestAttribute::SERIAL_NO));
+  ASSERT_EQ(4, journal.size());
+
+  journal.rollback(mark);
+  ASSERT_EQ(0, journal.size());
+  ASSERT_EQ("1", leaf->get(TestAttribute::VALUE));
+  ASSERT_FALSE(leaf->has(TestAttribute::COUNT));
+  ASSERT_TRUE(original == Image(root));
+}
+
+TEST(Journal, Structure) {
+  auto root = expression();
+  Image original(root);
+  Journal<BaseAttrNode> journal;
+
+  auto left = root->child(0);
+  auto right = root->child(1);
+  auto nested = right->child(1);
+  journal.detach(left->child(0));
+  journal.append_child(root, IntegerNode::SUPPLIER);
+  journal.excise(nested);
+  journal.insert_child(right, 1, PlusNode::SUPPLIER.make_shared());
+  journal.excise(left);
+  journal.detach(root->child(0));
+  ASSERT_EQ(2, root->child_count());
+  ASSERT_EQ(4, right->child_count());
+  ASSERT_TRUE(nested->is_root());
+  ASSERT_FALSE(original == Image(root));
+
+  journal.rollback(0);
+  ASSERT_TRUE(original == Image(root));
+  ASSERT_EQ(root, left->parent());
+  ASSERT_EQ(0, left->child_index());
+  ASSERT_EQ(1, nested->child_index());
+}
+
+TEST(Journal, NestedCheckpoints) {
+  auto root = expression();
+  Image original(root);
+  Journal<BaseAttrNode> journal;
+
+  journal.put(root, TestAttribute::NAME, "first");
+  auto outer = journal.checkpoint();
+  journal.append_child(root, IntegerNode::SUPPLIER)
+      ->put(TestAttribute::SERIAL_NO, "new");
+  Image after_first(root);
+  auto inner = journal.checkpoint();
+  journal.excise(root->child(1));
+  journal.put(root->child(1), TestAttribute::NAME, "inner");
+
+  journal.rollback(inner);
+  ASSERT_TRUE(after_first == Image(root));
+  journal.rollback(outer);
+  ASSERT_EQ(2, root->child_count());
+  ASSERT_EQ("first", root->get(TestAttribute::NAME));
+
+  journal.commit();
+  journal.rollback(0);
+  ASSERT_EQ("first", root->get(TestAttribute::NAME));
+  root->erase(TestAttribute::NAME);
+  ASSERT_TRUE(original == Image(root));
+}
+
+TEST(Journal, ExciseRoot) {
+  auto root = expression();
+  Journal<BaseAttrNode> journal;
+  ASSERT_THROW(journal.excise(root), IllegalOnRoot);
+  ASSERT_EQ(0, journal.size());
+  journal.detach(root);
+  ASSERT_EQ(0, journal.size());
+}
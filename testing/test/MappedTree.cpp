@@ -0,0 +1,193 @@
+/*
+ * MappedTree.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests memory-mapped trees.
+ */
+
+#include <cstring>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "BinaryTreeWriter.h"
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
+#include "IllegalOperation.h"
+#include "InternPool.h"
+#include "MappedNodeAction.h"
+#include "MappedTree.h"
+#include "TestAttribute.h"
+#include "TestTrees.h"
+#include "TimesNode.h"
+#include "TreeCorruptError.h"
+#include "VacuousVoidFunction.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace MappedTreeTest {
+
+/*
+ * Writes a tree to a temporary file that is removed on destruction.
+ */
+class TreeFile {
+  filesystem::path path_;
+
+public:
+  TreeFile(const shared_ptr<BaseAttrNode>& root, const string& name) :
+      path_(filesystem::temp_directory_path() / name) {
+    ofstream out(path_, ios::binary);
+    MappedTree::write(root, out);
+  }
+
+  ~TreeFile() {
+    filesystem::remove(path_);
+  }
+
+  string path(void) const {
+    return path_.string();
+  }
+};
+
+/*
+ * Records serial numbers in entry order.
+ */
+class SerialNumbers : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  vector<string> entered;
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    entered.push_back(node->get(TestAttribute::SERIAL_NO));
+    return node->has(TestAttribute::BYPASS_CHILDREN_ON_ENTRY)
+        ? TraversalStatus::BYPASS_CHILDREN
+        : TraversalStatus::CONTINUE;
+  }
+};
+
+class MappedSerialNumbers : public MappedNodeAction {
+public:
+  vector<string> entered;
+
+  virtual TraversalStatus operator()(
+      const MappedTree& tree, size_t node) override {
+    entered.emplace_back(tree.get(node, TestAttribute::SERIAL_NO));
+    return tree.has(node, TestAttribute::BYPASS_CHILDREN_ON_ENTRY)
+        ? TraversalStatus::BYPASS_CHILDREN
+        : TraversalStatus::CONTINUE;
+  }
+};
+
+class Continue : public MappedNodeAction {
+public:
+  virtual TraversalStatus operator()(
+      const MappedTree& tree, size_t node) override {
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+/*
+ * Asserts that a mapped subtree matches the tree it was written from.
+ */
+static void expect_same(
+    BaseAttrNode& node, const MappedTree& tree, size_t mapped) {
+  ASSERT_EQ(node.type_name(), tree.type_name(tree.type(mapped)));
+  ASSERT_EQ(node.attribute_count(), tree.attribute_count(mapped));
+  ASSERT_EQ(node.get(TestAttribute::SERIAL_NO),
+      tree.get(mapped, TestAttribute::SERIAL_NO));
+  ASSERT_EQ(node.get(TestAttribute::VALUE),
+      tree.get(mapped, TestAttribute::VALUE));
+  size_t child = tree.first_child(mapped);
+  for (size_t i = 0; i < node.child_count(); ++i) {
+    ASSERT_NE(MappedTree::NO_NODE, child);
+    ASSERT_EQ(mapped, tree.parent(child));
+    expect_same(*node.child(i), tree, child);
+    child = tree.next_sibling(child);
+  }
+  ASSERT_EQ(MappedTree::NO_NODE, child);
+}
+
+} /* namespace MappedTreeTest */
+
+using namespace MappedTreeTest;
+
+TEST(MappedTree, Structure) {
+  auto tree = TestTrees::complex_tree();
+  auto leaf = tree->child(0)->child(0);
+  leaf->put(TestAttribute::COUNT, int64_t(-42));
+  leaf->put(TestAttribute::WEIGHT, 2.5);
+  leaf->put(TestAttribute::VISITED, true);
+  leaf->put(TestAttribute::TYPE_NAME, InternPool::global().intern("times"));
+  TreeFile file(tree, "MappedTree.Structure.vpt");
+  auto mapped = MappedTree::open(file.path());
+
+  expect_same(*tree, mapped, mapped.root());
+  ASSERT_EQ(MappedTree::NO_NODE, mapped.parent(mapped.root()));
+  ASSERT_EQ(MappedTree::NO_NODE, mapped.next_sibling(mapped.root()));
+
+  size_t mapped_leaf = mapped.first_child(mapped.first_child(mapped.root()));
+  ASSERT_EQ(-42, mapped.get(mapped_leaf, TestAttribute::COUNT));
+  ASSERT_EQ(2.5, mapped.get(mapped_leaf, TestAttribute::WEIGHT));
+  ASSERT_TRUE(mapped.get(mapped_leaf, TestAttribute::VISITED));
+  ASSERT_EQ("times", mapped.get(mapped_leaf, TestAttribute::TYPE_NAME));
+  ASSERT_EQ(0, mapped.get(mapped.root(), TestAttribute::COUNT));
+  ASSERT_EQ("", mapped.get(mapped.root(), TestAttribute::NAME));
+  ASSERT_EQ(MappedTree::NOT_FOUND, mapped.key(TestAttribute::NAME));
+  ASSERT_THROW(
+      mapped.get(mapped_leaf, mapped.key(TestAttribute::COUNT)),
+      IllegalOperation);
+  ASSERT_NE(MappedTree::NOT_FOUND, mapped.find_type(TimesNode::SUPPLIER));
+}
+
+TEST(MappedTree, MatchesTraversal) {
+  auto tree = TestTrees::bypass_on_entry();
+  SerialNumbers expected;
+  SerialNumbers ignored;
+  BorrowingTraversal<BaseAttrNode>(
+      expected,
+      ignored,
+      VacuousVoidFunction::INSTANCE,
+      VacuousVoidFunction::INSTANCE)(tree.get());
+
+  stringstream stream;
+  MappedTree::write(tree, stream);
+  // Copy into 8-byte aligned memory, as a mapping would be.
+  string bytes = stream.str();
+  vector<uint64_t> aligned((bytes.size() + 7) / 8);
+  memcpy(aligned.data(), bytes.data(), bytes.size());
+  auto mapped = MappedTree::view(aligned.data(), bytes.size());
+  MappedSerialNumbers actual;
+  Continue on_exit;
+  ASSERT_EQ(TraversalStatus::CONTINUE, mapped.traverse(actual, on_exit));
+  ASSERT_EQ(expected.entered, actual.entered);
+  ASSERT_EQ(tree->child(0)->child(0)->get(TestAttribute::SERIAL_NO),
+      mapped.get(mapped.first_child(mapped.first_child(0)),
+          TestAttribute::SERIAL_NO));
+}
+
+TEST(MappedTree, Malformed) {
+  stringstream stream;
+  MappedTree::write(TestTrees::simple_addition(), stream);
+  string bytes = stream.str();
+  vector<uint64_t> aligned((bytes.size() + 7) / 8);
+  memcpy(aligned.data(), bytes.data(), bytes.size());
+  ASSERT_THROW(
+      MappedTree::view(aligned.data(), bytes.size() - 8),
+      TreeCorruptError);
+  reinterpret_cast<char *>(aligned.data())[0] = 'X';
+  ASSERT_THROW(
+      MappedTree::view(aligned.data(), bytes.size()),
+      TreeCorruptError);
+  ASSERT_THROW(
+      MappedTree::open("/nonexistent/MappedTree.vpt"),
+      IllegalOperation);
+}
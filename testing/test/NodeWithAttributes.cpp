@@ -9,15 +9,80 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
 #include "AttributedTestNode.h"
+#include "FrozenTree.h"
+#include "IntegerNode.h"
+#include "NodeArena.h"
+#include "PlusNode.h"
+#include "RootNode.h"
 #include "TestAttribute.h"
 
 using namespace std;
 using namespace VisitingParseTree;
 
+namespace NodeWithAttributesTest {
+
+/*
+ * Builds a complete binary expression tree whose leaves carry values.
+ */
+static shared_ptr<BaseAttrNode> expression(int depth, NodeArena *arena) {
+  auto root = arena
+      ? RootNode::SUPPLIER.allocate_shared(*arena)
+      : RootNode::SUPPLIER.make_shared();
+  vector<shared_ptr<BaseAttrNode>> level = {root};
+  for (int d = 0; d < depth; ++d) {
+    vector<shared_ptr<BaseAttrNode>> next_level;
+    for (auto& node : level) {
+      for (int i = 0; i < 2; ++i) {
+        auto& supplier = d + 1 < depth
+            ? static_cast<Supplier<BaseAttrNode>&>(PlusNode::SUPPLIER)
+            : static_cast<Supplier<BaseAttrNode>&>(IntegerNode::SUPPLIER);
+        auto child = arena
+            ? node->append_child(supplier, *arena)
+            : node->append_child(supplier);
+        child->put(TestAttribute::SERIAL_NO, to_string(next_level.size()));
+        child->put(TestAttribute::COUNT, d);
+        next_level.push_back(child);
+      }
+    }
+    level = std::move(next_level);
+  }
+  return root;
+}
+
+/*
+ * Asserts that two trees have the same shape, node types, and
+ * attributes.
+ */
+static void assert_same(
+    const shared_ptr<BaseAttrNode>& expected,
+    const shared_ptr<BaseAttrNode>& actual) {
+  auto expected_frozen = FrozenTree::freeze(expected);
+  auto actual_frozen = FrozenTree::freeze(actual);
+  ASSERT_EQ(expected_frozen.size(), actual_frozen.size());
+  for (size_t i = 0; i < expected_frozen.size(); ++i) {
+    ASSERT_NE(expected_frozen.node(i), actual_frozen.node(i));
+    ASSERT_EQ(expected_frozen.supplier(i), actual_frozen.supplier(i));
+    ASSERT_EQ(expected_frozen.parent(i), actual_frozen.parent(i));
+    ASSERT_EQ(expected_frozen.subtree_end(i), actual_frozen.subtree_end(i));
+    auto expected_attributes = expected_frozen.attributes(i);
+    auto actual_attributes = actual_frozen.attributes(i);
+    ASSERT_EQ(expected_attributes.size(), actual_attributes.size());
+    for (size_t j = 0; j < expected_attributes.size(); ++j) {
+      ASSERT_EQ(expected_attributes[j].attribute, actual_attributes[j].attribute);
+      ASSERT_EQ(expected_attributes[j].value, actual_attributes[j].value);
+    }
+  }
+}
+
+} /* namespace NodeWithAttributesTest */
+
+using namespace NodeWithAttributesTest;
+
 TEST(NodeWithAttributes, Empty_Copy) {
   auto root = AttributedTestNode::SUPPLIER.make_shared();
   auto source = root->append_child(AttributedTestNode::SUPPLIER);
@@ -49,3 +114,49 @@ TEST(NodeWithAttributes, Clone) {
   ASSERT_STREQ("July 16, 1945", destination->get(TestAttribute::BIRTH_DATE).c_str());
   ASSERT_STREQ("Trinity Test", destination->get(TestAttribute::NAME).c_str());
 }
+
+TEST(NodeWithAttributes, DeepClone) {
+  auto root = expression(6, nullptr);
+  root->child(1)->set(TestAttribute::NAME, "Right");
+  auto source = root->child(1);
+  auto copy = source->deep_clone();
+  ASSERT_TRUE(copy->is_root());
+  assert_same(source, copy);
+
+  copy->child(0)->set(TestAttribute::NAME, "Changed");
+  ASSERT_FALSE(source->child(0)->has(TestAttribute::NAME));
+
+  auto leaf = root->child(0)->child(0)->child(0)->child(0)->child(0)->child(0);
+  auto leaf_copy = leaf->deep_clone();
+  assert_same(leaf, leaf_copy);
+  ASSERT_TRUE(leaf_copy->is_leaf());
+}
+
+TEST(NodeWithAttributes, DeepCloneIntoArena) {
+  auto source = expression(8, nullptr);
+  weak_ptr<NodeArena> arena_reference;
+  shared_ptr<BaseAttrNode> copy;
+  {
+    auto arena = NodeArena::make_shared();
+    arena_reference = arena;
+    copy = source->deep_clone(*arena);
+  }
+  assert_same(source, copy);
+  ASSERT_FALSE(arena_reference.expired());
+  copy.reset();
+  ASSERT_TRUE(arena_reference.expired());
+}
+
+TEST(NodeWithAttributes, DeepCloneDeepChain) {
+  constexpr long DEPTH = 200000;
+  auto root = RootNode::SUPPLIER.make_shared();
+  auto current = root;
+  for (long i = 1; i < DEPTH; ++i) {
+    current = current->append_child(PlusNode::SUPPLIER);
+  }
+  current->set(TestAttribute::NAME, "Bottom");
+  auto copy = root->deep_clone();
+  auto frozen = FrozenTree::freeze(copy);
+  ASSERT_EQ(DEPTH, frozen.size());
+  ASSERT_EQ("Bottom", frozen.get(DEPTH - 1, TestAttribute::NAME));
+}
@@ -0,0 +1,252 @@
+/*
+ * ParallelTraversal.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests the work-stealing pool and parallel traversal
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "BorrowedNodeAction.h"
+#include "IntegerNode.h"
+#include "ParallelTraversal.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TaskGroup.h"
+#include "TestAttribute.h"
+#include "WorkStealingPool.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace ParallelTraversalTest {
+
+/*
+ * Builds a tree in which every interior node has the specified
+ * number of children.
+ */
+static shared_ptr<BaseAttrNode> bushy(int fanout, int depth) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  vector<shared_ptr<BaseAttrNode>> level = {root};
+  for (int d = 0; d < depth; ++d) {
+    vector<shared_ptr<BaseAttrNode>> next_level;
+    for (auto& node : level) {
+      for (int i = 0; i < fanout; ++i) {
+        next_level.push_back(node->append_child(PlusNode::SUPPLIER));
+      }
+    }
+    level = std::move(next_level);
+  }
+  return root;
+}
+
+/*
+ * Marks nodes entered (COUNT = 1) and exited (VISITED), and counts
+ * nodes entered before their parents, or exited before their
+ * children.
+ */
+class Enter : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  atomic<long> count = 0;
+  atomic<long> out_of_order = 0;
+  const BaseAttrNode *cancel_at = nullptr;
+  const BaseAttrNode *throw_at = nullptr;
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    ++count;
+    if (auto parent = node->parent();
+        parent && !parent->is_root() && 1 != parent->get(TestAttribute::COUNT)) {
+      ++out_of_order;
+    }
+    node->put(TestAttribute::COUNT, 1);
+    if (node == throw_at) {
+      throw runtime_error("Thrown from entry action");
+    }
+    return node == cancel_at
+        ? TraversalStatus::CANCEL
+        : TraversalStatus::CONTINUE;
+  }
+};
+
+class Exit : public BorrowedNodeAction<BaseAttrNode> {
+public:
+  atomic<long> count = 0;
+  atomic<long> out_of_order = 0;
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    ++count;
+    for (size_t i = 0; i < node->child_count(); ++i) {
+      if (!node->child(i)->get(TestAttribute::VISITED)) {
+        ++out_of_order;
+      }
+    }
+    node->put(TestAttribute::VISITED, true);
+    return TraversalStatus::CONTINUE;
+  }
+};
+
+} /* namespace ParallelTraversalTest */
+
+using namespace ParallelTraversalTest;
+
+TEST(ParallelTraversal, TaskGroup) {
+  WorkStealingPool pool(4);
+  ASSERT_EQ(4, pool.thread_count());
+  atomic<long> sum = 0;
+  TaskGroup group(pool);
+  for (long i = 1; i <= 100; ++i) {
+    group.run([&sum, &pool, i]() {
+      TaskGroup nested(pool);
+      for (long j = 0; j < 10; ++j) {
+        nested.run([&sum, i]() { sum += i; });
+      }
+      nested.wait();
+    });
+  }
+  group.wait();
+  ASSERT_EQ(50500, sum);
+
+  group.run([]() { throw runtime_error("Expected"); });
+  group.run([&sum]() { ++sum; });
+  ASSERT_THROW(group.wait(), runtime_error);
+  ASSERT_EQ(50501, sum);
+  group.wait();
+}
+
+/*
+ * A worker waiting for a group whose task runs elsewhere must wake to
+ * help when that task queues more work. Here the waiting worker is the
+ * only thread free to run the task that sets \c helped, which the other
+ * worker spins on.
+ */
+TEST(ParallelTraversal, WaiterHelpsWithNewWork) {
+  WorkStealingPool pool(2);
+  atomic<bool> stolen = false;
+  atomic<bool> helped = false;
+  bool waited = false;
+  atomic<bool> done = false;
+  // Submitted directly, so that this thread does not run the task.
+  pool.submit([&]() {
+    TaskGroup group(pool);
+    group.run([&]() {
+      stolen = true;
+      // Gives the first worker time to fall asleep in wait().
+      this_thread::sleep_for(chrono::milliseconds(20));
+      TaskGroup nested(pool);
+      nested.run([&helped]() { helped = true; });
+      nested.run([&helped, &waited]() {
+        auto deadline = chrono::steady_clock::now() + chrono::seconds(10);
+        while (!helped && chrono::steady_clock::now() < deadline) {
+          this_thread::yield();
+        }
+        waited = helped;
+      });
+      nested.wait();
+    });
+    // The other worker must take the task, so that this one waits.
+    while (!stolen) {
+      this_thread::yield();
+    }
+    group.wait();
+    done = true;
+  });
+  while (!done) {
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+  ASSERT_TRUE(waited);
+}
+
+TEST(ParallelTraversal, Ordering) {
+  WorkStealingPool pool(4);
+  auto root = bushy(6, 5);
+  const long node_count = 1 + 6 + 36 + 216 + 1296 + 7776;
+  Enter on_entry;
+  Exit on_exit;
+  ParallelTraversal<BaseAttrNode> traversal(on_entry, on_exit, pool, 16);
+  ASSERT_EQ(TraversalStatus::CONTINUE, traversal(root));
+  ASSERT_EQ(node_count, on_entry.count);
+  ASSERT_EQ(node_count, on_exit.count);
+  ASSERT_EQ(0, on_entry.out_of_order);
+  ASSERT_EQ(0, on_exit.out_of_order);
+}
+
+TEST(ParallelTraversal, DeepChain) {
+  constexpr long DEPTH = 250000;
+  WorkStealingPool pool(2);
+  auto root = RootNode::SUPPLIER.make_shared();
+  auto current = root;
+  for (long i = 1; i < DEPTH; ++i) {
+    current = current->append_child(PlusNode::SUPPLIER);
+  }
+  Enter on_entry;
+  Exit on_exit;
+  ParallelTraversal<BaseAttrNode> traversal(on_entry, on_exit, pool);
+  auto status = traversal(root);
+  ASSERT_EQ(TraversalStatus::CONTINUE, status);
+  ASSERT_EQ(DEPTH, on_entry.count);
+  ASSERT_EQ(DEPTH, on_exit.count);
+  ASSERT_EQ(0, on_exit.out_of_order);
+}
+
+TEST(ParallelTraversal, Caterpillar) {
+  // Each spine node has a leaf and the rest of the spine as children,
+  // so every spine node has one large child and one small one.
+  constexpr long SPINE = 50000;
+  WorkStealingPool pool(2);
+  auto root = RootNode::SUPPLIER.make_shared();
+  auto current = root;
+  for (long i = 1; i < SPINE; ++i) {
+    current->append_child(IntegerNode::SUPPLIER);
+    current = current->append_child(PlusNode::SUPPLIER);
+  }
+  Enter on_entry;
+  Exit on_exit;
+  ParallelTraversal<BaseAttrNode> traversal(on_entry, on_exit, pool);
+  ASSERT_EQ(TraversalStatus::CONTINUE, traversal(root));
+  ASSERT_EQ(2 * SPINE - 1, on_entry.count);
+  ASSERT_EQ(2 * SPINE - 1, on_exit.count);
+  ASSERT_EQ(0, on_exit.out_of_order);
+}
+
+TEST(ParallelTraversal, Cancel) {
+  WorkStealingPool pool(4);
+  auto root = bushy(6, 5);
+  auto cancelling = root->child(2)->child(3);
+  Enter on_entry;
+  Exit on_exit;
+  on_entry.cancel_at = cancelling.get();
+  ParallelTraversal<BaseAttrNode> traversal(on_entry, on_exit, pool, 16);
+  ASSERT_EQ(TraversalStatus::CANCEL, traversal(root));
+  ASSERT_FALSE(root->get(TestAttribute::VISITED));
+  ASSERT_FALSE(root->child(2)->get(TestAttribute::VISITED));
+  ASSERT_FALSE(cancelling->get(TestAttribute::VISITED));
+  for (size_t i = 0; i < cancelling->child_count(); ++i) {
+    ASSERT_FALSE(cancelling->child(i)->has(TestAttribute::COUNT));
+  }
+  ASSERT_LT(on_entry.count, 1 + 6 + 36 + 216 + 1296 + 7776);
+}
+
+TEST(ParallelTraversal, Exception) {
+  WorkStealingPool pool(4);
+  auto root = bushy(6, 4);
+  Enter on_entry;
+  Exit on_exit;
+  on_entry.throw_at = root->child(4)->child(1)->child(5).get();
+  ParallelTraversal<BaseAttrNode> traversal(on_entry, on_exit, pool, 8);
+  ASSERT_THROW(traversal(root), runtime_error);
+  ASSERT_FALSE(root->get(TestAttribute::VISITED));
+
+  on_entry.throw_at = nullptr;
+  ASSERT_EQ(TraversalStatus::CONTINUE, traversal(root));
+  ASSERT_TRUE(root->get(TestAttribute::VISITED));
+}
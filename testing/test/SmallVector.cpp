@@ -0,0 +1,134 @@
+/*
+ * SmallVector.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests the inline-storage vector that holds node children.
+ */
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "SmallVector.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace SmallVectorTest {
+
+template <typename C> static vector<int> contents(const C& container) {
+  vector<int> result;
+  for (const auto& element : container) {
+    result.push_back(*element);
+  }
+  return result;
+}
+
+} /* namespace SmallVectorTest */
+
+using namespace SmallVectorTest;
+
+TEST(SmallVector, InlineThenHeap) {
+  SmallVector<shared_ptr<int>, 2> small;
+  ASSERT_TRUE(small.empty());
+  ASSERT_EQ(2, small.capacity());
+  small.push_back(make_shared<int>(1));
+  small.push_back(make_shared<int>(2));
+  ASSERT_EQ(2, small.capacity());
+  small.push_back(make_shared<int>(3));
+  ASSERT_LT(2, small.capacity());
+  ASSERT_EQ(vector<int>({1, 2, 3}), contents(small));
+  ASSERT_EQ(3, *small.back());
+  small.pop_back();
+  ASSERT_EQ(vector<int>({1, 2}), contents(small));
+
+  auto shared = make_shared<int>(4);
+  small.push_back(shared);
+  ASSERT_EQ(2, shared.use_count());
+  small.clear();
+  ASSERT_EQ(1, shared.use_count());
+  ASSERT_TRUE(small.empty());
+}
+
+TEST(SmallVector, Move) {
+  SmallVector<shared_ptr<int>, 2> inline_source;
+  inline_source.push_back(make_shared<int>(1));
+  SmallVector<shared_ptr<int>, 2> inline_target(std::move(inline_source));
+  ASSERT_TRUE(inline_source.empty());
+  ASSERT_EQ(vector<int>({1}), contents(inline_target));
+
+  SmallVector<shared_ptr<int>, 2> heap_source;
+  for (int i = 0; i < 5; ++i) {
+    heap_source.push_back(make_shared<int>(i));
+  }
+  inline_target = std::move(heap_source);
+  ASSERT_TRUE(heap_source.empty());
+  ASSERT_EQ(2, heap_source.capacity());
+  ASSERT_EQ(vector<int>({0, 1, 2, 3, 4}), contents(inline_target));
+}
+
+/*
+ * Appending an element of the container itself when the container is
+ * full must not read the element after growing frees it.
+ */
+TEST(SmallVector, PushBackOwnElement) {
+  SmallVector<shared_ptr<int>, 2> copied;
+  copied.push_back(make_shared<int>(1));
+  copied.push_back(make_shared<int>(2));
+  for (int i = 0; i < 3; ++i) {
+    copied.push_back(copied[0]);
+  }
+  ASSERT_EQ(vector<int>({1, 2, 1, 1, 1}), contents(copied));
+  ASSERT_EQ(4, copied[0].use_count());
+
+  SmallVector<shared_ptr<int>, 2> moved;
+  moved.push_back(make_shared<int>(1));
+  moved.push_back(make_shared<int>(2));
+  moved.push_back(std::move(moved[0]));
+  ASSERT_FALSE(moved[0]);
+  ASSERT_EQ(1, *moved[2]);
+  moved.push_back(std::move(moved[1]));
+  moved.push_back(std::move(moved[2]));
+  ASSERT_EQ(5, moved.size());
+  ASSERT_EQ(2, *moved[3]);
+  ASSERT_EQ(1, *moved[4]);
+}
+
+/*
+ * Applies the same random inserts and erasures to a SmallVector and a
+ * std::vector and compares the results.
+ */
+TEST(SmallVector, MatchesVector) {
+  mt19937 random(17);
+  for (int trial = 0; trial < 200; ++trial) {
+    SmallVector<shared_ptr<int>, 2> small;
+    vector<shared_ptr<int>> expected;
+    int next = 0;
+    for (int step = 0; step < 20; ++step) {
+      size_t position = random() % (expected.size() + 1);
+      if (random() % 4) {
+        vector<shared_ptr<int>> to_insert;
+        for (size_t i = random() % 4; 0 < i; --i) {
+          to_insert.push_back(make_shared<int>(next++));
+        }
+        auto inserted =
+            small.insert(small.begin() + position, to_insert.begin(), to_insert.end());
+        expected.insert(expected.begin() + position, to_insert.begin(), to_insert.end());
+        ASSERT_EQ(small.begin() + position, inserted);
+      } else {
+        int modulus = 2 + random() % 3;
+        erase_if(small, [modulus](const shared_ptr<int>& e) {
+          return 0 == *e % modulus;
+        });
+        std::erase_if(expected, [modulus](const shared_ptr<int>& e) {
+          return 0 == *e % modulus;
+        });
+      }
+      ASSERT_EQ(contents(expected), contents(small));
+    }
+  }
+}
@@ -0,0 +1,178 @@
+/*
+ * StructuralHash.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests structural hashing, structural equality, and hash-consing
+ */
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "HashCombine.h"
+#include "HashConsTable.h"
+#include "IntegerNode.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace StructuralHashTest {
+
+static shared_ptr<BaseAttrNode> integer(const string& value) {
+  auto node = IntegerNode::SUPPLIER.make_shared();
+  node->put(TestAttribute::VALUE, value);
+  return node;
+}
+
+static shared_ptr<BaseAttrNode> sum(
+    shared_ptr<BaseAttrNode> lhs,
+    shared_ptr<BaseAttrNode> rhs) {
+  auto node = PlusNode::SUPPLIER.make_shared();
+  node->append_child(lhs);
+  node->append_child(rhs);
+  return node;
+}
+
+} /* namespace StructuralHashTest */
+
+using namespace StructuralHashTest;
+
+TEST(StructuralHash, EqualSubtrees) {
+  auto first = sum(integer("1"), sum(integer("2"), integer("3")));
+  auto second = sum(integer("1"), sum(integer("2"), integer("3")));
+  ASSERT_EQ(first->structural_hash(), second->structural_hash());
+  ASSERT_TRUE(first->structurally_equals(*second));
+  ASSERT_TRUE(first->structurally_equals(*first));
+
+  auto swapped = sum(sum(integer("2"), integer("3")), integer("1"));
+  ASSERT_NE(first->structural_hash(), swapped->structural_hash());
+  ASSERT_FALSE(first->structurally_equals(*swapped));
+
+  auto retyped = sum(integer("1"), sum(integer("2"), integer("3")));
+  retyped->child(1)->child(1)->put(TestAttribute::COUNT, 3);
+  ASSERT_NE(first->structural_hash(), retyped->structural_hash());
+  ASSERT_FALSE(first->structurally_equals(*retyped));
+
+  auto root = RootNode::SUPPLIER.make_shared();
+  root->append_child(PlusNode::SUPPLIER);
+  auto other_type = PlusNode::SUPPLIER.make_shared();
+  other_type->append_child(PlusNode::SUPPLIER);
+  ASSERT_FALSE(root->structurally_equals(*other_type));
+}
+
+TEST(StructuralHash, TypedValues) {
+  auto text = IntegerNode::SUPPLIER.make_shared();
+  text->put(TestAttribute::VALUE, "0");
+  auto number = IntegerNode::SUPPLIER.make_shared();
+  number->put(TestAttribute::COUNT, int64_t(0));
+  ASSERT_FALSE(text->structurally_equals(*number));
+
+  auto positive_zero = IntegerNode::SUPPLIER.make_shared();
+  positive_zero->put(TestAttribute::WEIGHT, 0.0);
+  auto negative_zero = IntegerNode::SUPPLIER.make_shared();
+  negative_zero->put(TestAttribute::WEIGHT, -0.0);
+  ASSERT_EQ(positive_zero->structural_hash(), negative_zero->structural_hash());
+  ASSERT_TRUE(positive_zero->structurally_equals(*negative_zero));
+}
+
+TEST(StructuralHash, InvalidatedByChanges) {
+  auto tree = sum(integer("1"), sum(integer("2"), integer("3")));
+  auto original = tree->structural_hash();
+  auto leaf = tree->child(1)->child(0);
+  auto leaf_hash = leaf->structural_hash();
+
+  leaf->put(TestAttribute::VALUE, "20");
+  auto changed = tree->structural_hash();
+  ASSERT_NE(original, changed);
+  ASSERT_NE(leaf_hash, leaf->structural_hash());
+  leaf->set(TestAttribute::VALUE, "2");
+  ASSERT_EQ(original, tree->structural_hash());
+
+  auto extra = tree->child(1)->append_child(IntegerNode::SUPPLIER);
+  ASSERT_NE(original, tree->structural_hash());
+  extra->detach();
+  ASSERT_EQ(original, tree->structural_hash());
+
+  tree->child(1)->excise();
+  auto flattened = sum(integer("1"), integer("2"));
+  flattened->append_child(integer("3"));
+  ASSERT_EQ(flattened->structural_hash(), tree->structural_hash());
+  ASSERT_TRUE(flattened->structurally_equals(*tree));
+
+  leaf->erase(TestAttribute::VALUE);
+  auto bare = IntegerNode::SUPPLIER.make_shared();
+  ASSERT_EQ(bare->structural_hash(), leaf->structural_hash());
+}
+
+TEST(StructuralHash, HashCons) {
+  // (1 + 2) + ((1 + 2) + 3)
+  auto tree = sum(
+      sum(integer("1"), integer("2")),
+      sum(sum(integer("1"), integer("2")), integer("3")));
+  HashConsTable<BaseAttrNode> table;
+  auto duplicates = table.intern_all(tree);
+
+  // The second (1 + 2), and its 1 and 2, duplicate the first.
+  ASSERT_EQ(3, duplicates.size());
+  auto first_sum = tree->child(0);
+  auto second_sum = tree->child(1)->child(0);
+  ASSERT_EQ(second_sum, duplicates.back().subtree);
+  ASSERT_EQ(first_sum, duplicates.back().canonical);
+  ASSERT_EQ(first_sum->child(0), duplicates[0].canonical);
+  ASSERT_EQ(second_sum->child(1), duplicates[1].subtree);
+
+  // Distinct subtrees: 1, 2, 1 + 2, 3, (1 + 2) + 3, and the whole tree
+  ASSERT_EQ(6, table.size());
+
+  auto elsewhere = sum(integer("1"), integer("2"));
+  ASSERT_EQ(first_sum, table.intern(elsewhere));
+  auto novel = sum(integer("2"), integer("1"));
+  ASSERT_EQ(novel, table.intern(novel));
+  ASSERT_EQ(7, table.size());
+  table.clear();
+  ASSERT_EQ(0, table.size());
+}
+
+TEST(StructuralHash, HashConsDuplicateChildren) {
+  // The first (1 + 2) + 3 is canonical although its 1 + 2 is a
+  // duplicate, and the second still duplicates it.
+  auto tree = RootNode::SUPPLIER.make_shared();
+  tree->append_child(sum(integer("1"), integer("2")));
+  tree->append_child(sum(sum(integer("1"), integer("2")), integer("3")));
+  tree->append_child(sum(sum(integer("1"), integer("2")), integer("3")));
+  HashConsTable<BaseAttrNode> table;
+  auto duplicates = table.intern_all(tree);
+  ASSERT_EQ(tree->child(2), duplicates.back().subtree);
+  ASSERT_EQ(tree->child(1), duplicates.back().canonical);
+  // 1, 2, 1 + 2, 3, (1 + 2) + 3, and the whole tree
+  ASSERT_EQ(6, table.size());
+}
+
+TEST(StructuralHash, HashConsDeepDuplicates) {
+  // Two equal chains: interning compares each node one level deep.
+  constexpr int DEPTH = 8000;
+  auto tree = RootNode::SUPPLIER.make_shared();
+  for (int i = 0; i < 2; ++i) {
+    auto current = tree->append_child(PlusNode::SUPPLIER);
+    for (int d = 1; d < DEPTH; ++d) {
+      current = current->append_child(PlusNode::SUPPLIER);
+    }
+  }
+  HashConsTable<BaseAttrNode> table;
+  auto duplicates = table.intern_all(tree);
+  ASSERT_EQ(DEPTH, duplicates.size());
+  ASSERT_EQ(tree->child(0), duplicates.back().canonical);
+  ASSERT_EQ(DEPTH + 1, table.size());
+}
+
+TEST(StructuralHash, CombineIsNotASum) {
+  ASSERT_NE(hash_combine(1, 2), hash_combine(2, 1));
+  ASSERT_NE(hash_combine(0, 3), hash_combine(1, 2));
+}
@@ -0,0 +1,155 @@
+/*
+ * Teardown.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests iterative and deferred tree destruction
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+#include "TreeReclaimer.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace TeardownTest {
+
+static shared_ptr<BaseAttrNode> chain(long depth) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  auto current = root;
+  for (long i = 1; i < depth; ++i) {
+    current = current->append_child(PlusNode::SUPPLIER);
+  }
+  return root;
+}
+
+static shared_ptr<BaseAttrNode> bushy(int fanout, int depth) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  vector<shared_ptr<BaseAttrNode>> level = {root};
+  for (int d = 0; d < depth; ++d) {
+    vector<shared_ptr<BaseAttrNode>> next_level;
+    for (auto& node : level) {
+      for (int i = 0; i < fanout; ++i) {
+        next_level.push_back(node->append_child(PlusNode::SUPPLIER));
+      }
+    }
+    level = std::move(next_level);
+  }
+  return root;
+}
+
+/*
+ * Records the number of children it has when its destructor runs.
+ */
+class WitnessNode : public BaseAttrNode {
+  class WitnessSupplier : public BaseAttrNodeSupplier {
+  public:
+    WitnessSupplier(void) :
+        BaseAttrNodeSupplier("WitnessNode") {
+    }
+
+    virtual shared_ptr<BaseAttrNode> make_shared(void) override {
+      return std::make_shared<WitnessNode>();
+    }
+  };
+
+public:
+  static WitnessSupplier SUPPLIER;
+  static vector<size_t> child_counts;
+
+  virtual ~WitnessNode() {
+    child_counts.push_back(child_count());
+  }
+
+  virtual Supplier<BaseAttrNode>& supplier(void) override {
+    return SUPPLIER;
+  }
+};
+
+WitnessNode::WitnessSupplier WitnessNode::SUPPLIER;
+vector<size_t> WitnessNode::child_counts;
+
+} /* namespace TeardownTest */
+
+using namespace TeardownTest;
+
+TEST(Teardown, DeepChain) {
+  auto root = chain(1000000);
+  weak_ptr<BaseAttrNode> tail = root;
+  while (tail.lock()->has_children()) {
+    tail = tail.lock()->child(0);
+  }
+  root.reset();
+  ASSERT_TRUE(tail.expired());
+}
+
+TEST(Teardown, DestructorsSeeChildren) {
+  constexpr size_t DEPTH = 100000;
+  auto root = WitnessNode::SUPPLIER.make_shared();
+  auto current = root;
+  for (size_t i = 1; i < DEPTH; ++i) {
+    current = current->append_child(WitnessNode::SUPPLIER);
+  }
+  for (int i = 0; i < 3; ++i) {
+    current->append_child(WitnessNode::SUPPLIER);
+  }
+  current.reset();
+  WitnessNode::child_counts.clear();
+  root.reset();
+
+  ASSERT_EQ(DEPTH + 3, WitnessNode::child_counts.size());
+  ASSERT_EQ(3, count(
+      WitnessNode::child_counts.begin(), WitnessNode::child_counts.end(), 0));
+  ASSERT_EQ(DEPTH - 1, count(
+      WitnessNode::child_counts.begin(), WitnessNode::child_counts.end(), 1));
+  ASSERT_EQ(1, count(
+      WitnessNode::child_counts.begin(), WitnessNode::child_counts.end(), 3));
+}
+
+TEST(Teardown, SharedDescendantsSurvive) {
+  auto root = bushy(3, 3);
+  auto survivor = root->child(1)->child(2);
+  survivor->set(TestAttribute::VALUE, "survivor");
+  weak_ptr<BaseAttrNode> grandchild = survivor->child(0);
+  weak_ptr<BaseAttrNode> sibling = root->child(1)->child(1);
+  root.reset();
+
+  ASSERT_TRUE(sibling.expired());
+  ASSERT_TRUE(survivor->is_root());
+  ASSERT_EQ("survivor", survivor->get(TestAttribute::VALUE));
+  ASSERT_EQ(3, survivor->child_count());
+  ASSERT_FALSE(grandchild.expired());
+  ASSERT_EQ(survivor, grandchild.lock()->parent());
+}
+
+TEST(Teardown, Reclaimer) {
+  TreeReclaimer reclaimer;
+  auto deep = chain(1000000);
+  auto wide = bushy(10, 5);
+  weak_ptr<BaseAttrNode> deep_reference = deep;
+  weak_ptr<BaseAttrNode> wide_reference = wide;
+  auto leaf = wide->child(9)->child(9);
+
+  reclaimer.reclaim(std::move(deep));
+  reclaimer.reclaim(std::move(wide));
+  ASSERT_FALSE(deep);
+  ASSERT_FALSE(wide);
+  reclaimer.drain();
+  ASSERT_TRUE(deep_reference.expired());
+  ASSERT_TRUE(wide_reference.expired());
+  ASSERT_TRUE(leaf->is_root());
+  ASSERT_EQ(10, leaf->child_count());
+
+  reclaimer.reclaim(std::move(leaf));
+}
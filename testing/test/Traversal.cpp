@@ -15,6 +15,8 @@
 #include "gtest/gtest.h"
 
 #include "BaseAttrNodeTraversal.h"
+#include "BorrowedNodeAction.h"
+#include "BorrowingTraversal.h"
 #include "IntegerNode.h"
 #include "MinusNode.h"
 #include "OperatorNode.h"
@@ -31,7 +33,7 @@
 using namespace VisitingParseTree;
 using namespace std;
 
-static TraversalStatus entry_status_of(shared_ptr<BaseAttrNode> node) {
+static TraversalStatus entry_status_of(BaseAttrNode *node) {
   if (node->has(TestAttribute::CANCEL_ON_ENTRY)) {
     return TraversalStatus::CANCEL;
   }
@@ -41,7 +43,7 @@ static TraversalStatus entry_status_of(shared_ptr<BaseAttrNode> node) {
   return TraversalStatus::CONTINUE;
 }
 
-static TraversalStatus exit_status_of(shared_ptr<BaseAttrNode> node) {
+static TraversalStatus exit_status_of(BaseAttrNode *node) {
   if (node->has(TestAttribute::CANCEL_ON_EXIT)) {
     return TraversalStatus::CANCEL;
   }
@@ -58,11 +60,11 @@ class TraversalContext {
   vector<pair<string, int>> entries_;
   vector<pair<string, int>> exits_;
 public:
-  void enter(shared_ptr<BaseAttrNode> node) {
+  void enter(BaseAttrNode *node) {
     entries_.emplace_back(node->get(TestAttribute::SERIAL_NO), level_);
   }
 
-  void exit(shared_ptr<BaseAttrNode> node) {
+  void exit(BaseAttrNode *node) {
     exits_.emplace_back(node->get(TestAttribute::SERIAL_NO), level_);
   }
 
@@ -81,6 +83,10 @@ public:
   void ascend() {
     --level_;
   }
+
+  int level() const {
+    return level_;
+  }
 };
 
 class AscendFunction : public VoidFunction {
@@ -112,8 +118,8 @@ public:
     context_(context) {}
 
   virtual TraversalStatus operator()(shared_ptr<BaseAttrNode> node) override {
-    context_.enter(node);
-    return entry_status_of(node);
+    context_.enter(node.get());
+    return entry_status_of(node.get());
   }
 };
 
@@ -124,11 +130,49 @@ public:
     context_(context) {}
 
   virtual TraversalStatus operator()(shared_ptr<BaseAttrNode> node) override {
+    context_.exit(node.get());
+    return exit_status_of(node.get());
+  }
+};
+
+class BorrowedEnter : public BorrowedNodeAction<BaseAttrNode> {
+  TraversalContext& context_;
+public:
+  BorrowedEnter(TraversalContext& context) :
+    context_(context) {}
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
+    context_.enter(node);
+    return entry_status_of(node);
+  }
+};
+
+class BorrowedExit : public BorrowedNodeAction<BaseAttrNode> {
+  TraversalContext& context_;
+public:
+  BorrowedExit(TraversalContext& context) :
+    context_(context) {}
+
+  virtual TraversalStatus operator()(BaseAttrNode *node) override {
     context_.exit(node);
     return exit_status_of(node);
   }
 };
 
+/*
+ * Builds a degenerate tree: a chain of the specified depth.
+ */
+static shared_ptr<BaseAttrNode> chain(size_t depth) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  root->set(TestAttribute::SERIAL_NO, "0");
+  auto current = root;
+  for (size_t i = 1; i < depth; ++i) {
+    current = current->append_child(PlusNode::SUPPLIER);
+    current->set(TestAttribute::SERIAL_NO, to_string(i));
+  }
+  return root;
+}
+
 };/* namespace TraversalTest */
 
 using namespace TraversalTest;
@@ -276,3 +320,110 @@ TEST(Traversal, CancelOnExit) {
   ASSERT_EQ(context.entries(), expected_entries);
   ASSERT_EQ(context.exits(), expected_exits);
 }
+
+TEST(Traversal, DeepChain) {
+  constexpr size_t DEPTH = 250000;
+  TraversalContext context;
+  AscendFunction on_ascent(context);
+  DescendFunction on_descent(context);
+  Enter on_entry(context);
+  Exit on_exit(context);
+  BaseAttrNodeTraversal traversal(on_entry, on_exit, on_descent, on_ascent);
+
+  auto root = chain(DEPTH);
+  ASSERT_EQ(TraversalStatus::CONTINUE, traversal(root));
+  ASSERT_EQ(DEPTH, context.entries().size());
+  ASSERT_EQ(DEPTH, context.exits().size());
+  ASSERT_EQ(0, context.level());
+  ASSERT_EQ(make_pair(to_string(DEPTH - 1), static_cast<int>(DEPTH - 1)),
+      context.entries().back());
+  ASSERT_EQ(context.entries().back(), context.exits().front());
+  ASSERT_EQ(make_pair(string("0"), 0), context.exits().back());
+}
+
+TEST(Traversal, CancelDeepChain) {
+  constexpr size_t DEPTH = 250000;
+  TraversalContext context;
+  AscendFunction on_ascent(context);
+  DescendFunction on_descent(context);
+  Enter on_entry(context);
+  Exit on_exit(context);
+  BaseAttrNodeTraversal traversal(on_entry, on_exit, on_descent, on_ascent);
+
+  auto root = chain(DEPTH);
+  auto deepest = root;
+  while (deepest->has_children()) {
+    deepest = deepest->child(0);
+  }
+  deepest->set(TestAttribute::CANCEL_ON_EXIT, "Yes");
+  ASSERT_EQ(TraversalStatus::CANCEL, traversal(root));
+  ASSERT_EQ(DEPTH, context.entries().size());
+  ASSERT_EQ(1, context.exits().size());
+  ASSERT_EQ(0, context.level());
+}
+
+/*
+ * Runs shared and borrowing traversals over the same tree, and
+ * verifies that they behave identically.
+ */
+static void compare_traversals(shared_ptr<BaseAttrNode> root) {
+  TraversalContext shared_context;
+  AscendFunction shared_on_ascent(shared_context);
+  DescendFunction shared_on_descent(shared_context);
+  Enter shared_on_entry(shared_context);
+  Exit shared_on_exit(shared_context);
+  BaseAttrNodeTraversal shared_traversal(
+      shared_on_entry, shared_on_exit, shared_on_descent, shared_on_ascent);
+
+  TraversalContext borrowed_context;
+  AscendFunction borrowed_on_ascent(borrowed_context);
+  DescendFunction borrowed_on_descent(borrowed_context);
+  BorrowedEnter borrowed_on_entry(borrowed_context);
+  BorrowedExit borrowed_on_exit(borrowed_context);
+  BorrowingTraversal<BaseAttrNode> borrowing_traversal(
+      borrowed_on_entry,
+      borrowed_on_exit,
+      borrowed_on_descent,
+      borrowed_on_ascent);
+
+  ASSERT_EQ(shared_traversal(root), borrowing_traversal(root));
+  ASSERT_EQ(shared_context.entries(), borrowed_context.entries());
+  ASSERT_EQ(shared_context.exits(), borrowed_context.exits());
+  ASSERT_EQ(shared_context.level(), borrowed_context.level());
+}
+
+TEST(Traversal, Borrowing) {
+  compare_traversals(TestTrees::simple_addition());
+  compare_traversals(TestTrees::bypass_on_entry());
+  compare_traversals(TestTrees::bypass_on_exit());
+  compare_traversals(TestTrees::cancel_on_entry());
+  compare_traversals(TestTrees::cancel_on_exit());
+}
+
+TEST(Traversal, BorrowingLeavesReferenceCountsAlone) {
+  class CountReferences : public BorrowedNodeAction<BaseAttrNode> {
+  public:
+    vector<long> counts;
+
+    virtual TraversalStatus operator()(BaseAttrNode *node) override {
+      counts.push_back(node->weak_from_this().use_count());
+      return TraversalStatus::CONTINUE;
+    }
+  };
+
+  auto root = TestTrees::simple_addition();
+  CountReferences on_entry;
+  CountReferences on_exit;
+  BorrowingTraversal<BaseAttrNode> traversal(
+      on_entry,
+      on_exit,
+      VacuousVoidFunction::INSTANCE,
+      VacuousVoidFunction::INSTANCE);
+  ASSERT_EQ(TraversalStatus::CONTINUE, traversal(root));
+  ASSERT_EQ(vector<long>({1, 1, 1, 1}), on_entry.counts);
+  ASSERT_EQ(on_entry.counts, on_exit.counts);
+
+  CountReferences per_child;
+  ASSERT_EQ(TraversalStatus::CONTINUE, root->child(0)->for_each_child(per_child));
+  ASSERT_EQ(vector<long>({1, 1}), per_child.counts);
+}
@@ -0,0 +1,85 @@
+/*
+ * TreeBuilder.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests building trees from open, attribute, and close events.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "IllegalOperation.h"
+#include "IntegerNode.h"
+#include "NodeArena.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+#include "TestTrees.h"
+#include "TreeBuilder.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+TEST(TreeBuilder, MatchesAppending) {
+  TreeBuilder<BaseAttrNode> builder;
+  builder.open(RootNode::SUPPLIER)
+      .attr(TestAttribute::SERIAL_NO, "1")
+      .open(PlusNode::SUPPLIER, 2)
+          .attr(TestAttribute::SERIAL_NO, "2")
+          .open(IntegerNode::SUPPLIER)
+              .attr(TestAttribute::SERIAL_NO, "3")
+              .attr(TestAttribute::VALUE, string("137"))
+          .close()
+          .open(IntegerNode::SUPPLIER)
+              .attr(TestAttribute::SERIAL_NO, "4")
+              .attr(TestAttribute::VALUE, "314")
+          .close()
+      .close();
+  ASSERT_EQ(1, builder.depth());
+  builder.close();
+  ASSERT_EQ(0, builder.depth());
+  auto tree = builder.finish();
+  ASSERT_TRUE(tree->structurally_equals(*TestTrees::simple_addition()));
+
+  auto sum = tree->child(0);
+  ASSERT_EQ(tree, sum->parent());
+  ASSERT_EQ(1, sum->child(1)->child_index());
+  ASSERT_EQ(sum->child(0), sum->child(1)->previous_sibling());
+
+  // The builder can be reused.
+  auto leaf = builder.open(IntegerNode::SUPPLIER)
+      .attr(TestAttribute::COUNT, int64_t(7))
+      .close()
+      .finish();
+  ASSERT_EQ(7, leaf->get(TestAttribute::COUNT));
+  ASSERT_TRUE(leaf->is_root());
+}
+
+TEST(TreeBuilder, Arena) {
+  auto arena = NodeArena::make_shared();
+  TreeBuilder<BaseAttrNode> builder(*arena);
+  builder.open(RootNode::SUPPLIER);
+  for (int i = 0; i < 100; ++i) {
+    builder.open(IntegerNode::SUPPLIER).close();
+  }
+  auto tree = builder.close().finish();
+  ASSERT_EQ(100, tree->child_count());
+}
+
+TEST(TreeBuilder, Misuse) {
+  TreeBuilder<BaseAttrNode> builder;
+  ASSERT_THROW(builder.close(), IllegalOperation);
+  ASSERT_THROW(builder.attr(TestAttribute::NAME, "x"), IllegalOperation);
+  ASSERT_THROW(builder.finish(), IllegalOperation);
+  builder.open(RootNode::SUPPLIER);
+  ASSERT_THROW(builder.finish(), IllegalOperation);
+  builder.close();
+  ASSERT_THROW(builder.open(IntegerNode::SUPPLIER), IllegalOperation);
+  ASSERT_TRUE(builder.finish());
+}
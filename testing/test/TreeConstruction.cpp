@@ -5,7 +5,9 @@
  *      Author: Eric Mintz
  */
 
+#include <algorithm>
 #include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -228,3 +230,198 @@ TEST(TreeConstruction, Excise) {
   ASSERT_STREQ("Second Grandchild", root->child(2)->get(TestAttribute::NAME).c_str());
   ASSERT_STREQ("Youngest Child", root->child(3)->get(TestAttribute::NAME).c_str());
 }
+
+TEST(TreeConstruction, Siblings) {
+  auto root = AttributedTestNode::SUPPLIER.make_shared();
+  auto first_child = root->append_child(AttributedTestNode::SUPPLIER);
+  auto middle_child = root->append_child(AttributedTestNode::SUPPLIER);
+  auto last_child = root->append_child(AttributedTestNode::SUPPLIER);
+  ASSERT_FALSE(root->next_sibling());
+  ASSERT_FALSE(root->previous_sibling());
+  ASSERT_EQ(middle_child, first_child->next_sibling());
+  ASSERT_EQ(last_child, middle_child->next_sibling());
+  ASSERT_FALSE(last_child->next_sibling());
+  ASSERT_FALSE(first_child->previous_sibling());
+  ASSERT_EQ(first_child, middle_child->previous_sibling());
+  ASSERT_EQ(middle_child, last_child->previous_sibling());
+
+  middle_child->detach();
+  ASSERT_EQ(last_child, first_child->next_sibling());
+  ASSERT_EQ(first_child, last_child->previous_sibling());
+  ASSERT_FALSE(middle_child->next_sibling());
+  ASSERT_FALSE(middle_child->previous_sibling());
+}
+
+TEST(TreeConstruction, DetachAllFromWideNode) {
+  constexpr size_t WIDTH = 100000;
+  auto root = AttributedTestNode::SUPPLIER.make_shared();
+  vector<shared_ptr<BaseAttrNode>> children;
+  for (size_t i = 0; i < WIDTH; ++i) {
+    children.push_back(root->append_child(AttributedTestNode::SUPPLIER));
+  }
+  ASSERT_EQ(WIDTH, root->child_count());
+
+  for (size_t i = 0; i < WIDTH; ++i) {
+    children[i]->detach();
+    ASSERT_TRUE(children[i]->is_root());
+  }
+  ASSERT_EQ(0, root->child_count());
+  ASSERT_TRUE(root->is_leaf());
+
+  for (auto& child : children) {
+    root->append_child(child);
+  }
+  for (size_t i = WIDTH; 0 < i; --i) {
+    children[i - 1]->detach();
+  }
+  ASSERT_TRUE(root->is_leaf());
+
+  for (auto& child : children) {
+    root->append_child(child);
+  }
+  for (size_t i = 0; i < WIDTH; i += 2) {
+    children[i]->detach();
+  }
+  ASSERT_EQ(WIDTH / 2, root->child_count());
+  for (size_t i = 1; i < WIDTH; i += 2) {
+    ASSERT_EQ(root, children[i]->parent());
+    ASSERT_EQ(children[i], *children[i]->find_in_parent());
+  }
+  for (size_t i = 0; i < WIDTH / 2; ++i) {
+    ASSERT_EQ(children[2 * i + 1], root->child(i));
+  }
+  Gather gather;
+  root->for_each_child(gather);
+  ASSERT_EQ(WIDTH / 2, gather().size());
+  ASSERT_EQ(children[1], gather()[0]);
+  ASSERT_EQ(children[WIDTH - 1], gather().back());
+}
+
+/*
+ * Detaching children in swapped pairs (1, 0, 3, 2, ...) alternately
+ * opens a vacancy between children and closes the gap at the front.
+ * The node must keep its slot index across the gaps closing rather
+ * than rebuild it for every pair.
+ */
+TEST(TreeConstruction, DetachInterleavedFromWideNode) {
+  constexpr size_t WIDTH = 100000;
+  auto root = AttributedTestNode::SUPPLIER.make_shared();
+  vector<shared_ptr<BaseAttrNode>> children;
+  for (size_t i = 0; i < WIDTH; ++i) {
+    children.push_back(root->append_child(AttributedTestNode::SUPPLIER));
+  }
+
+  for (size_t i = 0; i < WIDTH; i += 2) {
+    children[i + 1]->detach();
+    ASSERT_EQ(children[i], root->child(0));
+    ASSERT_EQ(i + 2 < WIDTH ? children[i + 2] : nullptr,
+        children[i]->next_sibling());
+    children[i]->detach();
+    ASSERT_EQ(WIDTH - i - 2, root->child_count());
+    if (i + 2 < WIDTH) {
+      ASSERT_EQ(children[i + 2], root->child(0));
+      ASSERT_EQ(0, children[i + 2]->child_index());
+      ASSERT_EQ(children[WIDTH - 1], root->child(WIDTH - i - 3));
+      ASSERT_FALSE(children[i + 2]->previous_sibling());
+      ASSERT_EQ(children[i + 3], children[i + 2]->next_sibling());
+    }
+  }
+  ASSERT_TRUE(root->is_leaf());
+
+  // The kept index must follow children appended afterwards.
+  for (size_t i = 0; i < 64; ++i) {
+    root->append_child(children[i]);
+  }
+  children[5]->detach();
+  ASSERT_EQ(63, root->child_count());
+  ASSERT_EQ(children[6], root->child(5));
+  ASSERT_EQ(children[6], children[4]->next_sibling());
+  ASSERT_EQ(62, children[63]->child_index());
+}
+
+TEST(TreeConstruction, ExciseAfterDetach) {
+  auto root = AttributedTestNode::SUPPLIER.make_shared();
+  auto first_child = root->append_child(AttributedTestNode::SUPPLIER);
+  auto detached_child = root->append_child(AttributedTestNode::SUPPLIER);
+  auto excised_child = root->append_child(AttributedTestNode::SUPPLIER);
+  auto grandchild = excised_child->append_child(AttributedTestNode::SUPPLIER);
+  auto last_child = root->append_child(AttributedTestNode::SUPPLIER);
+  detached_child->detach();
+  excised_child->excise();
+  ASSERT_EQ(3, root->child_count());
+  ASSERT_EQ(first_child, root->child(0));
+  ASSERT_EQ(grandchild, root->child(1));
+  ASSERT_EQ(last_child, root->child(2));
+  ASSERT_EQ(root, grandchild->parent());
+  ASSERT_EQ(grandchild, *grandchild->find_in_parent());
+  ASSERT_EQ(last_child, *last_child->find_in_parent());
+  ASSERT_EQ(last_child, grandchild->next_sibling());
+  ASSERT_TRUE(excised_child->is_root());
+  ASSERT_TRUE(excised_child->is_leaf());
+  last_child->detach();
+  first_child->detach();
+  ASSERT_EQ(1, root->child_count());
+  ASSERT_EQ(grandchild, root->child(0));
+}
+
+/*
+ * Detaching children in random order opens vacancies between the
+ * remaining children. Positional reads and sibling lookups must skip
+ * them without compacting the child vector.
+ */
+TEST(TreeConstruction, ReadWhileDetachingFromWideNode) {
+  constexpr size_t WIDTH = 20000;
+  auto root = AttributedTestNode::SUPPLIER.make_shared();
+  vector<shared_ptr<BaseAttrNode>> remaining;
+  for (size_t i = 0; i < WIDTH; ++i) {
+    remaining.push_back(root->append_child(AttributedTestNode::SUPPLIER));
+  }
+  vector<shared_ptr<BaseAttrNode>> order(remaining);
+  shuffle(order.begin(), order.end(), mt19937(17));
+
+  auto verify = [&](size_t index) {
+    auto child = root->child(index);
+    ASSERT_EQ(remaining[index], child);
+    ASSERT_EQ(index, child->child_index());
+    ASSERT_EQ(
+        index + 1 < remaining.size() ? remaining[index + 1] : nullptr,
+        child->next_sibling());
+    ASSERT_EQ(
+        0 < index ? remaining[index - 1] : nullptr,
+        child->previous_sibling());
+  };
+
+  for (size_t i = 0; i < WIDTH - 1; ++i) {
+    auto& detached = order[i];
+    size_t index = detached->child_index();
+    ASSERT_EQ(detached, remaining[index]);
+    detached->detach();
+    remaining.erase(remaining.begin() + index);
+    ASSERT_EQ(remaining.size(), root->child_count());
+    verify(min(index, remaining.size() - 1));
+    verify(i % remaining.size());
+    if (0 == i % 4000) {
+      for (size_t j = 0; j < remaining.size(); ++j) {
+        verify(j);
+      }
+    }
+  }
+  verify(0);
+
+  // Excising a child among vacancies promotes its children in place.
+  for (size_t i = 0; i < 64; ++i) {
+    remaining.push_back(root->append_child(AttributedTestNode::SUPPLIER));
+  }
+  for (size_t i = 2; i < 64; i += 3) {
+    remaining[i]->detach();
+  }
+  erase_if(remaining, [](auto& child) { return child->is_root(); });
+  auto excised = remaining[10];
+  auto grandchild = excised->append_child(AttributedTestNode::SUPPLIER);
+  excised->excise();
+  remaining[10] = grandchild;
+  ASSERT_EQ(remaining.size(), root->child_count());
+  for (size_t j = 0; j < remaining.size(); ++j) {
+    verify(j);
+  }
+}
@@ -0,0 +1,235 @@
+/*
+ * TreeDiff.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests tree matching and edit scripts.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "IntegerNode.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+#include "TimesNode.h"
+#include "TreeDiff.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace TreeDiffTest {
+
+using Kind = TreeDiff::EditKind;
+
+static shared_ptr<BaseAttrNode> integer(const string& value) {
+  auto node = IntegerNode::SUPPLIER.make_shared();
+  node->put(TestAttribute::VALUE, value);
+  return node;
+}
+
+static shared_ptr<BaseAttrNode> node(
+    Supplier<BaseAttrNode>& supplier,
+    const vector<shared_ptr<BaseAttrNode>>& children) {
+  auto result = supplier.make_shared();
+  for (auto& child : children) {
+    result->append_child(child);
+  }
+  return result;
+}
+
+static shared_ptr<BaseAttrNode> sum(
+    shared_ptr<BaseAttrNode> lhs,
+    shared_ptr<BaseAttrNode> rhs) {
+  return node(PlusNode::SUPPLIER, {lhs, rhs});
+}
+
+static shared_ptr<BaseAttrNode> product(
+    shared_ptr<BaseAttrNode> lhs,
+    shared_ptr<BaseAttrNode> rhs) {
+  return node(TimesNode::SUPPLIER, {lhs, rhs});
+}
+
+/*
+ * Verifies that the matching is one to one and pairs nodes of the
+ * same type, and that the script inserts and deletes exactly the
+ * unmatched nodes.
+ */
+static void assert_consistent(const TreeDiff& diff) {
+  size_t deletions = 0;
+  size_t insertions = 0;
+  for (auto& edit : diff.edits()) {
+    deletions += Kind::DELETE == edit.kind;
+    insertions += Kind::INSERT == edit.kind;
+  }
+  size_t unmatched = 0;
+  for (size_t o = 0; o < diff.old_tree().size(); ++o) {
+    size_t n = diff.new_counterpart(o);
+    if (TreeDiff::NO_NODE == n) {
+      ++unmatched;
+      continue;
+    }
+    ASSERT_EQ(o, diff.old_counterpart(n));
+    ASSERT_EQ(diff.old_tree().supplier(o), diff.new_tree().supplier(n));
+  }
+  ASSERT_EQ(unmatched, deletions);
+  unmatched = 0;
+  for (size_t n = 0; n < diff.new_tree().size(); ++n) {
+    unmatched += TreeDiff::NO_NODE == diff.old_counterpart(n);
+  }
+  ASSERT_EQ(unmatched, insertions);
+}
+
+/*
+ * Builds a complete binary tree of sums of the specified depth whose
+ * leaves all hold the specified value.
+ */
+static shared_ptr<BaseAttrNode> balanced(int depth, const string& leaf_value) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  vector<shared_ptr<BaseAttrNode>> level = {root};
+  for (int d = 0; d < depth; ++d) {
+    vector<shared_ptr<BaseAttrNode>> next_level;
+    for (auto& parent : level) {
+      for (int i = 0; i < 2; ++i) {
+        next_level.push_back(d + 1 < depth
+            ? parent->append_child(PlusNode::SUPPLIER)
+            : parent->append_child(integer(leaf_value)));
+      }
+    }
+    level = std::move(next_level);
+  }
+  return root;
+}
+
+} /* namespace TreeDiffTest */
+
+using namespace TreeDiffTest;
+
+TEST(TreeDiff, Identical) {
+  auto diff = TreeDiff::compare(
+      node(RootNode::SUPPLIER, {sum(integer("1"), integer("2"))}),
+      node(RootNode::SUPPLIER, {sum(integer("1"), integer("2"))}));
+  ASSERT_TRUE(diff.edits().empty());
+  for (size_t n = 0; n < diff.new_tree().size(); ++n) {
+    ASSERT_EQ(n, diff.old_counterpart(n));
+  }
+  assert_consistent(diff);
+}
+
+TEST(TreeDiff, Update) {
+  auto diff = TreeDiff::compare(
+      node(RootNode::SUPPLIER, {sum(integer("1"), integer("2"))}),
+      node(RootNode::SUPPLIER, {sum(integer("1"), integer("3"))}));
+  vector<TreeDiff::Edit> expected = {{Kind::UPDATE, 3, 3}};
+  ASSERT_EQ(expected, diff.edits());
+  assert_consistent(diff);
+
+  // Every leaf changes, so only the structure anchors the matching.
+  diff = TreeDiff::compare(
+      node(RootNode::SUPPLIER, {sum(integer("1"), integer("2"))}),
+      node(RootNode::SUPPLIER, {sum(integer("4"), integer("5"))}));
+  expected = {{Kind::UPDATE, 2, 2}, {Kind::UPDATE, 3, 3}};
+  ASSERT_EQ(expected, diff.edits());
+  assert_consistent(diff);
+}
+
+TEST(TreeDiff, InsertAndDelete) {
+  auto smaller = node(RootNode::SUPPLIER, {sum(integer("1"), integer("2"))});
+  auto larger = node(
+      RootNode::SUPPLIER,
+      {sum(integer("1"), integer("2")), product(integer("4"), integer("5"))});
+
+  auto diff = TreeDiff::compare(smaller, larger);
+  vector<TreeDiff::Edit> expected = {
+      {Kind::INSERT, TreeDiff::NO_NODE, 4},
+      {Kind::INSERT, TreeDiff::NO_NODE, 5},
+      {Kind::INSERT, TreeDiff::NO_NODE, 6},
+  };
+  ASSERT_EQ(expected, diff.edits());
+  assert_consistent(diff);
+
+  diff = TreeDiff::compare(larger, smaller);
+  expected = {
+      {Kind::DELETE, 4, TreeDiff::NO_NODE},
+      {Kind::DELETE, 5, TreeDiff::NO_NODE},
+      {Kind::DELETE, 6, TreeDiff::NO_NODE},
+  };
+  ASSERT_EQ(expected, diff.edits());
+  assert_consistent(diff);
+}
+
+TEST(TreeDiff, Reorder) {
+  auto diff = TreeDiff::compare(
+      node(
+          RootNode::SUPPLIER,
+          {sum(integer("1"), integer("2")), product(integer("3"), integer("4"))}),
+      node(
+          RootNode::SUPPLIER,
+          {product(integer("3"), integer("4")), sum(integer("1"), integer("2"))}));
+  ASSERT_EQ(1, diff.edits().size());
+  ASSERT_EQ(Kind::MOVE, diff.edits()[0].kind);
+  assert_consistent(diff);
+}
+
+TEST(TreeDiff, MoveToNewParent) {
+  // (1 + 2) (3 * 4) becomes (1 + 2 + (3 * 4))
+  auto before = node(
+      RootNode::SUPPLIER,
+      {sum(integer("1"), integer("2")), product(integer("3"), integer("4"))});
+  auto after = node(RootNode::SUPPLIER, {sum(integer("1"), integer("2"))});
+  after->child(0)->append_child(product(integer("3"), integer("4")));
+  auto diff = TreeDiff::compare(before, after);
+  vector<TreeDiff::Edit> expected = {{Kind::MOVE, 4, 4}};
+  ASSERT_EQ(expected, diff.edits());
+  assert_consistent(diff);
+}
+
+TEST(TreeDiff, RepeatedSubtrees) {
+  // Identical leaves everywhere: no subtree is unique.
+  auto before = node(
+      RootNode::SUPPLIER,
+      {sum(integer("1"), integer("1")), sum(integer("1"), integer("1"))});
+  auto after = node(
+      RootNode::SUPPLIER,
+      {sum(integer("1"), integer("1")),
+       sum(integer("1"), integer("1")),
+       sum(integer("1"), integer("1"))});
+  auto diff = TreeDiff::compare(before, after);
+  vector<TreeDiff::Edit> expected = {
+      {Kind::INSERT, TreeDiff::NO_NODE, 7},
+      {Kind::INSERT, TreeDiff::NO_NODE, 8},
+      {Kind::INSERT, TreeDiff::NO_NODE, 9},
+  };
+  ASSERT_EQ(expected, diff.edits());
+  assert_consistent(diff);
+}
+
+TEST(TreeDiff, EditAmongRepeatedSiblings) {
+  // Every sibling has an identical twin, so only position tells an
+  // unchanged sibling from the partner of its edited twin.
+  auto before = balanced(3, "1");
+  auto after = balanced(3, "1");
+  after->child(0)->child(1)->child(0)->set(TestAttribute::VALUE, "changed");
+  auto diff = TreeDiff::compare(before, after);
+  vector<TreeDiff::Edit> expected = {{Kind::UPDATE, 6, 6}};
+  ASSERT_EQ(expected, diff.edits());
+  assert_consistent(diff);
+
+  before = balanced(12, "1");
+  after = before->deep_clone();
+  auto leaf = after;
+  for (int d = 0; d < 12; ++d) {
+    leaf = leaf->child(d % 2);
+  }
+  leaf->set(TestAttribute::VALUE, "changed");
+  diff = TreeDiff::compare(before, after);
+  ASSERT_EQ(1, diff.edits().size());
+  ASSERT_EQ(Kind::UPDATE, diff.edits()[0].kind);
+  assert_consistent(diff);
+}
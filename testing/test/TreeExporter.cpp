@@ -0,0 +1,203 @@
+/*
+ * TreeExporter.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Tests the DOT and JSON exporters: their formats, escaping, subtree
+ * and depth-limited export, and buffered output.
+ */
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "BaseAttrNode.h"
+#include "ByteSink.h"
+#include "DotExporter.h"
+#include "IntegerNode.h"
+#include "InternPool.h"
+#include "JsonExporter.h"
+#include "PlusNode.h"
+#include "RootNode.h"
+#include "TestAttribute.h"
+#include "TestTrees.h"
+#include "TreeBuilder.h"
+
+using namespace std;
+using namespace VisitingParseTree;
+
+namespace TreeExporterTest {
+
+/*
+ * Counts the bytes written to it, and records the largest write.
+ */
+class CountingSink : public ByteSink {
+public:
+  size_t size = 0;
+  size_t largest_write = 0;
+
+  virtual void write(
+      span<const span<const unsigned char>> buffers) override {
+    size_t written = 0;
+    for (const auto& buffer : buffers) {
+      written += buffer.size();
+    }
+    size += written;
+    largest_write = max(largest_write, written);
+  }
+};
+
+template <typename E> static string export_tree(
+    shared_ptr<BaseAttrNode> root,
+    size_t max_depth = TreeExporter::UNLIMITED) {
+  ostringstream out;
+  E exporter(out);
+  exporter.set_max_depth(max_depth);
+  exporter.write(root);
+  return out.str();
+}
+
+/*
+ * A root with sum_count sums of leaves_per_sum leaves each.
+ */
+static shared_ptr<BaseAttrNode> sums(int sum_count, int leaves_per_sum) {
+  TreeBuilder<BaseAttrNode> builder;
+  builder.open(RootNode::SUPPLIER, sum_count);
+  for (int i = 0; i < sum_count; ++i) {
+    builder.open(PlusNode::SUPPLIER, leaves_per_sum);
+    for (int j = 0; j < leaves_per_sum; ++j) {
+      builder.open(IntegerNode::SUPPLIER)
+          .attr(TestAttribute::COUNT, int64_t(j))
+          .close();
+    }
+    builder.close();
+  }
+  return builder.close().finish();
+}
+
+}
+
+using namespace TreeExporterTest;
+
+TEST(TreeExporter, Json) {
+  ASSERT_EQ(
+      "{\"type\":\"RootNode\","
+          "\"attributes\":{\"SERIAL_NO\":\"1\"},"
+          "\"children\":["
+      "{\"type\":\"PlusNode\","
+          "\"attributes\":{\"SERIAL_NO\":\"2\"},"
+          "\"children\":["
+      "{\"type\":\"IntegerNode\","
+          "\"attributes\":{\"SERIAL_NO\":\"3\","
+          "\"VALUE\":\"137\"}},"
+      "{\"type\":\"IntegerNode\","
+          "\"attributes\":{\"SERIAL_NO\":\"4\","
+          "\"VALUE\":\"314\"}}"
+      "]}]}\n",
+      export_tree<JsonExporter>(TestTrees::simple_addition()));
+}
+
+TEST(TreeExporter, JsonValues) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  root->set(TestAttribute::NAME, "say \"hi\"\\\n\t\x01");
+  root->set(TestAttribute::COUNT, int64_t(-7));
+  root->set(TestAttribute::WEIGHT, 0.5);
+  root->set(TestAttribute::VISITED, true);
+  root->set(TestAttribute::TYPE_NAME, InternPool::global().intern("int"));
+  ASSERT_EQ(
+      "{\"type\":\"RootNode\",\"attributes\":{"
+      "\"TestAttribute::NAME\":\"say \\\"hi\\\"\\\\\\n\\t\\u0001\","
+      "\"TestAttribute::COUNT\":-7,"
+      "\"TestAttribute::WEIGHT\":0.5,"
+      "\"TestAttribute::VISITED\":true,"
+      "\"TestAttribute::TYPE_NAME\":\"int\"}}\n",
+      export_tree<JsonExporter>(root));
+
+  root->set(TestAttribute::WEIGHT, numeric_limits<double>::infinity());
+  ASSERT_NE(
+      string::npos,
+      export_tree<JsonExporter>(root).find(
+          "\"TestAttribute::WEIGHT\":null"));
+}
+
+TEST(TreeExporter, JsonSubtreeAndDepth) {
+  auto all_operations = TestTrees::all_operations();
+  ASSERT_EQ(
+      "{\"type\":\"TimesNode\",\"children\":["
+      "{\"type\":\"IntegerNode\","
+          "\"attributes\":{\"VALUE\":\"3\"}},"
+      "{\"type\":\"IntegerNode\","
+          "\"attributes\":{\"VALUE\":\"4\"}}"
+      "]}\n",
+      export_tree<JsonExporter>(all_operations->child(0)->child(0)));
+  ASSERT_EQ(
+      "{\"type\":\"RootNode\",\"children\":["
+      "{\"type\":\"PlusNode\",\"children\":["
+      "{\"type\":\"TimesNode\",\"elided\":2},"
+      "{\"type\":\"MinusNode\",\"elided\":2}"
+      "]}]}\n",
+      export_tree<JsonExporter>(all_operations, 2));
+  ASSERT_EQ(
+      "{\"type\":\"RootNode\",\"elided\":1}\n",
+      export_tree<JsonExporter>(all_operations, 0));
+}
+
+TEST(TreeExporter, Dot) {
+  ASSERT_EQ(
+      "digraph tree {\n"
+      "  node [shape=box];\n"
+      "  n0 [label=\"RootNode\\nSERIAL_NO=1\"];\n"
+      "  n1 [label=\"PlusNode\\nSERIAL_NO=2\"];\n"
+      "  n0 -> n1;\n"
+      "  n2 [label=\"IntegerNode\\nSERIAL_NO=3"
+          "\\nVALUE=137\"];\n"
+      "  n1 -> n2;\n"
+      "  n3 [label=\"IntegerNode\\nSERIAL_NO=4"
+          "\\nVALUE=314\"];\n"
+      "  n1 -> n3;\n"
+      "}\n",
+      export_tree<DotExporter>(TestTrees::simple_addition()));
+}
+
+TEST(TreeExporter, DotEscapesAndDepth) {
+  auto root = RootNode::SUPPLIER.make_shared();
+  root->set(TestAttribute::NAME, "a \"b\"\\c\nd");
+  root->append_child(PlusNode::SUPPLIER)
+      ->append_child(IntegerNode::SUPPLIER)
+      ->append_sibling(IntegerNode::SUPPLIER);
+  ASSERT_EQ(
+      "digraph tree {\n"
+      "  node [shape=box];\n"
+      "  n0 [label=\"RootNode\\nTestAttribute::NAME=a \\\"b\\\"\\\\c\\nd\"];\n"
+      "  n1 [label=\"PlusNode\"];\n"
+      "  n0 -> n1;\n"
+      "  n2 [label=\"... (2 more)\", shape=plaintext];\n"
+      "  n1 -> n2;\n"
+      "}\n",
+      export_tree<DotExporter>(root, 1));
+}
+
+TEST(TreeExporter, Reuse) {
+  ostringstream out;
+  DotExporter exporter(out);
+  exporter.write(TestTrees::simple_addition());
+  auto first = out.str();
+  exporter.write(TestTrees::simple_addition());
+  ASSERT_EQ(first + first, out.str());
+}
+
+TEST(TreeExporter, BoundedWrites) {
+  auto root = sums(1 << 12, 15);
+  CountingSink sink;
+  JsonExporter exporter(sink);
+  exporter.write(root);
+  ASSERT_EQ(export_tree<JsonExporter>(root).size(), sink.size);
+  ASSERT_LT(TreeExporter::BUFFER_SIZE, sink.size);
+  ASSERT_LT(sink.largest_write, TreeExporter::BUFFER_SIZE + 1024);
+}
@@ -15,6 +15,7 @@
 #include "gtest/gtest.h"
 
 #include "BaseAttrNodeTraversal.h"
+#include "BorrowingVisitingTraversal.h"
 #include "DivNode.h"
 #include "IntegerNode.h"
 #include "MinusNode.h"
@@ -25,6 +26,7 @@
 #include "TestAttribute.h"
 #include "TestTrees.h"
 #include "TimesNode.h"
+#include "TreeCorruptError.h"
 #include "ValueNode.h"
 #include "VacuousVoidFunction.h"
 #include "VisitingTraversal.h"
@@ -199,3 +201,28 @@ TEST(VisitingTraversal, FullCalculation) {
 //  ASSERT_EQ(1, context.stack_depth());
 //  ASSERT_EQ(14, context.pop_value());
 }
+
+TEST(VisitingTraversal, Borrowing) {
+  CalcContext context;
+  CalcOnEntry on_entry(context);
+  CalcOnExit on_exit(context);
+  auto root = TestTrees::addition_and_multiplication();
+  BorrowingVisitingTraversal<BaseAttrNode> traversal(
+      &on_entry, &on_exit, do_nothing, do_nothing);
+  traversal(root);
+  ASSERT_EQ(1, context.stack_depth());
+  ASSERT_EQ(152, context.pop_value());
+  ASSERT_EQ(1, root.use_count());
+}
+
+TEST(VisitingTraversal, NullRoot) {
+  OperatorNodeCounter on_entry;
+  ValueNodeCounter on_exit;
+  VisitingTraversal<BaseAttrNode> sharing(
+      &on_entry, &on_exit, do_nothing, do_nothing);
+  ASSERT_THROW(sharing(nullptr), TreeCorruptError);
+  BorrowingVisitingTraversal<BaseAttrNode> borrowing(
+      &on_entry, &on_exit, do_nothing, do_nothing);
+  ASSERT_THROW(borrowing(static_cast<BaseAttrNode *>(nullptr)),
+      TreeCorruptError);
+}